@@ -53,7 +53,13 @@ extern uint32_t SystemCoreClock;
 #define configTICK_RATE_HZ				( ( TickType_t ) 1000 )
 #define configMAX_PRIORITIES			( 5 )
 #define configMINIMAL_STACK_SIZE		( ( unsigned short ) 130 )
-#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 16 * 1024 ) )
+/* Heap budget (heap_4, 8 byte block header): task stacks + TCBs ~7.9 KB
+(Menu 1024 words, Idle 130, Key 128, Pedometer/Alarm/Display 192 each),
+queues + mutexes ~0.6 KB, history pool ~1 KB, about 9.4 KB in total.  11 KB
+leaves ~1.8 KB headroom and keeps .data + .bss + startup stack/heap under the
+20 KB of the STM32F103C8.  These are host estimates; check them on the target
+with the Menu page heap print and MENU_TASK_PROFILE. */
+#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 11 * 1024 ) )
 #define configMAX_TASK_NAME_LEN			( 10 )
 #define configUSE_TRACE_FACILITY		1
 #define configUSE_16_BIT_TICKS			0
@@ -68,8 +74,9 @@ extern uint32_t SystemCoreClock;
 #define configGENERATE_RUN_TIME_STATS	0
 
 
-/* Software timer definitions. */
-#define configUSE_TIMERS				1
+/* Software timer definitions.  No software timers are used, so the timer
+task and its command queue (~1.3 KB of heap) are not created. */
+#define configUSE_TIMERS				0
 #define configTIMER_TASK_PRIORITY		( 2 )
 #define configTIMER_QUEUE_LENGTH		10
 #define configTIMER_TASK_STACK_DEPTH	( configMINIMAL_STACK_SIZE * 2 )
@@ -83,6 +90,7 @@ to exclude the API function. */
 #define INCLUDE_vTaskSuspend			1
 #define INCLUDE_vTaskDelayUntil			1
 #define INCLUDE_vTaskDelay				1
+#define INCLUDE_uxTaskGetStackHighWaterMark	1
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -1,4 +1,21 @@
 #include "Key.h"
+
+/* 单个按键的扫描状态 */
+typedef struct {
+	uint8_t pressed;            // 去抖后的状态，1-按下
+	uint8_t bounce;             // 原始电平与 pressed 不同的连续采样次数
+	uint8_t consumed;           // 本次按下已报告过长按或组合键
+	uint8_t repeat;             // 本次按下已连发的次数
+	uint32_t press_time;        // 按下时刻
+	uint32_t next_time;         // 下一次长按/连发的时刻
+	uint16_t interval;          // 当前连发间隔(ms)
+} key_state_t;
+
+static key_state_t s_keys[KEY_COUNT];
+static key_event_t s_events[KEY_EVENT_QUEUE_SIZE];
+static uint8_t s_event_head;
+static uint8_t s_event_tail;
+
 /**
   * 函    数：按键初始化
   * 参    数：无
@@ -8,60 +25,181 @@ void Key_Init(void)
 {
 	/*开启时钟*/
 	RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB, ENABLE);		//开启GPIOB的时钟
-	
+
 	/*GPIO初始化*/
 	GPIO_InitTypeDef GPIO_InitStructure;
 	GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IPU;
 	GPIO_InitStructure.GPIO_Pin = KEY1_PIN | KEY2_PIN|KEY3_PIN|KEY4_PIN;
 	GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
-	GPIO_Init(GPIOB, &GPIO_InitStructure);						
+	GPIO_Init(GPIOB, &GPIO_InitStructure);
 }
 
 /**
-  * 函    数：按键获取键码
-  * 参    数：无
-  * 返 回 值：按下按键的键码值，范围：0~2，返回0代表没有按键按下
-  * 注意事项：此函数是阻塞式操作，当按键按住不放时，函数会卡住，直到按键松手
+  * 函    数：读取按键原始电平
+  * 参    数：index 按键下标0~3
+  * 返 回 值：1-按下（低电平），0-松开
   */
-uint8_t Key_GetNum(void)
+static uint8_t Key_ReadRaw(uint8_t index)
 {
-	uint8_t KeyNum = 0;		//定义变量，默认键码值为0
-	
-	if (KEY1 == 0)			//读PB1输入寄存器的状态，如果为0，则代表按键1按下
+	switch (index)
+	{
+		case 0: return KEY1 == 0;
+		case 1: return KEY2 == 0;
+		case 2: return KEY3 == 0;
+		case 3: return KEY4 == 0;
+		default: return 0;
+	}
+}
+
+/**
+  * 函    数：事件入队
+  * 参    数：type 事件类型，key 键码或组合键掩码，flags 标志，repeat 连发序号，now 时刻
+  * 返 回 值：无
+  * 注意事项：缓冲满时丢弃新事件
+  */
+static void Key_PushEvent(uint8_t type, uint8_t key, uint8_t flags, uint8_t repeat, uint32_t now)
+{
+	uint8_t next = (s_event_head + 1) % KEY_EVENT_QUEUE_SIZE;
+
+	if (next == s_event_tail)
+	{
+		return;
+	}
+	s_events[s_event_head].type = type;
+	s_events[s_event_head].key = key;
+	s_events[s_event_head].flags = flags;
+	s_events[s_event_head].repeat = repeat;
+	s_events[s_event_head].timestamp = now;
+	s_event_head = next;
+}
+
+/**
+  * 函    数：处理一次去抖后的按下
+  * 参    数：index 按键下标，now 时刻
+  * 返 回 值：无
+  * 注意事项：另一个键在 KEY_CHORD_MS 内先按下且未被占用时，两键组成组合键，
+  *           之后不再报告它们的长按和连发，松开事件带 KEY_FLAG_CONSUMED
+  */
+static void Key_OnPress(uint8_t index, uint32_t now)
+{
+	key_state_t *key = &s_keys[index];
+
+	key->press_time = now;
+	key->consumed = 0;
+	key->repeat = 0;
+	key->interval = KEY_REPEAT_START_MS;
+	key->next_time = now + pdMS_TO_TICKS((KEY_REPEAT_KEYS & KEY_MASK(index + 1)) ? KEY_REPEAT_DELAY_MS : KEY_LONG_MS);
+	Key_PushEvent(KEY_EVENT_PRESS, index + 1, 0, 0, now);
+
+	for (uint8_t i = 0; i < KEY_COUNT; i++)
 	{
-		vTaskDelay(20);											//延时消抖
-		while (KEY1 == 0);	//等待按键松手
-		vTaskDelay(20);											//延时消抖
-		KeyNum = 1;												//置键码为1
+		if (i != index && s_keys[i].pressed && !s_keys[i].consumed &&
+		    now - s_keys[i].press_time <= pdMS_TO_TICKS(KEY_CHORD_MS))
+		{
+			s_keys[i].consumed = 1;
+			key->consumed = 1;
+			Key_PushEvent(KEY_EVENT_CHORD, KEY_MASK(i + 1) | KEY_MASK(index + 1), 0, 0, now);
+			break;
+		}
 	}
-	
-	if (KEY2 == 0)			//读PB11输入寄存器的状态，如果为0，则代表按键2按下
+}
+
+/**
+  * 函    数：处理按住期间的长按和连发
+  * 参    数：index 按键下标，now 时刻
+  * 返 回 值：无
+  */
+static void Key_OnHold(uint8_t index, uint32_t now)
+{
+	key_state_t *key = &s_keys[index];
+
+	if (key->consumed || (int32_t)(now - key->next_time) < 0)
 	{
-		vTaskDelay(20);											//延时消抖
-		while (KEY2== 0);	//等待按键松手
-		vTaskDelay(20);											//延时消抖
-		KeyNum = 2;												//置键码为2
+		return;
 	}
 
-	if (KEY3 == 0)			//读PB11输入寄存器的状态，如果为0，则代表按键2按下
+	if (KEY_REPEAT_KEYS & KEY_MASK(index + 1))
+	{
+		// 连发：每次间隔缩短 KEY_REPEAT_STEP_MS，直到 KEY_REPEAT_MIN_MS
+		if (key->repeat < 255)
+		{
+			key->repeat++;
+		}
+		Key_PushEvent(KEY_EVENT_REPEAT, index + 1, 0, key->repeat, now);
+		key->next_time = now + pdMS_TO_TICKS(key->interval);
+		if (key->interval > KEY_REPEAT_MIN_MS + KEY_REPEAT_STEP_MS)
+		{
+			key->interval -= KEY_REPEAT_STEP_MS;
+		}
+		else
+		{
+			key->interval = KEY_REPEAT_MIN_MS;
+		}
+	}
+	else
 	{
-		vTaskDelay(20);											//延时消抖
-		while (KEY3== 0);	//等待按键松手
-		vTaskDelay(20);											//延时消抖
-		KeyNum = 3;												//置键码为2
+		// 长按只报告一次，之后的松开不再算单击
+		key->consumed = 1;
+		Key_PushEvent(KEY_EVENT_LONG, index + 1, 0, 0, now);
 	}
+}
 
-	if (KEY4 == 0)			//读PB11输入寄存器的状态，如果为0，则代表按键2按下
+/**
+  * 函    数：按键扫描，每 KEY_SCAN_MS 调用一次
+  * 参    数：无
+  * 返 回 值：无
+  * 注意事项：非阻塞；电平连续 KEY_DEBOUNCE_MS 与当前状态不同才翻转，
+  *           产生的事件用 Key_GetEvent 取出
+  */
+void Key_Scan(void)
+{
+	uint32_t now = xTaskGetTickCount();
+
+	for (uint8_t i = 0; i < KEY_COUNT; i++)
 	{
-		vTaskDelay(20);											//延时消抖
-		while (KEY4== 0);	//等待按键松手
-		vTaskDelay(20);											//延时消抖
-		KeyNum = 4;												//置键码为2
+		key_state_t *key = &s_keys[i];
+
+		if (Key_ReadRaw(i) != key->pressed)
+		{
+			key->bounce++;
+			if (key->bounce * KEY_SCAN_MS >= KEY_DEBOUNCE_MS)
+			{
+				key->bounce = 0;
+				key->pressed = !key->pressed;
+				if (key->pressed)
+				{
+					Key_OnPress(i, now);
+				}
+				else
+				{
+					Key_PushEvent(KEY_EVENT_RELEASE, i + 1, key->consumed ? KEY_FLAG_CONSUMED : 0, 0, now);
+				}
+			}
+		}
+		else
+		{
+			key->bounce = 0;
+			if (key->pressed)
+			{
+				Key_OnHold(i, now);
+			}
+		}
 	}
-	
-	return KeyNum;			//返回键码值，如果没有按键按下，所有if都不成立，则键码为默认值0
 }
-uint8_t KEY_Get(void)
+
+/**
+  * 函    数：取出一个按键事件
+  * 参    数：event 事件输出
+  * 返 回 值：1-取到事件，0-没有事件
+  * 注意事项：与 Key_Scan 在同一任务中调用
+  */
+uint8_t Key_GetEvent(key_event_t *event)
 {
-	return Key_GetNum();
+	if (s_event_tail == s_event_head)
+	{
+		return 0;
+	}
+	*event = s_events[s_event_tail];
+	s_event_tail = (s_event_tail + 1) % KEY_EVENT_QUEUE_SIZE;
+	return 1;
 }
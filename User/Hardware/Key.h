@@ -8,9 +8,45 @@
 // 按键按键常量定义
 // ==================================
 
+#define KEY_COUNT               4       // 按键数，键码1~4
+#define KEY_MASK(key)           (1U << ((key) - 1))
 
+#define KEY_SCAN_MS             10      // 扫描周期，Key_Scan 按此周期调用
+#define KEY_DEBOUNCE_MS         20      // 电平连续稳定这么久才认定按下/松开
+#define KEY_LONG_MS             800     // 长按判定时间（不连发的键）
+#define KEY_REPEAT_DELAY_MS     400     // 按住后开始连发的时间
+#define KEY_REPEAT_START_MS     150     // 首次连发间隔
+#define KEY_REPEAT_MIN_MS       40      // 加速后的最短连发间隔
+#define KEY_REPEAT_STEP_MS      15      // 每连发一次间隔缩短
+#define KEY_CHORD_MS            80      // 两键按下间隔不超过此值视为组合键
+#define KEY_REPEAT_KEYS         (KEY_MASK(1) | KEY_MASK(2))    // 连发的键（其余键报告长按）
+
+#define KEY_EVENT_QUEUE_SIZE    8       // 事件缓冲深度，满了丢弃新事件
+
+// ==================================
+// 按键事件
+// ==================================
+
+typedef enum {
+	KEY_EVENT_NONE = 0,
+	KEY_EVENT_PRESS,            // 按下（去抖后）
+	KEY_EVENT_RELEASE,          // 松开（去抖后）
+	KEY_EVENT_LONG,             // 长按，按住 KEY_LONG_MS 报告一次
+	KEY_EVENT_REPEAT,           // 连发，间隔逐次缩短
+	KEY_EVENT_CHORD             // 组合键，key 为两键的位掩码
+} key_event_type_t;
+
+#define KEY_FLAG_CONSUMED       0x01    // 松开前已报告过长按或组合键，松开不应再当作单击
+
+typedef struct {
+	uint8_t type;               // key_event_type_t
+	uint8_t key;                // 键码1~4；组合键为 KEY_MASK(a) | KEY_MASK(b)
+	uint8_t flags;              // KEY_FLAG_xxx
+	uint8_t repeat;             // 连发序号（从1开始），其他事件为0
+	uint32_t timestamp;         // 事件时刻（系统节拍）
+} key_event_t;
 
 void Key_Init(void);
-uint8_t Key_GetNum(void);
-uint8_t KEY_Get(void);
+void Key_Scan(void);
+uint8_t Key_GetEvent(key_event_t *event);
 #endif
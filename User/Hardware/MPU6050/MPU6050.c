@@ -1,5 +1,6 @@
 
 #include "MPU6050_hardware_i2c.h"
+#include "mpu_calib.h"
 #include "stdio.h"
 #include "eMPL/inv_mpu.h"
 #include "eMPL/inv_mpu_dmp_motion_driver.h"
@@ -15,7 +16,7 @@ u8 MPU_Init(void)
 	MPU_Write_Byte(MPU_ADDR, MPU_PWR_MGMT1_REG, 0X00); // MPU6050
 	MPU_Set_Gyro_Fsr(3);							   // Ǵ,2000dps
 	MPU_Set_Accel_Fsr(0);							   // ٶȴ,2g
-	MPU_Set_Rate(50);								   // ò50Hz
+	MPU_Set_Rate(MPU_SAMPLE_RATE_HZ);				   // ò50Hz
 	MPU_Write_Byte(MPU_ADDR, MPU_INT_EN_REG, 0X00);	   // رж
 	MPU_Write_Byte(MPU_ADDR, MPU_USER_CTRL_REG, 0X00); // I2Cģʽر
 	MPU_Write_Byte(MPU_ADDR, MPU_FIFO_EN_REG, 0X00);   // رFIFO
@@ -26,7 +27,7 @@ u8 MPU_Init(void)
 	{
 		MPU_Write_Byte(MPU_ADDR, MPU_PWR_MGMT1_REG, 0X01); // CLKSEL,PLL XΪο
 		MPU_Write_Byte(MPU_ADDR, MPU_PWR_MGMT2_REG, 0X00); // ٶǶ
-		MPU_Set_Rate(50);								   // òΪ50Hz
+		MPU_Set_Rate(MPU_SAMPLE_RATE_HZ);				   // òΪ50Hz
 	}
 	else
 		return 1;
@@ -97,8 +98,8 @@ short MPU_Get_Temperature(void)
 	temp = 36.53 + ((double)raw) / 340;
 	return temp * 100;
 }
-// õֵ(ԭʼֵ)
-// gx,gy,gz:x,y,zԭʼ()
+// õֵ(ƫУ׼)
+// gx,gy,gz:x,y,zĶ()
 // ֵ:0,ɹ
 //     ,
 u8 MPU_Get_Gyroscope(short *gx, short *gy, short *gz)
@@ -110,11 +111,12 @@ u8 MPU_Get_Gyroscope(short *gx, short *gy, short *gz)
 		*gx = ((u16)buf[0] << 8) | buf[1];
 		*gy = ((u16)buf[2] << 8) | buf[3];
 		*gz = ((u16)buf[4] << 8) | buf[5];
+		mpu_calib_apply_gyro(gx, gy, gz);
 	}
 	return res;
 	;
 }
-// õٶֵ(ԭʼֵ)
+// õٶֵ(ƫУ׼)
 // gx,gy,gz:x,y,zԭʼ()
 // ֵ:0,ɹ
 //     ,
@@ -127,11 +129,36 @@ u8 MPU_Get_Accelerometer(short *ax, short *ay, short *az)
 		*ax = ((u16)buf[0] << 8) | buf[1];
 		*ay = ((u16)buf[2] << 8) | buf[3];
 		*az = ((u16)buf[4] << 8) | buf[5];
+		mpu_calib_apply_accel(ax, ay, az);
 	}
 	return res;
 	;
 }
 
+// һԶȡٶ+¶+ǹ14ֽ(У׼)
+// ȷֱMPU_Get_Accelerometer/MPU_Get_GyroscopeһI2C,ͬһʱ
+// ax,ay,az:ٶȼx,y,zĶ()
+// gx,gy,gz:x,y,zĶ()
+// ֵ:0,ɹ
+//     ,
+u8 MPU_Get_Motion6(short *ax, short *ay, short *az, short *gx, short *gy, short *gz)
+{
+	u8 buf[14], res;
+	res = MPU_Read_Bytes(MPU_ADDR, MPU_ACCEL_XOUTH_REG, 14, buf);
+	if (res == 0)
+	{
+		*ax = ((u16)buf[0] << 8) | buf[1];
+		*ay = ((u16)buf[2] << 8) | buf[3];
+		*az = ((u16)buf[4] << 8) | buf[5];
+		*gx = ((u16)buf[8] << 8) | buf[9];
+		*gy = ((u16)buf[10] << 8) | buf[11];
+		*gz = ((u16)buf[12] << 8) | buf[13];
+		mpu_calib_apply_accel(ax, ay, az);
+		mpu_calib_apply_gyro(gx, gy, gz);
+	}
+	return res;
+}
+
 //ݸλ(V2.6汾)
 //fun:. 0XA0~0XAF
 //data:ݻ,28ֽ!!
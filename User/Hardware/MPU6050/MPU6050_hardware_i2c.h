@@ -78,6 +78,9 @@
 // If connected to 3.3V, I2C address is 0X69
 #define MPU_ADDR                  0X68
 
+// Sample rate configured by MPU_Init, shared with the sensor task and detectors
+#define MPU_SAMPLE_RATE_HZ        50
+
 /************************************ Hardware I2C Implementation ************************************** */
 #include "hardware_i2c.h"
 #include "debug.h"
@@ -104,6 +107,7 @@ u8 MPU_Set_Fifo(u8 sens);
 short MPU_Get_Temperature(void);
 u8 MPU_Get_Gyroscope(short *gx,short *gy,short *gz);
 u8 MPU_Get_Accelerometer(short *ax,short *ay,short *az);
+u8 MPU_Get_Motion6(short *ax,short *ay,short *az,short *gx,short *gy,short *gz);
 void MPU_ReportImu(short aacx,short aacy,short aacz,short gyrox,short gyroy,short gyroz,short roll,short pitch,short yaw);
 
 // DMP pedometer functions
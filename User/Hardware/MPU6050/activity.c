@@ -0,0 +1,357 @@
+#include "activity.h"
+#include <stddef.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "debug.h"
+#include "fixed_math.h"
+#include "step_detector.h"
+
+// 采样间隔超过该值时丢弃当前窗口
+#define ACTIVITY_MAX_GAP_MS         1000
+
+// 合加速度上限（平方和超过后直接饱和）
+#define ACTIVITY_MAGNITUDE_MAX      32766
+#define ACTIVITY_MAGNITUDE_MAX_SQ   ((uint32_t)ACTIVITY_MAGNITUDE_MAX * ACTIVITY_MAGNITUDE_MAX)
+
+#define ACTIVITY_BINS               3
+
+// ==================================
+// Goertzel 系数表
+// ==================================
+
+/*
+ * coeff = 2*cos(2*pi*f/fs)，Q14，f = 1/2/3Hz
+ * s[n] = x[n] + coeff*s[n-1] - s[n-2]
+ * 能量 = s1^2 + s2^2 - coeff*s1*s2
+ */
+typedef struct {
+    uint16_t rate_hz;
+    int32_t coeff[ACTIVITY_BINS];
+} activity_goertzel_coef_t;
+
+static const activity_goertzel_coef_t s_goertzel_table[] = {
+    {25,  {31739, 28715, 23887}},
+    {50,  {32510, 31739, 30467}},
+    {100, {32703, 32510, 32188}},
+    {200, {32752, 32703, 32623}},
+};
+
+#define ACTIVITY_TABLE_SIZE  (sizeof(s_goertzel_table) / sizeof(s_goertzel_table[0]))
+
+// ==================================
+// 模块状态
+// ==================================
+
+typedef struct {
+    const activity_goertzel_coef_t *coef;
+
+    // 当前窗口累加量
+    int32_t s1[ACTIVITY_BINS];
+    int32_t s2[ACTIVITY_BINS];
+    int32_t sum;                    // Σx
+    uint64_t sum_sq;                // Σx²
+    uint16_t count;                 // 样本数
+    int32_t dc;                     // 直流估计（上一窗口均值），x = |a| - dc
+    unsigned long window_start;
+    unsigned long last_sample_time;
+    uint8_t has_sample;
+
+    // 峰值率
+    unsigned long last_peaks;
+    uint8_t peak_hist[ACTIVITY_PEAK_WINDOWS];
+    uint8_t peak_index;
+
+    // 状态去抖
+    uint8_t last_periodicity;       // 上一窗口周期性
+    uint8_t candidate;
+
+    activity_info_t output;         // 对外发布的快照
+} activity_ctx_t;
+
+static activity_ctx_t s_activity;
+
+static const char *const s_state_names[] = {"Idle", "Walk", "Run"};
+
+// ==================================
+// 内部函数
+// ==================================
+
+static int32_t activity_magnitude(short ax, short ay, short az)
+{
+    uint32_t magnitude_sq = (uint32_t)((int32_t)ax * ax)
+                          + (uint32_t)((int32_t)ay * ay)
+                          + (uint32_t)((int32_t)az * az);
+
+    if (magnitude_sq >= ACTIVITY_MAGNITUDE_MAX_SQ) {
+        return ACTIVITY_MAGNITUDE_MAX;
+    }
+    return fx_isqrt32(magnitude_sq);
+}
+
+/**
+ * @brief 清空当前窗口
+ */
+static void activity_window_clear(unsigned long timestamp_ms)
+{
+    uint8_t i;
+
+    for (i = 0; i < ACTIVITY_BINS; i++) {
+        s_activity.s1[i] = 0;
+        s_activity.s2[i] = 0;
+    }
+    s_activity.sum = 0;
+    s_activity.sum_sq = 0;
+    s_activity.count = 0;
+    s_activity.window_start = timestamp_ms;
+}
+
+/**
+ * @brief 决策树分类
+ * @param std 合加速度标准差
+ * @param periodicity 周期性（Q8）
+ * @param dominant_hz 主频
+ * @param peak_spm 峰值率（次/分钟）
+ * @param rhythm_locked step_detector 节律是否已确认
+ * @return 分类结果
+ */
+static activity_state_t activity_classify(uint32_t std, uint8_t periodicity,
+                                          uint8_t dominant_hz, uint16_t peak_spm,
+                                          uint8_t rhythm_locked)
+{
+    if (std < ACTIVITY_IDLE_STD) {
+        return ACTIVITY_IDLE;
+    }
+    // 有动作但无节律（抬手、打字、乘车颠簸）：随机的慢动作在1秒窗口内也会有不少能量
+    // 落入1Hz频点，因此还要求步间隔一致（step_detector 已锁定节律）
+    if (periodicity < ACTIVITY_PERIODIC_MIN || peak_spm < ACTIVITY_WALK_MIN_SPM ||
+        !rhythm_locked) {
+        return ACTIVITY_IDLE;
+    }
+    if (std >= ACTIVITY_RUN_STD &&
+        (dominant_hz == 3 || peak_spm >= ACTIVITY_RUN_MIN_SPM)) {
+        return ACTIVITY_RUN;
+    }
+    return ACTIVITY_WALK;
+}
+
+/**
+ * @brief 窗口结束：提取特征、分类并发布
+ */
+static void activity_window_finish(void)
+{
+    const activity_goertzel_coef_t *c = s_activity.coef;
+    uint16_t n = s_activity.count;
+    int64_t power;
+    int64_t power_sum = 0;
+    int64_t power_max = -1;
+    int64_t energy;
+    uint32_t periodicity = 0;
+    uint32_t std;
+    uint16_t peak_sum = 0;
+    uint16_t peak_spm;
+    uint16_t cadence;
+    unsigned long peaks;
+    uint8_t dominant = 0;
+    uint8_t i;
+    activity_state_t state;
+
+    // 去均值后的总能量 N*Σx² - (Σx)²，即 N² * 方差
+    energy = (int64_t)s_activity.sum_sq * n - (int64_t)s_activity.sum * s_activity.sum;
+    if (energy < 0) {
+        energy = 0;
+    }
+
+    for (i = 0; i < ACTIVITY_BINS; i++) {
+        int32_t s1 = s_activity.s1[i];
+        int32_t s2 = s_activity.s2[i];
+        power = (int64_t)s1 * s1 + (int64_t)s2 * s2
+              - (((int64_t)c->coeff[i] * s1) >> 14) * s2;
+        power_sum += power;
+        if (power > power_max) {
+            power_max = power;
+            dominant = i + 1;
+        }
+    }
+
+    // 纯正弦落在频点上时 |X|² = (N*A/2)²，N²方差 = N²*A²/2，比值 2|X|²/(N²方差) = 1
+    if (energy > 0) {
+        periodicity = (uint32_t)((power_sum * 2 * 256) / energy);
+        if (periodicity > 255) {
+            periodicity = 255;
+        }
+    }
+    std = fx_isqrt32((uint32_t)(energy / ((int64_t)n * n)));
+
+    // 峰值率：最近几个窗口内 step_detector 的峰谷数
+    peaks = step_detector_get_peaks();
+    s_activity.peak_hist[s_activity.peak_index] = (uint8_t)(peaks - s_activity.last_peaks);
+    s_activity.peak_index = (s_activity.peak_index + 1) % ACTIVITY_PEAK_WINDOWS;
+    s_activity.last_peaks = peaks;
+    for (i = 0; i < ACTIVITY_PEAK_WINDOWS; i++) {
+        peak_sum += s_activity.peak_hist[i];
+    }
+    peak_spm = (uint16_t)(peak_sum * (60000UL / (ACTIVITY_WINDOW_MS * ACTIVITY_PEAK_WINDOWS)));
+
+    // 直流估计跟随本窗口均值
+    s_activity.dc += s_activity.sum / (int32_t)n;
+
+    // 连续两个窗口结果一致才切换
+    // 周期性取本窗口和上一窗口的较小值，单个窗口偶然的高周期性不足以判为运动
+    state = activity_classify(std,
+                              (uint8_t)(periodicity < s_activity.last_periodicity ?
+                                        periodicity : s_activity.last_periodicity),
+                              dominant, peak_spm, step_detector_is_locked());
+    s_activity.last_periodicity = (uint8_t)periodicity;
+    if (state != (activity_state_t)s_activity.output.state) {
+        if (state != (activity_state_t)s_activity.candidate) {
+            // 第一次出现，先记为候选，保持原状态
+            s_activity.candidate = (uint8_t)state;
+            state = (activity_state_t)s_activity.output.state;
+        } else {
+            printf("Activity: %s -> %s\r\n",
+                   s_state_names[s_activity.output.state], s_state_names[state]);
+        }
+    } else {
+        s_activity.candidate = (uint8_t)state;
+    }
+
+    // 步频优先取节律已确认的步间隔，否则用峰值率
+    cadence = 0;
+    if (state != ACTIVITY_IDLE) {
+        cadence = step_detector_get_cadence();
+        if (cadence == 0) {
+            cadence = peak_spm;
+        }
+    }
+
+    taskENTER_CRITICAL();
+    s_activity.output.state = (uint8_t)state;
+    s_activity.output.dominant_hz = (state != ACTIVITY_IDLE) ? dominant : 0;
+    s_activity.output.periodicity = (uint8_t)periodicity;
+    s_activity.output.cadence_spm = cadence;
+    s_activity.output.std_mg = (uint16_t)(std * 1000 / FX_Q14_ONE);
+    s_activity.output.windows++;
+    taskEXIT_CRITICAL();
+}
+
+// ==================================
+// 对外接口
+// ==================================
+
+/**
+ * @brief 初始化运动状态识别
+ * @param sample_rate_hz 传感器采样率
+ * @return 0-成功，-1-系数表中无此采样率（使用最接近的一组系数）
+ */
+int activity_init(uint16_t sample_rate_hz)
+{
+    uint8_t i;
+    uint8_t best = 0;
+    uint16_t best_diff = 0xFFFF;
+    uint16_t diff;
+
+    for (i = 0; i < ACTIVITY_TABLE_SIZE; i++) {
+        diff = (s_goertzel_table[i].rate_hz > sample_rate_hz) ?
+               (s_goertzel_table[i].rate_hz - sample_rate_hz) :
+               (sample_rate_hz - s_goertzel_table[i].rate_hz);
+        if (diff < best_diff) {
+            best_diff = diff;
+            best = i;
+        }
+    }
+
+    memset(&s_activity, 0, sizeof(s_activity));
+    s_activity.coef = &s_goertzel_table[best];
+    s_activity.last_peaks = step_detector_get_peaks();
+
+    printf("Activity classifier initialized, rate=%dHz\r\n", s_activity.coef->rate_hz);
+    return (best_diff == 0) ? 0 : -1;
+}
+
+/**
+ * @brief 输入单个带时间戳的采样（由传感器任务在 step_detector_update 之后调用）
+ * @param ax X轴加速度
+ * @param ay Y轴加速度
+ * @param az Z轴加速度
+ * @param timestamp_ms 采样时间戳（毫秒，允许回绕）
+ */
+void activity_update(short ax, short ay, short az, unsigned long timestamp_ms)
+{
+    int32_t x;
+    int32_t s;
+    uint8_t i;
+
+    if (s_activity.coef == NULL) {
+        return;
+    }
+
+    x = activity_magnitude(ax, ay, az);
+
+    // 首帧或采样断档：以当前值为直流估计重新开窗
+    if (!s_activity.has_sample ||
+        timestamp_ms - s_activity.last_sample_time > ACTIVITY_MAX_GAP_MS) {
+        s_activity.has_sample = 1;
+        s_activity.last_sample_time = timestamp_ms;
+        s_activity.dc = x;
+        activity_window_clear(timestamp_ms);
+        return;
+    }
+    s_activity.last_sample_time = timestamp_ms;
+
+    if (timestamp_ms - s_activity.window_start >= ACTIVITY_WINDOW_MS) {
+        if (s_activity.count > 0) {
+            activity_window_finish();
+        }
+        activity_window_clear(timestamp_ms);
+    }
+
+    x -= s_activity.dc;
+    s_activity.sum += x;
+    s_activity.sum_sq += (uint32_t)(x * x);
+    s_activity.count++;
+
+    for (i = 0; i < ACTIVITY_BINS; i++) {
+        s = x + (int32_t)(((int64_t)s_activity.coef->coeff[i] * s_activity.s1[i]) >> 14)
+              - s_activity.s2[i];
+        s_activity.s2[i] = s_activity.s1[i];
+        s_activity.s1[i] = s;
+    }
+}
+
+/**
+ * @brief 获取最新的运动状态快照
+ * @param info 输出
+ */
+void activity_get(activity_info_t *info)
+{
+    if (info == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    *info = s_activity.output;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 获取当前运动状态（单字节读取，无需临界区）
+ * @return 运动状态
+ */
+activity_state_t activity_get_state(void)
+{
+    return (activity_state_t)s_activity.output.state;
+}
+
+/**
+ * @brief 运动状态名称
+ * @param state 运动状态
+ * @return 名称字符串
+ */
+const char *activity_state_name(activity_state_t state)
+{
+    if ((unsigned)state >= sizeof(s_state_names) / sizeof(s_state_names[0])) {
+        return "?";
+    }
+    return s_state_names[state];
+}
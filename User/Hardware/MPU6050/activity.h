@@ -0,0 +1,63 @@
+/**
+ * @file activity.h
+ * @brief 运动状态识别（静止/步行/跑步）与步频输出
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 传感器任务每帧调用 activity_update()，每 ACTIVITY_WINDOW_MS 提取一次特征：
+ *       - 合加速度标准差
+ *       - Goertzel 在 1/2/3Hz 三个频点的能量：主频和周期性（三点能量占总能量的比例）
+ *       - 峰值率：step_detector 最近 ACTIVITY_PEAK_WINDOWS 个窗口内的峰谷数
+ *       再用定点决策树分类，连续两个窗口结果一致才切换状态。
+ *       每采样约3次乘加，每窗口一次64位除法，读取快照只需几十个周期
+ */
+
+#ifndef __ACTIVITY_H
+#define __ACTIVITY_H
+
+#include <stdint.h>
+
+// ==================================
+// 宏定义
+// ==================================
+
+#define ACTIVITY_WINDOW_MS          1000    // 特征窗口，1秒内1/2/3Hz恰为整周期，三个频点与直流正交
+#define ACTIVITY_PEAK_WINDOWS       4       // 峰值率统计的窗口数
+
+// 决策树阈值（合加速度，16384 = 1g）
+#define ACTIVITY_IDLE_STD           600     // 标准差低于约0.04g视为静止
+#define ACTIVITY_RUN_STD            3300    // 跑步至少约0.2g的标准差
+#define ACTIVITY_PERIODIC_MIN       160     // 周期性下限（Q8，160/256 ≈ 0.63）
+#define ACTIVITY_WALK_MIN_SPM       30      // 峰值率低于该值不算步行
+#define ACTIVITY_RUN_MIN_SPM        150     // 峰值率达到该值且幅度足够视为跑步
+
+// ==================================
+// 数据结构
+// ==================================
+
+typedef enum {
+    ACTIVITY_IDLE = 0,
+    ACTIVITY_WALK,
+    ACTIVITY_RUN
+} activity_state_t;
+
+typedef struct {
+    uint8_t state;              // activity_state_t
+    uint8_t dominant_hz;        // Goertzel 能量最大的频点（1~3Hz），静止时为0
+    uint8_t periodicity;        // 周期性，Q8（256 = 全部能量落在三个频点）
+    uint16_t cadence_spm;       // 步频（步/分钟），静止时为0
+    uint16_t std_mg;            // 合加速度标准差（mg）
+    uint32_t windows;           // 已完成的窗口数（消费方据此判断是否有新数据）
+} activity_info_t;
+
+// ==================================
+// 函数声明
+// ==================================
+
+int activity_init(uint16_t sample_rate_hz);
+void activity_update(short ax, short ay, short az, unsigned long timestamp_ms);
+void activity_get(activity_info_t *info);
+activity_state_t activity_get_state(void);
+const char *activity_state_name(activity_state_t state);
+
+#endif
@@ -0,0 +1,262 @@
+#include "imu_attitude.h"
+#include "fixed_math.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "debug.h"
+
+// ==================================
+// 常量定义
+// ==================================
+
+// 陀螺仪±2000dps：1 LSB = 1/16.4 °/s = 1.0642e-3 rad/s
+// 单次旋转角(Q14) = raw * dt_ms * 1.0642e-6 * 16384 ≈ raw * dt_ms * 1143 / 65536
+#define IMU_GYRO_TO_Q14_MUL       1143
+#define IMU_GYRO_TO_Q14_SHIFT     16
+
+#define IMU_MAX_DT_MS             50       // dt上限，防止任务卡顿后一次积分过大
+
+// 加速度模长在 0.85g ~ 1.15g 之间才参与修正（Q14平方）
+#define IMU_ACC_GATE_LO_SQ        193933476UL   // (0.85 * 16384)^2
+#define IMU_ACC_GATE_HI_SQ        355020964UL   // (1.15 * 16384)^2
+
+// ==================================
+// 模块状态
+// ==================================
+
+typedef struct {
+    int32_t g[3];                    // 重力向量估计，Q14
+    uint8_t initialized;             // 是否已用加速度计初始化
+    uint8_t acc_shift;               // 加速度修正增益 = 1 / 2^acc_shift
+    imu_attitude_t output;           // 对外发布的姿态快照
+    imu_attitude_cb_t subscribers[IMU_ATTITUDE_MAX_SUBSCRIBERS];
+} imu_attitude_state_t;
+
+static imu_attitude_state_t s_imu_state;
+
+// ==================================
+// 内部函数
+// ==================================
+
+/**
+ * @brief 将向量归一化为Q14单位向量
+ * @param v 三维向量（原地修改）
+ * @return 0-成功，-1-零向量
+ */
+static int imu_normalize_q14(int32_t v[3])
+{
+    uint32_t norm_sq = (uint32_t)v[0] * (uint32_t)v[0]
+                     + (uint32_t)v[1] * (uint32_t)v[1]
+                     + (uint32_t)v[2] * (uint32_t)v[2];
+    uint32_t norm = fx_isqrt32(norm_sq);
+
+    if (norm == 0) {
+        return -1;
+    }
+
+    v[0] = v[0] * FX_Q14_ONE / (int32_t)norm;
+    v[1] = v[1] * FX_Q14_ONE / (int32_t)norm;
+    v[2] = v[2] * FX_Q14_ONE / (int32_t)norm;
+    return 0;
+}
+
+// ==================================
+// 初始化
+// ==================================
+
+/**
+ * @brief 初始化姿态估计
+ * @param sample_rate_hz 传感器采样率，用于换算加速度计修正增益
+ */
+void imu_attitude_init(uint16_t sample_rate_hz)
+{
+    uint32_t samples_per_tau = (uint32_t)sample_rate_hz * IMU_ATTITUDE_TAU_MS / 1000;
+    uint8_t shift = 0;
+
+    while ((1UL << shift) < samples_per_tau && shift < 10) {
+        shift++;
+    }
+
+    imu_attitude_reset();
+    s_imu_state.acc_shift = shift;
+    printf("IMU attitude init: rate=%dHz, acc_shift=%d\r\n", sample_rate_hz, shift);
+}
+
+/**
+ * @brief 复位姿态估计（下一次更新时用加速度计重新初始化）
+ */
+void imu_attitude_reset(void)
+{
+    taskENTER_CRITICAL();
+    s_imu_state.initialized = 0;
+    s_imu_state.output.valid = 0;
+    taskEXIT_CRITICAL();
+}
+
+// ==================================
+// 姿态更新
+// ==================================
+
+/**
+ * @brief 输入一帧六轴原始数据，更新姿态
+ * @param ax,ay,az 加速度原始值（±2g）
+ * @param gx,gy,gz 陀螺仪原始值（±2000dps）
+ * @param dt_ms 距上一帧的时间间隔（毫秒）
+ */
+void imu_attitude_update(short ax, short ay, short az,
+                         short gx, short gy, short gz,
+                         uint16_t dt_ms)
+{
+    int32_t *g = s_imu_state.g;
+    imu_attitude_t att;
+    uint32_t acc_sq;
+    uint8_t i;
+
+    acc_sq = (uint32_t)((int32_t)ax * ax) + (uint32_t)((int32_t)ay * ay) + (uint32_t)((int32_t)az * az);
+    att.acc_used = 0;
+
+    if (!s_imu_state.initialized) {
+        // 首帧：直接用加速度方向作为重力方向
+        g[0] = ax;
+        g[1] = ay;
+        g[2] = az;
+        if (imu_normalize_q14(g) != 0) {
+            return;
+        }
+        s_imu_state.initialized = 1;
+        att.acc_used = 1;
+    } else {
+        int32_t wx, wy, wz;
+        int32_t g0 = g[0], g1 = g[1], g2 = g[2];
+
+        if (dt_ms > IMU_MAX_DT_MS) {
+            dt_ms = IMU_MAX_DT_MS;
+        }
+
+        // 1. 陀螺仪积分：机体系下重力向量 dg/dt = g × ω
+        wx = ((int32_t)gx * dt_ms * IMU_GYRO_TO_Q14_MUL) >> IMU_GYRO_TO_Q14_SHIFT;
+        wy = ((int32_t)gy * dt_ms * IMU_GYRO_TO_Q14_MUL) >> IMU_GYRO_TO_Q14_SHIFT;
+        wz = ((int32_t)gz * dt_ms * IMU_GYRO_TO_Q14_MUL) >> IMU_GYRO_TO_Q14_SHIFT;
+
+        g[0] = g0 + ((g1 * wz - g2 * wy) >> 14);
+        g[1] = g1 + ((g2 * wx - g0 * wz) >> 14);
+        g[2] = g2 + ((g0 * wy - g1 * wx) >> 14);
+
+        // 2. 加速度计修正：仅在接近1g（非剧烈运动）时向测量值靠拢
+        if (acc_sq > IMU_ACC_GATE_LO_SQ && acc_sq < IMU_ACC_GATE_HI_SQ) {
+            g[0] += ((int32_t)ax - g[0]) >> s_imu_state.acc_shift;
+            g[1] += ((int32_t)ay - g[1]) >> s_imu_state.acc_shift;
+            g[2] += ((int32_t)az - g[2]) >> s_imu_state.acc_shift;
+            att.acc_used = 1;
+        }
+
+        // 3. 重新归一化，抑制积分误差导致的模长漂移
+        if (imu_normalize_q14(g) != 0) {
+            s_imu_state.initialized = 0;
+            return;
+        }
+    }
+
+    // 计算倾斜角（与原页面的X/Y角定义一致）
+    att.pitch = fx_atan2_cdeg(g[0], fx_isqrt32((uint32_t)(g[1] * g[1] + g[2] * g[2])));
+    att.roll = fx_atan2_cdeg(g[1], fx_isqrt32((uint32_t)(g[0] * g[0] + g[2] * g[2])));
+    att.gravity[0] = (int16_t)g[0];
+    att.gravity[1] = (int16_t)g[1];
+    att.gravity[2] = (int16_t)g[2];
+    att.valid = 1;
+    att.timestamp = xTaskGetTickCount();
+
+    // 发布快照
+    taskENTER_CRITICAL();
+    s_imu_state.output = att;
+    taskEXIT_CRITICAL();
+
+    // 通知订阅者
+    for (i = 0; i < IMU_ATTITUDE_MAX_SUBSCRIBERS; i++) {
+        imu_attitude_cb_t cb = s_imu_state.subscribers[i];
+        if (cb != NULL) {
+            cb(&att);
+        }
+    }
+}
+
+// ==================================
+// 数据获取与订阅
+// ==================================
+
+/**
+ * @brief 获取最新姿态快照
+ * @param attitude 输出姿态
+ */
+void imu_attitude_get(imu_attitude_t *attitude)
+{
+    if (attitude == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    *attitude = s_imu_state.output;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 姿态数据是否可用
+ * @return 1-可用，0-尚无有效数据
+ */
+uint8_t imu_attitude_is_ready(void)
+{
+    return s_imu_state.output.valid;
+}
+
+/**
+ * @brief 订阅姿态更新
+ * @param cb 回调函数
+ * @return 0-成功，-1-参数错误，-2-订阅者已满
+ */
+int imu_attitude_subscribe(imu_attitude_cb_t cb)
+{
+    uint8_t i;
+    int ret = -2;
+
+    if (cb == NULL) {
+        return -1;
+    }
+
+    taskENTER_CRITICAL();
+    for (i = 0; i < IMU_ATTITUDE_MAX_SUBSCRIBERS; i++) {
+        if (s_imu_state.subscribers[i] == cb) {
+            ret = 0;    // 已订阅
+            break;
+        }
+    }
+    for (i = 0; i < IMU_ATTITUDE_MAX_SUBSCRIBERS && ret != 0; i++) {
+        if (s_imu_state.subscribers[i] == NULL) {
+            s_imu_state.subscribers[i] = cb;
+            ret = 0;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return ret;
+}
+
+/**
+ * @brief 取消订阅姿态更新
+ * @param cb 回调函数
+ * @return 0-成功，-1-未找到
+ */
+int imu_attitude_unsubscribe(imu_attitude_cb_t cb)
+{
+    uint8_t i;
+    int ret = -1;
+
+    taskENTER_CRITICAL();
+    for (i = 0; i < IMU_ATTITUDE_MAX_SUBSCRIBERS; i++) {
+        if (s_imu_state.subscribers[i] == cb) {
+            s_imu_state.subscribers[i] = NULL;
+            ret = 0;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return ret;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file imu_attitude.h
+ * @brief 定点姿态估计（陀螺仪+加速度计互补滤波）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 由传感器任务按MPU采样率调用 imu_attitude_update()，
+ *       页面通过 imu_attitude_get() 取快照或订阅回调，不再各自读MPU做平滑
+ */
+
+#ifndef __IMU_ATTITUDE_H
+#define __IMU_ATTITUDE_H
+
+#include <stdint.h>
+
+// ==================================
+// 宏定义
+// ==================================
+
+#define IMU_ATTITUDE_MAX_SUBSCRIBERS   4       // 最大订阅者数量
+#define IMU_ATTITUDE_TAU_MS            500     // 加速度计修正时间常数（毫秒）
+
+// ==================================
+// 姿态数据结构体
+// ==================================
+
+typedef struct {
+    int16_t pitch;           // 前后倾斜角，0.01°（即原X轴角度 atan2(gx, sqrt(gy²+gz²))）
+    int16_t roll;            // 左右倾斜角，0.01°（即原Y轴角度 atan2(gy, sqrt(gx²+gz²))）
+    int16_t gravity[3];      // 机体坐标系下重力单位向量，Q14（16384 = 1g）
+    uint8_t valid;           // 1-已收到有效数据
+    uint8_t acc_used;        // 本次更新是否采用了加速度计修正（剧烈运动时跳过）
+    uint32_t timestamp;      // 更新时刻（系统tick）
+} imu_attitude_t;
+
+// 订阅回调，在传感器任务上下文中调用，需尽快返回
+typedef void (*imu_attitude_cb_t)(const imu_attitude_t *attitude);
+
+// ==================================
+// 函数声明
+// ==================================
+
+void imu_attitude_init(uint16_t sample_rate_hz);
+void imu_attitude_reset(void);
+void imu_attitude_update(short ax, short ay, short az,
+                         short gx, short gy, short gz,
+                         uint16_t dt_ms);
+
+void imu_attitude_get(imu_attitude_t *attitude);
+uint8_t imu_attitude_is_ready(void);
+
+int imu_attitude_subscribe(imu_attitude_cb_t cb);
+int imu_attitude_unsubscribe(imu_attitude_cb_t cb);
+
+#endif
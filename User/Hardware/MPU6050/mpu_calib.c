@@ -0,0 +1,380 @@
+#include "mpu_calib.h"
+#include "flash_store.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "debug.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ==================================
+// 模块状态
+// ==================================
+
+typedef struct {
+    mpu_calib_t coeff;                          // 当前生效的系数
+    uint8_t valid;                              // 系数来自有效的校准记录
+    volatile uint8_t bypass;                    // 校准进行中，驱动层输出原始值
+    volatile int8_t capture_step;               // 正在采集的步骤，-1表示空闲
+    volatile uint8_t count;                     // 当前步骤已采集样本数
+    int32_t sum[6];                             // 加速度/陀螺仪累加值
+    int16_t first[3];                           // 静止判定参考帧
+    int16_t mean[MPU_CALIB_STEP_COUNT][3];      // 各步骤采集结果（陀螺仪步骤存陀螺仪均值）
+    volatile uint8_t status[MPU_CALIB_STEP_COUNT];
+} mpu_calib_state_t;
+
+static mpu_calib_state_t s_calib_state = {
+    .coeff = {
+        .accel_offset = {0, 0, 0},
+        .accel_scale = {16384, 16384, 16384},
+        .gyro_offset = {0, 0, 0},
+    },
+    .capture_step = -1,
+};
+
+// ==================================
+// 内部函数
+// ==================================
+
+/**
+ * @brief 恢复为单位系数（无修正）
+ * @param coeff 系数
+ */
+static void mpu_calib_set_identity(mpu_calib_t *coeff)
+{
+    uint8_t i;
+
+    for (i = 0; i < 3; i++) {
+        coeff->accel_offset[i] = 0;
+        coeff->accel_scale[i] = 16384;
+        coeff->gyro_offset[i] = 0;
+    }
+    coeff->_reserved = 0;
+}
+
+static short mpu_calib_clamp16(int32_t v)
+{
+    if (v > 32767) {
+        return 32767;
+    }
+    if (v < -32768) {
+        return -32768;
+    }
+    return (short)v;
+}
+
+// ==================================
+// 加载与修正
+// ==================================
+
+/**
+ * @brief 从Flash加载校准系数，无有效记录时使用单位系数
+ */
+void mpu_calib_init(void)
+{
+    mpu_calib_t loaded;
+    int ret = flash_store_read(FLASH_STORE_CALIB_ADDR, FLASH_STORE_MAGIC_CALIB, &loaded, sizeof(loaded));
+
+    if (ret == 0) {
+        s_calib_state.coeff = loaded;
+        s_calib_state.valid = 1;
+        printf("MPU calib loaded: acc_off=%d,%d,%d acc_scale=%d,%d,%d gyro_off=%d,%d,%d\r\n",
+               loaded.accel_offset[0], loaded.accel_offset[1], loaded.accel_offset[2],
+               loaded.accel_scale[0], loaded.accel_scale[1], loaded.accel_scale[2],
+               loaded.gyro_offset[0], loaded.gyro_offset[1], loaded.gyro_offset[2]);
+    } else {
+        mpu_calib_set_identity(&s_calib_state.coeff);
+        s_calib_state.valid = 0;
+        printf("MPU calib not found (%d), using raw data\r\n", ret);
+    }
+}
+
+/**
+ * @brief 获取当前生效的校准系数
+ * @return 系数指针
+ */
+const mpu_calib_t *mpu_calib_get(void)
+{
+    return &s_calib_state.coeff;
+}
+
+/**
+ * @brief 是否已加载有效校准
+ * @return 1-已校准，0-未校准
+ */
+uint8_t mpu_calib_is_valid(void)
+{
+    return s_calib_state.valid;
+}
+
+/**
+ * @brief 修正加速度：(raw - offset) * scale >> 14
+ */
+void mpu_calib_apply_accel(short *ax, short *ay, short *az)
+{
+    const mpu_calib_t *c = &s_calib_state.coeff;
+
+    if (s_calib_state.bypass) {
+        return;
+    }
+
+    *ax = mpu_calib_clamp16(((int32_t)(*ax - c->accel_offset[0]) * c->accel_scale[0]) >> 14);
+    *ay = mpu_calib_clamp16(((int32_t)(*ay - c->accel_offset[1]) * c->accel_scale[1]) >> 14);
+    *az = mpu_calib_clamp16(((int32_t)(*az - c->accel_offset[2]) * c->accel_scale[2]) >> 14);
+}
+
+/**
+ * @brief 修正陀螺仪：raw - offset
+ */
+void mpu_calib_apply_gyro(short *gx, short *gy, short *gz)
+{
+    const mpu_calib_t *c = &s_calib_state.coeff;
+
+    if (s_calib_state.bypass) {
+        return;
+    }
+
+    *gx = mpu_calib_clamp16((int32_t)*gx - c->gyro_offset[0]);
+    *gy = mpu_calib_clamp16((int32_t)*gy - c->gyro_offset[1]);
+    *gz = mpu_calib_clamp16((int32_t)*gz - c->gyro_offset[2]);
+}
+
+// ==================================
+// 校准流程
+// ==================================
+
+/**
+ * @brief 开始一次校准会话（驱动层切换为原始输出）
+ */
+void mpu_calib_begin(void)
+{
+    taskENTER_CRITICAL();
+    memset((void *)s_calib_state.status, 0, sizeof(s_calib_state.status));
+    s_calib_state.capture_step = -1;
+    s_calib_state.count = 0;
+    s_calib_state.bypass = 1;
+    taskEXIT_CRITICAL();
+
+    printf("MPU calib session begin\r\n");
+}
+
+/**
+ * @brief 开始采集某一步骤
+ * @param step 校准步骤
+ * @return 0-成功，-1-参数错误，-2-未开始校准会话
+ */
+int mpu_calib_capture_start(mpu_calib_step_t step)
+{
+    if (step >= MPU_CALIB_STEP_COUNT) {
+        return -1;
+    }
+    if (!s_calib_state.bypass) {
+        return -2;
+    }
+
+    taskENTER_CRITICAL();
+    memset(s_calib_state.sum, 0, sizeof(s_calib_state.sum));
+    s_calib_state.count = 0;
+    s_calib_state.status[step] = MPU_CALIB_CAPTURE_RUNNING;
+    s_calib_state.capture_step = (int8_t)step;
+    taskEXIT_CRITICAL();
+
+    return 0;
+}
+
+/**
+ * @brief 查询步骤采集状态
+ * @param step 校准步骤
+ * @param progress 输出采集进度（0~100），可为NULL
+ * @return 采集状态
+ */
+mpu_calib_capture_t mpu_calib_capture_status(mpu_calib_step_t step, uint8_t *progress)
+{
+    mpu_calib_capture_t status;
+
+    if (step >= MPU_CALIB_STEP_COUNT) {
+        return MPU_CALIB_CAPTURE_IDLE;
+    }
+
+    status = (mpu_calib_capture_t)s_calib_state.status[step];
+    if (progress != NULL) {
+        if (status == MPU_CALIB_CAPTURE_DONE) {
+            *progress = 100;
+        } else if (status == MPU_CALIB_CAPTURE_RUNNING) {
+            *progress = (uint8_t)(s_calib_state.count * 100 / MPU_CALIB_SAMPLES);
+        } else {
+            *progress = 0;
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief 采样输入，由传感器任务每帧调用
+ * @note 设备移动时重新开始累加，保证每一步都是静止数据
+ */
+void mpu_calib_feed(short ax, short ay, short az, short gx, short gy, short gz)
+{
+    int8_t step = s_calib_state.capture_step;
+    int32_t *sum = s_calib_state.sum;
+    int16_t *first = s_calib_state.first;
+    int16_t *mean;
+    uint8_t axis;
+
+    if (step < 0) {
+        return;
+    }
+
+    if (s_calib_state.count == 0) {
+        first[0] = ax;
+        first[1] = ay;
+        first[2] = az;
+    } else if (abs(ax - first[0]) > MPU_CALIB_STILL_LIMIT ||
+               abs(ay - first[1]) > MPU_CALIB_STILL_LIMIT ||
+               abs(az - first[2]) > MPU_CALIB_STILL_LIMIT) {
+        // 检测到移动，重新采集
+        memset(sum, 0, sizeof(s_calib_state.sum));
+        s_calib_state.count = 0;
+        first[0] = ax;
+        first[1] = ay;
+        first[2] = az;
+    }
+
+    sum[0] += ax;
+    sum[1] += ay;
+    sum[2] += az;
+    sum[3] += gx;
+    sum[4] += gy;
+    sum[5] += gz;
+
+    if (++s_calib_state.count < MPU_CALIB_SAMPLES) {
+        return;
+    }
+
+    // 采集完成
+    mean = s_calib_state.mean[step];
+    s_calib_state.capture_step = -1;
+
+    if (step == MPU_CALIB_STEP_GYRO) {
+        mean[0] = (int16_t)(sum[3] / MPU_CALIB_SAMPLES);
+        mean[1] = (int16_t)(sum[4] / MPU_CALIB_SAMPLES);
+        mean[2] = (int16_t)(sum[5] / MPU_CALIB_SAMPLES);
+        s_calib_state.status[step] = MPU_CALIB_CAPTURE_DONE;
+        return;
+    }
+
+    mean[0] = (int16_t)(sum[0] / MPU_CALIB_SAMPLES);
+    mean[1] = (int16_t)(sum[1] / MPU_CALIB_SAMPLES);
+    mean[2] = (int16_t)(sum[2] / MPU_CALIB_SAMPLES);
+
+    // 检查姿态：对应轴需接近±1g且方向正确
+    axis = step / 2;
+    if ((step % 2 == 0 && mean[axis] > MPU_CALIB_1G * 7 / 10) ||
+        (step % 2 == 1 && mean[axis] < -MPU_CALIB_1G * 7 / 10)) {
+        s_calib_state.status[step] = MPU_CALIB_CAPTURE_DONE;
+    } else {
+        s_calib_state.status[step] = MPU_CALIB_CAPTURE_BAD_POSE;
+    }
+}
+
+/**
+ * @brief 根据采集结果计算系数并保存
+ * @return 0-成功，-1-数据不足，-2-加速度结果超出合理范围，
+ *         -3-陀螺仪零偏过大，-4-Flash写入失败
+ * @note 只完成陀螺仪步骤时仅更新陀螺仪零偏，加速度沿用原系数
+ */
+int mpu_calib_finish(void)
+{
+    mpu_calib_t coeff = s_calib_state.coeff;
+    uint8_t accel_done = 1;
+    uint8_t gyro_done;
+    uint8_t i;
+    int ret;
+
+    for (i = MPU_CALIB_STEP_X_UP; i <= MPU_CALIB_STEP_Z_DOWN; i++) {
+        if (s_calib_state.status[i] != MPU_CALIB_CAPTURE_DONE) {
+            accel_done = 0;
+        }
+    }
+    gyro_done = (s_calib_state.status[MPU_CALIB_STEP_GYRO] == MPU_CALIB_CAPTURE_DONE);
+
+    if (!accel_done && !gyro_done) {
+        return -1;
+    }
+
+    if (accel_done) {
+        for (i = 0; i < 3; i++) {
+            int32_t up = s_calib_state.mean[i * 2][i];
+            int32_t down = s_calib_state.mean[i * 2 + 1][i];
+            int32_t span = up - down;
+
+            // 两面读数差应接近2g（允许±20%）
+            if (span < MPU_CALIB_1G * 2 * 8 / 10 || span > MPU_CALIB_1G * 2 * 12 / 10) {
+                return -2;
+            }
+            coeff.accel_offset[i] = (int16_t)((up + down) / 2);
+            coeff.accel_scale[i] = (int16_t)(((int32_t)MPU_CALIB_1G * 2 << 14) / span);
+        }
+    }
+
+    if (gyro_done) {
+        for (i = 0; i < 3; i++) {
+            int16_t bias = s_calib_state.mean[MPU_CALIB_STEP_GYRO][i];
+            if (bias > 2000 || bias < -2000) {
+                return -3;
+            }
+            coeff.gyro_offset[i] = bias;
+        }
+    }
+
+    ret = flash_store_write(FLASH_STORE_CALIB_ADDR, FLASH_STORE_MAGIC_CALIB, &coeff, sizeof(coeff));
+    if (ret != 0) {
+        return -4;
+    }
+
+    taskENTER_CRITICAL();
+    s_calib_state.coeff = coeff;
+    s_calib_state.valid = 1;
+    s_calib_state.capture_step = -1;
+    s_calib_state.bypass = 0;
+    taskEXIT_CRITICAL();
+
+    printf("MPU calib saved: acc_off=%d,%d,%d acc_scale=%d,%d,%d gyro_off=%d,%d,%d\r\n",
+           coeff.accel_offset[0], coeff.accel_offset[1], coeff.accel_offset[2],
+           coeff.accel_scale[0], coeff.accel_scale[1], coeff.accel_scale[2],
+           coeff.gyro_offset[0], coeff.gyro_offset[1], coeff.gyro_offset[2]);
+    return 0;
+}
+
+/**
+ * @brief 放弃本次校准，恢复原系数
+ */
+void mpu_calib_cancel(void)
+{
+    taskENTER_CRITICAL();
+    s_calib_state.capture_step = -1;
+    s_calib_state.bypass = 0;
+    taskEXIT_CRITICAL();
+
+    printf("MPU calib session cancelled\r\n");
+}
+
+/**
+ * @brief 恢复出厂（单位系数）并保存
+ * @return 0-成功，-4-Flash写入失败
+ */
+int mpu_calib_reset_default(void)
+{
+    mpu_calib_t coeff;
+
+    mpu_calib_set_identity(&coeff);
+    if (flash_store_write(FLASH_STORE_CALIB_ADDR, FLASH_STORE_MAGIC_CALIB, &coeff, sizeof(coeff)) != 0) {
+        return -4;
+    }
+
+    taskENTER_CRITICAL();
+    s_calib_state.coeff = coeff;
+    s_calib_state.valid = 0;
+    taskEXIT_CRITICAL();
+
+    return 0;
+}
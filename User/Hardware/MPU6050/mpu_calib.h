@@ -0,0 +1,74 @@
+/**
+ * @file mpu_calib.h
+ * @brief MPU6050 加速度计六面校准与陀螺仪零偏校准
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 校准系数保存在片内Flash（带CRC），MPU_Get_* 读取后直接修正，
+ *       上层拿到的就是校准后的数据
+ */
+
+#ifndef __MPU_CALIB_H
+#define __MPU_CALIB_H
+
+#include <stdint.h>
+
+// ==================================
+// 宏定义
+// ==================================
+
+#define MPU_CALIB_SAMPLES          64      // 每个姿态采集的样本数
+#define MPU_CALIB_STILL_LIMIT      800     // 静止判定：加速度偏离窗口首帧的最大值（原始值）
+#define MPU_CALIB_1G               16384   // ±2g量程下1g对应的原始值
+
+// 校准步骤：六个朝上面 + 陀螺仪静置
+typedef enum {
+    MPU_CALIB_STEP_X_UP = 0,
+    MPU_CALIB_STEP_X_DOWN,
+    MPU_CALIB_STEP_Y_UP,
+    MPU_CALIB_STEP_Y_DOWN,
+    MPU_CALIB_STEP_Z_UP,
+    MPU_CALIB_STEP_Z_DOWN,
+    MPU_CALIB_STEP_GYRO,
+    MPU_CALIB_STEP_COUNT
+} mpu_calib_step_t;
+
+// 单步采集状态
+typedef enum {
+    MPU_CALIB_CAPTURE_IDLE = 0,     // 未开始
+    MPU_CALIB_CAPTURE_RUNNING,      // 采集中
+    MPU_CALIB_CAPTURE_DONE,         // 已完成
+    MPU_CALIB_CAPTURE_BAD_POSE      // 姿态不对（主轴方向与步骤不符）
+} mpu_calib_capture_t;
+
+// 校准系数（持久化）
+typedef struct {
+    int16_t accel_offset[3];        // 加速度零偏（原始值）
+    int16_t accel_scale[3];         // 加速度比例系数，Q14（16384 = 1.0）
+    int16_t gyro_offset[3];         // 陀螺仪零偏（原始值）
+    uint16_t _reserved;             // 保留，对齐
+} mpu_calib_t;
+
+// ==================================
+// 函数声明
+// ==================================
+
+// 加载与修正
+void mpu_calib_init(void);
+const mpu_calib_t *mpu_calib_get(void);
+uint8_t mpu_calib_is_valid(void);
+void mpu_calib_apply_accel(short *ax, short *ay, short *az);
+void mpu_calib_apply_gyro(short *gx, short *gy, short *gz);
+
+// 校准流程（页面调用）
+void mpu_calib_begin(void);
+int mpu_calib_capture_start(mpu_calib_step_t step);
+mpu_calib_capture_t mpu_calib_capture_status(mpu_calib_step_t step, uint8_t *progress);
+int mpu_calib_finish(void);
+void mpu_calib_cancel(void);
+int mpu_calib_reset_default(void);
+
+// 采样输入（传感器任务每帧调用，未在采集时立即返回）
+void mpu_calib_feed(short ax, short ay, short az, short gx, short gy, short gz);
+
+#endif
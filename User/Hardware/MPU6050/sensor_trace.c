@@ -0,0 +1,195 @@
+#include "sensor_trace.h"
+#include "mpu_calib.h"
+#include "debug.h"
+
+// ==================================
+// 模块状态
+// ==================================
+
+typedef struct {
+    volatile uint8_t request;       // 页面请求：0-无，1-开始，2-停止
+    volatile uint8_t active;        // 抓包进行中
+    uint16_t sample_rate_hz;        // 采样率
+    uint32_t period_ms;             // 采样周期
+    uint32_t last_timestamp;        // 上一帧时间戳
+    volatile uint32_t frames;       // 已发送采样帧数
+    uint32_t gaps;                  // 采样间隔异常次数
+} sensor_trace_state_t;
+
+static sensor_trace_state_t s_trace_state;
+
+#define TRACE_REQ_NONE      0
+#define TRACE_REQ_START     1
+#define TRACE_REQ_STOP      2
+
+// ==================================
+// 内部函数
+// ==================================
+
+static void trace_put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void trace_put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * @brief 组帧并发送
+ * @param type 帧类型
+ * @param payload 数据
+ * @param len 数据长度
+ */
+static void trace_send_frame(uint8_t type, const uint8_t *payload, uint8_t len)
+{
+    uint8_t buf[4 + 16 + 1];
+    uint8_t sum = 0;
+    uint8_t i;
+
+    if (len > 16) {
+        return;
+    }
+
+    buf[0] = SENSOR_TRACE_HEAD0;
+    buf[1] = SENSOR_TRACE_HEAD1;
+    buf[2] = type;
+    buf[3] = len;
+    for (i = 0; i < len; i++) {
+        buf[4 + i] = payload[i];
+    }
+    for (i = 0; i < len + 4; i++) {
+        sum += buf[i];
+    }
+    buf[len + 4] = sum;
+
+    Usart1_send_bytes(buf, len + 5);
+}
+
+static void trace_send_start(void)
+{
+    uint8_t payload[8];
+
+    payload[0] = SENSOR_TRACE_VERSION;
+    payload[1] = mpu_calib_is_valid();
+    trace_put_u16(&payload[2], s_trace_state.sample_rate_hz);
+    trace_put_u16(&payload[4], 2);       // MPU_Init: ±2g
+    trace_put_u16(&payload[6], 2000);    // MPU_Init: ±2000dps
+    trace_send_frame(SENSOR_TRACE_TYPE_START, payload, sizeof(payload));
+}
+
+static void trace_send_stop(void)
+{
+    uint8_t payload[8];
+
+    trace_put_u32(&payload[0], s_trace_state.frames);
+    trace_put_u32(&payload[4], s_trace_state.gaps);
+    trace_send_frame(SENSOR_TRACE_TYPE_STOP, payload, sizeof(payload));
+}
+
+// ==================================
+// 对外接口
+// ==================================
+
+/**
+ * @brief 请求开始抓包（由传感器任务在下一帧执行）
+ * @param sample_rate_hz 传感器采样率
+ * @return 0-成功，-1-参数错误
+ */
+int sensor_trace_start(uint16_t sample_rate_hz)
+{
+    if (sample_rate_hz == 0) {
+        return -1;
+    }
+
+    s_trace_state.sample_rate_hz = sample_rate_hz;
+    s_trace_state.request = TRACE_REQ_START;
+    return 0;
+}
+
+/**
+ * @brief 请求停止抓包（由传感器任务在下一帧执行）
+ */
+void sensor_trace_stop(void)
+{
+    s_trace_state.request = TRACE_REQ_STOP;
+}
+
+/**
+ * @brief 是否正在抓包
+ * @return 1-是，0-否
+ */
+uint8_t sensor_trace_is_active(void)
+{
+    return s_trace_state.active || s_trace_state.request == TRACE_REQ_START;
+}
+
+/**
+ * @brief 获取已发送采样帧数
+ * @return 帧数
+ */
+uint32_t sensor_trace_get_frames(void)
+{
+    return s_trace_state.frames;
+}
+
+/**
+ * @brief 采样输入，由传感器任务每帧调用
+ * @param timestamp_ms 采样时刻（毫秒）
+ */
+void sensor_trace_feed(uint32_t timestamp_ms,
+                       short ax, short ay, short az,
+                       short gx, short gy, short gz)
+{
+    uint8_t payload[16];
+    uint8_t request = s_trace_state.request;
+
+    if (request != TRACE_REQ_NONE) {
+        s_trace_state.request = TRACE_REQ_NONE;
+
+        if (request == TRACE_REQ_START && !s_trace_state.active) {
+            printf("Sensor trace start, rate=%dHz\r\n", s_trace_state.sample_rate_hz);
+            s_trace_state.period_ms = 1000 / s_trace_state.sample_rate_hz;
+            s_trace_state.frames = 0;
+            s_trace_state.gaps = 0;
+            s_trace_state.last_timestamp = timestamp_ms;
+            debug_set_quiet(1);
+            trace_send_start();
+            s_trace_state.active = 1;
+        } else if (request == TRACE_REQ_STOP && s_trace_state.active) {
+            s_trace_state.active = 0;
+            trace_send_stop();
+            debug_set_quiet(0);
+            printf("Sensor trace stop, frames=%lu gaps=%lu\r\n",
+                   (unsigned long)s_trace_state.frames, (unsigned long)s_trace_state.gaps);
+            return;
+        }
+    }
+
+    if (!s_trace_state.active) {
+        return;
+    }
+
+    // 统计采样间隔异常（大于1.5倍周期）
+    if (s_trace_state.frames > 0 &&
+        (timestamp_ms - s_trace_state.last_timestamp) * 2 > s_trace_state.period_ms * 3) {
+        s_trace_state.gaps++;
+    }
+    s_trace_state.last_timestamp = timestamp_ms;
+
+    trace_put_u32(&payload[0], timestamp_ms);
+    trace_put_u16(&payload[4], (uint16_t)ax);
+    trace_put_u16(&payload[6], (uint16_t)ay);
+    trace_put_u16(&payload[8], (uint16_t)az);
+    trace_put_u16(&payload[10], (uint16_t)gx);
+    trace_put_u16(&payload[12], (uint16_t)gy);
+    trace_put_u16(&payload[14], (uint16_t)gz);
+    trace_send_frame(SENSOR_TRACE_TYPE_SAMPLE, payload, sizeof(payload));
+
+    s_trace_state.frames++;
+}
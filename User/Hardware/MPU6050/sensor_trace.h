@@ -0,0 +1,54 @@
+/**
+ * @file sensor_trace.h
+ * @brief 六轴传感器数据二进制抓包（串口输出）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 帧格式（小端）：
+ *       [0xAA][0x55][type][len][payload: len字节][sum]
+ *       sum 为前面所有字节的累加和（低8位），与匿名上位机协议的校验方式一致
+ *
+ *       type 0x01 采样帧，len=16：
+ *         u32 timestamp_ms, i16 ax, ay, az, gx, gy, gz
+ *       type 0x02 开始帧，len=8：
+ *         u8 version, u8 calibrated, u16 sample_rate_hz, u16 accel_fsr_g, u16 gyro_fsr_dps
+ *       type 0x03 结束帧，len=8：
+ *         u32 frames_sent, u32 gaps（采样间隔超过1.5倍周期的次数）
+ *
+ *       开始/结束帧也由传感器任务发出，保证所有帧来自同一任务、不会被拆开；
+ *       抓包期间 printf 输出被静默，避免文本与二进制帧交错；
+ *       上位机按帧头+校验和重新同步即可丢弃残留文本
+ */
+
+#ifndef __SENSOR_TRACE_H
+#define __SENSOR_TRACE_H
+
+#include <stdint.h>
+
+// ==================================
+// 协议定义
+// ==================================
+
+#define SENSOR_TRACE_HEAD0          0xAA
+#define SENSOR_TRACE_HEAD1          0x55
+#define SENSOR_TRACE_VERSION        1
+
+#define SENSOR_TRACE_TYPE_SAMPLE    0x01
+#define SENSOR_TRACE_TYPE_START     0x02
+#define SENSOR_TRACE_TYPE_STOP      0x03
+
+// ==================================
+// 函数声明
+// ==================================
+
+int sensor_trace_start(uint16_t sample_rate_hz);
+void sensor_trace_stop(void);
+uint8_t sensor_trace_is_active(void);
+uint32_t sensor_trace_get_frames(void);
+
+// 采样输入（传感器任务每帧调用，未抓包时立即返回）
+void sensor_trace_feed(uint32_t timestamp_ms,
+                       short ax, short ay, short az,
+                       short gx, short gy, short gz);
+
+#endif
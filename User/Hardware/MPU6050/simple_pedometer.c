@@ -2,19 +2,34 @@
 #include "math.h"
 #include <stdlib.h>
 #include "debug.h"
+#include "fixed_math.h"
+#include "cycle_counter.h"
 // 包含步数存储函数
 
+// 置1后统计每次更新的CPU周期数，每PEDOMETER_PROFILE_WINDOW次打印一次平均值
+#define PEDOMETER_PROFILE           0
+#define PEDOMETER_PROFILE_WINDOW    512
+
+// 合加速度上限（保持与原二分查找法的饱和值一致）
+#define PEDOMETER_MAGNITUDE_MAX     32766
+#define PEDOMETER_MAGNITUDE_MAX_SQ  ((uint32_t)PEDOMETER_MAGNITUDE_MAX * PEDOMETER_MAGNITUDE_MAX)
+
 // 全局步数变量
 unsigned long g_step_count = 0;
 
+// 采样间隔超过该值（传感器休眠、任务卡顿）时重新开始波形跟踪
+#define PEDOMETER_MAX_GAP_MS        1000
+
 // 计步器状态结构体
 typedef struct {
-    short last_acceleration;        // 上一次的合加速度
+    short last_acceleration;        // 当前跟踪的极值（等待波峰时为最大值，等待波谷时为最小值）
     short peak_threshold;           // 峰值阈值
-    short noise_threshold;          // 噪声阈值
+    short noise_threshold;          // 噪声阈值（峰谷回落/回升幅度）
     short min_step_interval;        // 最小步间隔（毫秒）
     unsigned long last_step_time;   // 上次步数检测时间
+    unsigned long last_sample_time; // 上一个采样的时间戳
     short step_state;               // 步数检测状态（0-等待波峰，1-等待波谷）
+    uint8_t has_sample;             // 是否已有采样（用于首帧和断档处理）
 } SimplePedometer;
 
 // 全局计步器实例
@@ -31,12 +46,19 @@ void simple_pedometer_init(void)
     // 降低阈值以提高灵敏度
     pedometer.peak_threshold = 8000;      // 降低峰值阈值
     pedometer.noise_threshold = 2000;     // 降低噪声阈值
-    pedometer.min_step_interval = 100;    // 缩短最小步间隔到100毫秒
+    // 原10Hz调用时峰+谷至少占两帧，隐含了200ms下限；按真实时间戳后需显式给出
+    pedometer.min_step_interval = 250;
     pedometer.last_step_time = 0;
+    pedometer.last_sample_time = 0;
     pedometer.step_state = 0;             // 初始状态：等待波峰
+    pedometer.has_sample = 0;
     
     printf("Simple pedometer initialized with high sensitivity\r\n");
     
+#if PEDOMETER_PROFILE
+    cycle_counter_init();
+#endif
+    
     // 加载保存的步数数据
     // Steps_Load();
 }
@@ -46,76 +68,72 @@ void simple_pedometer_init(void)
  * @param ax X轴加速度
  * @param ay Y轴加速度
  * @param az Z轴加速度
- * @return 合加速度值
+ * @return 合加速度值（上限32766，与原二分查找结果一致）
  */
 static short calculate_magnitude(short ax, short ay, short az)
 {
-    // 计算三轴加速度的合加速度 (sqrt(ax^2 + ay^2 + az^2))
-    // 为避免浮点运算，我们使用近似算法
-    long magnitude_sq = (long)ax * ax + (long)ay * ay + (long)az * az;
-    
-    // 简单的整数平方根近似算法
-    if (magnitude_sq <= 0) return 0;
+    // 平方和最大 3*32768^2，用无符号32位避免溢出
+    uint32_t magnitude_sq = (uint32_t)((int32_t)ax * ax)
+                          + (uint32_t)((int32_t)ay * ay)
+                          + (uint32_t)((int32_t)az * az);
     
-    short magnitude = 0;
-    short low = 0;
-    short high = 0x7FFF; // 32767
-    
-    // 二分查找法求平方根
-    while (high - low > 1) {
-        short mid = (low + high) / 2;
-        long sq = (long)mid * mid;
-        if (sq <= magnitude_sq) {
-            low = mid;
-        } else {
-            high = mid;
-        }
+    // 超过32766^2时直接饱和，省去开方
+    if (magnitude_sq >= PEDOMETER_MAGNITUDE_MAX_SQ) {
+        return PEDOMETER_MAGNITUDE_MAX;
     }
     
-    magnitude = low;
-    return magnitude;
+    // 逐位法整数开方：16次移位/加减，无乘法
+    return (short)fx_isqrt32(magnitude_sq);
 }
 
 /**
- * @brief 更新计步器状态并检测步数
+ * @brief 处理单个采样（波峰/波谷滞回检测）
  * @param ax X轴加速度
  * @param ay Y轴加速度
  * @param az Z轴加速度
- * @return 当前步数
+ * @param timestamp_ms 采样时间戳（毫秒，允许回绕）
+ * @note 与相邻两帧做差不同，这里跟踪当前极值并以noise_threshold做滞回，
+ *       检测结果与采样率无关（25~200Hz）
  */
-unsigned long simple_pedometer_update(short ax, short ay, short az)
+static void simple_pedometer_process(short ax, short ay, short az, unsigned long timestamp_ms)
 {
     // 计算合加速度
     short magnitude = calculate_magnitude(ax, ay, az);
     
-    // 获取当前时间（简化处理，使用固定间隔）
-    static unsigned long current_time = 0;
-    current_time += 100; // 假设每100ms调用一次
-    
-    // 简单的峰值检测算法
-    short diff = magnitude - pedometer.last_acceleration;
+    // 首帧或采样断档：从当前值重新跟踪波峰
+    if (!pedometer.has_sample ||
+        timestamp_ms - pedometer.last_sample_time > PEDOMETER_MAX_GAP_MS) {
+        pedometer.has_sample = 1;
+        pedometer.step_state = 0;
+        pedometer.last_acceleration = magnitude;
+        pedometer.last_sample_time = timestamp_ms;
+        return;
+    }
+    pedometer.last_sample_time = timestamp_ms;
     
     // 状态机检测步数
     if (pedometer.step_state == 0) {
-        // 等待波峰状态
-        if (diff < -pedometer.noise_threshold && 
-            magnitude < pedometer.last_acceleration - pedometer.noise_threshold) {
-            // 检测到波峰
+        // 等待波峰状态：跟踪最大值，回落超过噪声阈值即确认波峰
+        if (magnitude > pedometer.last_acceleration) {
+            pedometer.last_acceleration = magnitude;
+        } else if (magnitude < pedometer.last_acceleration - pedometer.noise_threshold) {
             if (pedometer.last_acceleration > pedometer.peak_threshold) {
                 // 波峰足够大
                 pedometer.step_state = 1; // 转换到等待波谷状态
             }
+            pedometer.last_acceleration = magnitude;
         }
     } else {
-        // 等待波谷状态
-        if (diff > pedometer.noise_threshold && 
-            magnitude > pedometer.last_acceleration + pedometer.noise_threshold) {
+        // 等待波谷状态：跟踪最小值，回升超过噪声阈值即确认波谷
+        if (magnitude < pedometer.last_acceleration) {
+            pedometer.last_acceleration = magnitude;
+        } else if (magnitude > pedometer.last_acceleration + pedometer.noise_threshold) {
             // 检测到波谷
             // 检查时间间隔，避免重复计数
-            if (current_time - pedometer.last_step_time > pedometer.min_step_interval) {
+            if (timestamp_ms - pedometer.last_step_time > (unsigned long)pedometer.min_step_interval) {
                 // 计为一步
                 g_step_count++;
-                pedometer.last_step_time = current_time;
+                pedometer.last_step_time = timestamp_ms;
                 printf("Step detected! Total steps: %lu\r\n", g_step_count);
                 
                 // 每100步或达到特定步数时保存一次
@@ -124,11 +142,58 @@ unsigned long simple_pedometer_update(short ax, short ay, short az)
                 }
             }
             pedometer.step_state = 0; // 回到等待波峰状态
+            pedometer.last_acceleration = magnitude;
         }
     }
+}
+
+/**
+ * @brief 输入单个带时间戳的采样
+ * @param ax X轴加速度
+ * @param ay Y轴加速度
+ * @param az Z轴加速度
+ * @param timestamp_ms 采样时间戳（毫秒）
+ * @return 当前步数
+ */
+unsigned long simple_pedometer_update(short ax, short ay, short az, unsigned long timestamp_ms)
+{
+#if PEDOMETER_PROFILE
+    static uint32_t profile_cycles = 0;
+    static uint16_t profile_count = 0;
+    uint32_t profile_start = cycle_counter_get();
+#endif
+
+    simple_pedometer_process(ax, ay, az, timestamp_ms);
+    
+#if PEDOMETER_PROFILE
+    profile_cycles += cycle_counter_get() - profile_start;
+    if (++profile_count >= PEDOMETER_PROFILE_WINDOW) {
+        printf("pedometer: %lu cycles/sample\r\n", (unsigned long)(profile_cycles / profile_count));
+        profile_cycles = 0;
+        profile_count = 0;
+    }
+#endif
+    
+    return g_step_count;
+}
+
+/**
+ * @brief 批量输入带时间戳的采样（如MPU FIFO读出的一批数据）
+ * @param samples 采样数组，按时间先后排列
+ * @param count 采样个数
+ * @return 当前步数
+ */
+unsigned long simple_pedometer_update_batch(const pedometer_sample_t *samples, uint16_t count)
+{
+    uint16_t i;
+    
+    if (samples == NULL) {
+        return g_step_count;
+    }
     
-    // 更新上一次的加速度值
-    pedometer.last_acceleration = magnitude;
+    for (i = 0; i < count; i++) {
+        simple_pedometer_update(samples[i].ax, samples[i].ay, samples[i].az, samples[i].timestamp_ms);
+    }
     
     return g_step_count;
 }
@@ -151,6 +216,7 @@ void simple_pedometer_reset(void)
     pedometer.last_acceleration = 0;
     pedometer.last_step_time = 0;
     pedometer.step_state = 0;
+    pedometer.has_sample = 0;
     printf("Simple pedometer reset\r\n");
     
     // 重置后立即保存
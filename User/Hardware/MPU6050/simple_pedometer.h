@@ -6,9 +6,18 @@
 // 全局步数变量
 extern unsigned long g_step_count;
 
+// 带时间戳的加速度采样
+typedef struct {
+    unsigned long timestamp_ms;     // 采样时刻（毫秒，允许回绕）
+    short ax;
+    short ay;
+    short az;
+} pedometer_sample_t;
+
 // 函数声明
 void simple_pedometer_init(void);
-unsigned long simple_pedometer_update(short ax, short ay, short az);
+unsigned long simple_pedometer_update(short ax, short ay, short az, unsigned long timestamp_ms);
+unsigned long simple_pedometer_update_batch(const pedometer_sample_t *samples, uint16_t count);
 void simple_pedometer_reset(void);
 unsigned long simple_pedometer_get_steps(void);
 
@@ -0,0 +1,460 @@
+#include "step_detector.h"
+#include <stddef.h>
+#include "debug.h"
+#include "fixed_math.h"
+#include "cycle_counter.h"
+
+// 置1后统计每次更新的CPU周期数，每STEP_DETECTOR_PROFILE_WINDOW次打印一次平均值和最大值
+#define STEP_DETECTOR_PROFILE           0
+#define STEP_DETECTOR_PROFILE_WINDOW    512
+
+// 滤波器系数为Q24，输出状态保留4位小数（Q4），抑制低频极点下的量化噪声
+#define STEP_FILTER_COEF_SHIFT          24
+#define STEP_FILTER_STATE_SHIFT         4
+
+// 采样间隔超过该值时重新初始化滤波器（与 simple_pedometer 一致）
+#define STEP_DETECTOR_MAX_GAP_MS        1000
+
+// 合加速度上限（平方和超过后直接饱和）
+#define STEP_MAGNITUDE_MAX              32766
+#define STEP_MAGNITUDE_MAX_SQ           ((uint32_t)STEP_MAGNITUDE_MAX * STEP_MAGNITUDE_MAX)
+
+// ==================================
+// 带通滤波器系数表
+// ==================================
+
+/*
+ * RBJ带通（峰值增益0dB）：f0 = sqrt(0.5*3) ≈ 1.22Hz，Q = f0/2.5，-3dB点约为0.5Hz和3Hz
+ * y[n] = b0*(x[n] - x[n-2]) - a1*y[n-1] - a2*y[n-2]，系数已按a0归一化，Q24
+ */
+typedef struct {
+    uint16_t rate_hz;
+    int32_t b0;
+    int32_t a1;
+    int32_t a2;
+} step_filter_coef_t;
+
+static const step_filter_coef_t s_filter_table[] = {
+    {25,  3962568, -24424688,  8852081},
+    {50,  2269829, -28671814, 12237558},
+    {100, 1220608, -31021140, 14336001},
+    {200,  633794, -32262947, 15509627},
+};
+
+#define STEP_FILTER_TABLE_SIZE  (sizeof(s_filter_table) / sizeof(s_filter_table[0]))
+
+// ==================================
+// 模块状态
+// ==================================
+
+typedef struct {
+    // 滤波器
+    const step_filter_coef_t *coef;
+    int32_t x1, x2;                 // 输入历史（合加速度原始值）
+    int32_t y1, y2;                 // 输出历史（Q4）
+
+    // 峰谷检测
+    uint8_t seek_valley;            // 0-等待波峰，1-等待波谷
+    int32_t extreme;                // 当前跟踪的极值
+    int32_t peak_value;             // 最近确认的波峰值
+    unsigned long extreme_time;     // 当前极值出现时刻
+    unsigned long peak_time;        // 最近确认的波峰时刻
+
+    // 动态阈值：最近几步的峰谷幅度
+    int32_t amp_window[STEP_DETECTOR_AMP_WINDOW];
+    int32_t amp_sum;
+    uint8_t amp_index;
+    uint8_t amp_count;
+
+    // 节律确认
+    unsigned long last_step_time;   // 上一个候选步时刻
+    unsigned long interval;         // 参考步间隔（平滑后）
+    uint8_t pending;                // 待确认的步数
+    uint8_t locked;                 // 1-节律已确认，逐步计数
+
+    unsigned long last_sample_time;
+    uint8_t has_sample;
+    volatile unsigned long steps;
+    volatile unsigned long peaks;   // 通过幅度门限的峰谷总数（不经节律确认，供活动识别统计峰值率）
+} step_detector_state_t;
+
+static step_detector_state_t s_detector;
+
+// ==================================
+// 内部函数
+// ==================================
+
+/**
+ * @brief 计算合加速度
+ * @return 合加速度（上限32766）
+ */
+static int32_t step_magnitude(short ax, short ay, short az)
+{
+    uint32_t magnitude_sq = (uint32_t)((int32_t)ax * ax)
+                          + (uint32_t)((int32_t)ay * ay)
+                          + (uint32_t)((int32_t)az * az);
+
+    if (magnitude_sq >= STEP_MAGNITUDE_MAX_SQ) {
+        return STEP_MAGNITUDE_MAX;
+    }
+    return fx_isqrt32(magnitude_sq);
+}
+
+/**
+ * @brief 以当前输入为稳态重置滤波器（带通对直流输出为0，避免重力阶跃引起的假峰）
+ */
+static void step_filter_prime(int32_t x)
+{
+    s_detector.x1 = x;
+    s_detector.x2 = x;
+    s_detector.y1 = 0;
+    s_detector.y2 = 0;
+}
+
+/**
+ * @brief 带通滤波一个采样
+ * @param x 合加速度
+ * @return 滤波输出（与输入同量纲）
+ */
+static int32_t step_filter_run(int32_t x)
+{
+    const step_filter_coef_t *c = s_detector.coef;
+    int64_t acc;
+    int32_t y;
+
+    // Cortex-M3 上为 SMULL/SMLAL，三次64位乘加
+    acc = (int64_t)c->b0 * ((x - s_detector.x2) << STEP_FILTER_STATE_SHIFT)
+        - (int64_t)c->a1 * s_detector.y1
+        - (int64_t)c->a2 * s_detector.y2;
+    y = (int32_t)(acc >> STEP_FILTER_COEF_SHIFT);
+
+    s_detector.x2 = s_detector.x1;
+    s_detector.x1 = x;
+    s_detector.y2 = s_detector.y1;
+    s_detector.y1 = y;
+
+    return y >> STEP_FILTER_STATE_SHIFT;
+}
+
+/**
+ * @brief 清空节律和幅度窗口（停走或采样断档后调用）
+ */
+static void step_rhythm_reset(void)
+{
+    uint8_t i;
+
+    s_detector.pending = 0;
+    s_detector.locked = 0;
+    s_detector.interval = 0;
+    s_detector.amp_sum = 0;
+    s_detector.amp_index = 0;
+    s_detector.amp_count = 0;
+    for (i = 0; i < STEP_DETECTOR_AMP_WINDOW; i++) {
+        s_detector.amp_window[i] = 0;
+    }
+}
+
+/**
+ * @brief 把一次峰谷幅度加入滑动窗口
+ */
+static void step_amp_push(int32_t amp)
+{
+    s_detector.amp_sum += amp - s_detector.amp_window[s_detector.amp_index];
+    s_detector.amp_window[s_detector.amp_index] = amp;
+    s_detector.amp_index = (s_detector.amp_index + 1) & (STEP_DETECTOR_AMP_WINDOW - 1);
+    if (s_detector.amp_count < STEP_DETECTOR_AMP_WINDOW) {
+        s_detector.amp_count++;
+    }
+}
+
+/**
+ * @brief 窗口内平均峰谷幅度
+ */
+static int32_t step_amp_average(void)
+{
+    if (s_detector.amp_count == 0) {
+        return 0;
+    }
+    return s_detector.amp_sum / s_detector.amp_count;
+}
+
+/**
+ * @brief 节律确认：判断一个候选步是否计数
+ * @param t 候选步（波峰）时刻
+ */
+static void step_rhythm_check(unsigned long t)
+{
+    unsigned long dt;
+
+    if (s_detector.pending == 0 && !s_detector.locked) {
+        // 一串步伐的第一步
+        s_detector.pending = 1;
+        s_detector.last_step_time = t;
+        return;
+    }
+
+    dt = t - s_detector.last_step_time;
+    if (dt > STEP_DETECTOR_MAX_INTERVAL_MS) {
+        // 间隔过长：重新开始一串步伐
+        s_detector.pending = 1;
+        s_detector.locked = 0;
+        s_detector.last_step_time = t;
+        return;
+    }
+    if (dt < STEP_DETECTOR_MIN_INTERVAL_MS) {
+        // 同一步内的抖动，忽略且不更新参考时刻
+        return;
+    }
+
+    if (s_detector.locked) {
+        // 已确认节律：明显短于参考间隔的峰（摆臂等）丢弃，其余计数并跟踪步频变化
+        if (dt * 8 < s_detector.interval * 5) {
+            return;
+        }
+        s_detector.steps++;
+        s_detector.interval = (s_detector.interval * 3 + dt) >> 2;
+        s_detector.last_step_time = t;
+        return;
+    }
+
+    s_detector.last_step_time = t;
+
+    if (s_detector.pending == 1) {
+        s_detector.interval = dt;
+        s_detector.pending = 2;
+        return;
+    }
+
+    // 与参考间隔偏差在 ±3/8 以内视为一致
+    if (dt * 8 > s_detector.interval * 5 && dt * 8 < s_detector.interval * 11) {
+        s_detector.interval = (s_detector.interval + dt) >> 1;
+        if (++s_detector.pending >= STEP_DETECTOR_REGULAR_STEPS) {
+            // 节律确认，补记之前待确认的步数
+            s_detector.steps += s_detector.pending;
+            s_detector.pending = 0;
+            s_detector.locked = 1;
+            printf("Step rhythm locked, interval=%lums, steps=%lu\r\n",
+                   s_detector.interval, s_detector.steps);
+        }
+    } else {
+        // 不规律：最近两步作为新的起点
+        s_detector.interval = dt;
+        s_detector.pending = 2;
+    }
+}
+
+/**
+ * @brief 处理单个采样
+ */
+static void step_detector_process(short ax, short ay, short az, unsigned long timestamp_ms)
+{
+    int32_t magnitude = step_magnitude(ax, ay, az);
+    int32_t y;
+    int32_t hysteresis;
+    int32_t amp;
+    int32_t amp_avg;
+
+    // 首帧或采样断档：重置滤波器和节律
+    if (!s_detector.has_sample ||
+        timestamp_ms - s_detector.last_sample_time > STEP_DETECTOR_MAX_GAP_MS) {
+        s_detector.has_sample = 1;
+        s_detector.last_sample_time = timestamp_ms;
+        s_detector.seek_valley = 0;
+        s_detector.extreme = 0;
+        s_detector.extreme_time = timestamp_ms;
+        step_filter_prime(magnitude);
+        step_rhythm_reset();
+        return;
+    }
+    s_detector.last_sample_time = timestamp_ms;
+
+    y = step_filter_run(magnitude);
+
+    // 停走（两倍最大步间隔内没有候选步）：丢弃未确认的步并让阈值回落
+    if ((s_detector.pending > 0 || s_detector.locked) &&
+        timestamp_ms - s_detector.last_step_time > STEP_DETECTOR_MAX_INTERVAL_MS * 2) {
+        step_rhythm_reset();
+    }
+
+    // 动态阈值：滞回取平均幅度的1/4，最小幅度取平均幅度的1/2
+    amp_avg = step_amp_average();
+    hysteresis = amp_avg >> 2;
+    if (hysteresis < STEP_DETECTOR_MIN_HYSTERESIS) {
+        hysteresis = STEP_DETECTOR_MIN_HYSTERESIS;
+    }
+
+    if (!s_detector.seek_valley) {
+        // 等待波峰：跟踪最大值，回落超过滞回量即确认
+        if (y > s_detector.extreme) {
+            s_detector.extreme = y;
+            s_detector.extreme_time = timestamp_ms;
+        } else if (y < s_detector.extreme - hysteresis) {
+            s_detector.peak_value = s_detector.extreme;
+            s_detector.peak_time = s_detector.extreme_time;
+            s_detector.seek_valley = 1;
+            s_detector.extreme = y;
+            s_detector.extreme_time = timestamp_ms;
+        }
+        return;
+    }
+
+    // 等待波谷：跟踪最小值，回升超过滞回量即确认一个完整峰谷
+    if (y < s_detector.extreme) {
+        s_detector.extreme = y;
+        s_detector.extreme_time = timestamp_ms;
+        return;
+    }
+    if (y <= s_detector.extreme + hysteresis) {
+        return;
+    }
+
+    amp = s_detector.peak_value - s_detector.extreme;
+    s_detector.seek_valley = 0;
+    s_detector.extreme = y;
+    s_detector.extreme_time = timestamp_ms;
+
+    if (amp < STEP_DETECTOR_MIN_AMPLITUDE) {
+        return;
+    }
+    step_amp_push(amp);
+
+    // 幅度不足平均值一半的峰谷（摆臂、手腕小动作）不作为候选步
+    if (amp * 2 < amp_avg) {
+        return;
+    }
+    s_detector.peaks++;
+    step_rhythm_check(s_detector.peak_time);
+}
+
+// ==================================
+// 对外接口
+// ==================================
+
+/**
+ * @brief 初始化计步流水线
+ * @param sample_rate_hz 传感器采样率
+ * @return 0-成功，-1-系数表中无此采样率（使用最接近的一组系数）
+ */
+int step_detector_init(uint16_t sample_rate_hz)
+{
+    uint8_t i;
+    uint8_t best = 0;
+    uint16_t best_diff = 0xFFFF;
+    uint16_t diff;
+
+    for (i = 0; i < STEP_FILTER_TABLE_SIZE; i++) {
+        diff = (s_filter_table[i].rate_hz > sample_rate_hz) ?
+               (s_filter_table[i].rate_hz - sample_rate_hz) :
+               (sample_rate_hz - s_filter_table[i].rate_hz);
+        if (diff < best_diff) {
+            best_diff = diff;
+            best = i;
+        }
+    }
+
+    s_detector.coef = &s_filter_table[best];
+    step_detector_reset();
+
+#if STEP_DETECTOR_PROFILE
+    cycle_counter_init();
+#endif
+
+    printf("Step detector initialized, filter rate=%dHz\r\n", s_detector.coef->rate_hz);
+    return (best_diff == 0) ? 0 : -1;
+}
+
+/**
+ * @brief 清零步数并重新开始检测
+ */
+void step_detector_reset(void)
+{
+    s_detector.steps = 0;
+    s_detector.has_sample = 0;
+    s_detector.seek_valley = 0;
+    s_detector.extreme = 0;
+    step_rhythm_reset();
+}
+
+/**
+ * @brief 输入单个带时间戳的采样（由传感器任务每帧调用）
+ * @param ax X轴加速度
+ * @param ay Y轴加速度
+ * @param az Z轴加速度
+ * @param timestamp_ms 采样时间戳（毫秒，允许回绕）
+ * @return 当前步数
+ */
+unsigned long step_detector_update(short ax, short ay, short az, unsigned long timestamp_ms)
+{
+#if STEP_DETECTOR_PROFILE
+    static uint32_t profile_cycles = 0;
+    static uint32_t profile_max = 0;
+    static uint16_t profile_count = 0;
+    uint32_t profile_start = cycle_counter_get();
+    uint32_t profile_used;
+#endif
+
+    if (s_detector.coef == NULL) {
+        return 0;
+    }
+
+    step_detector_process(ax, ay, az, timestamp_ms);
+
+#if STEP_DETECTOR_PROFILE
+    profile_used = cycle_counter_get() - profile_start;
+    profile_cycles += profile_used;
+    if (profile_used > profile_max) {
+        profile_max = profile_used;
+    }
+    if (++profile_count >= STEP_DETECTOR_PROFILE_WINDOW) {
+        printf("step_detector: avg %lu max %lu cycles/sample (budget %d)\r\n",
+               (unsigned long)(profile_cycles / profile_count),
+               (unsigned long)profile_max, STEP_DETECTOR_CYCLE_BUDGET);
+        profile_cycles = 0;
+        profile_max = 0;
+        profile_count = 0;
+    }
+#endif
+
+    return s_detector.steps;
+}
+
+/**
+ * @brief 获取当前步数
+ * @return 步数
+ */
+unsigned long step_detector_get_steps(void)
+{
+    return s_detector.steps;
+}
+
+/**
+ * @brief 获取通过幅度门限的峰谷总数（单调递增，调用方自行做差）
+ * @return 峰谷数
+ */
+unsigned long step_detector_get_peaks(void)
+{
+    return s_detector.peaks;
+}
+
+/**
+ * @brief 获取当前步频
+ * @return 步/分钟，节律未确认时返回0
+ */
+uint16_t step_detector_get_cadence(void)
+{
+    unsigned long interval = s_detector.interval;
+
+    if (!s_detector.locked || interval == 0) {
+        return 0;
+    }
+    return (uint16_t)(60000UL / interval);
+}
+
+/**
+ * @brief 节律是否已确认（正在逐步计数）
+ * @return 1-是，0-否
+ */
+uint8_t step_detector_is_locked(void)
+{
+    return s_detector.locked;
+}
@@ -0,0 +1,47 @@
+/**
+ * @file step_detector.h
+ * @brief 自适应定点计步流水线（带通滤波 + 动态峰谷阈值 + 节律确认）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 处理流程（每个采样）：
+ *       1. 合加速度 |a|（逐位法开方）
+ *       2. 二阶IIR带通 0.5~3Hz（步频范围），同时去除重力直流分量
+ *       3. 波峰/波谷滞回检测，滞回量和最小峰谷幅度取最近若干步幅度的滑动平均
+ *       4. 节律确认：连续 STEP_DETECTOR_REGULAR_STEPS 步间隔一致才开始计数，
+ *          确认后把这几步一次补记，之后逐步计数；停走超过2秒重新确认
+ *
+ *       周期预算：每个采样 ≤ STEP_DETECTOR_CYCLE_BUDGET 个CPU周期，
+ *       置 STEP_DETECTOR_PROFILE 为1可用DWT实测（见 step_detector.c）
+ */
+
+#ifndef __STEP_DETECTOR_H
+#define __STEP_DETECTOR_H
+
+#include <stdint.h>
+
+// ==================================
+// 宏定义
+// ==================================
+
+#define STEP_DETECTOR_CYCLE_BUDGET      400     // 每采样周期预算（72MHz下约5.6us）
+#define STEP_DETECTOR_REGULAR_STEPS     4       // 开始计数前需要的连续规律步数
+#define STEP_DETECTOR_AMP_WINDOW        4       // 幅度滑动窗口（步数），需为2的幂
+#define STEP_DETECTOR_MIN_AMPLITUDE     1200    // 最小峰谷幅度（约0.07g）
+#define STEP_DETECTOR_MIN_HYSTERESIS    400     // 最小滞回量（约0.025g）
+#define STEP_DETECTOR_MIN_INTERVAL_MS   250     // 最小步间隔（4步/秒）
+#define STEP_DETECTOR_MAX_INTERVAL_MS   2000    // 最大步间隔（0.5步/秒），超过即认为停走
+
+// ==================================
+// 函数声明
+// ==================================
+
+int step_detector_init(uint16_t sample_rate_hz);
+void step_detector_reset(void);
+unsigned long step_detector_update(short ax, short ay, short az, unsigned long timestamp_ms);
+unsigned long step_detector_get_steps(void);
+unsigned long step_detector_get_peaks(void);
+uint16_t step_detector_get_cadence(void);
+uint8_t step_detector_is_locked(void);
+
+#endif
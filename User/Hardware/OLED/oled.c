@@ -1,10 +1,13 @@
 #include "oled.h"
 #include "stdlib.h"
+#include "string.h"
 #include "oledfont.h"
 
 static uint8_t OLED_GRAM[144][8];
 static uint8_t dirty_flag = 0;
 static uint8_t dirty_x1 = 127, dirty_y1 = 63, dirty_x2 = 0, dirty_y2 = 0;
+static uint8_t refresh_hold = 0;
+static void (*refresh_hook)(void) = NULL;
 
 // 发送一个字节
 // mode:数据/命令标志 0,表示命令;1,表示数据;
@@ -73,6 +76,16 @@ void OLED_Refresh(void)
 {
 	uint8_t i, n;
 	uint8_t data[128];
+	if (refresh_hold)
+	{
+		return;
+	}
+	if (refresh_hook)
+	{
+		OLED_Set_Dirty_Area(0, 0, 127, 63);
+		refresh_hook();
+		return;
+	}
 	for (i = 0; i < 8; i++)
 	{
 		for (n = 0; n < 128; n++)
@@ -89,6 +102,22 @@ void OLED_Refresh(void)
 
 // 局部刷新函数，只刷新指定区域 (x1,y1) 到 (x2,y2)
 void OLED_Refresh_Area(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2)
+{
+	if (refresh_hold)
+	{
+		return;
+	}
+	if (refresh_hook)
+	{
+		OLED_Set_Dirty_Area(x1, y1, x2, y2);
+		refresh_hook();
+		return;
+	}
+	OLED_Send_Area(x1, y1, x2, y2);
+}
+
+// 发送显存区域 (x1,y1) 到 (x2,y2)，不检查暂停和钩子（显示服务任务送屏用）
+void OLED_Send_Area(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2)
 {
 	uint8_t i, n, start_page, end_page, start_col, end_col;
 	uint8_t data[128];
@@ -160,12 +189,94 @@ void OLED_Set_Dirty_Area(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2)
 // 刷新脏区域
 void OLED_Refresh_Dirty(void)
 {
+	if (refresh_hook) {
+		// 脏区域留给显示服务任务，本帧统一送屏
+		if (dirty_flag && !refresh_hold) {
+			refresh_hook();
+		}
+		return;
+	}
 	if (dirty_flag) {
 		OLED_Refresh_Area(dirty_x1, dirty_y1, dirty_x2, dirty_y2);
 		dirty_flag = 0;
 		dirty_x1 = 127; dirty_y1 = 63; dirty_x2 = 0; dirty_y2 = 0;
 	}
 }
+// 暂停/恢复刷新
+// hold:1 暂停，OLED_Refresh 系列只改显存不发总线（脏区域照常清除）；0 恢复
+// 页面切换时用它把退出/进入回调里的清屏和首帧绘制留在显存里，最后一次性送屏
+void OLED_Refresh_Hold(uint8_t hold)
+{
+	refresh_hold = hold;
+}
+
+// 设置刷新钩子，NULL 恢复直接送屏
+// 设置后 OLED_Refresh/OLED_Refresh_Area/OLED_Refresh_Dirty 不再访问总线，
+// 只合并脏区域并调用 hook 通知显示服务任务，由它用 OLED_Take_Dirty + OLED_Send_Area 每帧送屏一次
+void OLED_Set_Refresh_Hook(void (*hook)(void))
+{
+	refresh_hook = hook;
+}
+
+// 取出并清除脏区域
+// 返回:1 有脏区域，坐标写入参数；0 没有，或刷新暂停中（脏区域留到恢复后）
+// 与绘制任务并发时由调用者保证原子性（如挂起调度器）
+uint8_t OLED_Take_Dirty(uint8_t *x1, uint8_t *y1, uint8_t *x2, uint8_t *y2)
+{
+	if (!dirty_flag || refresh_hold)
+	{
+		return 0;
+	}
+	*x1 = dirty_x1; *y1 = dirty_y1; *x2 = dirty_x2; *y2 = dirty_y2;
+	dirty_flag = 0;
+	dirty_x1 = 127; dirty_y1 = 63; dirty_x2 = 0; dirty_y2 = 0;
+	return 1;
+}
+
+// 拷贝当前显存画面到 frame（OLED_FRAME_BYTES 字节，frame[x*8+page] 与显存列布局相同）
+void OLED_Snapshot(uint8_t *frame)
+{
+	memcpy(frame, OLED_GRAM, OLED_FRAME_BYTES);
+}
+
+// 合成刷新：显存画面左边缘放在 front_x 列，盖在左边缘放在 back_x 列的 back 画面之上，
+// 两幅画面都没有覆盖的列显示黑色；只发送 x1~x2 列，不修改显存
+// 按整列（1字节）平移，不做位移运算，每帧开销与普通局部刷新相同
+// 不受暂停影响：动画期间保持暂停，新页面的脏区域不会被提前送屏
+void OLED_Refresh_Compose(const uint8_t *back, int16_t back_x, int16_t front_x, uint8_t x1, uint8_t x2)
+{
+	uint8_t i, n;
+	int16_t src;
+	uint8_t data[128];
+	
+	if (x1 > x2 || x2 >= 128)
+	{
+		return;
+	}
+	
+	for (i = 0; i < 8; i++)
+	{
+		for (n = x1; n <= x2; n++)
+		{
+			src = n - front_x;
+			if (src >= 0 && src < 128)
+			{
+				data[n - x1] = OLED_GRAM[src][i];
+			}
+			else
+			{
+				src = n - back_x;
+				data[n - x1] = (src >= 0 && src < 128) ? back[src * 8 + i] : 0;
+			}
+		}
+		
+		OLED_WR_Byte(0xb0 + i, OLED_CMD);
+		OLED_WR_Byte(x1 & 0x0f, OLED_CMD);
+		OLED_WR_Byte(0x10 | (x1 >> 4), OLED_CMD);
+		OLED_Send_Bytes(0x3c, 0x40, x2 - x1 + 1, data);
+	}
+}
+
 // 清屏函数
 void OLED_Clear(void)
 {
@@ -180,6 +291,17 @@ void OLED_Clear(void)
 	OLED_Refresh(); // 更新显示
 }
 
+// 获取一列显存，OLED_GRAM_Column(x)[page] 的bit n 对应 y = page*8+n
+// 逐列绘制的控件直接按页写入，省去逐点读改写；调用者负责标记脏区域
+uint8_t *OLED_GRAM_Column(uint8_t x)
+{
+	if (x >= 128)
+	{
+		return NULL;
+	}
+	return OLED_GRAM[x];
+}
+
 // 画点
 // x:0~127
 // y:0~63
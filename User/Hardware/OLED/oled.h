@@ -11,6 +11,7 @@
 /****************************************end********************************************** */
 #define OLED_CMD 0  // д
 #define OLED_DATA 1 // д
+#define OLED_FRAME_BYTES (128 * 8) // һԴֽ128 x 8ҳ
 void OLED_ClearPoint(uint8_t x, uint8_t y);
 void OLED_ColorTurn(uint8_t i);
 void OLED_DisplayTurn(uint8_t i);
@@ -21,7 +22,14 @@ void OLED_Refresh(void);
 void OLED_Refresh_Area(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2);
 void OLED_Set_Dirty_Area(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2);
 void OLED_Refresh_Dirty(void);
+void OLED_Refresh_Hold(uint8_t hold); // 1-ͣˢ£ֻԴ治ߣ0-ָ
+void OLED_Snapshot(uint8_t *frame); // Դ滭棬frame[x*8+page] OLED_FRAME_BYTES ֽ
+void OLED_Refresh_Compose(const uint8_t *back, int16_t back_x, int16_t front_x, uint8_t x1, uint8_t x2); // ϳˢ£ҳл
+void OLED_Set_Refresh_Hook(void (*hook)(void)); // ú OLED_Refresh ϵֻ򲢵 hookʾͳһ
+uint8_t OLED_Take_Dirty(uint8_t *x1, uint8_t *y1, uint8_t *x2, uint8_t *y2); // ȡ0-û
+void OLED_Send_Area(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2); // ֱӷԴ򣬲Ӻͣ
 void OLED_Clear(void);
+uint8_t *OLED_GRAM_Column(uint8_t x); // ֱӷһԴ棨8ҳлƵĿؼʹ
 void OLED_DrawPoint(uint8_t x, uint8_t y, uint8_t t);
 void OLED_DrawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t mode);
 void OLED_DrawCircle(uint8_t x, uint8_t y, uint8_t r);
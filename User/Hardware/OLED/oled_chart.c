@@ -0,0 +1,308 @@
+/**
+ * @file oled_chart.c
+ * @brief OLED时间序列图表控件实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "oled_chart.h"
+#include "oled.h"
+
+// ==================================
+// 内部函数
+// ==================================
+
+/**
+ * @brief 某页中 [top, bottom] 行对应的位掩码
+ */
+static uint8_t OLED_Chart_Page_Mask(uint8_t page, int16_t top, int16_t bottom)
+{
+    int16_t base = (int16_t)page * 8;
+
+    if (top < base) {
+        top = base;
+    }
+    if (bottom > base + 7) {
+        bottom = base + 7;
+    }
+    if (top > bottom) {
+        return 0;
+    }
+    return (uint8_t)((0xFF << (top - base)) & (0xFF >> (base + 7 - bottom)));
+}
+
+/**
+ * @brief 数值映射到屏幕行（量程外截断）
+ */
+static uint8_t OLED_Chart_Row(const oled_chart_t *chart, int16_t value)
+{
+    int32_t span = (int32_t)chart->hi - chart->lo;
+    int32_t offset;
+    uint8_t bottom = chart->y + chart->height - 1;
+
+    if (span <= 0) {
+        return bottom - (chart->height - 1) / 2;
+    }
+    offset = (int32_t)value - chart->lo;
+    if (offset <= 0) {
+        return bottom;
+    }
+    if (offset >= span) {
+        return chart->y;
+    }
+    return bottom - (uint8_t)((offset * (chart->height - 1) + span / 2) / span);
+}
+
+/**
+ * @brief 用当前累计的最小/最大值绘制一列
+ */
+static void OLED_Chart_Column(oled_chart_t *chart)
+{
+    uint8_t *gram = OLED_GRAM_Column(chart->x + chart->column);
+    uint8_t bottom = chart->y + chart->height - 1;
+    int16_t top_row = 1;
+    int16_t bottom_row = 0;
+    uint8_t page;
+    uint8_t region;
+
+    if (gram == NULL) {
+        return;
+    }
+
+    if (chart->acc_min <= chart->acc_max) {
+        top_row = OLED_Chart_Row(chart, chart->acc_max);
+        bottom_row = (chart->style == OLED_CHART_BAR) ? bottom : OLED_Chart_Row(chart, chart->acc_min);
+
+        // 折线：与前一列的范围相接，陡变处不断线
+        if (chart->style == OLED_CHART_LINE && chart->prev_valid) {
+            if (chart->prev_top > bottom_row) {
+                bottom_row = chart->prev_top;
+            }
+            if (chart->prev_bottom < top_row) {
+                top_row = chart->prev_bottom;
+            }
+        }
+        chart->prev_valid = 1;
+        chart->prev_top = OLED_Chart_Row(chart, chart->acc_max);
+        chart->prev_bottom = (chart->style == OLED_CHART_BAR) ? bottom : OLED_Chart_Row(chart, chart->acc_min);
+    } else {
+        chart->prev_valid = 0;
+        // 缺测列：底部每隔一列画一个点
+        if ((chart->column & 1) == 0) {
+            top_row = bottom;
+            bottom_row = bottom;
+        }
+    }
+
+    for (page = chart->y / 8; page <= bottom / 8; page++) {
+        region = OLED_Chart_Page_Mask(page, chart->y, bottom);
+        gram[page] = (gram[page] & ~region) | (OLED_Chart_Page_Mask(page, top_row, bottom_row) & region);
+    }
+}
+
+// ==================================
+// 对外接口
+// ==================================
+
+/**
+ * @brief 初始化图表
+ * @param chart 图表
+ * @param x 左上角X
+ * @param y 左上角Y
+ * @param width 宽度（列数）
+ * @param height 高度（像素）
+ * @param style 柱状/折线
+ * @param flags OLED_CHART_FLAG_*
+ */
+void OLED_Chart_Init(oled_chart_t *chart, uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                     oled_chart_style_t style, uint8_t flags)
+{
+    if (x >= 128) {
+        x = 127;
+    }
+    if (y >= 64) {
+        y = 63;
+    }
+    if (width == 0 || width > 128 - x) {
+        width = 128 - x;
+    }
+    if (height == 0 || height > 64 - y) {
+        height = 64 - y;
+    }
+
+    chart->x = x;
+    chart->y = y;
+    chart->width = width;
+    chart->height = height;
+    chart->style = (uint8_t)style;
+    chart->flags = flags;
+    chart->lo = 0;
+    chart->hi = 1;
+    chart->count = 0;
+    chart->pushed = 0;
+    chart->column = width;
+}
+
+/**
+ * @brief 设置固定量程（关闭自动量程）
+ */
+void OLED_Chart_Set_Range(oled_chart_t *chart, int16_t lo, int16_t hi)
+{
+    chart->flags &= ~OLED_CHART_FLAG_AUTO;
+    chart->lo = lo;
+    chart->hi = hi;
+}
+
+/**
+ * @brief 开始统计自动量程
+ */
+void OLED_Chart_Range_Reset(oled_chart_t *chart)
+{
+    if (chart->flags & OLED_CHART_FLAG_ZERO) {
+        chart->lo = 0;
+        chart->hi = 0;
+    } else {
+        chart->lo = 32767;
+        chart->hi = -32767;
+    }
+}
+
+/**
+ * @brief 把一个样本计入自动量程
+ */
+void OLED_Chart_Range_Add(oled_chart_t *chart, int16_t value)
+{
+    if (value == OLED_CHART_NO_DATA) {
+        return;
+    }
+    if (value < chart->lo) {
+        chart->lo = value;
+    }
+    if (value > chart->hi) {
+        chart->hi = value;
+    }
+}
+
+/**
+ * @brief 开始绘制
+ * @param chart 图表
+ * @param count 随后推入的样本数
+ */
+void OLED_Chart_Begin(oled_chart_t *chart, uint16_t count)
+{
+    // 没有有效样本时给一个默认量程；所有样本相同时居中（以0为基线时从底部起）
+    if (chart->lo > chart->hi) {
+        chart->lo = 0;
+        chart->hi = 1;
+    } else if (chart->lo == chart->hi) {
+        if (chart->lo > -32767 && !((chart->flags & OLED_CHART_FLAG_ZERO) && chart->lo == 0)) {
+            chart->lo--;
+        }
+        if (chart->hi < 32767) {
+            chart->hi++;
+        }
+    }
+
+    chart->count = count;
+    chart->pushed = 0;
+    chart->column = 0;
+    chart->prev_valid = 0;
+    chart->acc_min = 32767;
+    chart->acc_max = -32767;
+}
+
+/**
+ * @brief 推入一个样本，凑满一列即绘制
+ * @param chart 图表
+ * @param value 样本（OLED_CHART_NO_DATA 为缺测）
+ */
+void OLED_Chart_Push(oled_chart_t *chart, int16_t value)
+{
+    uint8_t end_column;
+
+    if (chart->pushed >= chart->count) {
+        return;
+    }
+
+    if (value != OLED_CHART_NO_DATA) {
+        if (value < chart->acc_min) {
+            chart->acc_min = value;
+        }
+        if (value > chart->acc_max) {
+            chart->acc_max = value;
+        }
+    }
+    chart->pushed++;
+
+    // 第 c 列覆盖样本 [c*count/width, (c+1)*count/width)
+    end_column = (uint8_t)((uint32_t)chart->pushed * chart->width / chart->count);
+    if (end_column > chart->column) {
+        while (chart->column < end_column) {
+            OLED_Chart_Column(chart);
+            chart->column++;
+        }
+        chart->acc_min = 32767;
+        chart->acc_max = -32767;
+    }
+}
+
+/**
+ * @brief 结束绘制：补画剩余的列并标记脏区域
+ */
+void OLED_Chart_End(oled_chart_t *chart)
+{
+    while (chart->column < chart->width) {
+        OLED_Chart_Column(chart);
+        chart->column++;
+        chart->acc_min = 32767;
+        chart->acc_max = -32767;
+    }
+    OLED_Set_Dirty_Area(chart->x, chart->y, chart->x + chart->width - 1, chart->y + chart->height - 1);
+}
+
+/**
+ * @brief 绘制一段样本数组（自动量程时先扫描一遍）
+ * @param chart 图表
+ * @param values 样本数组
+ * @param count 样本数
+ */
+void OLED_Chart_Draw(oled_chart_t *chart, const int16_t *values, uint16_t count)
+{
+    uint16_t i;
+
+    if (chart->flags & OLED_CHART_FLAG_AUTO) {
+        OLED_Chart_Range_Reset(chart);
+        for (i = 0; i < count; i++) {
+            OLED_Chart_Range_Add(chart, values[i]);
+        }
+    }
+
+    OLED_Chart_Begin(chart, count);
+    for (i = 0; i < count; i++) {
+        OLED_Chart_Push(chart, values[i]);
+    }
+    OLED_Chart_End(chart);
+}
+
+/**
+ * @brief 滚动时间窗口
+ * @param first 当前窗口起点
+ * @param delta 滚动量（负数向前）
+ * @param window 窗口长度
+ * @param total 序列总长度
+ * @return 新的窗口起点（限制在 [0, total-window]）
+ */
+uint16_t OLED_Chart_Scroll(uint16_t first, int16_t delta, uint16_t window, uint16_t total)
+{
+    int32_t pos = (int32_t)first + delta;
+    int32_t last = (window < total) ? (int32_t)(total - window) : 0;
+
+    if (pos < 0) {
+        pos = 0;
+    }
+    if (pos > last) {
+        pos = last;
+    }
+    return (uint16_t)pos;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file oled_chart.h
+ * @brief OLED时间序列图表控件（按列最小/最大值抽取，逐列写入显存）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 任意长度的序列均匀映射到图表的每一列，每列保留该列样本的最小值和最大值，
+ *       因此短时峰值不会在抽取中丢失；样本少于列数时一个样本拉伸到多列。
+ *       数据以流的形式推入（Begin/Push/End），调用方不需要整块缓冲区，
+ *       每列凑齐后立即按页写入 OLED_GRAM，整张图只对每页每列写一次
+ */
+
+#ifndef __OLED_CHART_H
+#define __OLED_CHART_H
+
+#include <stdint.h>
+
+// ==================================
+// 宏定义
+// ==================================
+
+#define OLED_CHART_NO_DATA          ((int16_t)-32768)   // 缺测样本，该列留空（底部画虚线）
+
+#define OLED_CHART_FLAG_AUTO        0x01                // 自动量程（Range_Reset/Range_Add）
+#define OLED_CHART_FLAG_ZERO        0x02                // 自动量程时包含0（柱状图基线）
+
+// ==================================
+// 数据结构
+// ==================================
+
+typedef enum {
+    OLED_CHART_BAR = 0,             // 柱状：从底部填充到该列最大值
+    OLED_CHART_LINE                 // 折线：该列最小~最大值的竖线，并与前一列连接
+} oled_chart_style_t;
+
+typedef struct {
+    uint8_t x, y;                   // 左上角
+    uint8_t width, height;          // 尺寸（宽度不超过128）
+    uint8_t style;                  // oled_chart_style_t
+    uint8_t flags;                  // OLED_CHART_FLAG_*
+    int16_t lo, hi;                 // 纵轴量程
+
+    // 流式绘制状态
+    uint16_t count;                 // 本次要推入的样本数
+    uint16_t pushed;                // 已推入的样本数
+    uint8_t column;                 // 下一个要绘制的列
+    uint8_t prev_valid;             // 前一列是否有数据（折线连接用）
+    uint8_t prev_top, prev_bottom;  // 前一列的像素范围
+    int16_t acc_min, acc_max;       // 当前列累计的最小/最大值
+} oled_chart_t;
+
+// ==================================
+// 函数声明
+// ==================================
+
+void OLED_Chart_Init(oled_chart_t *chart, uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                     oled_chart_style_t style, uint8_t flags);
+void OLED_Chart_Set_Range(oled_chart_t *chart, int16_t lo, int16_t hi);
+void OLED_Chart_Range_Reset(oled_chart_t *chart);
+void OLED_Chart_Range_Add(oled_chart_t *chart, int16_t value);
+
+void OLED_Chart_Begin(oled_chart_t *chart, uint16_t count);
+void OLED_Chart_Push(oled_chart_t *chart, int16_t value);
+void OLED_Chart_End(oled_chart_t *chart);
+void OLED_Chart_Draw(oled_chart_t *chart, const int16_t *values, uint16_t count);
+
+uint16_t OLED_Chart_Scroll(uint16_t first, int16_t delta, uint16_t window, uint16_t total);
+
+#endif
@@ -80,9 +80,22 @@ void Usart1_Send_Sring(char *string)
     while(USART_GetFlagStatus(USART1, USART_FLAG_TC) == RESET);
 }
 
+// Ĭ־ڱռʱprintf
+static volatile uint8_t s_debug_quiet = 0;
+
+void debug_set_quiet(uint8_t quiet)
+{
+    s_debug_quiet = quiet;
+}
+
 //ضc⺯printfڣضʹprintf
 int fputc(int ch, FILE *f)
 {
+    if (s_debug_quiet)
+    {
+        return (ch);
+    }
+
     /* һֽݵ */
     USART_SendData(USART1, (uint8_t) ch);
 
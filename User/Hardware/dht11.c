@@ -1,5 +1,9 @@
 #include "dht11.h"
 #include "Delay.h"
+#include "semphr.h"
+
+// 温湿度页面和历史记录任务都会读取DHT11，单总线时序不能被另一次读取打断
+static SemaphoreHandle_t s_dht11_mutex = NULL;
 
 void DHT11_Init(void)
 {
@@ -12,7 +16,10 @@ void DHT11_Init(void)
 	GPIO_Init(GPIOB, &GPIO_InitStruct);
 	PBout(5) = 1;
 
-
+	if (s_dht11_mutex == NULL)
+	{
+		s_dht11_mutex = xSemaphoreCreateMutex();
+	}
 }
 
 
@@ -66,7 +73,7 @@ uint8_t Read_Byte(void)
 
 
 // 返回值：失败-1，成功0
-int Read_DHT11(DHT11_Data_TypeDef* data)
+static int DHT11_Read_Frame(DHT11_Data_TypeDef* data)
 {
 	
 	uint32_t count = 0;
@@ -129,6 +136,19 @@ int Read_DHT11(DHT11_Data_TypeDef* data)
 	}
 }
 
+// 返回值：失败-1，成功0
+int Read_DHT11(DHT11_Data_TypeDef* data)
+{
+	int ret;
 
-
-
+	if (s_dht11_mutex != NULL)
+	{
+		xSemaphoreTake(s_dht11_mutex, portMAX_DELAY);
+	}
+	ret = DHT11_Read_Frame(data);
+	if (s_dht11_mutex != NULL)
+	{
+		xSemaphoreGive(s_dht11_mutex);
+	}
+	return ret;
+}
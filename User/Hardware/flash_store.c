@@ -0,0 +1,197 @@
+#include "flash_store.h"
+#include "stm32f10x_flash.h"
+#include "debug.h"
+#include <string.h>
+
+// 记录头：魔数 + 数据长度，后跟数据和CRC16
+typedef struct {
+    uint16_t magic;
+    uint16_t len;
+} flash_record_header_t;
+
+/**
+ * @brief CRC16-CCITT（多项式0x1021）
+ * @param data 数据
+ * @param len 长度
+ * @param crc 初值（首次调用传0xFFFF，可分段连续计算）
+ * @return CRC值
+ */
+uint16_t flash_store_crc16(const uint8_t *data, uint32_t len, uint16_t crc)
+{
+    uint8_t i;
+
+    while (len--) {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief 读取一条记录并校验
+ * @param page_addr 页首地址
+ * @param magic 期望的魔数
+ * @param data 输出缓冲区
+ * @param len 期望长度
+ * @return 0-成功，-1-无记录，-2-长度不符，-3-CRC错误
+ */
+int flash_store_read(uint32_t page_addr, uint16_t magic, void *data, uint16_t len)
+{
+    const flash_record_header_t *hdr = (const flash_record_header_t *)page_addr;
+    const uint8_t *payload = (const uint8_t *)(page_addr + sizeof(flash_record_header_t));
+    uint16_t stored_crc;
+    uint16_t crc;
+
+    if (hdr->magic != magic) {
+        return -1;
+    }
+    if (hdr->len != len) {
+        return -2;
+    }
+
+    crc = flash_store_crc16((const uint8_t *)hdr, sizeof(flash_record_header_t), 0xFFFF);
+    crc = flash_store_crc16(payload, len, crc);
+    stored_crc = *(const uint16_t *)(page_addr + sizeof(flash_record_header_t) + ((len + 1) & ~1U));
+    if (crc != stored_crc) {
+        return -3;
+    }
+
+    memcpy(data, payload, len);
+    return 0;
+}
+
+/**
+ * @brief 擦除整页并写入一条记录
+ * @param page_addr 页首地址
+ * @param magic 魔数
+ * @param data 数据
+ * @param len 长度（不超过一页减去头和CRC）
+ * @return 0-成功，-1-参数错误，-2-擦除失败，-3-写入失败，-4-回读校验失败
+ */
+int flash_store_write(uint32_t page_addr, uint16_t magic, const void *data, uint16_t len)
+{
+    flash_record_header_t hdr;
+    const uint8_t *src = (const uint8_t *)data;
+    uint32_t addr;
+    uint16_t crc;
+    uint16_t i;
+    int ret = 0;
+
+    if (data == NULL || len + sizeof(hdr) + 2 > FLASH_STORE_PAGE_SIZE) {
+        return -1;
+    }
+
+    hdr.magic = magic;
+    hdr.len = len;
+    crc = flash_store_crc16((const uint8_t *)&hdr, sizeof(hdr), 0xFFFF);
+    crc = flash_store_crc16(src, len, crc);
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPRTERR);
+
+    if (FLASH_ErasePage(page_addr) != FLASH_COMPLETE) {
+        ret = -2;
+        goto out;
+    }
+
+    addr = page_addr;
+    if (FLASH_ProgramHalfWord(addr, hdr.magic) != FLASH_COMPLETE ||
+        FLASH_ProgramHalfWord(addr + 2, hdr.len) != FLASH_COMPLETE) {
+        ret = -3;
+        goto out;
+    }
+    addr += sizeof(hdr);
+
+    // Flash只能按半字写入，奇数长度末尾补0xFF
+    for (i = 0; i < len; i += 2) {
+        uint16_t half = src[i];
+        half |= (i + 1 < len) ? ((uint16_t)src[i + 1] << 8) : 0xFF00;
+        if (FLASH_ProgramHalfWord(addr, half) != FLASH_COMPLETE) {
+            ret = -3;
+            goto out;
+        }
+        addr += 2;
+    }
+
+    if (FLASH_ProgramHalfWord(addr, crc) != FLASH_COMPLETE) {
+        ret = -3;
+        goto out;
+    }
+
+out:
+    FLASH_Lock();
+
+    if (ret == 0 && memcmp((const void *)(page_addr + sizeof(hdr)), data, len) != 0) {
+        ret = -4;
+    }
+    if (ret != 0) {
+        printf("flash_store_write failed at 0x%08lX: %d\r\n", (unsigned long)page_addr, ret);
+    }
+    return ret;
+}
+
+/**
+ * @brief 擦除一页
+ * @param page_addr 页首地址
+ * @return 0-成功，-2-擦除失败
+ */
+int flash_store_erase_page(uint32_t page_addr)
+{
+    int ret = 0;
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPRTERR);
+    if (FLASH_ErasePage(page_addr) != FLASH_COMPLETE) {
+        ret = -2;
+    }
+    FLASH_Lock();
+
+    if (ret != 0) {
+        printf("flash_store_erase_page failed at 0x%08lX\r\n", (unsigned long)page_addr);
+    }
+    return ret;
+}
+
+/**
+ * @brief 向已擦除区域写入数据（不擦除）
+ * @param addr 起始地址（须半字对齐，目标区域须为0xFF）
+ * @param data 数据
+ * @param len 长度（奇数长度末尾补0xFF）
+ * @return 0-成功，-1-参数错误，-3-写入失败，-4-回读校验失败
+ */
+int flash_store_program(uint32_t addr, const void *data, uint16_t len)
+{
+    const uint8_t *src = (const uint8_t *)data;
+    uint32_t dst = addr;
+    uint16_t i;
+    int ret = 0;
+
+    if (data == NULL || (addr & 1) != 0) {
+        return -1;
+    }
+
+    FLASH_Unlock();
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPRTERR);
+
+    for (i = 0; i < len; i += 2) {
+        uint16_t half = src[i];
+        half |= (i + 1 < len) ? ((uint16_t)src[i + 1] << 8) : 0xFF00;
+        if (FLASH_ProgramHalfWord(dst, half) != FLASH_COMPLETE) {
+            ret = -3;
+            break;
+        }
+        dst += 2;
+    }
+
+    FLASH_Lock();
+
+    if (ret == 0 && memcmp((const void *)addr, data, len) != 0) {
+        ret = -4;
+    }
+    if (ret != 0) {
+        printf("flash_store_program failed at 0x%08lX: %d\r\n", (unsigned long)addr, ret);
+    }
+    return ret;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file flash_store.h
+ * @brief 片内Flash参数存储（带CRC校验的记录读写）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note STM32F103C8 共64KB Flash，每页1KB，参数区放在末尾，避开程序区
+ */
+
+#ifndef __FLASH_STORE_H
+#define __FLASH_STORE_H
+
+#include "stm32f10x.h"
+
+// ==================================
+// Flash布局
+// ==================================
+
+#define FLASH_STORE_PAGE_SIZE       1024
+#define FLASH_STORE_HISTORY_ADDR    0x0800EC00UL    // 倒数第5~2页：历史数据日志（环形追加）
+#define FLASH_STORE_HISTORY_PAGES   4
+#define FLASH_STORE_CALIB_ADDR      0x0800FC00UL    // 最后一页：传感器校准参数
+
+// ==================================
+// 记录魔数
+// ==================================
+
+#define FLASH_STORE_MAGIC_CALIB     0xCA1B
+#define FLASH_STORE_MAGIC_HISTORY   0x4853
+
+// ==================================
+// 函数声明
+// ==================================
+
+uint16_t flash_store_crc16(const uint8_t *data, uint32_t len, uint16_t crc);
+int flash_store_read(uint32_t page_addr, uint16_t magic, void *data, uint16_t len);
+int flash_store_write(uint32_t page_addr, uint16_t magic, const void *data, uint16_t len);
+
+// 追加式写入（日志类数据自行管理页内位置）
+int flash_store_erase_page(uint32_t page_addr);
+int flash_store_program(uint32_t addr, const void *data, uint16_t len);
+
+#endif
@@ -0,0 +1,260 @@
+/**
+ * @file rtc_clock.c
+ * @brief 日历时钟服务实现
+ * @author flowkite-0689
+ * @version v1.1
+ * @date 2026.10.19
+ */
+
+#include "rtc_clock.h"
+#include "rtc_date.h"
+
+// ==================================
+// 全局变量定义
+// ==================================
+
+static struct {
+    rtc_clock_handler_t handler;
+    uint8_t events;
+} s_subscribers[RTC_CLOCK_MAX_SUBSCRIBERS];
+
+static uint8_t s_subscriber_count = 0;
+static rtc_clock_time_t s_time;
+static volatile uint32_t s_seq = 0;            // 顺序锁：奇数表示正在写
+static volatile uint8_t s_ready = 0;
+
+// ==================================
+// 内部函数
+// ==================================
+
+/**
+ * @brief 顺序锁写开始/结束（写者只有RTC中断和屏蔽了RTC中断的 RTC_Clock_Sync，不会并发）
+ */
+static void RTC_Clock_Write_Begin(void)
+{
+    s_seq++;
+    __DMB();
+}
+
+static void RTC_Clock_Write_End(void)
+{
+    __DMB();
+    s_seq++;
+}
+
+/**
+ * @brief 本地时间秒数完整分解为日历时间
+ */
+static void RTC_Clock_Decompose(uint32_t local_sec, rtc_clock_time_t *t)
+{
+    uint32_t days = local_sec / 86400;
+    uint32_t secs = local_sec % 86400;
+
+    t->local_sec = local_sec;
+    t->hours = (uint8_t)(secs / 3600);
+    t->minutes = (uint8_t)((secs % 3600) / 60);
+    t->seconds = (uint8_t)(secs % 60);
+    t->weekday = MyRTC_WeekdayFromDays(days);
+    MyRTC_DateFromDays(days, &t->year, &t->month, &t->day);
+}
+
+/**
+ * @brief 日历时间前进一秒
+ * @return 产生的事件
+ */
+static uint8_t RTC_Clock_Step(rtc_clock_time_t *t)
+{
+    uint8_t events = RTC_CLOCK_EVT_SECOND;
+
+    t->local_sec++;
+    if (++t->seconds < 60) {
+        return events;
+    }
+    t->seconds = 0;
+    events |= RTC_CLOCK_EVT_MINUTE;
+    if (++t->minutes < 60) {
+        return events;
+    }
+    t->minutes = 0;
+    events |= RTC_CLOCK_EVT_HOUR;
+    if (++t->hours < 24) {
+        return events;
+    }
+    t->hours = 0;
+    events |= RTC_CLOCK_EVT_DAY;
+    if (++t->weekday > 6) {
+        t->weekday = 0;
+    }
+    if (++t->day <= MyRTC_DaysInMonth(t->year, t->month)) {
+        return events;
+    }
+    t->day = 1;
+    if (++t->month <= 12) {
+        return events;
+    }
+    t->month = 1;
+    t->year++;
+    return events;
+}
+
+/**
+ * @brief 分发事件给订阅者（中断中或临界区内调用）
+ */
+static void RTC_Clock_Notify(uint8_t events, BaseType_t *woken)
+{
+    uint8_t i;
+
+    for (i = 0; i < s_subscriber_count; i++) {
+        if (s_subscribers[i].events & events) {
+            s_subscribers[i].handler(events, &s_time, woken);
+        }
+    }
+}
+
+// ==================================
+// 中断服务函数
+// ==================================
+
+/**
+ * @brief RTC全局中断：秒中断推进时钟，闹钟中断转为事件
+ */
+void RTC_IRQHandler(void)
+{
+    BaseType_t woken = pdFALSE;
+    uint8_t events = 0;
+    uint32_t local;
+
+    if (RTC_GetITStatus(RTC_IT_ALR) != RESET) {
+        RTC_ClearITPendingBit(RTC_IT_ALR);
+        events |= RTC_CLOCK_EVT_ALARM;
+    }
+
+    if (RTC_GetITStatus(RTC_IT_SEC) != RESET) {
+        RTC_ClearITPendingBit(RTC_IT_SEC);
+
+        local = MyRTC_GetLocalSeconds();
+        RTC_Clock_Write_Begin();
+        if ((uint32_t)(local - s_time.local_sec) <= RTC_CLOCK_CATCHUP_S) {
+            while (s_time.local_sec != local) {
+                events |= RTC_Clock_Step(&s_time);
+            }
+        } else {
+            // 计数器跳变（修改了时间）：重新分解
+            RTC_Clock_Decompose(local, &s_time);
+            events |= RTC_CLOCK_EVT_SECOND | RTC_CLOCK_EVT_MINUTE | RTC_CLOCK_EVT_HOUR |
+                      RTC_CLOCK_EVT_DAY | RTC_CLOCK_EVT_SYNC;
+        }
+        RTC_Clock_Write_End();
+    }
+
+    if (events != 0) {
+        RTC_Clock_Notify(events, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+// ==================================
+// 对外接口
+// ==================================
+
+/**
+ * @brief 初始化时钟服务（MyRTC_Init之后调用）：分解一次时间并打开RTC秒中断
+ */
+void RTC_Clock_Init(void)
+{
+    rtc_clock_time_t t;
+
+    RTC_Clock_Decompose(MyRTC_GetLocalSeconds(), &t);
+    taskENTER_CRITICAL();
+    RTC_Clock_Write_Begin();
+    s_time = t;
+    RTC_Clock_Write_End();
+    s_ready = 1;
+    taskEXIT_CRITICAL();
+
+    RTC_WaitForLastTask();
+    RTC_ClearITPendingBit(RTC_IT_SEC);
+    RTC_ITConfig(RTC_IT_SEC, ENABLE);
+    RTC_WaitForLastTask();
+
+    // 直接按优先级数值设置，与优先级分组无关
+    NVIC_SetPriority(RTC_IRQn, RTC_CLOCK_IRQ_PRIORITY);
+    NVIC_EnableIRQ(RTC_IRQn);
+
+    printf("RTC clock: %04d-%02d-%02d %02d:%02d:%02d, second IRQ enabled\r\n",
+           t.year, t.month, t.day, t.hours, t.minutes, t.seconds);
+}
+
+/**
+ * @brief 修改系统时间后调用：立即重新分解，并向订阅者发出 RTC_CLOCK_EVT_SYNC
+ * @note 即使不调用，下一个秒中断也会发现时间跳变并同步
+ */
+void RTC_Clock_Sync(void)
+{
+    BaseType_t woken = pdFALSE;
+    rtc_clock_time_t t;
+
+    RTC_Clock_Decompose(MyRTC_GetLocalSeconds(), &t);
+
+    taskENTER_CRITICAL();
+    RTC_Clock_Write_Begin();
+    s_time = t;
+    RTC_Clock_Write_End();
+    RTC_Clock_Notify(RTC_CLOCK_EVT_SYNC | RTC_CLOCK_EVT_DAY, &woken);
+    taskEXIT_CRITICAL();
+
+    if (woken == pdTRUE) {
+        taskYIELD();
+    }
+}
+
+/**
+ * @brief 读取当前时间的一致快照（无锁，任务和中断中均可调用）
+ * @param out 输出
+ * @note 顺序锁读：拷贝前后序号相同且为偶数才有效，否则重读。
+ *       任务中读时写者（RTC中断）只可能整段插在拷贝中间，重读一次即可；
+ *       更高优先级中断打断了写者时序号一直为奇数，重试用完后直接分解计数器
+ */
+void RTC_Clock_Get(rtc_clock_time_t *out)
+{
+    uint32_t seq;
+    uint8_t tries;
+
+    if (s_ready) {
+        for (tries = 0; tries < RTC_CLOCK_READ_RETRIES; tries++) {
+            seq = s_seq;
+            __DMB();
+            if (seq & 1) {
+                continue;
+            }
+            *out = s_time;
+            __DMB();
+            if (seq == s_seq) {
+                return;
+            }
+        }
+    }
+
+    // 时钟服务启动前，或打断了写者：直接分解计数器
+    RTC_Clock_Decompose(MyRTC_GetLocalSeconds(), out);
+}
+
+/**
+ * @brief 订阅时钟事件（初始化阶段调用）
+ * @param events 关心的事件（RTC_CLOCK_EVT_*）
+ * @param handler 回调，在RTC中断中执行
+ * @return 0成功，-1订阅表已满
+ */
+int RTC_Clock_Subscribe(uint8_t events, rtc_clock_handler_t handler)
+{
+    if (handler == NULL || s_subscriber_count >= RTC_CLOCK_MAX_SUBSCRIBERS) {
+        return -1;
+    }
+
+    taskENTER_CRITICAL();
+    s_subscribers[s_subscriber_count].handler = handler;
+    s_subscribers[s_subscriber_count].events = events;
+    s_subscriber_count++;
+    taskEXIT_CRITICAL();
+    return 0;
+}
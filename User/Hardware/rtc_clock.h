@@ -0,0 +1,70 @@
+/**
+ * @file rtc_clock.h
+ * @brief 日历时钟服务：RTC秒中断驱动的增量时间
+ * @author flowkite-0689
+ * @version v1.1
+ * @date 2026.10.19
+ * @note 开机或修改时间后把RTC计数器完整分解一次为年月日时分秒，
+ *       之后每个RTC秒中断只做一次 +1 秒（带日/月/年进位），读时间就是拷贝结构体。
+ *       秒中断发现计数器与时钟不连续（修改了时间或丢了中断）时自动重新分解。
+ *       读取用顺序锁（seqlock），不关中断、不挂起调度器，得到的年月日时分秒一定属于同一秒。
+ *       RTC全局中断由本模块统一处理，闹钟中断(RTC_IT_ALR)也作为事件分发给订阅者
+ */
+
+#ifndef __RTC_CLOCK_H
+#define __RTC_CLOCK_H
+
+#include "stm32f10x.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+// ==================================
+// 宏定义
+// ==================================
+
+#define RTC_CLOCK_IRQ_PRIORITY      6       // 须低于 configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY(5)
+#define RTC_CLOCK_MAX_SUBSCRIBERS   4
+#define RTC_CLOCK_CATCHUP_S         5       // 落后不超过该秒数时逐秒补进（补发分钟/小时/日事件），否则重新分解
+#define RTC_CLOCK_READ_RETRIES      4       // 读快照时的最大重试次数
+
+// 事件
+#define RTC_CLOCK_EVT_SECOND    (1 << 0)    // 秒变化
+#define RTC_CLOCK_EVT_MINUTE    (1 << 1)    // 分钟变化
+#define RTC_CLOCK_EVT_HOUR      (1 << 2)    // 小时变化
+#define RTC_CLOCK_EVT_DAY       (1 << 3)    // 日期变化
+#define RTC_CLOCK_EVT_ALARM     (1 << 4)    // RTC闹钟到点
+#define RTC_CLOCK_EVT_SYNC      (1 << 5)    // 时间被修改（重新分解）
+
+// ==================================
+// 数据结构
+// ==================================
+
+typedef struct {
+    uint32_t local_sec;         // 本地时间秒数（自2000-01-01起）
+    uint16_t year;
+    uint8_t month;              // 1-12
+    uint8_t day;                // 1-31
+    uint8_t hours;
+    uint8_t minutes;
+    uint8_t seconds;
+    uint8_t weekday;            // 0=Sun ... 6=Sat
+} rtc_clock_time_t;
+
+/**
+ * @brief 订阅回调（在RTC中断中调用，只能使用 FromISR 接口）
+ * @param events 本次发生的事件（RTC_CLOCK_EVT_*）
+ * @param now 当前时间
+ * @param woken 唤醒了更高优先级任务时置 pdTRUE
+ */
+typedef void (*rtc_clock_handler_t)(uint8_t events, const rtc_clock_time_t *now, BaseType_t *woken);
+
+// ==================================
+// 函数声明
+// ==================================
+
+void RTC_Clock_Init(void);
+void RTC_Clock_Sync(void);
+void RTC_Clock_Get(rtc_clock_time_t *out);
+int RTC_Clock_Subscribe(uint8_t events, rtc_clock_handler_t handler);
+
+#endif // __RTC_CLOCK_H
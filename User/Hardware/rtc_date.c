@@ -1,9 +1,9 @@
 #include "rtc_date.h"
 
 
-// ================== 全局变量 ==================
-uint16_t MyRTC_Time[7] = {2005, 2, 13, 7, 30, 0}; // 
-myRTC_data RTC_data = {0};
+// ================== 常量 ==================
+// 首次配置 RTC 时写入的默认时间（本地时间：年 月 日 时 分 秒）
+static const uint16_t default_time[6] = {2005, 2, 13, 7, 30, 0};
 
 // 星期字符串（对齐 OLED 显示）
 static const char *weekday_str[] = {
@@ -16,52 +16,74 @@ static const char *weekday_str[] = {
     " Saturday"     // 6
 };
 
-// ================== 工具函数：儒略日计算 ==================
-// 将年月日转换为儒略日（整数），支持 1900~2100
-// static uint32_t DateToJulianDay(uint16_t year, uint8_t month, uint8_t day) {
-//     if (month <= 2) {
-//         year--;
-//         month += 12;
-//     }
-//     uint32_t A = year / 100;
-//     uint32_t B = 2 - A + (A / 4);
-//     return (uint32_t)(365.25 * (year + 4716)) + (uint32_t)(30.6001 * (month + 1)) + day + B - 1524;
-// }
-
-// // 将儒略日转换为年月日（输出参数）
-// static void JulianDayToDate(uint32_t jd, uint16_t *year, uint8_t *month, uint8_t *day) {
-//     uint32_t a = jd + 32044;
-//     uint32_t b = (4 * a + 3) / 146097;
-//     uint32_t c = a - (146097 * b) / 4;
-//     uint32_t d = (4 * c + 3) / 1461;
-//     uint32_t e = c - (1461 * d) / 4;
-//     uint32_t m = (5 * e + 2) / 153;
-
-//     *day   = (uint8_t)(e - (153 * m + 2) / 5 + 1);
-//     *month = (uint8_t)(m + 3 - 12 * (m / 10));
-//     *year  = (uint16_t)(100 * b + d - 4800 + (m / 10));
-// }
-
-// 使用 Zeller 公式
-static uint8_t ZellerWeekDay(uint16_t year, uint8_t month, uint8_t day) {
-    if (month < 3) {
-        month += 12;
-        year--;
+// ================== 工具函数：日期 <-> 天数 ==================
+// 基准时间：2000-01-01 00:00:00 → 第0天 / 第0秒
+// 支持范围：2000-01-01 至 2099-12-31（足够用）
+// 闭式算法（H. Hinnant, days_from_civil / civil_from_days）：
+// 以3月为一年的开始，闰日落在"年末"，按400年周期(146097天)、100年、4年、1年分解，
+// 月份用 (153*mp+2)/5 换算，只有整数乘除，没有循环，耗时与日期无关
+
+#define RTC_EPOCH_YEAR 2000
+#define RTC_EPOCH_WEEKDAY 6             // 2000-01-01 为周六
+#define RTC_DAYS_0000_TO_2000 730425    // 0000-03-01 起算的纪元天数到 2000-01-01
+
+static uint8_t IsLeapYear(uint16_t year)
+{
+    return (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)) ? 1 : 0;
+}
+
+// 年月日 → 天数
+uint32_t MyRTC_DaysFromDate(uint16_t year, uint8_t month, uint8_t day)
+{
+    uint32_t y = year - (month <= 2);
+    uint32_t era = y / 400;
+    uint32_t yoe = y - era * 400;                                   // [0, 399]
+    uint32_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1; // [0, 365]
+    uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;           // [0, 146096]
+
+    return era * 146097 + doe - RTC_DAYS_0000_TO_2000;
+}
+
+// 天数 → 年月日
+void MyRTC_DateFromDays(uint32_t days, uint16_t *year, uint8_t *month, uint8_t *day)
+{
+    uint32_t z = days + RTC_DAYS_0000_TO_2000;
+    uint32_t era = z / 146097;
+    uint32_t doe = z - era * 146097;                                        // [0, 146096]
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;   // [0, 399]
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);                 // [0, 365]
+    uint32_t mp = (5 * doy + 2) / 153;                                      // [0, 11]
+    uint8_t m = (uint8_t)(mp < 10 ? mp + 3 : mp - 9);
+
+    *day = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);
+    *month = m;
+    *year = (uint16_t)(yoe + era * 400 + (m <= 2));
+}
+
+// 某月天数
+uint8_t MyRTC_DaysInMonth(uint16_t year, uint8_t month)
+{
+    static const uint8_t days_in_month[] = {31,28,31,30,31,30,31,31,30,31,30,31};
+
+    if (month == 2 && IsLeapYear(year)) {
+        return 29;
     }
-    uint32_t K = year % 100;
-    uint32_t J = year / 100;
-    uint32_t h = (day + (13 * (month + 1)) / 5 + K + K / 4 + J / 4 + 5 * J) % 7;
-    // h: 0=Sat, 1=Sun, 2=Mon, ..., 6=Fri
-    // 转为 0=Sun, 1=Mon, ..., 6=Sat
-    uint8_t wd = (h + 6) % 7; // Sat(0)→6, Sun(1)→0, Mon(2)→1, ...
-    return wd;
+    return days_in_month[month - 1];
 }
 
-// ================== 时间 <-> 秒数转换 ==================
-// 基准时间：2000-01-01 00:00:00 UTC → 秒数 = 0
-// 支持范围：2000-01-01 至 2100-12-31（足够用）
+// 星期字符串（0=Sun ... 6=Sat）
+const char *MyRTC_WeekdayName(uint8_t weekday)
+{
+    return (weekday <= 6) ? weekday_str[weekday] : "Unknown";
+}
 
-#define RTC_EPOCH_YEAR 2000
+// 天数 → 星期（0=Sun ... 6=Sat）
+uint8_t MyRTC_WeekdayFromDays(uint32_t days)
+{
+    return (uint8_t)((days + RTC_EPOCH_WEEKDAY) % 7);
+}
+
+// ================== 时间 <-> 秒数转换 ==================
 
 // 将 (年,月,日,时,分,秒) 转为自 2000-01-01 00:00:00 UTC 起的秒数
 static uint32_t DateTimeToSeconds(uint16_t year, uint8_t month, uint8_t day,
@@ -69,31 +91,12 @@ static uint32_t DateTimeToSeconds(uint16_t year, uint8_t month, uint8_t day,
     if (year < RTC_EPOCH_YEAR) year = RTC_EPOCH_YEAR;
     if (year > 2099) year = 2099;
 
-    // 计算从 2000-01-01 到 year-01-01 的总天数
-    uint32_t days = 0;
-    for (uint16_t y = RTC_EPOCH_YEAR; y < year; y++) {
-        days += 365 + ((y % 4 == 0 && (y % 100 != 0 || y % 400 == 0)) ? 1 : 0);
-    }
-
-    // 加上当年已过天数
-    static const uint8_t days_in_month[] = {31,28,31,30,31,30,31,31,30,31,30,31};
-    uint8_t dim = days_in_month[month - 1];
-    if (month == 2 && (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0))) {
-        dim = 29;
-    }
+    // 日期超出当月天数时截断到月末
+    uint8_t dim = MyRTC_DaysInMonth(year, month);
     if (day > dim) day = dim;
 
-    for (uint8_t m = 1; m < month; m++) {
-        uint8_t d = days_in_month[m - 1];
-        if (m == 2 && (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0))) {
-            d = 29;
-        }
-        days += d;
-    }
-    days += day - 1; // 1号算第0天
-
     // 总秒数
-    uint32_t total_sec = days * 86400UL
+    uint32_t total_sec = MyRTC_DaysFromDate(year, month, day) * 86400UL
                        + hours * 3600UL
                        + minutes * 60UL
                        + seconds;
@@ -111,32 +114,13 @@ static void SecondsToDateTime(uint32_t seconds,
     *minutes = (uint8_t)((secs_remain % 3600) / 60);
     *seconds_out = (uint8_t)(secs_remain % 60);
 
-    // 从 2000 开始逐年减
-    *year = RTC_EPOCH_YEAR;
-    while (1) {
-        uint32_t year_days = 365 + (((*year) % 4 == 0 && ((*year) % 100 != 0 || (*year) % 400 == 0)) ? 1 : 0);
-        if (days < year_days) break;
-        days -= year_days;
-        (*year)++;
-    }
-
-    // 逐月减
-    static const uint8_t days_in_month[] = {31,28,31,30,31,30,31,31,30,31,30,31};
-    *month = 1;
-    while (*month <= 12) {
-        uint8_t d = days_in_month[*month - 1];
-        if (*month == 2 && ((*year) % 4 == 0 && ((*year) % 100 != 0 || (*year) % 400 == 0))) {
-            d = 29;
-        }
-        if (days < d) break;
-        days -= d;
-        (*month)++;
-    }
-    *day = (uint8_t)(days + 1);
+    MyRTC_DateFromDays(days, year, month, day);
 }
 
 // ================== RTC 底层操作 ==================
 
+static void MyRTC_WriteDefault(void);
+
 #define LSE_TIMEOUT_S   5  // 5秒超时
 #define SYSCLK_FREQ_HZ  72000000
 uint8_t RTC_WaitForSynchro_Debug(void)
@@ -207,10 +191,10 @@ void MyRTC_Init(void)
         RTC_WaitForLastTask();
 
         printf("flag 2");
-        RTC_SetPrescaler(32767); // 32768 - 1 → 1Hz
+        RTC_SetPrescaler(MYRTC_PRL_LSE); // 32768 - 1 → 1Hz
         RTC_WaitForLastTask();
 
-        MyRTC_SetTime(); // 写入初始时间
+        MyRTC_WriteDefault(); // 写入初始时间
         BKP_WriteBackupRegister(BKP_DR1, 0xA5A6);
         printf("RTC init with LSE OK!\n");
         return;
@@ -232,10 +216,10 @@ void MyRTC_Init(void)
         // LSI 频率约 40kHz，需调整分频
         // 精确值需校准，此处按 38000Hz 估算：38000 - 1 = 37999
         // 实际可用 RTC_Adjust() 校准，此处简化：
-        RTC_SetPrescaler(37999); // ≈1Hz
+        RTC_SetPrescaler(MYRTC_PRL_LSI); // ≈1Hz
         RTC_WaitForLastTask();
 
-        MyRTC_SetTime();
+        MyRTC_WriteDefault();
         BKP_WriteBackupRegister(BKP_DR1, 0xA5A6); // 标志 LSI 模式
         printf("RTC init with LSI OK!\n");
 
@@ -262,65 +246,35 @@ void MyRTC_Init(void)
     printf("RTC init OK!\n");
 }
 
-// 写全局时间数组到 RTC（UTC 时间）
-void MyRTC_SetTime(void)
+// 本地时间写入 RTC 计数器（UTC 时间）
+static void MyRTC_WriteLocal(uint16_t year, uint8_t month, uint8_t day,
+                             uint8_t hour, uint8_t min, uint8_t sec)
 {
-    // MyRTC_Time 中是 **本地时间（东八区）**
-    // → 转为 UTC 再存入 RTC
-    uint16_t year  = MyRTC_Time[0];
-    uint8_t  month = MyRTC_Time[1];
-    uint8_t  day   = MyRTC_Time[2];
-    uint8_t  hour  = MyRTC_Time[3];
-    uint8_t  min   = MyRTC_Time[4];
-    uint8_t  sec   = MyRTC_Time[5];
-
-    // 减 8 小时转 UTC（注意跨天）
-    int32_t total_sec = (int32_t)DateTimeToSeconds(year, month, day, hour, min, sec);
-    total_sec -= 8 * 3600; // UTC = CST - 8h
-
-    if (total_sec < 0) {
-        // 极端情况：2000-01-01 00:00:00 之前，设为 2000-01-01 00:00:00 UTC
-        total_sec = 0;
-    }
+    // 按时区（含夏令时）转 UTC，早于 2000-01-01 00:00:00 UTC 时为0
+    uint32_t utc = RTC_TZ_LocalToUtc(DateTimeToSeconds(year, month, day, hour, min, sec));
 
-    RTC_SetCounter((uint32_t)total_sec);
-    RTC_WaitForLastTask();
+    // 经单调时间服务写入，毫秒时间戳不随修改时间跳变
+    RTC_Mono_Set_Counter(utc);
+
+    // 设置到切换表范围之外时重建
+    RTC_TZ_Rebase(utc);
 }
 
-// 从 RTC 读取（UTC 秒数）→ 更新 MyRTC_Time 和 RTC_data（转为本地时间）
-void MyRTC_ReadTime(void)
+static void MyRTC_WriteDefault(void)
 {
-    uint32_t rtc_sec_utc = RTC_GetCounter();
-
-    // 转为本地时间（UTC + 8h）
-    uint32_t local_sec = rtc_sec_utc + 8 * 3600;
-
-    uint16_t year; uint8_t mon, day, hour, min, sec;
-    SecondsToDateTime(local_sec, &year, &mon, &day, &hour, &min, &sec);
-
-    // 更新全局数组（本地时间）
-    MyRTC_Time[0] = year;
-    MyRTC_Time[1] = mon;
-    MyRTC_Time[2] = day;
-    MyRTC_Time[3] = hour;
-    MyRTC_Time[4] = min;
-    MyRTC_Time[5] = sec;
-
-    // 计算星期
-    uint8_t wday = ZellerWeekDay(year, mon, day); // 0=Sun ... 6=Sat
-    MyRTC_Time[6] = (wday == 0) ? 7 : wday;       // 1=Mon ... 7=Sun
-
-    // 更新结构体
-    RTC_data.year = year;
-    RTC_data.mon = mon;
-    RTC_data.day = day;
-    RTC_data.hours = hour;
-    RTC_data.minutes = min;
-    RTC_data.seconds = sec;
-    RTC_data.weekday = (wday <= 6) ? weekday_str[wday] : "Unknown";
+    MyRTC_WriteLocal(default_time[0], (uint8_t)default_time[1], (uint8_t)default_time[2],
+                     (uint8_t)default_time[3], (uint8_t)default_time[4], (uint8_t)default_time[5]);
+}
+
+// 读取本地时间秒数（自 2000-01-01 00:00:00 本地时间起）
+// 需要年月日时分秒时用 RTC_Clock_Get 取一致的快照
+uint32_t MyRTC_GetLocalSeconds(void)
+{
+    return RTC_TZ_UtcToLocal(RTC_GetCounter());
 }
 
 // 手动设置（输入为 **本地时间**）
+// 修改后调用 RTC_Clock_Sync 通知时钟服务和订阅者
 void RTC_SetDateTime_Manual(uint16_t year, uint8_t month, uint8_t day,
                             uint8_t hours, uint8_t minutes, uint8_t seconds)
 {
@@ -335,44 +289,24 @@ void RTC_SetDateTime_Manual(uint16_t year, uint8_t month, uint8_t day,
     if (minutes > 59) minutes = 59;
     if (seconds > 59) seconds = 59;
 
-    MyRTC_Time[0] = year;
-    MyRTC_Time[1] = month;
-    MyRTC_Time[2] = day;
-    MyRTC_Time[3] = hours;
-    MyRTC_Time[4] = minutes;
-    MyRTC_Time[5] = seconds;
-
-    MyRTC_SetTime(); // 自动转 UTC 存入 RTC
+    MyRTC_WriteLocal(year, month, day, hours, minutes, seconds); // 自动转 UTC 存入 RTC
 
     printf("RTC set to %04d-%02d-%02d %02d:%02d:%02d (Local)\n",
            year, month, day, hours, minutes, seconds);
 }
 void RTC_SetTime_Manual(uint8_t hours, uint8_t minutes, uint8_t seconds)
 {
-    if (hours > 23) hours = 23;
-    if (minutes > 59) minutes = 59;
-    if (seconds > 59) seconds = 59;
-
-    MyRTC_Time[3] = hours;
-    MyRTC_Time[4] = minutes;
-    MyRTC_Time[5] = seconds;
+    uint16_t year; uint8_t month, day, h, m, s;
 
-    MyRTC_SetTime(); 
+    // 日期取当前值
+    SecondsToDateTime(MyRTC_GetLocalSeconds(), &year, &month, &day, &h, &m, &s);
+    RTC_SetDateTime_Manual(year, month, day, hours, minutes, seconds);
 }
 void RTC_SetDate_Manual(uint16_t year, uint8_t month, uint8_t day)
 {
-    // 参数校验
-    if (year < 2000U) year = 2000U;
-    if (year > 2099U) year = 2099U;
-    if (month < 1) month = 1;
-    if (month > 12) month = 12;
-    if (day < 1) day = 1;
-    if (day > 31) day = 31;
-
-    
-    MyRTC_Time[0] = year;
-    MyRTC_Time[1] = month;
-    MyRTC_Time[2] = day;
+    uint16_t y; uint8_t mo, d, hours, minutes, seconds;
 
-    MyRTC_SetTime(); // 自动转 UTC 存入 RTC
+    // 时分秒取当前值
+    SecondsToDateTime(MyRTC_GetLocalSeconds(), &y, &mo, &d, &hours, &minutes, &seconds);
+    RTC_SetDateTime_Manual(year, month, day, hours, minutes, seconds);
 }
@@ -6,24 +6,20 @@
 #include "debug.h"
 #include "oled_print.h"
 #include "Delay.h"
-extern uint16_t MyRTC_Time[];
+#include "rtc_tz.h"                     // 本地时间 = RTC计数器(UTC) 按时区换算
+#include "rtc_mono.h"
 
-typedef struct
-{
-  uint32_t year;
-  uint8_t mon;
-  uint8_t day;
-  uint8_t hours;
-  uint8_t minutes;
-  uint8_t seconds;
-  const char* weekday; 
+#define MYRTC_PRL_LSE   32767                   // 32768Hz / (32767 + 1) = 1Hz
+#define MYRTC_PRL_LSI   37999                   // LSI 约40kHz，按38000Hz估算
 
-}myRTC_data;
 
-extern myRTC_data RTC_data;
 void MyRTC_Init(void);
-void MyRTC_SetTime(void);
-void MyRTC_ReadTime(void);
+uint32_t MyRTC_GetLocalSeconds(void);
+uint32_t MyRTC_DaysFromDate(uint16_t year, uint8_t month, uint8_t day);
+void MyRTC_DateFromDays(uint32_t days, uint16_t *year, uint8_t *month, uint8_t *day);
+uint8_t MyRTC_WeekdayFromDays(uint32_t days);
+uint8_t MyRTC_DaysInMonth(uint16_t year, uint8_t month);
+const char *MyRTC_WeekdayName(uint8_t weekday);
 void RTC_SetTime_Manual(uint8_t hours, uint8_t minutes, uint8_t seconds);
 void RTC_SetDate_Manual(uint16_t year, uint8_t month, uint8_t day);
 void RTC_SetDateTime_Manual(uint16_t year, uint8_t month, uint8_t day,
@@ -0,0 +1,96 @@
+/**
+ * @file rtc_mono.c
+ * @brief 单调毫秒时间戳实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "rtc_mono.h"
+#include "rtc_date.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+// ==================================
+// 全局变量定义
+// ==================================
+
+static uint32_t s_prl = 0;                  // 预分频值（PRL只写，按RTC时钟源推得）
+static volatile uint32_t s_adjust = 0;      // 单调秒 = 计数器 + s_adjust（修改时间时抵消跳变）
+
+// ==================================
+// 内部函数
+// ==================================
+
+/**
+ * @brief RTC时钟源对应的预分频值（与 MyRTC_Init 的设置一致）
+ */
+static uint32_t RTC_Mono_Prescaler(void)
+{
+    return ((RCC->BDCR & RCC_BDCR_RTCSEL) == RCC_BDCR_RTCSEL_LSI) ? MYRTC_PRL_LSI : MYRTC_PRL_LSE;
+}
+
+// ==================================
+// 对外接口
+// ==================================
+
+/**
+ * @brief 读取单调时间（任务和中断中均可调用）
+ * @param sec 单调秒数
+ * @param ms 秒内毫秒 0-999
+ * @note 计数器和DIV不能同时读：读计数器、DIV、再读计数器，
+ *       两次计数器相同（期间没有进位）且修正量没变才有效
+ */
+void RTC_Mono_Read(uint32_t *sec, uint16_t *ms)
+{
+    uint32_t cnt;
+    uint32_t div;
+    uint32_t adjust;
+
+    if (s_prl == 0) {
+        s_prl = RTC_Mono_Prescaler();
+    }
+
+    do {
+        adjust = s_adjust;
+        cnt = RTC_GetCounter();
+        div = RTC_GetDivider();
+    } while (cnt != RTC_GetCounter() || adjust != s_adjust);
+
+    if (div > s_prl) {
+        div = s_prl;
+    }
+
+    *sec = cnt + adjust;
+    *ms = (uint16_t)((s_prl - div) * 1000 / (s_prl + 1));
+}
+
+/**
+ * @brief 单调毫秒时间戳
+ */
+uint32_t RTC_Mono_Ms(void)
+{
+    uint32_t sec;
+    uint16_t ms;
+
+    RTC_Mono_Read(&sec, &ms);
+    return sec * 1000 + ms;
+}
+
+/**
+ * @brief 写RTC计数器（修改系统时间），单调时间不受影响
+ * @param counter 新的计数器值（UTC）
+ * @note 写入到生效约需3个RTC时钟周期，期间关中断，避免读者看到新计数器配旧修正量
+ */
+void RTC_Mono_Set_Counter(uint32_t counter)
+{
+    uint32_t old;
+
+    RTC_WaitForLastTask();
+    taskENTER_CRITICAL();
+    old = RTC_GetCounter();
+    RTC_SetCounter(counter);
+    RTC_WaitForLastTask();
+    s_adjust += old - counter;
+    taskEXIT_CRITICAL();
+}
@@ -0,0 +1,27 @@
+/**
+ * @file rtc_mono.h
+ * @brief 单调毫秒时间戳：RTC计数器 + RTC_DIV 预分频余数
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note RTC_DIV 从预分频值 PRL 递减到0后重装并使计数器+1，
+ *       (PRL - DIV) / (PRL + 1) 就是当前这一秒过去的比例，LSE 下分辨率约30us。
+ *       RTC 在调度器挂起、关中断、停机模式下都继续走，不像系统节拍会停。
+ *       修改系统时间通过 RTC_Mono_Set_Counter 写计数器，时间戳保持连续，不随之跳变。
+ *       毫秒值为32位，约49.7天回绕，与 xTaskGetTickCount 一样用差值比较
+ */
+
+#ifndef __RTC_MONO_H
+#define __RTC_MONO_H
+
+#include "stm32f10x.h"
+
+// ==================================
+// 函数声明
+// ==================================
+
+uint32_t RTC_Mono_Ms(void);
+void RTC_Mono_Read(uint32_t *sec, uint16_t *ms);
+void RTC_Mono_Set_Counter(uint32_t counter);
+
+#endif // __RTC_MONO_H
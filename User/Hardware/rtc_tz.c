@@ -0,0 +1,344 @@
+/**
+ * @file rtc_tz.c
+ * @brief 时区与夏令时实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "rtc_tz.h"
+#include "rtc_date.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+// ==================================
+// 数据结构
+// ==================================
+
+// 区间：自 utc 起到下一区间起点之前，本地时间 = UTC + offset
+typedef struct {
+    uint32_t utc;
+    int32_t offset;
+} rtc_tz_span_t;
+
+typedef struct {
+    rtc_tz_span_t span[RTC_TZ_YEARS * 2 + 2];   // 首年元旦 + 每年两次切换 + 结束哨兵
+    uint8_t count;                              // 区间数（不含哨兵）
+    volatile uint8_t hint;                      // 上次命中的区间
+} rtc_tz_table_t;
+
+// ==================================
+// 预置时区
+// ==================================
+
+static const rtc_tz_rule_t s_zones[RTC_TZ_ZONE_COUNT] = {
+    [RTC_TZ_ZONE_UTC]        = { "UTC",   0,         0,    {0},                          {0}                           },
+    [RTC_TZ_ZONE_CST]        = { "CST",   8 * 3600,  0,    {0},                          {0}                           },
+    [RTC_TZ_ZONE_JST]        = { "JST",   9 * 3600,  0,    {0},                          {0}                           },
+    [RTC_TZ_ZONE_UK]         = { "UK",    0,         3600, { 3, RTC_TZ_WEEK_LAST, 0, 1}, {10, RTC_TZ_WEEK_LAST, 0, 2}  },
+    [RTC_TZ_ZONE_CET]        = { "CET",   1 * 3600,  3600, { 3, RTC_TZ_WEEK_LAST, 0, 2}, {10, RTC_TZ_WEEK_LAST, 0, 3}  },
+    [RTC_TZ_ZONE_US_EASTERN] = { "US-E", -5 * 3600,  3600, { 3, 2, 0, 2},                {11, 1, 0, 2}                 },
+    [RTC_TZ_ZONE_US_PACIFIC] = { "US-P", -8 * 3600,  3600, { 3, 2, 0, 2},                {11, 1, 0, 2}                 },
+    [RTC_TZ_ZONE_AU_EASTERN] = { "AU-E", 10 * 3600,  3600, {10, 1, 0, 2},                { 4, 1, 0, 3}                 },
+};
+
+// ==================================
+// 全局变量定义
+// ==================================
+
+static rtc_tz_rule_t s_custom[2];             // 自定义规则也双缓冲，改写不在用的一份
+static const rtc_tz_rule_t *volatile s_rule = &s_zones[RTC_TZ_DEFAULT_ZONE];
+
+// 双缓冲：重建写另一张表，建好后切换指针，中断中的读者不会读到半张表
+static rtc_tz_table_t s_tables[2];
+static rtc_tz_table_t *volatile s_active = NULL;
+
+// ==================================
+// 规则计算
+// ==================================
+
+/**
+ * @brief 某年切换规则对应的日期
+ * @return 自2000-01-01起的天数
+ */
+static uint32_t RTC_TZ_Switch_Day(uint16_t year, const rtc_tz_switch_t *sw)
+{
+    uint32_t first = MyRTC_DaysFromDate(year, sw->month, 1);
+    uint32_t last = first + MyRTC_DaysInMonth(year, sw->month) - 1;
+    uint32_t day;
+
+    day = first + (sw->weekday + 7 - MyRTC_WeekdayFromDays(first)) % 7 + (sw->week - 1) * 7;
+    while (day > last) {
+        day -= 7;
+    }
+    return day;
+}
+
+/**
+ * @brief 某年切换时刻（UTC）
+ * @param offset 切换前生效的偏移
+ */
+static uint32_t RTC_TZ_Switch_Utc(uint16_t year, const rtc_tz_switch_t *sw, int32_t offset)
+{
+    return RTC_TZ_Switch_Day(year, sw) * 86400UL + sw->hour * 3600UL - offset;
+}
+
+/**
+ * @brief UTC时刻所在的年份（按标准时间）
+ */
+static uint16_t RTC_TZ_Year(const rtc_tz_rule_t *rule, uint32_t utc)
+{
+    uint32_t local = utc + rule->std_offset_s;
+    uint16_t year;
+    uint8_t month, day;
+
+    if (rule->std_offset_s < 0 && utc < (uint32_t)-rule->std_offset_s) {
+        local = 0;
+    }
+    MyRTC_DateFromDays(local / 86400, &year, &month, &day);
+    return year;
+}
+
+/**
+ * @brief 直接按规则计算偏移（建表和表外时刻使用）
+ */
+static int32_t RTC_TZ_Rule_Offset(const rtc_tz_rule_t *rule, uint32_t utc)
+{
+    uint16_t year;
+    uint32_t start;
+    uint32_t end;
+    uint8_t in_dst;
+
+    if (rule->dst_save_s == 0) {
+        return rule->std_offset_s;
+    }
+
+    year = RTC_TZ_Year(rule, utc);
+    start = RTC_TZ_Switch_Utc(year, &rule->dst_start, rule->std_offset_s);
+    end = RTC_TZ_Switch_Utc(year, &rule->dst_end, rule->std_offset_s + rule->dst_save_s);
+
+    if (start < end) {
+        in_dst = (utc >= start && utc < end);       // 北半球：年中为夏令时
+    } else {
+        in_dst = (utc >= start || utc < end);       // 南半球：跨年
+    }
+    return rule->std_offset_s + (in_dst ? rule->dst_save_s : 0);
+}
+
+// ==================================
+// 切换表
+// ==================================
+
+/**
+ * @brief 从 utc 所在年份的元旦起，生成 RTC_TZ_YEARS 年的区间表
+ */
+static void RTC_TZ_Build(rtc_tz_table_t *tab, const rtc_tz_rule_t *rule, uint32_t utc)
+{
+    uint16_t year = RTC_TZ_Year(rule, utc);
+    int32_t std = rule->std_offset_s;
+    int32_t dst = rule->std_offset_s + rule->dst_save_s;
+    int32_t first = (int32_t)(MyRTC_DaysFromDate(year, 1, 1) * 86400UL) - std;
+    uint32_t a;
+    uint32_t b;
+    uint8_t n = 0;
+    uint8_t i;
+
+    tab->span[n].utc = (first > 0) ? (uint32_t)first : 0;
+    tab->span[n].offset = RTC_TZ_Rule_Offset(rule, tab->span[n].utc);
+    n++;
+
+    if (rule->dst_save_s != 0) {
+        for (i = 0; i < RTC_TZ_YEARS; i++) {
+            a = RTC_TZ_Switch_Utc(year + i, &rule->dst_start, std);
+            b = RTC_TZ_Switch_Utc(year + i, &rule->dst_end, dst);
+            if (a < b) {
+                tab->span[n].utc = a;
+                tab->span[n++].offset = dst;
+                tab->span[n].utc = b;
+                tab->span[n++].offset = std;
+            } else {
+                tab->span[n].utc = b;
+                tab->span[n++].offset = std;
+                tab->span[n].utc = a;
+                tab->span[n++].offset = dst;
+            }
+        }
+    }
+
+    // 哨兵：表的结束时刻
+    tab->span[n].utc = MyRTC_DaysFromDate(year + RTC_TZ_YEARS, 1, 1) * 86400UL - std;
+    tab->span[n].offset = std;
+    tab->count = n;
+    tab->hint = 0;
+}
+
+/**
+ * @brief 按当前规则重建切换表并切换为生效表
+ */
+static void RTC_TZ_Rebuild(uint32_t utc)
+{
+    rtc_tz_table_t *tab;
+
+    vTaskSuspendAll();
+    tab = (s_active == &s_tables[0]) ? &s_tables[1] : &s_tables[0];
+    RTC_TZ_Build(tab, s_rule, utc);
+    __DMB();
+    s_active = tab;
+    xTaskResumeAll();
+}
+
+// ==================================
+// 对外接口
+// ==================================
+
+/**
+ * @brief 初始化（MyRTC_Init之后调用）：按出厂时区和当前时间生成切换表
+ */
+void RTC_TZ_Init(void)
+{
+    RTC_TZ_Rebuild(RTC_GetCounter());
+    printf("RTC tz: %s, std offset %+ld min, %d spans\r\n",
+           s_rule->name, (long)(s_rule->std_offset_s / 60), s_active->count);
+}
+
+/**
+ * @brief 切换到预置时区
+ * @return 0成功，-1时区无效
+ * @note 本地时间随之跳变，调用方随后调用 RTC_Clock_Sync
+ */
+int RTC_TZ_Select(rtc_tz_zone_t zone)
+{
+    if (zone >= RTC_TZ_ZONE_COUNT) {
+        return -1;
+    }
+
+    s_rule = &s_zones[zone];
+    RTC_TZ_Rebuild(RTC_GetCounter());
+    return 0;
+}
+
+/**
+ * @brief 使用自定义规则（规则被拷贝保存）
+ * @return 0成功，-1规则无效
+ * @note 本地时间随之跳变，调用方随后调用 RTC_Clock_Sync
+ */
+int RTC_TZ_Set_Rule(const rtc_tz_rule_t *rule)
+{
+    rtc_tz_rule_t *custom;
+
+    if (rule == NULL || rule->std_offset_s < -12 * 3600 || rule->std_offset_s > 14 * 3600) {
+        return -1;
+    }
+    if (rule->dst_save_s != 0 &&
+        (rule->dst_start.month < 1 || rule->dst_start.month > 12 ||
+         rule->dst_end.month < 1 || rule->dst_end.month > 12 ||
+         rule->dst_start.week < 1 || rule->dst_start.week > RTC_TZ_WEEK_LAST ||
+         rule->dst_end.week < 1 || rule->dst_end.week > RTC_TZ_WEEK_LAST ||
+         rule->dst_start.weekday > 6 || rule->dst_end.weekday > 6 ||
+         rule->dst_start.hour > 23 || rule->dst_end.hour > 23)) {
+        return -1;
+    }
+
+    custom = (s_rule == &s_custom[0]) ? &s_custom[1] : &s_custom[0];
+    *custom = *rule;
+    __DMB();
+    s_rule = custom;
+    RTC_TZ_Rebuild(RTC_GetCounter());
+    return 0;
+}
+
+/**
+ * @brief 当前时区规则
+ */
+const rtc_tz_rule_t *RTC_TZ_Get_Rule(void)
+{
+    return s_rule;
+}
+
+/**
+ * @brief 时间被设置到表外时重建切换表（设置时间后调用）
+ * @param utc 新的RTC计数器值
+ */
+void RTC_TZ_Rebase(uint32_t utc)
+{
+    rtc_tz_table_t *tab = s_active;
+
+    if (tab != NULL && utc >= tab->span[0].utc && utc < tab->span[tab->count].utc) {
+        return;
+    }
+    RTC_TZ_Rebuild(utc);
+}
+
+/**
+ * @brief UTC时刻的偏移（任务和中断中均可调用）
+ * @note 先看上次命中的区间，一次比较即可返回；换区间时二分查表；表外按规则计算
+ */
+int32_t RTC_TZ_Offset(uint32_t utc)
+{
+    rtc_tz_table_t *tab = s_active;
+    const rtc_tz_span_t *sp;
+    uint8_t lo;
+    uint8_t hi;
+    uint8_t mid;
+
+    if (tab != NULL) {
+        sp = &tab->span[tab->hint];
+        if (utc - sp[0].utc < sp[1].utc - sp[0].utc) {
+            return sp[0].offset;
+        }
+
+        if (utc >= tab->span[0].utc && utc < tab->span[tab->count].utc) {
+            lo = 0;
+            hi = tab->count;
+            while (hi - lo > 1) {
+                mid = (lo + hi) / 2;
+                if (tab->span[mid].utc <= utc) {
+                    lo = mid;
+                } else {
+                    hi = mid;
+                }
+            }
+            tab->hint = lo;
+            return tab->span[lo].offset;
+        }
+    }
+
+    return RTC_TZ_Rule_Offset(s_rule, utc);
+}
+
+/**
+ * @brief RTC计数器(UTC) → 本地时间秒数
+ */
+uint32_t RTC_TZ_UtcToLocal(uint32_t utc)
+{
+    int32_t offset = RTC_TZ_Offset(utc);
+
+    if (offset < 0 && utc < (uint32_t)-offset) {
+        return 0;
+    }
+    return utc + offset;
+}
+
+/**
+ * @brief 本地时间秒数 → RTC计数器(UTC)
+ * @note 春季跳过的一小时内的时刻按切换前的偏移换算（相当于顺延一小时）；
+ *       秋季重复的一小时取第二次（标准时间）；早于 2000-01-01 00:00:00 UTC 时返回0
+ */
+uint32_t RTC_TZ_LocalToUtc(uint32_t local)
+{
+    int32_t std = s_rule->std_offset_s;
+    int32_t offset;
+    int32_t check;
+
+    // 先按标准时间估计UTC，再用该时刻的实际偏移修正一次
+    offset = RTC_TZ_Offset(local - std);
+    check = RTC_TZ_Offset(local - offset);
+    if (check != offset) {
+        offset = check;
+    }
+
+    if (offset > 0 && local < (uint32_t)offset) {
+        return 0;
+    }
+    return local - offset;
+}
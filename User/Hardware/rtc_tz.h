@@ -0,0 +1,76 @@
+/**
+ * @file rtc_tz.h
+ * @brief 时区与夏令时：RTC计数器(UTC) <-> 本地时间
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 时区由规则描述（标准时间偏移 + 夏令时起止规则"某月第n个星期几几点"）。
+ *       RTC_TZ_Init / RTC_TZ_Select 时把当年起 RTC_TZ_YEARS 年的切换时刻预先算成表，
+ *       UTC转本地时间只需比较当前所在区间并加偏移，跨区间时二分查表，不在读时间时计算规则。
+ *       表外的时刻（设置了很远的日期）直接按规则计算，结果相同，只是慢一些。
+ *       本地时间秒数同样自 2000-01-01 00:00:00 起，夏令时切换时本地时间跳变一小时，
+ *       日历时钟会按时间修改处理（重新分解并发出 RTC_CLOCK_EVT_SYNC）
+ */
+
+#ifndef __RTC_TZ_H
+#define __RTC_TZ_H
+
+#include "stm32f10x.h"
+
+// ==================================
+// 宏定义
+// ==================================
+
+#define RTC_TZ_YEARS            10              // 预计算的年数
+#define RTC_TZ_DEFAULT_ZONE     RTC_TZ_ZONE_CST // 出厂时区，按销售地区修改
+
+#define RTC_TZ_WEEK_LAST        5               // 规则中的"最后一个星期几"
+
+// ==================================
+// 数据结构
+// ==================================
+
+// 预置时区
+typedef enum {
+    RTC_TZ_ZONE_UTC = 0,        // UTC
+    RTC_TZ_ZONE_CST,            // 中国 UTC+8
+    RTC_TZ_ZONE_JST,            // 日本 UTC+9
+    RTC_TZ_ZONE_UK,             // 英国 GMT/BST
+    RTC_TZ_ZONE_CET,            // 中欧 CET/CEST
+    RTC_TZ_ZONE_US_EASTERN,     // 美东 EST/EDT
+    RTC_TZ_ZONE_US_PACIFIC,     // 美西 PST/PDT
+    RTC_TZ_ZONE_AU_EASTERN,     // 澳东 AEST/AEDT（南半球，跨年）
+    RTC_TZ_ZONE_COUNT
+} rtc_tz_zone_t;
+
+// 切换规则：month 月第 week 个（RTC_TZ_WEEK_LAST 为最后一个）星期 weekday 的 hour 点
+typedef struct {
+    uint8_t month;              // 1-12
+    uint8_t week;               // 1-4，或 RTC_TZ_WEEK_LAST
+    uint8_t weekday;            // 0=Sun ... 6=Sat
+    uint8_t hour;               // 切换前生效的本地时间
+} rtc_tz_switch_t;
+
+typedef struct {
+    const char *name;
+    int32_t std_offset_s;       // 标准时间 = UTC + std_offset_s（东为正）
+    int32_t dst_save_s;         // 夏令时额外偏移，0 表示不实行夏令时
+    rtc_tz_switch_t dst_start;  // 进入夏令时（hour 为标准时间）
+    rtc_tz_switch_t dst_end;    // 退出夏令时（hour 为夏令时间）
+} rtc_tz_rule_t;
+
+// ==================================
+// 函数声明
+// ==================================
+
+void RTC_TZ_Init(void);
+int RTC_TZ_Select(rtc_tz_zone_t zone);
+int RTC_TZ_Set_Rule(const rtc_tz_rule_t *rule);
+const rtc_tz_rule_t *RTC_TZ_Get_Rule(void);
+void RTC_TZ_Rebase(uint32_t utc);
+
+uint32_t RTC_TZ_UtcToLocal(uint32_t utc);
+uint32_t RTC_TZ_LocalToUtc(uint32_t local);
+int32_t RTC_TZ_Offset(uint32_t utc);
+
+#endif // __RTC_TZ_H
@@ -0,0 +1,38 @@
+/**
+ * @file cycle_counter.h
+ * @brief DWT周期计数器（用于算法耗时测量）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note CMSIS 1.30 未定义DWT结构体，这里直接访问寄存器；
+ *       72MHz 下 CYCCNT 约59秒回绕一次，只适合测量短代码段
+ */
+
+#ifndef __CYCLE_COUNTER_H
+#define __CYCLE_COUNTER_H
+
+#include "stm32f10x.h"
+
+#define DWT_CTRL_REG        (*(volatile uint32_t *)0xE0001000UL)
+#define DWT_CYCCNT_REG      (*(volatile uint32_t *)0xE0001004UL)
+#define DWT_CTRL_CYCCNTENA  (1UL << 0)
+
+/**
+ * @brief 使能周期计数器（可重复调用）
+ */
+static __INLINE void cycle_counter_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT_CTRL_REG |= DWT_CTRL_CYCCNTENA;
+}
+
+/**
+ * @brief 读取当前周期数
+ * @return CYCCNT
+ */
+static __INLINE uint32_t cycle_counter_get(void)
+{
+    return DWT_CYCCNT_REG;
+}
+
+#endif
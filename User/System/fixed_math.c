@@ -0,0 +1,79 @@
+#include "fixed_math.h"
+
+/**
+ * @brief 32位整数平方根（逐位法，结果向下取整）
+ * @param x 被开方数
+ * @return floor(sqrt(x))
+ */
+uint16_t fx_isqrt32(uint32_t x)
+{
+    uint32_t res = 0;
+    uint32_t bit = 1UL << 30;
+
+    // 找到不大于x的最高4的幂
+    while (bit > x) {
+        bit >>= 2;
+    }
+
+    while (bit != 0) {
+        if (x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint16_t)res;
+}
+
+/**
+ * @brief 第一象限atan近似：atan(z) ≈ π/4·z + 0.273·z·(1-z)
+ * @param z 比值，Q15格式，范围 0 ~ 32768
+ * @return 角度，单位0.01°，范围 0 ~ 4500
+ */
+static int32_t fx_atan_unit_cdeg(uint32_t z)
+{
+    return (int32_t)((z * (4500 + ((1564 * (32768 - z)) >> 15))) >> 15);
+}
+
+/**
+ * @brief 定点atan2
+ * @param y 纵坐标
+ * @param x 横坐标
+ * @return 角度，单位0.01°，范围 -18000 ~ 18000，最大误差约0.25°
+ */
+int16_t fx_atan2_cdeg(int32_t y, int32_t x)
+{
+    uint32_t abs_x = (x < 0) ? (uint32_t)(-x) : (uint32_t)x;
+    uint32_t abs_y = (y < 0) ? (uint32_t)(-y) : (uint32_t)y;
+    int32_t angle;
+
+    if (abs_x == 0 && abs_y == 0) {
+        return 0;
+    }
+
+    // 缩放到16位以内，保证左移15位不溢出
+    while (abs_x > 0xFFFF || abs_y > 0xFFFF) {
+        abs_x >>= 1;
+        abs_y >>= 1;
+    }
+
+    // 折叠到0~45°区间
+    if (abs_x >= abs_y) {
+        angle = fx_atan_unit_cdeg((abs_y << 15) / abs_x);
+    } else {
+        angle = 9000 - fx_atan_unit_cdeg((abs_x << 15) / abs_y);
+    }
+
+    // 还原象限
+    if (x < 0) {
+        angle = 18000 - angle;
+    }
+    if (y < 0) {
+        angle = -angle;
+    }
+
+    return (int16_t)angle;
+}
@@ -0,0 +1,33 @@
+/**
+ * @file fixed_math.h
+ * @brief 定点数学工具（整数平方根、atan2）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note Cortex-M3无FPU，传感器相关计算统一走整数路径
+ */
+
+#ifndef __FIXED_MATH_H
+#define __FIXED_MATH_H
+
+#include <stdint.h>
+
+// Q14 定点：16384 表示 1.0（±2g量程下加速度原始值恰好为Q14的g值）
+#define FX_Q14_ONE      16384
+
+/**
+ * @brief 32位整数平方根（逐位法，结果向下取整）
+ * @param x 被开方数
+ * @return floor(sqrt(x))
+ */
+uint16_t fx_isqrt32(uint32_t x);
+
+/**
+ * @brief 定点atan2
+ * @param y 纵坐标
+ * @param x 横坐标
+ * @return 角度，单位0.01°，范围 -18000 ~ 18000，最大误差约0.25°
+ */
+int16_t fx_atan2_cdeg(int32_t y, int32_t x);
+
+#endif
@@ -0,0 +1,176 @@
+/**
+ * @file mem_pool.c
+ * @brief 固定块内存池实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "mem_pool.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+#include <string.h>
+
+// ==================================
+// 调试标记
+// ==================================
+
+#if MEM_POOL_DEBUG
+#define MEM_POOL_MAGIC_USED     0xA110C8EDUL    // 块头：已分配
+#define MEM_POOL_MAGIC_FREE     0xF4EEB10CUL    // 块头：空闲
+#define MEM_POOL_FILL           0xDD            // 空闲块填充（链表指针之后）
+#endif
+
+// ==================================
+// 内部函数
+// ==================================
+
+#if MEM_POOL_DEBUG
+/**
+ * @brief 块头指针（用户指针前4字节）
+ */
+static uint32_t *mem_pool_header(void *ptr)
+{
+    return (uint32_t *)((uint8_t *)ptr - MEM_POOL_HEADER_SIZE);
+}
+
+/**
+ * @brief 检查空闲块填充是否完整，被改动说明释放后仍有写入
+ */
+static void mem_pool_check_fill(const mem_pool_t *pool, const uint8_t *ptr)
+{
+    for (uint16_t i = sizeof(void *); i < pool->block_size; i++) {
+        if (ptr[i] != MEM_POOL_FILL) {
+            printf("mem_pool %s: block %p written after free (offset %u)\r\n",
+                   pool->name, (const void *)ptr, i);
+            return;
+        }
+    }
+}
+#endif
+
+// ==================================
+// 对外接口
+// ==================================
+
+int mem_pool_init(mem_pool_t *pool, const char *name, uint32_t *buf,
+                  uint16_t block_size, uint16_t block_count)
+{
+    uint8_t *block;
+
+    if (pool == NULL || buf == NULL || block_size < sizeof(void *) || block_count == 0) {
+        return -1;
+    }
+
+    pool->name = name;
+    pool->buf = (uint8_t *)buf;
+    pool->block_size = (uint16_t)((block_size + 3) & ~3);
+    pool->stride = (uint16_t)MEM_POOL_BLOCK_BYTES(block_size);
+    pool->block_count = block_count;
+    pool->used = 0;
+    pool->peak = 0;
+    pool->fails = 0;
+    pool->free_list = NULL;
+
+    // 倒序插入，分配时从低地址开始
+    for (uint16_t i = block_count; i > 0; i--) {
+        block = pool->buf + (uint32_t)(i - 1) * pool->stride + MEM_POOL_HEADER_SIZE;
+#if MEM_POOL_DEBUG
+        *mem_pool_header(block) = MEM_POOL_MAGIC_FREE;
+        memset(block, MEM_POOL_FILL, pool->block_size);
+#endif
+        *(void **)block = pool->free_list;
+        pool->free_list = block;
+    }
+
+    return 0;
+}
+
+void *mem_pool_alloc(mem_pool_t *pool)
+{
+    void *block;
+
+    taskENTER_CRITICAL();
+    block = pool->free_list;
+    if (block == NULL) {
+        pool->fails++;
+        taskEXIT_CRITICAL();
+        printf("mem_pool %s: exhausted (%u blocks)\r\n", pool->name, pool->block_count);
+        return NULL;
+    }
+    pool->free_list = *(void **)block;
+    pool->used++;
+    if (pool->used > pool->peak) {
+        pool->peak = pool->used;
+    }
+#if MEM_POOL_DEBUG
+    *mem_pool_header(block) = MEM_POOL_MAGIC_USED;
+#endif
+    taskEXIT_CRITICAL();
+
+#if MEM_POOL_DEBUG
+    mem_pool_check_fill(pool, (const uint8_t *)block);
+#endif
+
+    return block;
+}
+
+int mem_pool_free(mem_pool_t *pool, void *ptr)
+{
+    uint32_t offset;
+    int ret = 0;
+
+    if (!mem_pool_owns(pool, ptr)) {
+        printf("mem_pool %s: free of foreign pointer %p\r\n", pool->name, ptr);
+        return -1;
+    }
+    offset = (uint32_t)((uint8_t *)ptr - pool->buf) - MEM_POOL_HEADER_SIZE;
+    if (offset % pool->stride != 0) {
+        printf("mem_pool %s: free of misaligned pointer %p\r\n", pool->name, ptr);
+        return -1;
+    }
+
+    // 检查和链入在同一个临界区内：两个任务同时释放同一块时只有先进入的成功
+    taskENTER_CRITICAL();
+    if (pool->used == 0) {
+        ret = -2;                       // 非调试模式下只能检出“已全部空闲还在释放”这一种重复释放
+    }
+#if MEM_POOL_DEBUG
+    else if (*mem_pool_header(ptr) != MEM_POOL_MAGIC_USED) {
+        ret = -2;
+    }
+#endif
+    else {
+#if MEM_POOL_DEBUG
+        // 填充后释放后写入可在下次分配时检出，读出的也是明显的 0xDD
+        memset(ptr, MEM_POOL_FILL, pool->block_size);
+        *mem_pool_header(ptr) = MEM_POOL_MAGIC_FREE;
+#endif
+        *(void **)ptr = pool->free_list;
+        pool->free_list = ptr;
+        pool->used--;
+    }
+    taskEXIT_CRITICAL();
+
+    if (ret != 0) {
+        printf("mem_pool %s: double free of %p\r\n", pool->name, ptr);
+    }
+
+    return ret;
+}
+
+int mem_pool_owns(const mem_pool_t *pool, const void *ptr)
+{
+    const uint8_t *p = (const uint8_t *)ptr;
+
+    return (p >= pool->buf + MEM_POOL_HEADER_SIZE &&
+            p < pool->buf + (uint32_t)pool->block_count * pool->stride) ? 1 : 0;
+}
+
+void mem_pool_print(const mem_pool_t *pool)
+{
+    printf("mem_pool %s: %u B x %u, used %u, peak %u, fails %u\r\n",
+           pool->name, pool->block_size, pool->block_count,
+           pool->used, pool->peak, pool->fails);
+}
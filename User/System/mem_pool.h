@@ -0,0 +1,101 @@
+/**
+ * @file mem_pool.h
+ * @brief 固定块内存池：O(1) 分配/释放，带用量和峰值统计
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 空闲块用块内第一个字串成单链表，分配取表头、释放插表头，不遍历、不产生碎片。
+ *       块存储区由调用者用 MEM_POOL_BUF_WORDS 静态定义。
+ *       MEM_POOL_DEBUG 为1时每块多4字节块头：重复释放、释放非本池指针、
+ *       释放后写入（空闲块的填充字节被改动）在下一次释放/分配时打印出来
+ */
+
+#ifndef __MEM_POOL_H
+#define __MEM_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ==================================
+// 配置
+// ==================================
+
+#ifndef MEM_POOL_DEBUG
+#define MEM_POOL_DEBUG      0           // 1-块头校验 + 空闲块填充检查
+#endif
+
+// ==================================
+// 块大小计算
+// ==================================
+
+#if MEM_POOL_DEBUG
+#define MEM_POOL_HEADER_SIZE    4       // 块头：分配/空闲标记
+#else
+#define MEM_POOL_HEADER_SIZE    0
+#endif
+
+// 块实际占用字节（4字节对齐，含调试块头）
+#define MEM_POOL_BLOCK_BYTES(size)      ((((size) + 3) & ~3) + MEM_POOL_HEADER_SIZE)
+
+// 存储区字数，用法：static uint32_t s_buf[MEM_POOL_BUF_WORDS(48, 2)];
+#define MEM_POOL_BUF_WORDS(size, count) (MEM_POOL_BLOCK_BYTES(size) / 4 * (count))
+
+// ==================================
+// 内存池结构体
+// ==================================
+
+typedef struct {
+    const char *name;           // 名称（打印用）
+    uint8_t *buf;               // 块存储区
+    void *free_list;            // 空闲链表表头
+    uint16_t block_size;        // 用户可用字节
+    uint16_t stride;            // 块实际占用字节
+    uint16_t block_count;       // 块数
+    uint16_t used;              // 已分配块数
+    uint16_t peak;              // 已分配块数峰值
+    uint16_t fails;             // 池满导致的分配失败次数
+} mem_pool_t;
+
+// ==================================
+// 函数声明
+// ==================================
+
+/**
+ * @brief 初始化内存池，把所有块串进空闲链表
+ * @param pool 内存池
+ * @param name 名称
+ * @param buf 存储区，至少 MEM_POOL_BUF_WORDS(block_size, block_count) 个字
+ * @param block_size 每块可用字节
+ * @param block_count 块数
+ * @return 0-成功，-1-参数错误
+ */
+int mem_pool_init(mem_pool_t *pool, const char *name, uint32_t *buf,
+                  uint16_t block_size, uint16_t block_count);
+
+/**
+ * @brief 分配一块
+ * @param pool 内存池
+ * @return 块指针（4字节对齐），NULL-池满
+ */
+void *mem_pool_alloc(mem_pool_t *pool);
+
+/**
+ * @brief 释放一块
+ * @param pool 内存池
+ * @param ptr mem_pool_alloc 返回的指针
+ * @return 0-成功，-1-不是本池的块，-2-重复释放（非调试模式只在池已全空时检出）
+ */
+int mem_pool_free(mem_pool_t *pool, void *ptr);
+
+/**
+ * @brief 指针是否落在本池存储区内
+ * @return 1-是，0-否
+ */
+int mem_pool_owns(const mem_pool_t *pool, const void *ptr);
+
+/**
+ * @brief 打印用量统计
+ */
+void mem_pool_print(const mem_pool_t *pool);
+
+#endif // __MEM_POOL_H
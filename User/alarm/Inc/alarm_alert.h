@@ -16,13 +16,16 @@
 #include "unified_menu.h"
 #include "alarm_core.h"
 
+// 提醒页重绘间隔（毫秒），蜂鸣500ms、闪烁1s都以此为粒度
+#define ALARM_ALERT_REFRESH_MS 100
+
 // ==================================
 // 闹钟提醒状态结构体
 // ==================================
 
 typedef struct {
     uint8_t active;                 // 是否激活
-    uint8_t triggered_alarm_index;  // 触发的闹钟索引
+    alarm_id_t triggered_alarm_id;  // 触发的闹钟ID
     uint8_t need_refresh;           // 需要刷新标志
     TickType_t start_time;          // 开始时间
     TickType_t last_beep_time;      // 上次蜂鸣器时间
@@ -35,30 +38,26 @@ typedef struct {
 // 函数声明
 // ==================================
 
-/**
- * @brief 初始化闹钟提醒页面
- * @return 创建的菜单项指针
- */
-menu_item_t *alarm_alert_init(void);
+extern const menu_item_t g_alarm_alert_page;       // 页面节点（常量）
 
 /**
  * @brief 闹钟提醒页面进入回调
  * @param item 菜单项
  */
-void alarm_alert_on_enter(menu_item_t *item);
+void alarm_alert_on_enter(const menu_item_t *item);
 
 /**
  * @brief 闹钟提醒页面退出回调
  * @param item 菜单项
  */
-void alarm_alert_on_exit(menu_item_t *item);
+void alarm_alert_on_exit(const menu_item_t *item);
 
 /**
  * @brief 闹钟提醒页面按键处理
  * @param item 菜单项
  * @param key_event 按键事件
  */
-void alarm_alert_key_handler(menu_item_t *item, uint8_t key_event);
+void alarm_alert_key_handler(const menu_item_t *item, uint8_t key_event);
 
 /**
  * @brief 闹钟提醒页面绘制函数
@@ -68,9 +67,9 @@ void alarm_alert_draw_function(void *context);
 
 /**
  * @brief 触发闹钟提醒
- * @param alarm_index 闹钟索引
+ * @param id 闹钟ID
  * @return 0-成功，其他-失败
  */
-int8_t alarm_alert_trigger(uint8_t alarm_index);
+int8_t alarm_alert_trigger(alarm_id_t id);
 
 #endif // __ALARM_ALERT_H
@@ -2,8 +2,13 @@
  * @file alarm_core.h
  * @brief 闹钟核心数据结构和管理函数头文件
  * @author flowkite-0689
- * @version v1.0
- * @date 2025.12.08
+ * @version v1.2
+ * @date 2026.10.19
+ * @note 闹钟存放在固定槽位中，通过稳定ID访问（低位为槽位号，高位为分配代数），
+ *       增删改不会移动其他闹钟，页面保存的ID在闹钟被删除前一直有效。
+ *       两个索引：
+ *       - 小根堆：按下一次触发时刻排序，只含启用的闹钟，到期检查只看堆顶 O(1)，增删改 O(log n)
+ *       - 显示顺序：按时分秒排序的槽位数组（列表页面用），插入/删除移动至多 MAX_ALARMS 字节
  */
 
 #ifndef __ALARM_CORE_H
@@ -19,47 +24,67 @@
 // 宏定义
 // ==================================
 
-#define MAX_ALARMS 16           // 最大闹钟数量
-#define ALARM_ID_LEN 8          // 闹钟ID长度
+#define ALARM_SLOT_BITS 6       // 槽位号位数
+#define MAX_ALARMS (1 << ALARM_SLOT_BITS) // 最大闹钟数量（64）
+#define ALARM_ID_NONE 0         // 无效ID
+#define ALARM_CATCHUP_MAX_S 300 // 补响窗口：晚于到点时刻超过该值的闹钟视为错过，不再响
+#define ALARM_NEVER 0xFFFFFFFFUL // 没有待触发的闹钟
+
+// 星期掩码（bit0=周日 ... bit6=周六），0表示单次闹钟
+#define ALARM_DAY_SUN       (1 << 0)
+#define ALARM_DAY_MON       (1 << 1)
+#define ALARM_DAY_TUE       (1 << 2)
+#define ALARM_DAY_WED       (1 << 3)
+#define ALARM_DAY_THU       (1 << 4)
+#define ALARM_DAY_FRI       (1 << 5)
+#define ALARM_DAY_SAT       (1 << 6)
+#define ALARM_DAYS_ONCE     0x00
+#define ALARM_DAYS_DAILY    0x7F
+#define ALARM_DAYS_WEEKDAYS 0x3E
+#define ALARM_DAYS_WEEKEND  0x41
+
+#define ALARM_DATE_NONE 0               // 不指定日期
+#define ALARM_SNOOZE_DEFAULT_MIN 5      // 默认贪睡间隔（分钟）
+#define ALARM_SNOOZE_MAX_MIN 30         // 最大贪睡间隔（分钟），0为关闭贪睡
 
 // ==================================
 // 闹钟数据结构
 // ==================================
 
+typedef uint16_t alarm_id_t;
+
 typedef struct {
-    char id[ALARM_ID_LEN];      // 闹钟ID
+    alarm_id_t id;             // 稳定ID（添加时分配，0表示空槽）
     uint8_t hour;              // 小时 (0-23)
     uint8_t minute;            // 分钟 (0-59)
     uint8_t second;            // 秒 (0-59)
     uint8_t enabled;           // 是否启用 (0/1)
-    uint8_t repeat;            // 是否重复 (0/1)
-    uint8_t _reserved[2];      // 保留字节，用于对齐
+    uint8_t days;              // 重复的星期掩码（ALARM_DAY_*），0为单次
+    uint8_t snooze_min;        // 贪睡间隔（分钟），0为不可贪睡
+    uint16_t date;             // 指定日期的单次闹钟（自2000-01-01起的天数），ALARM_DATE_NONE为不指定
 } Alarm_TypeDef;
 
-// ==================================
-// 全局变量声明
-// ==================================
-
-extern Alarm_TypeDef g_alarms[MAX_ALARMS];
-extern uint8_t g_alarm_count;
-
 // ==================================
 // 函数声明
 // ==================================
 
-// 闹钟管理函数
-int Alarm_Add(Alarm_TypeDef *alarm);
-int Alarm_Delete(uint8_t index);
-int Alarm_Enable(uint8_t index);
-int Alarm_Disable(uint8_t index);
-int Alarm_Update(uint8_t index, Alarm_TypeDef *alarm);
+// 闹钟管理函数（按ID）
+int Alarm_Add(const Alarm_TypeDef *alarm);
+int Alarm_Delete(alarm_id_t id);
+int Alarm_Enable(alarm_id_t id);
+int Alarm_Disable(alarm_id_t id);
+int Alarm_Update(alarm_id_t id, const Alarm_TypeDef *alarm);
+int Alarm_Snooze(alarm_id_t id, uint32_t now);
 
-// 闹钟检查函数
-int Alarm_Check(void);
-void Alarm_GenerateId(char *id);
+// 闹钟调度函数（时间均为本地时间秒数，自2000-01-01起）
+int Alarm_Check(uint32_t now);
+uint32_t Alarm_NextFire(void);
+void Alarm_Reschedule(uint32_t now);
 
 // 闹钟列表操作函数
-Alarm_TypeDef* Alarm_Get(uint8_t index);
+const Alarm_TypeDef* Alarm_Get(alarm_id_t id);
+alarm_id_t Alarm_GetIdAt(uint8_t position);
+int Alarm_GetPosition(alarm_id_t id);
 uint8_t Alarm_GetCount(void);
 
 #endif // __ALARM_CORE_H
@@ -0,0 +1,38 @@
+/**
+ * @file alarm_rule.h
+ * @brief 闹钟规则：下一次触发时刻计算与重复方式预设
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 纯计算，不访问RTC和闹钟表。时间统一用本地时间秒数（自2000-01-01 00:00:00起），
+ *       日期为天数，跨月跨年不需要特殊处理；星期由天数直接得出（2000-01-01为周六）。
+ *       重复方式：
+ *       - 星期掩码 days 非0：每周掩码中的几天
+ *       - days 为0：单次，下一个该时刻
+ *       - date 非0：指定日期单次（忽略 days）
+ */
+
+#ifndef __ALARM_RULE_H
+#define __ALARM_RULE_H
+
+#include "alarm_core.h"
+
+// ==================================
+// 宏定义
+// ==================================
+
+#define ALARM_RULE_PRESET_DATE 4    // 预设序号：指定日期
+
+// ==================================
+// 函数声明
+// ==================================
+
+uint32_t Alarm_Rule_Next(const Alarm_TypeDef *alarm, uint32_t after);
+uint8_t Alarm_Rule_Is_OneShot(const Alarm_TypeDef *alarm);
+uint8_t Alarm_Rule_Weekday(uint32_t day);
+
+uint8_t Alarm_Rule_Preset(const Alarm_TypeDef *alarm);
+void Alarm_Rule_Cycle(Alarm_TypeDef *alarm, int8_t dir, uint32_t now);
+const char *Alarm_Rule_Label(const Alarm_TypeDef *alarm);
+
+#endif // __ALARM_RULE_H
@@ -0,0 +1,34 @@
+/**
+ * @file alarm_sched.h
+ * @brief 闹钟调度：RTC硬件闹钟唤醒闹钟任务
+ * @author flowkite-0689
+ * @version v1.1
+ * @date 2026.10.19
+ * @note 闹钟任务算出最近的闹钟时刻，写入RTC闹钟寄存器（RTC_ALR，UTC计数值）后阻塞在任务通知上；
+ *       RTC闹钟中断和整分钟（经 rtc_clock 事件）、闹钟增删改、修改时间都会通知任务重新计算。
+ *       任务晚醒不会漏闹钟：到期判断是 next_fire <= now，并带补响窗口（见 alarm_core）
+ */
+
+#ifndef __ALARM_SCHED_H
+#define __ALARM_SCHED_H
+
+#include "stm32f10x.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+// ==================================
+// 宏定义
+// ==================================
+
+#define ALARM_SCHED_MAX_SLEEP_MS    61000       // 兜底超时：RTC中断异常时最多晚一分钟
+
+// ==================================
+// 函数声明
+// ==================================
+
+void Alarm_Sched_Init(TaskHandle_t task);
+void Alarm_Sched_Kick(void);
+uint8_t Alarm_Sched_Take_Time_Changed(void);
+void Alarm_Sched_Wait(uint32_t wake_local);
+
+#endif // __ALARM_SCHED_H
@@ -7,8 +7,11 @@
  */
 
 #include "alarm_alert.h"
+#include "menu_tree.h"
 #include "beep.h"
 #include "oled_print.h"
+#include "alarm_rule.h"
+#include "rtc_date.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -25,31 +28,17 @@ static alarm_alert_state_t g_alarm_alert_state;
 static void alarm_alert_init_state(alarm_alert_state_t *state);
 
 // ==================================
-// 页面初始化
+// 页面节点
 // ==================================
 
-/**
- * @brief 初始化闹钟提醒页面
- * @return 创建的菜单项指针
- */
-menu_item_t *alarm_alert_init(void)
-{
-    // 创建自定义菜单项
-    menu_item_t *alarm_alert_page = MENU_ITEM_CUSTOM("Alarm Alert", alarm_alert_draw_function, NULL);
-    if (alarm_alert_page == NULL) {
-        return NULL;
-    }
-    
-    // 设置回调函数
-    menu_item_set_callbacks(alarm_alert_page, 
-                           alarm_alert_on_enter, 
-                           alarm_alert_on_exit, 
-                           NULL, 
-                           alarm_alert_key_handler);
-    
-    printf("Alarm Alert page created successfully\r\n");
-    return alarm_alert_page;
-}
+// 不在菜单树中，闹钟事件时由菜单系统进入，上一级为当时所在的页面
+const menu_item_t g_alarm_alert_page = {
+    MENU_NODE_CUSTOM(MENU_ID_ALARM_ALERT, "Alarm Alert", alarm_alert_draw_function, NULL),
+    .refresh_ms = ALARM_ALERT_REFRESH_MS,
+    .on_enter = alarm_alert_on_enter,
+    .on_exit = alarm_alert_on_exit,
+    .on_key = alarm_alert_key_handler,
+};
 
 // ==================================
 // 回调函数
@@ -59,7 +48,7 @@ menu_item_t *alarm_alert_init(void)
  * @brief 闹钟提醒页面进入回调
  * @param item 菜单项
  */
-void alarm_alert_on_enter(menu_item_t *item)
+void alarm_alert_on_enter(const menu_item_t *item)
 {
     printf("Enter Alarm Alert page\r\n");
     Beep_Init();
@@ -67,7 +56,7 @@ void alarm_alert_on_enter(menu_item_t *item)
     alarm_alert_state_t *state = &g_alarm_alert_state;
     
     // 设置到菜单项上下文
-    item->content.custom.draw_context = state;
+    menu_item_set_context(item, state);
     
     // 如果闹钟提醒已经激活，保持状态不变
     if (!state->active) {
@@ -84,11 +73,11 @@ void alarm_alert_on_enter(menu_item_t *item)
  * @brief 闹钟提醒页面退出回调
  * @param item 菜单项
  */
-void alarm_alert_on_exit(menu_item_t *item)
+void alarm_alert_on_exit(const menu_item_t *item)
 {
     printf("Exit Alarm Alert page\r\n");
     
-    alarm_alert_state_t *state = (alarm_alert_state_t *)item->content.custom.draw_context;
+    alarm_alert_state_t *state = (alarm_alert_state_t *)menu_item_get_context(item);
     if (state == NULL) {
         return;
     }
@@ -112,9 +101,9 @@ void alarm_alert_on_exit(menu_item_t *item)
  * @param item 菜单项
  * @param key_event 按键事件
  */
-void alarm_alert_key_handler(menu_item_t *item, uint8_t key_event)
+void alarm_alert_key_handler(const menu_item_t *item, uint8_t key_event)
 {
-    alarm_alert_state_t *state = (alarm_alert_state_t *)item->content.custom.draw_context;
+    alarm_alert_state_t *state = (alarm_alert_state_t *)menu_item_get_context(item);
     if (state == NULL || !state->active) {
         return;
     }
@@ -122,6 +111,21 @@ void alarm_alert_key_handler(menu_item_t *item, uint8_t key_event)
     printf("Alarm Alert: KEY%d pressed\r\n", key_event - 1);
     
     switch (key_event) {
+        case MENU_EVENT_KEY_UP:
+        case MENU_EVENT_KEY_DOWN:
+            // KEY0 或 KEY1 - 贪睡，snooze_min 分钟后再响；不可贪睡的闹钟忽略
+            if (Alarm_Snooze(state->triggered_alarm_id, MyRTC_GetLocalSeconds()) != 0) {
+                break;
+            }
+            printf("Alarm Alert: Snooze\r\n");
+            
+            state->isRaing = 0;
+            state->active = 0;
+            OLED_Clear();
+            OLED_Refresh();
+            menu_back_to_parent();
+            break;
+            
         case MENU_EVENT_KEY_SELECT:
         case MENU_EVENT_KEY_ENTER:
             // KEY2 或 KEY3 - 关闭闹钟提醒
@@ -165,7 +169,7 @@ void alarm_alert_draw_function(void *context)
     }
     
     // 获取触发的闹钟信息
-    Alarm_TypeDef *alarm = Alarm_Get(state->triggered_alarm_index);
+    const Alarm_TypeDef *alarm = Alarm_Get(state->triggered_alarm_id);
     if (alarm == NULL) {
         return;
     }
@@ -203,8 +207,11 @@ void alarm_alert_draw_function(void *context)
             OLED_Printf_Line(2, "            ");
         }
         
-        // 显示重复状态
-        OLED_Printf_Line(3, " Repeat: %s  ", alarm->repeat ? "YES" : "NO");
+        // 显示重复方式和贪睡提示
+        OLED_Printf_Line(3, " Repeat: %s  ", Alarm_Rule_Label(alarm));
+        if (alarm->snooze_min > 0) {
+            OLED_Printf_Line(1, " KEY0/1:Snooze %dm", alarm->snooze_min);
+        }
         
         // 显示操作提示
         OLED_Printf_Line(6, " Press KEY2/3  ");
@@ -221,21 +228,21 @@ void alarm_alert_draw_function(void *context)
 
 /**
  * @brief 触发闹钟提醒
- * @param alarm_index 闹钟索引
+ * @param id 闹钟ID
  * @return 0-成功，其他-失败
  */
-int8_t alarm_alert_trigger(uint8_t alarm_index)
+int8_t alarm_alert_trigger(alarm_id_t id)
 {
-    if (alarm_index >= Alarm_GetCount()) {
+    if (Alarm_Get(id) == NULL) {
         return -1;
     }
     
     // 初始化状态
     alarm_alert_init_state(&g_alarm_alert_state);
     
-    // 设置触发的闹钟索引
+    // 设置触发的闹钟ID
     g_alarm_alert_state.active = 1;
-    g_alarm_alert_state.triggered_alarm_index = alarm_index;
+    g_alarm_alert_state.triggered_alarm_id = id;
     g_alarm_alert_state.need_refresh = 1;
     g_alarm_alert_state.start_time = xTaskGetTickCount();
     g_alarm_alert_state.last_beep_time = xTaskGetTickCount();
@@ -245,7 +252,7 @@ int8_t alarm_alert_trigger(uint8_t alarm_index)
     // 播放一次蜂鸣器提示
     BEEP_Buzz(10);
     
-    printf("Alarm Alert triggered for index %d\r\n", alarm_index);
+    printf("Alarm Alert triggered for ID %04X\r\n", id);
     
     return 0;
 }
@@ -268,7 +275,7 @@ static void alarm_alert_init_state(alarm_alert_state_t *state)
     
     // 初始化默认值
     state->active = 0;
-    state->triggered_alarm_index = 0;
+    state->triggered_alarm_id = ALARM_ID_NONE;
     state->need_refresh = 1;
     state->start_time = xTaskGetTickCount();
     state->blink_state = 1;
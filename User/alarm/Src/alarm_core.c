@@ -2,20 +2,185 @@
  * @file alarm_core.c
  * @brief 闹钟核心管理函数实现
  * @author flowkite-0689
- * @version v1.0
- * @date 2025.12.08
+ * @version v1.1
+ * @date 2026.10.19
  */
 
 #include "alarm_core.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include "rtc_date.h"
+#include "alarm_sched.h"
+#include "alarm_rule.h"
+
+// ==================================
+// 宏定义
+// ==================================
+
+#define ALARM_SLOT_MASK     (MAX_ALARMS - 1)
+#define ALARM_GEN_MAX       (0xFFFF >> ALARM_SLOT_BITS)
+#define ALARM_NOT_IN_HEAP   0xFF
+
 // ==================================
 // 全局变量定义
 // ==================================
 
-Alarm_TypeDef g_alarms[MAX_ALARMS];
-uint8_t g_alarm_count = 0;
+static Alarm_TypeDef s_alarms[MAX_ALARMS];      // 槽位，id为0表示空
+static uint32_t s_next_fire[MAX_ALARMS];        // 各槽位下一次触发时刻（本地时间秒数）
+
+static uint8_t s_heap[MAX_ALARMS];              // 小根堆（槽位号），键为 s_next_fire
+static uint8_t s_heap_pos[MAX_ALARMS];          // 槽位在堆中的位置
+static uint8_t s_heap_size = 0;
+
+static uint8_t s_order[MAX_ALARMS];             // 按时分秒排序的槽位号（列表显示顺序）
+static uint8_t s_alarm_count = 0;
+
+static uint16_t s_generation = 0;               // ID分配代数
+
+// ==================================
+// 小根堆
+// ==================================
+
+static void Alarm_Heap_Place(uint8_t pos, uint8_t slot)
+{
+    s_heap[pos] = slot;
+    s_heap_pos[slot] = pos;
+}
+
+static void Alarm_Heap_Up(uint8_t pos)
+{
+    uint8_t slot = s_heap[pos];
+
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (s_next_fire[s_heap[parent]] <= s_next_fire[slot]) {
+            break;
+        }
+        Alarm_Heap_Place(pos, s_heap[parent]);
+        pos = parent;
+    }
+    Alarm_Heap_Place(pos, slot);
+}
+
+static void Alarm_Heap_Down(uint8_t pos)
+{
+    uint8_t slot = s_heap[pos];
+
+    while (1) {
+        uint8_t child = pos * 2 + 1;
+        if (child >= s_heap_size) {
+            break;
+        }
+        if (child + 1 < s_heap_size && s_next_fire[s_heap[child + 1]] < s_next_fire[s_heap[child]]) {
+            child++;
+        }
+        if (s_next_fire[slot] <= s_next_fire[s_heap[child]]) {
+            break;
+        }
+        Alarm_Heap_Place(pos, s_heap[child]);
+        pos = child;
+    }
+    Alarm_Heap_Place(pos, slot);
+}
+
+static void Alarm_Heap_Remove(uint8_t slot)
+{
+    uint8_t pos = s_heap_pos[slot];
+    uint8_t last;
+
+    if (pos == ALARM_NOT_IN_HEAP) {
+        return;
+    }
+    s_heap_pos[slot] = ALARM_NOT_IN_HEAP;
+    s_heap_size--;
+    if (pos == s_heap_size) {
+        return;
+    }
+
+    last = s_heap[s_heap_size];
+    Alarm_Heap_Place(pos, last);
+    Alarm_Heap_Up(pos);
+    Alarm_Heap_Down(s_heap_pos[last]);
+}
+
+/**
+ * @brief 设置槽位的触发时刻并调整堆（ALARM_NEVER 则移出堆）
+ */
+static void Alarm_Heap_Set(uint8_t slot, uint32_t fire)
+{
+    s_next_fire[slot] = fire;
+
+    if (fire == ALARM_NEVER) {
+        Alarm_Heap_Remove(slot);
+    } else if (s_heap_pos[slot] == ALARM_NOT_IN_HEAP) {
+        Alarm_Heap_Place(s_heap_size, slot);
+        s_heap_size++;
+        Alarm_Heap_Up(s_heap_pos[slot]);
+    } else {
+        Alarm_Heap_Up(s_heap_pos[slot]);
+        Alarm_Heap_Down(s_heap_pos[slot]);
+    }
+}
+
+// ==================================
+// 显示顺序
+// ==================================
+
+static uint32_t Alarm_TimeKey(const Alarm_TypeDef *alarm)
+{
+    return alarm->hour * 3600UL + alarm->minute * 60UL + alarm->second;
+}
+
+/**
+ * @brief 槽位按时分秒插入显示顺序（二分查找插入点，同一时刻按添加先后）
+ */
+static void Alarm_Order_Insert(uint8_t slot)
+{
+    uint32_t key = Alarm_TimeKey(&s_alarms[slot]);
+    uint8_t lo = 0;
+    uint8_t hi = s_alarm_count;
+
+    while (lo < hi) {
+        uint8_t mid = (lo + hi) / 2;
+        if (Alarm_TimeKey(&s_alarms[s_order[mid]]) <= key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    memmove(&s_order[lo + 1], &s_order[lo], s_alarm_count - lo);
+    s_order[lo] = slot;
+    s_alarm_count++;
+}
+
+static void Alarm_Order_Remove(uint8_t slot)
+{
+    for (uint8_t i = 0; i < s_alarm_count; i++) {
+        if (s_order[i] == slot) {
+            memmove(&s_order[i], &s_order[i + 1], s_alarm_count - i - 1);
+            s_alarm_count--;
+            return;
+        }
+    }
+}
+
+// ==================================
+// 内部函数
+// ==================================
+
+/**
+ * @brief ID转槽位号
+ * @return 槽位号，ID无效或已删除返回-1
+ */
+static int Alarm_Slot(alarm_id_t id)
+{
+    uint8_t slot = id & ALARM_SLOT_MASK;
+
+    if (id == ALARM_ID_NONE || s_alarms[slot].id != id) {
+        return -1;
+    }
+    return slot;
+}
 
 // ==================================
 // 闹钟管理函数实现
@@ -23,168 +188,320 @@ uint8_t g_alarm_count = 0;
 
 /**
  * @brief 添加闹钟
- * @param alarm 闹钟指针
- * @return 0成功，-1失败
+ * @param alarm 闹钟数据（id字段忽略）
+ * @return 新闹钟的ID，-1失败
  */
-int Alarm_Add(Alarm_TypeDef *alarm)
+int Alarm_Add(const Alarm_TypeDef *alarm)
 {
-    if (alarm == NULL || g_alarm_count >= MAX_ALARMS) {
-        printf("Error: Cannot add alarm - full or null pointer\r\n");
+    uint32_t now = MyRTC_GetLocalSeconds();
+    int slot = -1;
+
+    if (alarm == NULL) {
+        printf("Error: Cannot add alarm - null pointer\r\n");
         return -1;
     }
-    
-    // 生成唯一ID
-    Alarm_GenerateId(g_alarms[g_alarm_count].id);
-    
-    // 复制闹钟数据
-    memcpy(&g_alarms[g_alarm_count], alarm, sizeof(Alarm_TypeDef));
-    
-    printf("Alarm added: ID=%s, Time=%02d:%02d:%02d, Enabled=%d, Repeat=%d\r\n",
-           g_alarms[g_alarm_count].id,
-           alarm->hour, alarm->minute, alarm->second,
-           alarm->enabled, alarm->repeat);
-    
-    g_alarm_count++;
-    return 0;
+
+    taskENTER_CRITICAL();
+    for (uint8_t i = 0; i < MAX_ALARMS; i++) {
+        if (s_alarms[i].id == ALARM_ID_NONE) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot >= 0) {
+        s_generation = (s_generation >= ALARM_GEN_MAX) ? 1 : s_generation + 1;
+        s_alarms[slot] = *alarm;
+        s_alarms[slot].id = (alarm_id_t)((s_generation << ALARM_SLOT_BITS) | slot);
+        s_heap_pos[slot] = ALARM_NOT_IN_HEAP;
+        Alarm_Order_Insert(slot);
+        Alarm_Heap_Set(slot, Alarm_Rule_Next(&s_alarms[slot], now));
+    }
+    taskEXIT_CRITICAL();
+
+    if (slot < 0) {
+        printf("Error: Cannot add alarm - full\r\n");
+        return -1;
+    }
+
+    printf("Alarm added: ID=%04X, Time=%02d:%02d:%02d, Enabled=%d, Days=%02X, Date=%u\r\n",
+           s_alarms[slot].id, alarm->hour, alarm->minute, alarm->second,
+           alarm->enabled, alarm->days, alarm->date);
+    Alarm_Sched_Kick();
+    return s_alarms[slot].id;
 }
 
 /**
  * @brief 删除闹钟
- * @param index 闹钟索引
+ * @param id 闹钟ID
  * @return 0成功，-1失败
  */
-int Alarm_Delete(uint8_t index)
+int Alarm_Delete(alarm_id_t id)
 {
-    if (index >= g_alarm_count) {
-        printf("Error: Invalid alarm index %d\r\n", index);
+    int slot;
+
+    taskENTER_CRITICAL();
+    slot = Alarm_Slot(id);
+    if (slot >= 0) {
+        Alarm_Heap_Remove(slot);
+        Alarm_Order_Remove(slot);
+        s_alarms[slot].id = ALARM_ID_NONE;
+    }
+    taskEXIT_CRITICAL();
+
+    if (slot < 0) {
+        printf("Error: Invalid alarm ID %04X\r\n", id);
         return -1;
     }
-    
-    printf("Alarm deleted: ID=%s, Time=%02d:%02d:%02d\r\n",
-           g_alarms[index].id,
-           g_alarms[index].hour, g_alarms[index].minute, g_alarms[index].second);
-    
-    // 将后面的闹钟向前移动
-    for (uint8_t i = index; i < g_alarm_count - 1; i++) {
-        memcpy(&g_alarms[i], &g_alarms[i + 1], sizeof(Alarm_TypeDef));
-    }
-    
-    g_alarm_count--;
+
+    printf("Alarm deleted: ID=%04X, Time=%02d:%02d:%02d\r\n",
+           id, s_alarms[slot].hour, s_alarms[slot].minute, s_alarms[slot].second);
+    Alarm_Sched_Kick();
     return 0;
 }
 
 /**
- * @brief 启用闹钟
- * @param index 闹钟索引
- * @return 0成功，-1失败
+ * @brief 修改闹钟启用状态
  */
-int Alarm_Enable(uint8_t index)
+static int Alarm_SetEnabled(alarm_id_t id, uint8_t enabled)
 {
-    if (index >= g_alarm_count) {
+    uint32_t now = MyRTC_GetLocalSeconds();
+    int slot;
+
+    taskENTER_CRITICAL();
+    slot = Alarm_Slot(id);
+    if (slot >= 0) {
+        s_alarms[slot].enabled = enabled;
+        Alarm_Heap_Set(slot, Alarm_Rule_Next(&s_alarms[slot], now));
+    }
+    taskEXIT_CRITICAL();
+
+    if (slot < 0) {
         return -1;
     }
-    
-    g_alarms[index].enabled = 1;
-    printf("Alarm enabled: ID=%s\r\n", g_alarms[index].id);
+
+    printf("Alarm %s: ID=%04X\r\n", enabled ? "enabled" : "disabled", id);
+    Alarm_Sched_Kick();
     return 0;
 }
 
+/**
+ * @brief 启用闹钟
+ * @param id 闹钟ID
+ * @return 0成功，-1失败
+ */
+int Alarm_Enable(alarm_id_t id)
+{
+    return Alarm_SetEnabled(id, 1);
+}
+
 /**
  * @brief 禁用闹钟
- * @param index 闹钟索引
+ * @param id 闹钟ID
+ * @return 0成功，-1失败
+ */
+int Alarm_Disable(alarm_id_t id)
+{
+    return Alarm_SetEnabled(id, 0);
+}
+
+/**
+ * @brief 更新闹钟（ID不变）
+ * @param id 闹钟ID
+ * @param alarm 新的闹钟数据（id字段忽略）
  * @return 0成功，-1失败
  */
-int Alarm_Disable(uint8_t index)
+int Alarm_Update(alarm_id_t id, const Alarm_TypeDef *alarm)
 {
-    if (index >= g_alarm_count) {
+    uint32_t now = MyRTC_GetLocalSeconds();
+    int slot = -1;
+
+    if (alarm == NULL) {
         return -1;
     }
-    
-    g_alarms[index].enabled = 0;
-    printf("Alarm disabled: ID=%s\r\n", g_alarms[index].id);
+
+    taskENTER_CRITICAL();
+    slot = Alarm_Slot(id);
+    if (slot >= 0) {
+        Alarm_Order_Remove(slot);
+        s_alarms[slot] = *alarm;
+        s_alarms[slot].id = id;
+        Alarm_Order_Insert(slot);
+        Alarm_Heap_Set(slot, Alarm_Rule_Next(&s_alarms[slot], now));
+    }
+    taskEXIT_CRITICAL();
+
+    if (slot < 0) {
+        return -1;
+    }
+
+    printf("Alarm updated: ID=%04X, Time=%02d:%02d:%02d\r\n",
+           id, alarm->hour, alarm->minute, alarm->second);
+    Alarm_Sched_Kick();
     return 0;
 }
 
 /**
- * @brief 更新闹钟
- * @param index 闹钟索引
- * @param alarm 新的闹钟数据
- * @return 0成功，-1失败
+ * @brief 贪睡：闹钟在 now 之后 snooze_min 分钟再响一次（不占用新槽位）
+ * @param id 闹钟ID
+ * @param now 当前本地时间秒数
+ * @return 0成功，-1失败（ID无效或该闹钟不可贪睡）
+ * @note 贪睡时刻直接写入堆，单次闹钟已被禁用也会再响；
+ *       修改/禁用闹钟或修改系统时间会取消贪睡
  */
-int Alarm_Update(uint8_t index, Alarm_TypeDef *alarm)
+int Alarm_Snooze(alarm_id_t id, uint32_t now)
 {
-    if (index >= g_alarm_count || alarm == NULL) {
+    uint8_t minutes = 0;
+    int slot;
+
+    taskENTER_CRITICAL();
+    slot = Alarm_Slot(id);
+    if (slot >= 0) {
+        minutes = s_alarms[slot].snooze_min;
+        if (minutes > 0) {
+            Alarm_Heap_Set(slot, now + minutes * 60UL);
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if (slot < 0 || minutes == 0) {
         return -1;
     }
-    
-    memcpy(&g_alarms[index], alarm, sizeof(Alarm_TypeDef));
-    printf("Alarm updated: ID=%s, Time=%02d:%02d:%02d\r\n",
-           g_alarms[index].id,
-           alarm->hour, alarm->minute, alarm->second);
+
+    printf("Alarm snoozed: ID=%04X, %d min\r\n", id, minutes);
+    Alarm_Sched_Kick();
     return 0;
 }
 
+// ==================================
+// 闹钟调度函数实现
+// ==================================
+
 /**
- * @brief 检查闹钟是否触发
- * @return 触发的闹钟索引，-1表示没有闹钟触发
+ * @brief 检查到期的闹钟（可能晚醒，按 next_fire <= now 判断，不依赖秒级对齐）
+ * @param now 当前本地时间秒数
+ * @return 需要响铃的闹钟ID，-1表示没有
+ * @note 只看堆顶，没有到期闹钟时为 O(1)；每次返回最早到期的一个，
+ *       调用方循环调用直到返回-1；到期超过 ALARM_CATCHUP_MAX_S 的闹钟只推进到下一次，不再响铃
  */
-int Alarm_Check(void)
+int Alarm_Check(uint32_t now)
 {
-    // 读取当前RTC时间
-    MyRTC_ReadTime();
-    
-    // 遍历所有闹钟
-    for (uint8_t i = 0; i < g_alarm_count; i++) {
-        Alarm_TypeDef *alarm = &g_alarms[i];
-        
-        // 检查闹钟是否启用
-        if (!alarm->enabled) {
-            continue;
+    while (1) {
+        Alarm_TypeDef alarm;
+        uint32_t late;
+        uint8_t slot;
+
+        taskENTER_CRITICAL();
+        if (s_heap_size == 0 || s_next_fire[s_heap[0]] > now) {
+            taskEXIT_CRITICAL();
+            return -1;
         }
-        
-        // 检查时间是否匹配
-        if (alarm->hour == RTC_data.hours && 
-            alarm->minute == RTC_data.minutes && 
-            alarm->second == RTC_data.seconds) {
-            
-            printf("Alarm triggered! Index: %d, Time: %02d:%02d:%02d\r\n", 
-                   i, alarm->hour, alarm->minute, alarm->second);
-            
-            // 如果是单次闹钟，触发后自动禁用
-            if (!alarm->repeat) {
-                alarm->enabled = 0;
-                printf("Single alarm disabled after trigger\r\n");
-            }
-            
-            return (int)i;
+
+        slot = s_heap[0];
+        late = now - s_next_fire[slot];
+
+        // 单次闹钟触发后自动禁用，重复闹钟推进到 now 之后的下一次
+        if (Alarm_Rule_Is_OneShot(&s_alarms[slot])) {
+            s_alarms[slot].enabled = 0;
+        }
+        Alarm_Heap_Set(slot, Alarm_Rule_Next(&s_alarms[slot], now));
+        alarm = s_alarms[slot];
+        taskEXIT_CRITICAL();
+
+        if (late <= ALARM_CATCHUP_MAX_S) {
+            printf("Alarm triggered! ID: %04X, Time: %02d:%02d:%02d, late %lus\r\n",
+                   alarm.id, alarm.hour, alarm.minute, alarm.second, (unsigned long)late);
+            return alarm.id;
         }
+
+        printf("Alarm missed: ID: %04X, Time: %02d:%02d:%02d, late %lus\r\n",
+               alarm.id, alarm.hour, alarm.minute, alarm.second, (unsigned long)late);
     }
-    
-    return -1; // 没有闹钟触发
 }
 
 /**
- * @brief 生成闹钟ID
- * @param id 输出ID缓冲区
+ * @brief 获取最近一次闹钟的触发时刻（堆顶）
+ * @return 本地时间秒数，没有启用的闹钟返回 ALARM_NEVER
  */
-void Alarm_GenerateId(char *id)
+uint32_t Alarm_NextFire(void)
 {
-    static uint16_t counter = 0;
-    snprintf(id, ALARM_ID_LEN, "AL%04X", counter);
-    counter = (counter + 1) % 0xFFFF;
+    uint32_t next;
+
+    taskENTER_CRITICAL();
+    next = (s_heap_size > 0) ? s_next_fire[s_heap[0]] : ALARM_NEVER;
+    taskEXIT_CRITICAL();
+    return next;
 }
 
 /**
- * @brief 获取闹钟指针
- * @param index 闹钟索引
- * @return 闹钟指针
+ * @brief 按当前时间重新计算所有闹钟并重建堆（系统时间被修改后调用）
+ * @param now 当前本地时间秒数
  */
-Alarm_TypeDef* Alarm_Get(uint8_t index)
+void Alarm_Reschedule(uint32_t now)
 {
-    if (index >= g_alarm_count) {
-        return NULL;
+    taskENTER_CRITICAL();
+    s_heap_size = 0;
+    for (uint8_t i = 0; i < s_alarm_count; i++) {
+        uint8_t slot = s_order[i];
+        s_next_fire[slot] = Alarm_Rule_Next(&s_alarms[slot], now);
+        s_heap_pos[slot] = ALARM_NOT_IN_HEAP;
+        if (s_next_fire[slot] != ALARM_NEVER) {
+            Alarm_Heap_Place(s_heap_size, slot);
+            s_heap_size++;
+        }
+    }
+    for (int pos = s_heap_size / 2 - 1; pos >= 0; pos--) {
+        Alarm_Heap_Down((uint8_t)pos);
+    }
+    taskEXIT_CRITICAL();
+}
+
+// ==================================
+// 闹钟列表操作函数
+// ==================================
+
+/**
+ * @brief 按ID获取闹钟
+ * @param id 闹钟ID
+ * @return 闹钟指针，ID无效返回NULL
+ */
+const Alarm_TypeDef* Alarm_Get(alarm_id_t id)
+{
+    int slot = Alarm_Slot(id);
+
+    return (slot >= 0) ? &s_alarms[slot] : NULL;
+}
+
+/**
+ * @brief 获取显示顺序（按时分秒）中第 position 个闹钟的ID
+ * @param position 位置
+ * @return 闹钟ID，越界返回 ALARM_ID_NONE
+ */
+alarm_id_t Alarm_GetIdAt(uint8_t position)
+{
+    if (position >= s_alarm_count) {
+        return ALARM_ID_NONE;
+    }
+    return s_alarms[s_order[position]].id;
+}
+
+/**
+ * @brief 获取闹钟在显示顺序中的位置
+ * @param id 闹钟ID
+ * @return 位置，ID无效返回-1
+ */
+int Alarm_GetPosition(alarm_id_t id)
+{
+    int slot = Alarm_Slot(id);
+
+    if (slot < 0) {
+        return -1;
+    }
+    for (uint8_t i = 0; i < s_alarm_count; i++) {
+        if (s_order[i] == slot) {
+            return i;
+        }
     }
-    return &g_alarms[index];
+    return -1;
 }
 
 /**
@@ -193,5 +510,5 @@ Alarm_TypeDef* Alarm_Get(uint8_t index)
  */
 uint8_t Alarm_GetCount(void)
 {
-    return g_alarm_count;
+    return s_alarm_count;
 }
@@ -0,0 +1,173 @@
+/**
+ * @file alarm_rule.c
+ * @brief 闹钟规则实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "alarm_rule.h"
+
+// ==================================
+// 宏定义
+// ==================================
+
+#define ALARM_RULE_EPOCH_WEEKDAY 6  // 2000-01-01 为周六
+
+// ==================================
+// 查找表
+// ==================================
+
+// 7位掩码中最低置位的位号（掩码为0时无意义）
+static const uint8_t s_first_day[128] = {
+    0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    6, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+};
+
+// 重复方式预设（界面循环切换），最后一项为指定日期
+static const struct {
+    uint8_t days;
+    const char *label;
+} s_presets[] = {
+    { ALARM_DAYS_ONCE,     "Once"  },
+    { ALARM_DAYS_DAILY,    "Daily" },
+    { ALARM_DAYS_WEEKDAYS, "Wkdy"  },
+    { ALARM_DAYS_WEEKEND,  "Wknd"  },
+    { ALARM_DAYS_ONCE,     "Date"  },
+};
+
+#define ALARM_RULE_PRESET_NUM (sizeof(s_presets) / sizeof(s_presets[0]))
+
+// ==================================
+// 规则计算
+// ==================================
+
+/**
+ * @brief 天数对应的星期
+ * @param day 自2000-01-01起的天数
+ * @return 0=周日 ... 6=周六
+ */
+uint8_t Alarm_Rule_Weekday(uint32_t day)
+{
+    return (uint8_t)((day + ALARM_RULE_EPOCH_WEEKDAY) % 7);
+}
+
+/**
+ * @brief 是否为单次闹钟（触发后自动禁用）
+ */
+uint8_t Alarm_Rule_Is_OneShot(const Alarm_TypeDef *alarm)
+{
+    return alarm->date != ALARM_DATE_NONE || (alarm->days & ALARM_DAYS_DAILY) == 0;
+}
+
+/**
+ * @brief 计算 after 之后（不含）的下一次触发时刻
+ * @param alarm 闹钟
+ * @param after 本地时间秒数
+ * @return 触发时刻，未启用或指定日期已过返回 ALARM_NEVER
+ * @note 星期掩码先循环右移到"今天"为bit0，今天的时刻已过则去掉bit0，
+ *       再查最低置位得到相隔天数，没有分支循环
+ */
+uint32_t Alarm_Rule_Next(const Alarm_TypeDef *alarm, uint32_t after)
+{
+    uint32_t tod;
+    uint32_t day;
+    uint32_t fire;
+    uint8_t days;
+    uint8_t weekday;
+    uint8_t offset;
+
+    if (!alarm->enabled) {
+        return ALARM_NEVER;
+    }
+
+    tod = alarm->hour * 3600UL + alarm->minute * 60UL + alarm->second;
+
+    if (alarm->date != ALARM_DATE_NONE) {
+        fire = alarm->date * 86400UL + tod;
+        return (fire > after) ? fire : ALARM_NEVER;
+    }
+
+    day = after / 86400;
+    days = alarm->days & ALARM_DAYS_DAILY;
+
+    if (days == ALARM_DAYS_ONCE) {
+        offset = (tod <= after % 86400) ? 1 : 0;
+    } else {
+        weekday = Alarm_Rule_Weekday(day);
+        days = (uint8_t)(((days >> weekday) | (days << (7 - weekday))) & ALARM_DAYS_DAILY);
+        if (tod <= after % 86400) {
+            days &= (uint8_t)~1;
+        }
+        // 只有今天在掩码中且已过：下周同一天
+        offset = (days != 0) ? s_first_day[days] : 7;
+    }
+
+    return (day + offset) * 86400UL + tod;
+}
+
+// ==================================
+// 重复方式预设
+// ==================================
+
+/**
+ * @brief 闹钟当前的重复方式对应的预设序号
+ * @return 预设序号，自定义掩码返回 ALARM_RULE_PRESET_NUM
+ */
+uint8_t Alarm_Rule_Preset(const Alarm_TypeDef *alarm)
+{
+    uint8_t i;
+
+    if (alarm->date != ALARM_DATE_NONE) {
+        return ALARM_RULE_PRESET_DATE;
+    }
+    for (i = 0; i < ALARM_RULE_PRESET_DATE; i++) {
+        if (s_presets[i].days == (alarm->days & ALARM_DAYS_DAILY)) {
+            return i;
+        }
+    }
+    return ALARM_RULE_PRESET_NUM;
+}
+
+/**
+ * @brief 切换到上一个/下一个重复方式预设
+ * @param alarm 闹钟
+ * @param dir 1下一个，-1上一个
+ * @param now 当前本地时间秒数（切到指定日期时，默认取该时刻的下一次所在日期）
+ */
+void Alarm_Rule_Cycle(Alarm_TypeDef *alarm, int8_t dir, uint32_t now)
+{
+    uint8_t preset = Alarm_Rule_Preset(alarm);
+
+    if (preset >= ALARM_RULE_PRESET_NUM) {
+        preset = 0;
+    } else if (dir > 0) {
+        preset = (preset + 1) % ALARM_RULE_PRESET_NUM;
+    } else {
+        preset = (preset + ALARM_RULE_PRESET_NUM - 1) % ALARM_RULE_PRESET_NUM;
+    }
+
+    alarm->days = s_presets[preset].days;
+    alarm->date = ALARM_DATE_NONE;
+    if (preset == ALARM_RULE_PRESET_DATE) {
+        Alarm_TypeDef once = *alarm;
+        once.enabled = 1;
+        alarm->date = (uint16_t)(Alarm_Rule_Next(&once, now) / 86400);
+    }
+}
+
+/**
+ * @brief 重复方式的显示文本
+ */
+const char *Alarm_Rule_Label(const Alarm_TypeDef *alarm)
+{
+    uint8_t preset = Alarm_Rule_Preset(alarm);
+
+    return (preset < ALARM_RULE_PRESET_NUM) ? s_presets[preset].label : "Cust";
+}
@@ -0,0 +1,114 @@
+/**
+ * @file alarm_sched.c
+ * @brief 闹钟调度实现
+ * @author flowkite-0689
+ * @version v1.1
+ * @date 2026.10.19
+ */
+
+#include "alarm_sched.h"
+#include "rtc_date.h"
+#include "rtc_clock.h"
+#include "alarm_core.h"
+
+// ==================================
+// 全局变量定义
+// ==================================
+
+static TaskHandle_t s_alarm_task = NULL;
+static volatile uint8_t s_time_changed = 0;    // 系统时间被修改，需要重新计算所有闹钟
+
+// ==================================
+// 时钟事件
+// ==================================
+
+/**
+ * @brief 时钟事件回调（RTC中断中）：闹钟到点、整分钟或时间被修改时唤醒闹钟任务
+ */
+static void Alarm_Sched_On_Clock(uint8_t events, const rtc_clock_time_t *now, BaseType_t *woken)
+{
+    (void)now;
+
+    if (events & RTC_CLOCK_EVT_SYNC) {
+        s_time_changed = 1;
+    }
+    if (s_alarm_task != NULL) {
+        vTaskNotifyGiveFromISR(s_alarm_task, woken);
+    }
+}
+
+// ==================================
+// 调度函数实现
+// ==================================
+
+/**
+ * @brief 初始化调度（在闹钟任务中、RTC_Clock_Init之后调用）
+ * @param task 闹钟任务句柄
+ */
+void Alarm_Sched_Init(TaskHandle_t task)
+{
+    s_alarm_task = task;
+
+    RTC_Clock_Subscribe(RTC_CLOCK_EVT_ALARM | RTC_CLOCK_EVT_MINUTE | RTC_CLOCK_EVT_SYNC,
+                        Alarm_Sched_On_Clock);
+
+    RTC_WaitForLastTask();
+    RTC_ClearITPendingBit(RTC_IT_ALR);
+    RTC_ITConfig(RTC_IT_ALR, ENABLE);
+    RTC_WaitForLastTask();
+
+    printf("Alarm scheduler: RTC alarm IRQ enabled\r\n");
+}
+
+/**
+ * @brief 闹钟表或系统时间改变后唤醒闹钟任务重新计算（任务上下文调用）
+ */
+void Alarm_Sched_Kick(void)
+{
+    if (s_alarm_task != NULL) {
+        xTaskNotifyGive(s_alarm_task);
+    }
+}
+
+/**
+ * @brief 读取并清除时间修改标志（闹钟任务调用）
+ * @return 1-时间被修改过
+ */
+uint8_t Alarm_Sched_Take_Time_Changed(void)
+{
+    uint8_t changed = s_time_changed;
+
+    s_time_changed = 0;
+    return changed;
+}
+
+/**
+ * @brief 设置RTC闹钟并阻塞到闹钟中断、整分钟事件或被 Alarm_Sched_Kick 唤醒
+ * @param wake_local 唤醒时刻（本地时间秒数），ALARM_NEVER 表示没有闹钟，只等整分钟
+ */
+void Alarm_Sched_Wait(uint32_t wake_local)
+{
+    uint32_t now = RTC_GetCounter();
+    uint32_t wake = RTC_TZ_LocalToUtc(wake_local);      // RTC计数器为UTC
+    uint32_t delta;
+
+    if (wake_local == ALARM_NEVER) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ALARM_SCHED_MAX_SLEEP_MS));
+        return;
+    }
+
+    // 闹钟在计数器变为ALR时触发，已过去的时刻改为下一秒
+    if ((int32_t)(wake - now) < 1) {
+        wake = now + 1;
+    }
+
+    RTC_WaitForLastTask();
+    RTC_SetAlarm(wake);
+    RTC_WaitForLastTask();
+
+    delta = wake - now;
+    if (delta > ALARM_SCHED_MAX_SLEEP_MS / 1000) {
+        delta = ALARM_SCHED_MAX_SLEEP_MS / 1000;
+    }
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(delta * 1000 + 100));
+}
@@ -0,0 +1,67 @@
+/**
+ * @file history.h
+ * @brief 步数与温湿度历史记录（分钟/小时桶 + Flash日志）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 当天数据：每个序列一条分钟级压缩流（history_codec）和24个小时桶，均在RAM中；
+ *       跨天时把24个小时桶压缩后追加到Flash日志（FLASH_STORE_HISTORY_ADDR起的环形页），
+ *       写满后擦除最旧的一页。分钟级数据只保留当天，掉电丢失当天未写入的数据。
+ *       时间使用本地时间秒数（自2000-01-01起），day 为自2000-01-01起的天数
+ */
+
+#ifndef __HISTORY_H
+#define __HISTORY_H
+
+#include <stdint.h>
+#include "history_codec.h"
+
+// ==================================
+// 宏定义
+// ==================================
+
+#define HISTORY_MINUTES_PER_DAY     1440
+#define HISTORY_HOURS_PER_DAY       24
+
+// 分钟流缓冲区（合计小于1KB，从FreeRTOS堆中一次性分配）
+#define HISTORY_STEPS_BUF_SIZE      512
+#define HISTORY_TEMP_BUF_SIZE       240
+#define HISTORY_HUMI_BUF_SIZE       240
+
+// ==================================
+// 数据结构
+// ==================================
+
+typedef enum {
+    HISTORY_SERIES_STEPS = 0,       // 每分钟/每小时步数
+    HISTORY_SERIES_TEMP,            // 温度，0.1°C（小时桶为平均值）
+    HISTORY_SERIES_HUMI,            // 湿度，0.1%（小时桶为平均值）
+    HISTORY_SERIES_COUNT
+} history_series_t;
+
+typedef struct {
+    uint16_t today;                             // 当天（自2000-01-01起的天数）
+    uint16_t minutes;                           // 当天已记录分钟数
+    uint16_t bytes[HISTORY_SERIES_COUNT];       // 各分钟流已用字节
+    uint8_t overflow;                           // 分钟流已写满的序列（位掩码）
+    uint16_t log_records;                       // Flash日志中的有效记录数
+    uint16_t log_oldest_day;                    // 日志中最早的一天
+} history_stats_t;
+
+// 逐样本回调（在历史记录锁内调用，应尽快返回）
+typedef void (*history_visit_t)(void *ctx, int16_t value);
+
+// ==================================
+// 函数声明
+// ==================================
+
+int history_init(void);
+void history_tick(uint32_t local_seconds);
+
+int history_visit_minutes(history_series_t series, uint16_t first_minute, uint16_t count,
+                          history_visit_t visit, void *ctx);
+int history_query_minutes(history_series_t series, uint16_t first_minute, uint16_t count, int16_t *out);
+int history_query_hours(history_series_t series, uint16_t day, uint8_t first_hour, uint8_t count, int16_t *out);
+void history_get_stats(history_stats_t *stats);
+
+#endif
@@ -0,0 +1,68 @@
+/**
+ * @file history_codec.h
+ * @brief 时间序列压缩编码（差分 + ZigZag + Varint + 零差分游程）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 每个样本与前一个样本做差（首个样本与0做差），差值经ZigZag映射为无符号数后
+ *       按以下记号写成 Varint（LEB128，每字节7位，最高位为续位）：
+ *         token = zigzag(delta) << 1        单个样本
+ *         token = (run << 1) | 1            连续 run 个与前值相同的样本
+ *       温湿度和静止时的步数大多不变，一整天的分钟数据通常只有几百字节
+ */
+
+#ifndef __HISTORY_CODEC_H
+#define __HISTORY_CODEC_H
+
+#include <stdint.h>
+
+// ==================================
+// 宏定义
+// ==================================
+
+#define HISTORY_NO_DATA             ((int16_t)-32768)   // 缺测样本（未开机、传感器读取失败）
+#define HISTORY_CODEC_MAX_TOKEN     3                   // int16差分或游程的最大记号长度（字节）
+
+// ==================================
+// 流式编码器 / 解码器
+// ==================================
+
+typedef struct {
+    uint8_t *buf;
+    uint16_t cap;
+    uint16_t len;               // 已写入字节数（不含未落盘的游程）
+    uint16_t count;             // 已编码样本数（含游程）
+    uint16_t run;               // 尚未写出的游程长度
+    int16_t last;               // 上一个样本
+} history_enc_t;
+
+typedef struct {
+    const uint8_t *buf;
+    uint16_t len;
+    uint16_t pos;
+    uint16_t run;               // 当前游程剩余样本数
+    uint16_t tail_run;          // 编码器中尚未写出的游程（读完字节后补上）
+    int16_t last;
+} history_dec_t;
+
+// ==================================
+// 函数声明
+// ==================================
+
+uint32_t history_zigzag_encode(int32_t value);
+int32_t history_zigzag_decode(uint32_t value);
+int history_varint_put(uint8_t *buf, uint16_t cap, uint16_t *pos, uint32_t value);
+int history_varint_get(const uint8_t *buf, uint16_t len, uint16_t *pos, uint32_t *value);
+
+void history_enc_init(history_enc_t *enc, uint8_t *buf, uint16_t cap);
+int history_enc_put(history_enc_t *enc, int16_t value);
+int history_enc_flush(history_enc_t *enc);
+
+void history_dec_init(history_dec_t *dec, const uint8_t *buf, uint16_t len);
+void history_dec_init_enc(history_dec_t *dec, const history_enc_t *enc);
+int history_dec_next(history_dec_t *dec, int16_t *value);
+
+int history_codec_encode(const int16_t *values, uint16_t count, uint8_t *out, uint16_t cap);
+int history_codec_decode(const uint8_t *in, uint16_t len, int16_t *values, uint16_t max_count);
+
+#endif
@@ -0,0 +1,581 @@
+/**
+ * @file history.c
+ * @brief 步数与温湿度历史记录实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "history.h"
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "debug.h"
+#include "dht11.h"
+#include "flash_store.h"
+#include "simple_pedometer.h"
+
+// ==================================
+// Flash日志布局
+// ==================================
+
+#define HISTORY_LOG_START       FLASH_STORE_HISTORY_ADDR
+#define HISTORY_LOG_END         (FLASH_STORE_HISTORY_ADDR + FLASH_STORE_HISTORY_PAGES * FLASH_STORE_PAGE_SIZE)
+#define HISTORY_LOG_VALUES      (HISTORY_SERIES_COUNT * HISTORY_HOURS_PER_DAY)
+#define HISTORY_LOG_PAYLOAD_MAX (HISTORY_LOG_VALUES * HISTORY_CODEC_MAX_TOKEN)
+
+#define HISTORY_POOL_SIZE       (HISTORY_STEPS_BUF_SIZE + HISTORY_TEMP_BUF_SIZE + HISTORY_HUMI_BUF_SIZE)
+
+// 记录：头 + 压缩后的 3×24 个小时桶（步数、温度、湿度依次排列）+ 补齐到半字 + CRC16
+typedef struct {
+    uint16_t magic;
+    uint16_t len;               // 负载字节数
+    uint32_t seq;               // 追加序号，越大越新
+    uint16_t day;               // 自2000-01-01起的天数
+    uint16_t values;            // 负载中的样本数
+} history_log_header_t;
+
+#define HISTORY_LOG_RECORD_SIZE(len)  (sizeof(history_log_header_t) + (((len) + 1) & ~1U) + 2)
+
+// ==================================
+// 模块状态
+// ==================================
+
+typedef struct {
+    uint8_t *pool;                                              // 分钟流缓冲区
+    history_enc_t series[HISTORY_SERIES_COUNT];                 // 当天各序列的分钟流
+    int16_t hour[HISTORY_SERIES_COUNT][HISTORY_HOURS_PER_DAY];  // 当天已结束的小时桶
+    int32_t hour_sum[HISTORY_SERIES_COUNT];                     // 当前小时累加
+    uint8_t hour_n[HISTORY_SERIES_COUNT];                       // 当前小时有效样本数
+    uint8_t overflow;                                           // 分钟流写满的序列（位掩码）
+
+    uint16_t day;                   // 当天
+    uint16_t minute;                // 当前分钟（尚未结束）
+    uint8_t started;
+    unsigned long last_steps;       // 上一分钟结束时的总步数
+
+    uint32_t log_addr;              // 下一条日志写入地址
+    uint32_t log_seq;               // 下一条日志序号
+
+    SemaphoreHandle_t mutex;
+} history_state_t;
+
+static history_state_t s_history;
+
+static const uint16_t s_buf_size[HISTORY_SERIES_COUNT] = {
+    HISTORY_STEPS_BUF_SIZE, HISTORY_TEMP_BUF_SIZE, HISTORY_HUMI_BUF_SIZE};
+
+// ==================================
+// Flash日志
+// ==================================
+
+/**
+ * @brief 检查一条记录
+ * @param addr 记录地址
+ * @return 记录总长度，0-空白（无记录），-1-损坏
+ */
+static int history_log_check(uint32_t addr)
+{
+    const history_log_header_t *hdr = (const history_log_header_t *)addr;
+    uint32_t page_end = (addr & ~(uint32_t)(FLASH_STORE_PAGE_SIZE - 1)) + FLASH_STORE_PAGE_SIZE;
+    uint32_t size;
+    uint16_t crc;
+
+    if (addr + sizeof(history_log_header_t) > page_end || hdr->magic == 0xFFFF) {
+        return 0;
+    }
+    if (hdr->magic != FLASH_STORE_MAGIC_HISTORY || hdr->len > HISTORY_LOG_PAYLOAD_MAX) {
+        return -1;
+    }
+    size = HISTORY_LOG_RECORD_SIZE(hdr->len);
+    if (addr + size > page_end) {
+        return -1;
+    }
+
+    crc = flash_store_crc16((const uint8_t *)addr, sizeof(history_log_header_t) + hdr->len, 0xFFFF);
+    if (crc != *(const uint16_t *)(addr + size - 2)) {
+        return -1;
+    }
+    return (int)size;
+}
+
+/**
+ * @brief 遍历日志，找最新记录和指定日期的记录
+ * @param day 要查找的日期（0xFFFF-不查找）
+ * @param found 输出：该日期最新一条记录的地址（0-未找到），可为NULL
+ * @param stats 输出：记录数和最早日期，可为NULL
+ */
+static void history_log_scan(uint16_t day, uint32_t *found, history_stats_t *stats)
+{
+    uint32_t page;
+    uint32_t addr;
+    uint32_t newest_seq = 0;
+    uint32_t newest_end = HISTORY_LOG_START;
+    uint32_t oldest_seq = 0xFFFFFFFF;
+    uint32_t found_seq = 0;
+    const history_log_header_t *hdr;
+    uint16_t records = 0;
+    int size;
+
+    if (found != NULL) {
+        *found = 0;
+    }
+
+    for (page = HISTORY_LOG_START; page < HISTORY_LOG_END; page += FLASH_STORE_PAGE_SIZE) {
+        addr = page;
+        while ((size = history_log_check(addr)) > 0) {
+            hdr = (const history_log_header_t *)addr;
+            records++;
+            if (hdr->seq >= newest_seq) {
+                newest_seq = hdr->seq;
+                newest_end = addr + size;
+            }
+            if (hdr->seq < oldest_seq) {
+                oldest_seq = hdr->seq;
+                if (stats != NULL) {
+                    stats->log_oldest_day = hdr->day;
+                }
+            }
+            if (found != NULL && hdr->day == day && hdr->seq >= found_seq) {
+                found_seq = hdr->seq;
+                *found = addr;
+            }
+            addr += size;
+        }
+    }
+
+    if (stats != NULL) {
+        stats->log_records = records;
+    }
+    if (found == NULL && stats == NULL) {
+        s_history.log_addr = newest_end;
+        s_history.log_seq = newest_seq + 1;
+    }
+}
+
+/**
+ * @brief 区域是否为擦除状态
+ */
+static uint8_t history_log_blank(uint32_t addr, uint32_t size)
+{
+    uint32_t end = addr + size;
+
+    for (; addr < end; addr += 2) {
+        if (*(const uint16_t *)addr != 0xFFFF) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief 把当天的小时桶追加到Flash日志
+ * @return 0-成功，负数-失败
+ * @note 借用分钟流缓冲区组帧，调用后须重新开始当天
+ */
+static int history_log_append(void)
+{
+    history_log_header_t *hdr = (history_log_header_t *)s_history.pool;
+    uint8_t *payload = s_history.pool + sizeof(history_log_header_t);
+    uint32_t page_end;
+    uint32_t size;
+    uint16_t crc;
+    int len;
+
+    len = history_codec_encode(&s_history.hour[0][0], HISTORY_LOG_VALUES, payload, HISTORY_LOG_PAYLOAD_MAX);
+    if (len < 0) {
+        return -1;
+    }
+
+    hdr->magic = FLASH_STORE_MAGIC_HISTORY;
+    hdr->len = (uint16_t)len;
+    hdr->seq = s_history.log_seq;
+    hdr->day = s_history.day;
+    hdr->values = HISTORY_LOG_VALUES;
+    size = HISTORY_LOG_RECORD_SIZE(len);
+
+    // 奇数长度补0xFF，与 flash_store_program 的补齐方式一致，CRC只覆盖头和负载
+    payload[len] = 0xFF;
+    crc = flash_store_crc16(s_history.pool, sizeof(history_log_header_t) + len, 0xFFFF);
+    memcpy(s_history.pool + size - 2, &crc, 2);
+
+    // 本页放不下则换到下一页（环形），擦除其中最旧的记录
+    page_end = (s_history.log_addr & ~(uint32_t)(FLASH_STORE_PAGE_SIZE - 1)) + FLASH_STORE_PAGE_SIZE;
+    if (s_history.log_addr >= HISTORY_LOG_END || s_history.log_addr + size > page_end) {
+        s_history.log_addr = (page_end >= HISTORY_LOG_END) ? HISTORY_LOG_START : page_end;
+        if (flash_store_erase_page(s_history.log_addr) != 0) {
+            return -2;
+        }
+    } else if (!history_log_blank(s_history.log_addr, size)) {
+        // 页内残留损坏数据：整页擦除后从页首写
+        s_history.log_addr &= ~(uint32_t)(FLASH_STORE_PAGE_SIZE - 1);
+        if (flash_store_erase_page(s_history.log_addr) != 0) {
+            return -2;
+        }
+    }
+
+    if (flash_store_program(s_history.log_addr, s_history.pool, (uint16_t)size) != 0) {
+        return -3;
+    }
+
+    printf("History: day %u logged, %d bytes at 0x%08lX\r\n",
+           s_history.day, len, (unsigned long)s_history.log_addr);
+    s_history.log_addr += size;
+    s_history.log_seq++;
+    return 0;
+}
+
+// ==================================
+// 分钟/小时桶
+// ==================================
+
+/**
+ * @brief 当前小时桶的值（未结束的小时按已有样本计算）
+ */
+static int16_t history_hour_value(uint8_t series)
+{
+    int32_t n = s_history.hour_n[series];
+
+    if (n == 0) {
+        return HISTORY_NO_DATA;
+    }
+    if (series == HISTORY_SERIES_STEPS) {
+        return (int16_t)((s_history.hour_sum[series] > 32767) ? 32767 : s_history.hour_sum[series]);
+    }
+    // 温湿度取平均（四舍五入）
+    if (s_history.hour_sum[series] >= 0) {
+        return (int16_t)((s_history.hour_sum[series] + n / 2) / n);
+    }
+    return (int16_t)((s_history.hour_sum[series] - n / 2) / n);
+}
+
+/**
+ * @brief 结束当前分钟：写入分钟流并累加到小时桶
+ * @param values 各序列的分钟值
+ */
+static void history_close_minute(const int16_t values[HISTORY_SERIES_COUNT])
+{
+    uint8_t hour = (uint8_t)(s_history.minute / 60);
+    uint8_t i;
+
+    for (i = 0; i < HISTORY_SERIES_COUNT; i++) {
+        if (!(s_history.overflow & (1 << i)) &&
+            history_enc_put(&s_history.series[i], values[i]) != 0) {
+            s_history.overflow |= (uint8_t)(1 << i);
+            printf("History: series %d minute buffer full at %u\r\n", i, s_history.minute);
+        }
+        if (values[i] != HISTORY_NO_DATA) {
+            s_history.hour_sum[i] += values[i];
+            s_history.hour_n[i]++;
+        }
+    }
+
+    if (s_history.minute % 60 == 59) {
+        for (i = 0; i < HISTORY_SERIES_COUNT; i++) {
+            s_history.hour[i][hour] = history_hour_value(i);
+            s_history.hour_sum[i] = 0;
+            s_history.hour_n[i] = 0;
+        }
+    }
+    s_history.minute++;
+}
+
+/**
+ * @brief 以缺测值补齐到指定分钟
+ */
+static void history_fill_to(uint16_t minute)
+{
+    static const int16_t no_data[HISTORY_SERIES_COUNT] = {
+        HISTORY_NO_DATA, HISTORY_NO_DATA, HISTORY_NO_DATA};
+
+    while (s_history.minute < minute) {
+        history_close_minute(no_data);
+    }
+}
+
+/**
+ * @brief 开始新的一天
+ * @param day 日期
+ * @param minute 当前分钟（之前的分钟记为缺测）
+ */
+static void history_start_day(uint16_t day, uint16_t minute)
+{
+    uint8_t i;
+    uint8_t h;
+    uint8_t *buf = s_history.pool;
+
+    for (i = 0; i < HISTORY_SERIES_COUNT; i++) {
+        history_enc_init(&s_history.series[i], buf, s_buf_size[i]);
+        buf += s_buf_size[i];
+        s_history.hour_sum[i] = 0;
+        s_history.hour_n[i] = 0;
+        for (h = 0; h < HISTORY_HOURS_PER_DAY; h++) {
+            s_history.hour[i][h] = HISTORY_NO_DATA;
+        }
+    }
+    s_history.overflow = 0;
+    s_history.day = day;
+    s_history.minute = 0;
+    history_fill_to(minute);
+}
+
+/**
+ * @brief 结束当天（跨天或时间回拨）：收尾当前小时并写入日志
+ */
+static void history_finish_day(void)
+{
+    uint8_t hour = (uint8_t)(s_history.minute / 60);
+    uint8_t i;
+
+    if (hour < HISTORY_HOURS_PER_DAY) {
+        for (i = 0; i < HISTORY_SERIES_COUNT; i++) {
+            s_history.hour[i][hour] = history_hour_value(i);
+        }
+    }
+    history_log_append();
+}
+
+// ==================================
+// 对外接口
+// ==================================
+
+/**
+ * @brief 初始化历史记录（分配分钟流缓冲区，扫描Flash日志）
+ * @return 0-成功，-1-内存不足
+ */
+int history_init(void)
+{
+    memset(&s_history, 0, sizeof(s_history));
+
+    s_history.pool = (uint8_t *)pvPortMalloc(HISTORY_POOL_SIZE);
+    s_history.mutex = xSemaphoreCreateMutex();
+    if (s_history.pool == NULL || s_history.mutex == NULL) {
+        printf("History: out of memory\r\n");
+        if (s_history.pool != NULL) {
+            vPortFree(s_history.pool);
+            s_history.pool = NULL;
+        }
+        return -1;
+    }
+
+    history_log_scan(0xFFFF, NULL, NULL);
+    DHT11_Init();
+
+    printf("History initialized, log next 0x%08lX seq %lu\r\n",
+           (unsigned long)s_history.log_addr, (unsigned long)s_history.log_seq);
+    return 0;
+}
+
+/**
+ * @brief 时间推进（每秒调用一次即可），每分钟结束时采样步数和温湿度
+ * @param local_seconds 本地时间秒数（自2000-01-01起）
+ */
+void history_tick(uint32_t local_seconds)
+{
+    uint16_t day = (uint16_t)(local_seconds / 86400);
+    uint16_t minute = (uint16_t)((local_seconds % 86400) / 60);
+    int16_t values[HISTORY_SERIES_COUNT];
+    unsigned long steps;
+    DHT11_Data_TypeDef dht;
+
+    if (s_history.pool == NULL) {
+        return;
+    }
+    if (s_history.started && day == s_history.day && minute == s_history.minute) {
+        return;
+    }
+
+    // 采样刚结束的一分钟（读DHT11约25ms，不持锁）
+    steps = simple_pedometer_get_steps();
+    values[HISTORY_SERIES_STEPS] = (int16_t)((steps >= s_history.last_steps) ?
+                                             (steps - s_history.last_steps) : steps);
+    s_history.last_steps = steps;
+    if (Read_DHT11(&dht) == 0) {
+        values[HISTORY_SERIES_TEMP] = (int16_t)(dht.temp_int * 10 + dht.temp_deci);
+        values[HISTORY_SERIES_HUMI] = (int16_t)(dht.humi_int * 10 + dht.humi_deci);
+    } else {
+        values[HISTORY_SERIES_TEMP] = HISTORY_NO_DATA;
+        values[HISTORY_SERIES_HUMI] = HISTORY_NO_DATA;
+    }
+
+    xSemaphoreTake(s_history.mutex, portMAX_DELAY);
+
+    if (!s_history.started) {
+        // 开机后的第一个整分钟之前的数据不完整，不记录
+        history_start_day(day, minute);
+        s_history.started = 1;
+    } else {
+        history_close_minute(values);
+
+        if (day == s_history.day && minute >= s_history.minute) {
+            history_fill_to(minute);
+        } else {
+            // 跨天或时间被调回：当天收尾写入日志，从新时间重新开始
+            if (day > s_history.day) {
+                history_fill_to(HISTORY_MINUTES_PER_DAY);
+            }
+            history_finish_day();
+            history_start_day(day, minute);
+        }
+    }
+
+    xSemaphoreGive(s_history.mutex);
+}
+
+/**
+ * @brief 按顺序遍历当天的分钟数据（不需要调用方提供缓冲区）
+ * @param series 序列
+ * @param first_minute 起始分钟（0~1439）
+ * @param count 分钟数
+ * @param visit 每个样本的回调（未记录的分钟为 HISTORY_NO_DATA）
+ * @param ctx 回调参数
+ * @return 遍历的样本数，-1-参数错误
+ */
+int history_visit_minutes(history_series_t series, uint16_t first_minute, uint16_t count,
+                          history_visit_t visit, void *ctx)
+{
+    history_dec_t dec;
+    uint16_t index = 0;
+    uint16_t n = 0;
+    int16_t value;
+
+    if (series >= HISTORY_SERIES_COUNT || visit == NULL || s_history.pool == NULL ||
+        first_minute >= HISTORY_MINUTES_PER_DAY) {
+        return -1;
+    }
+    if (count > HISTORY_MINUTES_PER_DAY - first_minute) {
+        count = HISTORY_MINUTES_PER_DAY - first_minute;
+    }
+
+    xSemaphoreTake(s_history.mutex, portMAX_DELAY);
+
+    history_dec_init_enc(&dec, &s_history.series[series]);
+    while (n < count && history_dec_next(&dec, &value) == 0) {
+        if (index >= first_minute) {
+            visit(ctx, value);
+            n++;
+        }
+        index++;
+    }
+    for (; n < count; n++) {
+        visit(ctx, HISTORY_NO_DATA);
+    }
+
+    xSemaphoreGive(s_history.mutex);
+    return n;
+}
+
+/**
+ * @brief 写入数组的遍历回调
+ */
+static void history_visit_store(void *ctx, int16_t value)
+{
+    int16_t **out = (int16_t **)ctx;
+
+    *(*out)++ = value;
+}
+
+/**
+ * @brief 查询当天的分钟数据
+ * @param series 序列
+ * @param first_minute 起始分钟（0~1439）
+ * @param count 分钟数
+ * @param out 输出（未记录的分钟为 HISTORY_NO_DATA）
+ * @return 输出的样本数，-1-参数错误
+ */
+int history_query_minutes(history_series_t series, uint16_t first_minute, uint16_t count, int16_t *out)
+{
+    if (out == NULL) {
+        return -1;
+    }
+    return history_visit_minutes(series, first_minute, count, history_visit_store, &out);
+}
+
+/**
+ * @brief 查询某一天的小时数据（当天取RAM，之前的日期取Flash日志）
+ * @param series 序列
+ * @param day 日期（自2000-01-01起的天数）
+ * @param first_hour 起始小时
+ * @param count 小时数
+ * @param out 输出（无数据的小时为 HISTORY_NO_DATA）
+ * @return 输出的样本数，-1-参数错误，-2-日志中没有该日期
+ */
+int history_query_hours(history_series_t series, uint16_t day, uint8_t first_hour, uint8_t count, int16_t *out)
+{
+    history_dec_t dec;
+    const history_log_header_t *hdr;
+    uint32_t addr;
+    uint16_t index;
+    uint16_t start;
+    uint8_t n = 0;
+    uint8_t current;
+    int16_t value;
+
+    if (series >= HISTORY_SERIES_COUNT || out == NULL || s_history.pool == NULL ||
+        first_hour >= HISTORY_HOURS_PER_DAY) {
+        return -1;
+    }
+    if (count > HISTORY_HOURS_PER_DAY - first_hour) {
+        count = HISTORY_HOURS_PER_DAY - first_hour;
+    }
+
+    xSemaphoreTake(s_history.mutex, portMAX_DELAY);
+
+    if (s_history.started && day == s_history.day) {
+        current = (uint8_t)(s_history.minute / 60);
+        for (n = 0; n < count; n++) {
+            out[n] = (first_hour + n == current) ? history_hour_value(series) :
+                     s_history.hour[series][first_hour + n];
+        }
+        xSemaphoreGive(s_history.mutex);
+        return n;
+    }
+
+    history_log_scan(day, &addr, NULL);
+    xSemaphoreGive(s_history.mutex);
+    if (addr == 0) {
+        return -2;
+    }
+
+    // 负载按序列依次排列，顺序解码到所需区间
+    hdr = (const history_log_header_t *)addr;
+    history_dec_init(&dec, (const uint8_t *)(addr + sizeof(history_log_header_t)), hdr->len);
+    start = (uint16_t)series * HISTORY_HOURS_PER_DAY + first_hour;
+    for (index = 0; n < count && history_dec_next(&dec, &value) == 0; index++) {
+        if (index >= start) {
+            out[n++] = value;
+        }
+    }
+    while (n < count) {
+        out[n++] = HISTORY_NO_DATA;
+    }
+    return n;
+}
+
+/**
+ * @brief 获取历史记录统计信息
+ * @param stats 输出
+ */
+void history_get_stats(history_stats_t *stats)
+{
+    uint8_t i;
+
+    if (stats == NULL) {
+        return;
+    }
+    memset(stats, 0, sizeof(*stats));
+    if (s_history.pool == NULL) {
+        return;
+    }
+
+    xSemaphoreTake(s_history.mutex, portMAX_DELAY);
+    stats->today = s_history.day;
+    stats->minutes = s_history.minute;
+    for (i = 0; i < HISTORY_SERIES_COUNT; i++) {
+        stats->bytes[i] = s_history.series[i].len;
+    }
+    stats->overflow = s_history.overflow;
+    history_log_scan(0xFFFF, NULL, stats);
+    xSemaphoreGive(s_history.mutex);
+}
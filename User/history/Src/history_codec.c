@@ -0,0 +1,290 @@
+/**
+ * @file history_codec.c
+ * @brief 时间序列压缩编码实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "history_codec.h"
+#include <stddef.h>
+
+// ==================================
+// 基础编码
+// ==================================
+
+/**
+ * @brief ZigZag映射：0,-1,1,-2,2... → 0,1,2,3,4...
+ */
+uint32_t history_zigzag_encode(int32_t value)
+{
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+/**
+ * @brief ZigZag逆映射
+ */
+int32_t history_zigzag_decode(uint32_t value)
+{
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+/**
+ * @brief 写入一个Varint
+ * @param buf 缓冲区
+ * @param cap 缓冲区容量
+ * @param pos 写入位置（成功后后移）
+ * @param value 数值
+ * @return 0-成功，-1-空间不足（pos不变）
+ */
+int history_varint_put(uint8_t *buf, uint16_t cap, uint16_t *pos, uint32_t value)
+{
+    uint16_t p = *pos;
+
+    do {
+        if (p >= cap) {
+            return -1;
+        }
+        buf[p++] = (uint8_t)((value & 0x7F) | (value > 0x7F ? 0x80 : 0));
+        value >>= 7;
+    } while (value != 0);
+
+    *pos = p;
+    return 0;
+}
+
+/**
+ * @brief 读取一个Varint
+ * @param buf 缓冲区
+ * @param len 数据长度
+ * @param pos 读取位置（成功后后移）
+ * @param value 输出数值
+ * @return 0-成功，-1-数据截断，-2-格式错误（超过5字节）
+ */
+int history_varint_get(const uint8_t *buf, uint16_t len, uint16_t *pos, uint32_t *value)
+{
+    uint16_t p = *pos;
+    uint32_t result = 0;
+    uint8_t shift = 0;
+    uint8_t byte;
+
+    do {
+        if (p >= len) {
+            return -1;
+        }
+        if (shift > 28) {
+            return -2;
+        }
+        byte = buf[p++];
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+
+    *pos = p;
+    *value = result;
+    return 0;
+}
+
+// ==================================
+// 流式编码器
+// ==================================
+
+/**
+ * @brief 初始化编码器
+ * @param enc 编码器
+ * @param buf 输出缓冲区
+ * @param cap 缓冲区容量
+ */
+void history_enc_init(history_enc_t *enc, uint8_t *buf, uint16_t cap)
+{
+    enc->buf = buf;
+    enc->cap = cap;
+    enc->len = 0;
+    enc->count = 0;
+    enc->run = 0;
+    enc->last = 0;
+}
+
+/**
+ * @brief 写出尚未落盘的游程
+ * @param enc 编码器
+ * @return 0-成功，-1-空间不足
+ */
+int history_enc_flush(history_enc_t *enc)
+{
+    if (enc->run == 0) {
+        return 0;
+    }
+    if (history_varint_put(enc->buf, enc->cap, &enc->len, ((uint32_t)enc->run << 1) | 1) != 0) {
+        return -1;
+    }
+    enc->run = 0;
+    return 0;
+}
+
+/**
+ * @brief 追加一个样本
+ * @param enc 编码器
+ * @param value 样本
+ * @return 0-成功，-1-空间不足（样本未写入，编码器状态不变）
+ */
+int history_enc_put(history_enc_t *enc, int16_t value)
+{
+    uint16_t saved_len = enc->len;
+    uint16_t saved_run = enc->run;
+
+    if (enc->count == 0xFFFF) {
+        return -1;
+    }
+
+    // 与前值相同：只增加游程，不占空间
+    if (enc->count > 0 && value == enc->last) {
+        enc->run++;
+        enc->count++;
+        return 0;
+    }
+
+    if (history_enc_flush(enc) != 0 ||
+        history_varint_put(enc->buf, enc->cap, &enc->len,
+                           history_zigzag_encode((int32_t)value - enc->last) << 1) != 0) {
+        enc->len = saved_len;
+        enc->run = saved_run;
+        return -1;
+    }
+
+    enc->last = value;
+    enc->count++;
+    return 0;
+}
+
+// ==================================
+// 流式解码器
+// ==================================
+
+/**
+ * @brief 初始化解码器（已完整写出的编码数据）
+ * @param dec 解码器
+ * @param buf 编码数据
+ * @param len 数据长度
+ */
+void history_dec_init(history_dec_t *dec, const uint8_t *buf, uint16_t len)
+{
+    dec->buf = buf;
+    dec->len = len;
+    dec->pos = 0;
+    dec->run = 0;
+    dec->tail_run = 0;
+    dec->last = 0;
+}
+
+/**
+ * @brief 从正在追加的编码器初始化解码器（包含尚未写出的游程）
+ * @param dec 解码器
+ * @param enc 编码器
+ */
+void history_dec_init_enc(history_dec_t *dec, const history_enc_t *enc)
+{
+    history_dec_init(dec, enc->buf, enc->len);
+    dec->tail_run = enc->run;
+}
+
+/**
+ * @brief 解码下一个样本
+ * @param dec 解码器
+ * @param value 输出样本
+ * @return 0-成功，-1-数据结束，-2-格式错误
+ */
+int history_dec_next(history_dec_t *dec, int16_t *value)
+{
+    uint32_t token;
+
+    if (dec->run == 0) {
+        if (dec->pos >= dec->len) {
+            if (dec->tail_run == 0) {
+                return -1;
+            }
+            dec->run = dec->tail_run;
+            dec->tail_run = 0;
+        } else {
+            if (history_varint_get(dec->buf, dec->len, &dec->pos, &token) != 0) {
+                return -2;
+            }
+            if (token & 1) {
+                dec->run = (uint16_t)(token >> 1);
+                if (dec->run == 0) {
+                    return -2;
+                }
+            } else {
+                dec->last = (int16_t)((int32_t)dec->last + history_zigzag_decode(token >> 1));
+                *value = dec->last;
+                return 0;
+            }
+        }
+    }
+
+    dec->run--;
+    *value = dec->last;
+    return 0;
+}
+
+// ==================================
+// 整块编解码
+// ==================================
+
+/**
+ * @brief 编码一段样本
+ * @param values 样本数组
+ * @param count 样本数
+ * @param out 输出缓冲区
+ * @param cap 缓冲区容量
+ * @return 编码后的字节数，-1-空间不足
+ */
+int history_codec_encode(const int16_t *values, uint16_t count, uint8_t *out, uint16_t cap)
+{
+    history_enc_t enc;
+    uint16_t i;
+
+    if (values == NULL || out == NULL) {
+        return -1;
+    }
+
+    history_enc_init(&enc, out, cap);
+    for (i = 0; i < count; i++) {
+        if (history_enc_put(&enc, values[i]) != 0) {
+            return -1;
+        }
+    }
+    if (history_enc_flush(&enc) != 0) {
+        return -1;
+    }
+    return enc.len;
+}
+
+/**
+ * @brief 解码一段样本
+ * @param in 编码数据
+ * @param len 数据长度
+ * @param values 输出数组
+ * @param max_count 输出数组容量
+ * @return 解码的样本数，-1-格式错误，-2-样本数超过容量
+ */
+int history_codec_decode(const uint8_t *in, uint16_t len, int16_t *values, uint16_t max_count)
+{
+    history_dec_t dec;
+    uint16_t count = 0;
+    int16_t value;
+    int ret;
+
+    if (in == NULL || values == NULL) {
+        return -1;
+    }
+
+    history_dec_init(&dec, in, len);
+    while ((ret = history_dec_next(&dec, &value)) == 0) {
+        if (count >= max_count) {
+            return -2;
+        }
+        values[count++] = value;
+    }
+    return (ret == -1) ? count : -1;
+}
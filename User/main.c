@@ -8,13 +8,24 @@
 #include "beep.h"
 #include "oled_print.h"
 #include "rtc_date.h"
+#include "rtc_clock.h"
+#include "rtc_mono.h"
 #include "dht11.h"
 #include "queue.h"
 #include "unified_menu.h"
 #include "index.h"
+#include "menu_tree.h"
 #include "MPU6050_hardware_i2c.h"
 #include "simple_pedometer.h"
+#include "imu_attitude.h"
+#include "mpu_calib.h"
+#include "sensor_trace.h"
+#include "step_detector.h"
+#include "activity.h"
 #include "alarm/Inc/alarm_alert.h"
+#include "alarm/Inc/alarm_sched.h"
+#include "history/Inc/history.h"
+#include "display_tools.h"
 
 
 // 洢¼
@@ -70,10 +81,16 @@ int main(void)
 		printf("MPU6050 Device ID OK\r\n");
 	}
 	
+	// شУ׼
+	mpu_calib_init();
+	
 	// ʼ򵥼Ʋ
 	simple_pedometer_init();
 	printf("Simple pedometer initialized\r\n");
 	
+	// ʼRTCҳʾʱ䣬ʱ״ʱȴLSE
+	MyRTC_Init();
+	
     // ϵͳʼɹ
     printf("wait for sys OK...\n");
     OLED_Clear();
@@ -88,28 +105,33 @@ int main(void)
         return -1;
     }
     
-    // ʼҳ
-    menu_item_t* index_menu = index_init();
-    if (index_menu == NULL) {
-        printf("Index page initialization failed\r\n");
+    // ·˵ǳ贴ҳ״νʱ죩
+    menu_tree_init();
+    
+    // ҳΪ˵ֻҳ
+    g_menu_sys.root_menu = g_menu_nodes[MENU_ID_ROOT];
+    g_menu_sys.current_menu = g_menu_nodes[MENU_ID_ROOT];
+    if (menu_page_create(g_menu_sys.root_menu) != 0) {
+        printf("Root page creation failed\r\n");
         return -1;
     }
-    
-    // ҳΪ˵
-    g_menu_sys.root_menu = index_menu;
-    g_menu_sys.current_menu = index_menu;
 
     printf("root_menu init OK\n");
     /* ˵ */
     xTaskCreate((TaskFunction_t)Menu_Main_Task,          /*  */
                 (const char *)"Menu_Main",               /*  */
-                (uint16_t)2024,                          /* ջС */
+                (uint16_t)1024,                          /* ջС̬Լ2KBMENU_TASK_PROFILEӡʵ */
                 (void *)NULL,                           /*  */
                 (UBaseType_t)3,                         /* ȼ */
                 (TaskHandle_t *)&Menu_handle);           /* ƾ */
     xTaskCreate(Key_Main_Task, "KeyMain", 128, NULL, 4, &Key_handle);
-    xTaskCreate(Pedometer_Task, "Pedometer", 128, NULL, 2, &Pedometer_handle);
-    xTaskCreate(Alarm_Task, "Alarm", 128, NULL, 3, &Alarm_handle);
+    xTaskCreate(Pedometer_Task, "Pedometer", 192, NULL, 2, &Pedometer_handle);
+    xTaskCreate(Alarm_Task, "Alarm", 192, NULL, 3, &Alarm_handle);
+    
+    // ʾкռOLEDߣ display_* 
+    if (display_server_init() != 0) {
+        printf("Display server initialization failed\r\n");
+    }
     
     printf("creat task OK\n");
     
@@ -143,17 +165,45 @@ static void Pedometer_Task(void *pvParameters)
     
     // ڴ洢MPU6050
     short ax, ay, az;
+    short gx, gy, gz;
     uint8_t mpu_status;
     
-    const TickType_t delay_100ms = pdMS_TO_TICKS(100);
+    // MPUУÿ̬֡ƺͼƲ
+    const TickType_t sample_period = pdMS_TO_TICKS(1000 / MPU_SAMPLE_RATE_HZ);
+    TickType_t last_wake = xTaskGetTickCount();
+    uint32_t last_sample = RTC_Mono_Ms();
+    
+    imu_attitude_init(MPU_SAMPLE_RATE_HZ);
+    step_detector_init(MPU_SAMPLE_RATE_HZ);
+    activity_init(MPU_SAMPLE_RATE_HZ);
     
     while (1) {
-        // ȡMPU6050ٶ
-        mpu_status = MPU_Get_Accelerometer(&ax, &ay, &az);
+        // һζȡ
+        mpu_status = MPU_Get_Motion6(&ax, &ay, &az, &gx, &gy, &gz);
         
         if (mpu_status == 0) {  // ȡɹ
-            // ¼Ʋ
-            simple_pedometer_update(ax, ay, az);
+            // ʱȡRTC룬ܵ͵͹ͣӰ
+            uint32_t now = RTC_Mono_Ms();
+            
+            // У׼ɼδУ׼ʱأ
+            mpu_calib_feed(ax, ay, az, gx, gy, gz);
+            
+            // ץδץʱأ
+            sensor_trace_feed(now, ax, ay, az, gx, gy, gz);
+            
+            // ̬
+            imu_attitude_update(ax, ay, az, gx, gy, gz,
+                                (uint16_t)(now - last_sample));
+            last_sample = now;
+            
+            // ¼Ʋʵʱڣ
+            simple_pedometer_update(ax, ay, az, now);
+            
+            // ӦƲˮߣ򵥼ƲУڶԱȣ
+            step_detector_update(ax, ay, az, now);
+            
+            // ˶״̬ʶʹ step_detector ķͳƣã
+            activity_update(ax, ay, az, now);
         } else {
             // ȡʧܣӡϢ
             static uint8_t error_count = 0;
@@ -170,19 +220,20 @@ printf("try init agin\n");
 	if (device_id != MPU_ADDR)
 	{
 		printf("MPU6050 Device ID Mismatch!\r\n");
-		OLED_Printf_Line(1, "MPU ID Error!");
-		OLED_Refresh();
+		display_print_line(1, "MPU ID Error!");
 		Delay_ms(2000);
 	}
 	else
 	{
 		printf("MPU6050 Device ID OK\r\n");
 	}
+                // ³ʼ̬Ҫ
+                imu_attitude_reset();
+                last_sample = RTC_Mono_Ms();
             }
         }
         
-        // ÿ100msִһ
-        vTaskDelay(delay_100ms);
+        vTaskDelayUntil(&last_wake, sample_period);
     }
 }
 
@@ -194,24 +245,39 @@ static void Alarm_Task(void *pvParameters)
 {
     printf("Alarm_Task started\n");
     
-    // ʼRTC
-    MyRTC_Init();
-    printf("RTC initialized for alarm checking\n");
+    // RTCʱʼ
+
+    // ʷ¼Լ1KBRTCʼ¼
+    history_init();
     // RTC_SetTime_Manual(23,59,40);
-    const TickType_t delay_1s = pdMS_TO_TICKS(1000); // 1һ
+
+    // ʱԤʱл֮ʱֻ
+    RTC_TZ_Init();
+
+    // ʱӣRTCжƽʱ䣬/¼ѱ񣬲ÿѯ
+    RTC_Clock_Init();
+    Alarm_Sched_Init(xTaskGetCurrentTaskHandle());
+    Alarm_Reschedule(MyRTC_GetLocalSeconds());
     
     while (1) {
-        // Ƿ񴥷
-        int triggered_alarm_index = Alarm_Check();
+        uint32_t now = MyRTC_GetLocalSeconds();
+        uint32_t wake;
+        int triggered_alarm_id;
+
+        // ʱ䱻޸Ĺʱ¼
+        if (Alarm_Sched_Take_Time_Changed()) {
+            Alarm_Reschedule(now);
+        }
         
-        if (triggered_alarm_index >= 0) {
-            printf("Alarm triggered! Index: %d\n", triggered_alarm_index);
+        // ѵڵӣʱڲ촰ڵҲᴥ
+        while ((triggered_alarm_id = Alarm_Check(now)) >= 0) {
+            printf("Alarm triggered! ID: %04X\n", triggered_alarm_id);
             
             // ¼͵˵
             menu_event_t alarm_event;
             alarm_event.type = MENU_EVENT_ALARM;
             alarm_event.timestamp = xTaskGetTickCount();
-            alarm_event.param = (uint8_t)triggered_alarm_index;
+            alarm_event.param = (uint16_t)triggered_alarm_id;
             
             // ¼˵¼
             if (xQueueSend(g_menu_sys.event_queue, &alarm_event, 0) == pdPASS) {
@@ -221,7 +287,11 @@ static void Alarm_Task(void *pvParameters)
             }
         }
         
-        // ÿһ
-        vTaskDelay(delay_1s);
+        // ÿӼ¼һβʪ
+        history_tick(now);
+
+        // ˯һӣʱ¼ѣʷ¼
+        wake = Alarm_NextFire();
+        Alarm_Sched_Wait(wake);
     }
 }
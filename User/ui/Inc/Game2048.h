@@ -15,7 +15,7 @@
 #include "unified_menu.h"
 #include "oled_print.h"
 #include "Key.h"
-#include "MPU6050_hardware_i2c.h"
+#include "imu_attitude.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -26,6 +26,7 @@
 // ==================================
 
 #define BOARD_SIZE 4
+#define GAME2048_REFRESH_MS 100         // 体感控制采样/重绘间隔
 #define GAME2048_DIRECTION_TEXT_LEN 16
 #define GAME2048_ANGLE_TEXT_LEN     16
 
@@ -38,9 +39,9 @@ typedef enum {
 
 // 显示模式
 typedef enum {
-    DISPLAY_MODE_NORMAL = 0,    // 正常模式
-    DISPLAY_MODE_SIMPLE = 1,    // 简洁模式
-    DISPLAY_MODE_MAX
+    GAME_DISPLAY_MODE_NORMAL = 0,    // 正常模式
+    GAME_DISPLAY_MODE_SIMPLE = 1,    // 简洁模式
+    GAME_DISPLAY_MODE_MAX
 } game_display_mode_t;
 
 // ==================================
@@ -56,8 +57,8 @@ typedef struct game2048_state {
     // 传感器数据
     float angle_x;           // X轴角度（前后倾斜）
     float angle_y;           // Y轴角度（左右倾斜）
-    float last_angle_x;      // 上次X轴角度（用于平滑显示）
-    float last_angle_y;      // 上次Y轴角度（用于平滑显示）
+    float last_angle_x;      // 当前使用的X轴角度
+    float last_angle_y;      // 当前使用的Y轴角度
     
     // 显示控制
     uint8_t need_refresh;    // 需要刷新标志
@@ -77,14 +78,15 @@ typedef struct game2048_state {
 // 函数声明
 // ==================================
 
-// 初始化与销毁函数
-menu_item_t* game2048_init(void);
-void game2048_deinit(menu_item_t* item);
+// 页面节点（常量）
+extern const menu_item_t g_game2048_page;
 
 // 回调函数
-void game2048_on_enter(menu_item_t* item);
-void game2048_on_exit(menu_item_t* item);
-void game2048_key_handler(menu_item_t* item, uint8_t key_event);
+int8_t game2048_on_create(const menu_item_t *item);
+void game2048_on_destroy(const menu_item_t *item);
+void game2048_on_enter(const menu_item_t *item);
+void game2048_on_exit(const menu_item_t *item);
+void game2048_key_handler(const menu_item_t *item, uint8_t key_event);
 void game2048_draw_function(void* context);
 
 // 游戏逻辑函数
@@ -95,7 +97,6 @@ int game2048_is_game_over(game2048_state_t* state);
 
 // 传感器数据处理函数
 void game2048_update_sensor_data(game2048_state_t* state);
-void game2048_calculate_tilt_angles(short ax, short ay, short az, float* angle_x, float* angle_y);
 int game2048_get_move_direction(game2048_state_t* state);
 
 // 显示函数
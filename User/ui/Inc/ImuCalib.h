@@ -0,0 +1,62 @@
+#ifndef _IMUCALIB_H_
+#define _IMUCALIB_H_
+
+#include "stm32f10x.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "unified_menu.h"
+#include "oled_print.h"
+#include "mpu_calib.h"
+
+// 保存页位于所有采集步骤之后
+#define IMUCALIB_STEP_SAVE   MPU_CALIB_STEP_COUNT
+
+// 采集进度重绘间隔（毫秒）
+#define IMUCALIB_REFRESH_MS  100
+
+typedef struct{
+    // 校准状态
+    uint8_t step;               // 当前步骤：0~5=六面加速度，6=陀螺仪，7=保存
+    uint8_t saved;              // 本次会话是否已保存
+    int8_t result;              // 保存结果（mpu_calib_finish返回值）
+    uint8_t capturing;          // 当前步骤正在采集，完成后自动进入下一步
+
+    // 刷新标志
+    uint8_t need_refresh;       // 需要刷新
+    uint32_t last_update;       // 上次更新时间
+}ImuCalib_state_t;
+
+extern const menu_item_t g_ImuCalib_page;       // 页面节点（常量）
+
+/**
+ * @brief 构造传感器校准页面（首次进入时由菜单框架调用）
+ * @return 0-成功
+ */
+int8_t ImuCalib_on_create(const menu_item_t *item);
+
+/**
+ * @brief 校准页面自定义绘制函数
+ * @param context 绘制上下文
+ */
+void ImuCalib_draw_function(void* context);
+
+/**
+ * @brief 校准页面按键处理函数
+ * @param item 菜单项
+ * @param key_event 按键事件
+ */
+void ImuCalib_key_handler(const menu_item_t *item, uint8_t key_event);
+
+/**
+ * @brief 进入校准页面时的回调
+ * @param item 菜单项
+ */
+void ImuCalib_on_enter(const menu_item_t *item);
+
+/**
+ * @brief 退出校准页面时的回调
+ * @param item 菜单项
+ */
+void ImuCalib_on_exit(const menu_item_t *item);
+
+#endif
@@ -8,6 +8,7 @@
 #include "unified_menu.h"
 #include "oled_print.h"
 #include "rtc_date.h"
+#include "rtc_clock.h"
 
 typedef struct{
     // 日期设置状态
@@ -29,11 +30,13 @@ typedef struct{
  */
 uint8_t get_max_days_in_month(u8 year, u8 month);
 
+extern const menu_item_t g_SetDate_page;       // 页面节点（常量）
+
 /**
- * @brief 初始化日期设置页面
- * @return 创建的日期设置菜单项指针
+ * @brief 构造日期设置页面（首次进入时由菜单框架调用）
+ * @return 0-成功
  */
-menu_item_t* SetDate_init(void);
+int8_t SetDate_on_create(const menu_item_t *item);
 
 /**
  * @brief 日期设置自定义绘制函数
@@ -46,7 +49,7 @@ void SetDate_draw_function(void* context);
  * @param item 菜单项
  * @param key_event 按键事件
  */
-void SetDate_key_handler(menu_item_t* item, uint8_t key_event);
+void SetDate_key_handler(const menu_item_t *item, uint8_t key_event);
 
 /**
  * @brief 获取日期设置状态
@@ -63,12 +66,12 @@ void SetDate_refresh_display(void);
  * @brief 进入日期设置页面时的回调
  * @param item 菜单项
  */
-void SetDate_on_enter(menu_item_t* item);
+void SetDate_on_enter(const menu_item_t *item);
 
 /**
  * @brief 退出日期设置页面时的回调
  * @param item 菜单项
  */
-void SetDate_on_exit(menu_item_t* item);
+void SetDate_on_exit(const menu_item_t *item);
 
 #endif
@@ -8,6 +8,7 @@
 #include "unified_menu.h"
 #include "oled_print.h"
 #include "rtc_date.h"
+#include "rtc_clock.h"
 
 typedef struct{
     // 时间设置状态
@@ -21,11 +22,13 @@ typedef struct{
     uint32_t last_update;       // 上次更新时间
 }SetTime_state_t;
 
+extern const menu_item_t g_SetTime_page;       // 页面节点（常量）
+
 /**
- * @brief 初始化时间设置页面
- * @return 创建的时间设置菜单项指针
+ * @brief 构造时间设置页面（首次进入时由菜单框架调用）
+ * @return 0-成功
  */
-menu_item_t* SetTime_init(void);
+int8_t SetTime_on_create(const menu_item_t *item);
 
 /**
  * @brief 时间设置自定义绘制函数
@@ -38,7 +41,7 @@ void SetTime_draw_function(void* context);
  * @param item 菜单项
  * @param key_event 按键事件
  */
-void SetTime_key_handler(menu_item_t* item, uint8_t key_event);
+void SetTime_key_handler(const menu_item_t *item, uint8_t key_event);
 
 /**
  * @brief 获取时间设置状态
@@ -55,12 +58,12 @@ void SetTime_refresh_display(void);
  * @brief 进入时间设置页面时的回调
  * @param item 菜单项
  */
-void SetTime_on_enter(menu_item_t* item);
+void SetTime_on_enter(const menu_item_t *item);
 
 /**
  * @brief 退出时间设置页面时的回调
  * @param item 菜单项
  */
-void SetTime_on_exit(menu_item_t* item);
+void SetTime_on_exit(const menu_item_t *item);
 
 #endif
@@ -8,6 +8,12 @@
 #include "unified_menu.h"
 #include "oled_print.h"
 #include "../../Hardware/MPU6050/simple_pedometer.h"
+#include "../../Hardware/MPU6050/step_detector.h"
+#include "../../Hardware/MPU6050/activity.h"
+#include "history_page.h"
+
+// 步数重绘间隔（毫秒）
+#define STEPCOUNTER_REFRESH_MS 500
 
 // 步数界面状态结构体
 typedef struct {
@@ -19,11 +25,13 @@ typedef struct {
     uint8_t show_reset_confirm; // 是否显示重置确认
 } StepCounter_state_t;
 
+extern const menu_item_t g_StepCounter_page;       // 页面节点（常量）
+
 /**
- * @brief 初始化步数页面
- * @return 创建的步数菜单项指针
+ * @brief 构造步数页面（首次进入时由菜单框架调用）
+ * @return 0-成功
  */
-menu_item_t* StepCounter_init(void);
+int8_t StepCounter_on_create(const menu_item_t *item);
 
 /**
  * @brief 步数自定义绘制函数
@@ -36,7 +44,7 @@ void StepCounter_draw_function(void* context);
  * @param item 菜单项
  * @param key_event 按键事件
  */
-void StepCounter_key_handler(menu_item_t* item, uint8_t key_event);
+void StepCounter_key_handler(const menu_item_t *item, uint8_t key_event);
 
 /**
  * @brief 获取步数状态
@@ -53,12 +61,12 @@ void StepCounter_refresh_display(void);
  * @brief 进入步数页面时的回调
  * @param item 菜单项
  */
-void StepCounter_on_enter(menu_item_t* item);
+void StepCounter_on_enter(const menu_item_t *item);
 
 /**
  * @brief 退出步数页面时的回调
  * @param item 菜单项
  */
-void StepCounter_on_exit(menu_item_t* item);
+void StepCounter_on_exit(const menu_item_t *item);
 
 #endif
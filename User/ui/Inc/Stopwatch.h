@@ -7,14 +7,15 @@
 #include "queue.h"
 #include "unified_menu.h"
 #include "oled_print.h"
+#include "rtc_mono.h"
 
-// 秒表更新间隔（毫秒）
-#define STOPWATCH_UPDATE_INTERVAL 10
+// 秒表运行时的重绘间隔（毫秒），暂停时不重绘
+#define STOPWATCH_UPDATE_INTERVAL 40
 
 typedef struct{
     // 秒表状态
     uint8_t running;             // 是否正在运行
-    uint32_t start_time;         // 开始时间
+    uint32_t start_time;         // 开始时间（RTC单调毫秒，调度器挂起时也在走）
     uint32_t pause_time;         // 累计暂停时间
     uint32_t elapsed_time;       // 已用时间（毫秒）
     
@@ -23,11 +24,13 @@ typedef struct{
     uint32_t last_update;       // 上次更新时间
 }Stopwatch_state_t;
 
+extern const menu_item_t g_Stopwatch_page;       // 页面节点（常量）
+
 /**
- * @brief 初始化秒表页面
- * @return 创建的秒表菜单项指针
+ * @brief 构造秒表页面（首次进入时由菜单框架调用）
+ * @return 0-成功
  */
-menu_item_t* Stopwatch_init(void);
+int8_t Stopwatch_on_create(const menu_item_t *item);
 
 /**
  * @brief 秒表自定义绘制函数
@@ -40,7 +43,7 @@ void Stopwatch_draw_function(void* context);
  * @param item 菜单项
  * @param key_event 按键事件
  */
-void Stopwatch_key_handler(menu_item_t* item, uint8_t key_event);
+void Stopwatch_key_handler(const menu_item_t *item, uint8_t key_event);
 
 /**
  * @brief 获取秒表状态
@@ -57,12 +60,12 @@ void Stopwatch_refresh_display(void);
  * @brief 进入秒表页面时的回调
  * @param item 菜单项
  */
-void Stopwatch_on_enter(menu_item_t* item);
+void Stopwatch_on_enter(const menu_item_t *item);
 
 /**
  * @brief 退出秒表页面时的回调
  * @param item 菜单项
  */
-void Stopwatch_on_exit(menu_item_t* item);
+void Stopwatch_on_exit(const menu_item_t *item);
 
 #endif
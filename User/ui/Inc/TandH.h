@@ -9,6 +9,10 @@
 #include "oled_print.h"
 
 #include "dht11.h"
+#include "history_page.h"
+
+// 温湿度重绘间隔（毫秒），DHT11 两次读取至少间隔1秒
+#define TANDH_REFRESH_MS 1000
 
 
 
@@ -35,11 +39,13 @@ typedef struct{
 
 
 
+extern const menu_item_t g_TandH_page;       // 页面节点（常量）
+
 /**
- * @brief 初始化温湿度页面
- * @return 创建的温湿菜单项指针
+ * @brief 构造温湿度页面（首次进入时由菜单框架调用）
+ * @return 0-成功
  */
-menu_item_t* TandH_init(void);
+int8_t TandH_on_create(const menu_item_t *item);
 
 /**
  * @brief 温湿度自定义绘制函数
@@ -48,7 +54,7 @@ menu_item_t* TandH_init(void);
 void TandH_draw_function(void* context);
 
 
-void TandH_key_handler(menu_item_t* item, uint8_t key_event);
+void TandH_key_handler(const menu_item_t *item, uint8_t key_event);
 
 void TandH_update_dht11(void);
 
@@ -56,8 +62,8 @@ TandH_state_t* TandH_get_state(void);
 
 void TandH_refresh_display(void);
 
-void TandH_on_enter(menu_item_t* item);
+void TandH_on_enter(const menu_item_t *item);
 
-void TandH_on_exit(menu_item_t* item);
+void TandH_on_exit(const menu_item_t *item);
 
 #endif
@@ -15,7 +15,7 @@
 #include "unified_menu.h"
 #include "oled_print.h"
 #include "Key.h"
-#include "MPU6050_hardware_i2c.h"
+#include "imu_attitude.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -25,6 +25,7 @@
 // 宏定义
 // ==================================
 
+#define AIR_LEVEL_REFRESH_MS         100     // 姿态数据重绘间隔
 #define AIR_LEVEL_DIRECTION_TEXT_LEN 16
 #define AIR_LEVEL_ANGLE_TEXT_LEN     16
 
@@ -43,8 +44,8 @@ typedef struct air_level_state {
     // 传感器数据
     float angle_x;           // X轴角度（前后倾斜）
     float angle_y;           // Y轴角度（左右倾斜）
-    float last_angle_x;      // 上次X轴角度（用于平滑显示）
-    float last_angle_y;      // 上次Y轴角度（用于平滑显示）
+    float last_angle_x;      // 当前显示的X轴角度
+    float last_angle_y;      // 当前显示的Y轴角度
     
     // 显示控制
     uint8_t need_refresh;    // 需要刷新标志
@@ -63,20 +64,17 @@ typedef struct air_level_state {
 // 函数声明
 // ==================================
 
-// 初始化与销毁函数
-menu_item_t* air_level_init(void);
-void air_level_deinit(menu_item_t* item);
+// 页面节点（常量）
+extern const menu_item_t g_air_level_page;
 
 // 回调函数
-void air_level_on_enter(menu_item_t* item);
-void air_level_on_exit(menu_item_t* item);
-void air_level_key_handler(menu_item_t* item, uint8_t key_event);
+void air_level_on_enter(const menu_item_t *item);
+void air_level_on_exit(const menu_item_t *item);
+void air_level_key_handler(const menu_item_t *item, uint8_t key_event);
 void air_level_draw_function(void* context);
 
 // 数据处理函数
 void air_level_update_data(air_level_state_t* state);
-void calculate_tilt_angles(short ax, short ay, short az, 
-                          float* angle_x, float* angle_y);
 
 // 显示函数
 void air_level_display_info(air_level_state_t* state);
@@ -15,6 +15,7 @@
 #include "unified_menu.h"
 #include "oled_print.h"
 #include "alarm_core.h"
+#include "alarm_rule.h"
 #include "Key.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -25,13 +26,17 @@
 // ==================================
 
 #define ALARM_ADD_TEXT_LEN 16
+#define ALARM_ADD_SNOOZE_STEP_MIN 5    // 贪睡间隔调整步长（分钟）
+#define ALARM_ADD_DATE_MAX 36524       // 可设置的最晚日期：2099-12-31（自2000-01-01起的天数）
 
 // 设置步骤枚举
 typedef enum {
     SET_STEP_HOUR = 0,      // 设置小时
     SET_STEP_MINUTE,        // 设置分钟
     SET_STEP_SECOND,        // 设置秒
-    SET_STEP_REPEAT,        // 设置重复
+    SET_STEP_REPEAT,        // 设置重复方式
+    SET_STEP_DATE,          // 设置日期（仅指定日期的闹钟）
+    SET_STEP_SNOOZE,        // 设置贪睡间隔
     SET_STEP_COUNT          // 设置项总数
 } alarm_set_step_t;
 
@@ -58,14 +63,13 @@ typedef struct alarm_add_state {
 // 函数声明
 // ==================================
 
-// 初始化与销毁函数
-menu_item_t* alarm_add_init(void);
-void alarm_add_deinit(menu_item_t* item);
+// 页面节点（常量）
+extern const menu_item_t g_alarm_add_page;
 
 // 回调函数
-void alarm_add_on_enter(menu_item_t* item);
-void alarm_add_on_exit(menu_item_t* item);
-void alarm_add_key_handler(menu_item_t* item, uint8_t key_event);
+void alarm_add_on_enter(const menu_item_t *item);
+void alarm_add_on_exit(const menu_item_t *item);
+void alarm_add_key_handler(const menu_item_t *item, uint8_t key_event);
 void alarm_add_draw_function(void* context);
 
 // 设置函数
@@ -73,6 +77,12 @@ void alarm_add_display_setting(alarm_add_state_t* state);
 void alarm_add_process_setting(alarm_add_state_t* state, uint8_t key_event);
 void alarm_add_save_alarm(alarm_add_state_t* state);
 
+// 设置项函数（新建与编辑页面共用）
+void alarm_add_adjust(Alarm_TypeDef* alarm, uint8_t step, int8_t dir);
+uint8_t alarm_add_next_step(const Alarm_TypeDef* alarm, uint8_t step);
+void alarm_add_show_setting(const Alarm_TypeDef* alarm, uint8_t step);
+int alarm_add_check(const Alarm_TypeDef* alarm);
+
 // 工具函数
 static inline uint8_t alarm_add_need_refresh(alarm_add_state_t* state)
 {
@@ -50,6 +50,7 @@ typedef struct alarm_list_state {
     uint8_t in_detail_view;     // 是否在详情视图
     uint8_t detail_selected;    // 详情页面选中项
     uint8_t operating;          // 是否正在操作
+    alarm_id_t detail_id;       // 详情/编辑中的闹钟ID（列表顺序变化不影响）
     
     // 编辑控制
     uint8_t editing_mode;       // 是否在编辑模式
@@ -65,23 +66,22 @@ typedef struct alarm_list_state {
 // 函数声明
 // ==================================
 
-// 初始化与销毁函数
-menu_item_t* alarm_list_init(void);
-void alarm_list_deinit(menu_item_t* item);
+// 页面节点（常量）
+extern const menu_item_t g_alarm_list_page;
 
 // 回调函数
-void alarm_list_on_enter(menu_item_t* item);
-void alarm_list_on_exit(menu_item_t* item);
-void alarm_list_key_handler(menu_item_t* item, uint8_t key_event);
+void alarm_list_on_enter(const menu_item_t *item);
+void alarm_list_on_exit(const menu_item_t *item);
+void alarm_list_key_handler(const menu_item_t *item, uint8_t key_event);
 void alarm_list_draw_function(void* context);
 
 // 显示函数
 void alarm_list_display_list(alarm_list_state_t* state);
-void alarm_list_display_detail(alarm_list_state_t* state, uint8_t alarm_index);
+void alarm_list_display_detail(alarm_list_state_t* state, alarm_id_t id);
 void alarm_list_display_empty(void);
 
 // 详情处理函数
-void alarm_list_enter_detail(alarm_list_state_t* state, uint8_t alarm_index);
+void alarm_list_enter_detail(alarm_list_state_t* state, alarm_id_t id);
 void alarm_list_exit_detail(alarm_list_state_t* state);
 void alarm_list_process_detail(alarm_list_state_t* state, uint8_t key_event);
 void alarm_list_handle_detail_action(alarm_list_state_t* state);
@@ -21,8 +21,9 @@ typedef enum {
 // ==================================
 // 函数声明
 // ==================================
-menu_item_t* alarm_menu_init(void);
-void alarm_menu_on_enter(menu_item_t* item);
-void alarm_menu_on_exit(menu_item_t* item);
+extern const menu_item_t g_alarm_menu;                          // 闹钟菜单节点（常量）
+extern const menu_item_t g_alarm_menu_items[ALARM_MENU_COUNT];  // 闹钟菜单图标项
+void alarm_menu_on_enter(const menu_item_t *item);
+void alarm_menu_on_exit(const menu_item_t *item);
 
 #endif
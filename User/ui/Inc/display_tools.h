@@ -1,6 +1,17 @@
 /**
- * 用来给显示消息队列用的一些工具函数，目前来说只有17k,故不启用
+ * @file display_tools.h
+ * @brief 显示服务任务：命令队列 + 文本区，每帧合并命令、只送屏一次
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 启动后 OLED 总线只由显示服务任务访问：OLED_Refresh 系列经刷新钩子只标记脏区域，
+ *       服务任务每帧取出脏区域送屏一次。菜单任务照常直接画显存；其他任务用 display_* 接口
+ *       发命令，由服务任务画进显存，不必持有任何锁。
+ *       服务任务优先级低于菜单任务，只在菜单任务阻塞（一帧画完）后运行；
+ *       执行每条命令时挂起调度器，菜单任务不会在半条命令中间改写显存。
+ *       命令固定6字节，文本等负载按需放进环形文本区，不再每条消息带32字节文本
  */
+
 #ifndef _DISP_TOLS_H
 #define _DISP_TOLS_H
 
@@ -8,54 +19,143 @@
 #include <queue.h>
 #include <task.h>
 #include <string.h>
-#include <stdarg.h> 
-QueueHandle_t displayQueue; // 显示队列
+#include <stdarg.h>
+#include <stdio.h>
+#include "oled_print.h"
+
+// ==================================
+// 配置
+// ==================================
 
+#define DISPLAY_QUEUE_LEN           16      // 命令队列深度，也是一帧最多合并的命令数
+#define DISPLAY_ARENA_SIZE          256     // 文本区字节数（文本、进度条参数等负载）
+#define DISPLAY_TEXT_MAX            21      // 每条文本最多字符数（一行 128/6），超出截断
+#define DISPLAY_FRAME_MS            20      // 最短帧间隔：一帧内到达的命令合并后送屏一次
+#define DISPLAY_COMPOSE_TIMEOUT_MS  100     // 合成刷新等待服务任务完成的超时
+#define DISPLAY_TASK_STACK          192     // 服务任务栈（字）
+#define DISPLAY_TASK_PRIORITY       2       // 必须低于菜单任务（3）
+
+// ==================================
+// 显示命令
+// ==================================
 
-// 显示命令类型定义
 typedef enum
 {
+    DISPLAY_CMD_NONE = 0,   // 空（被合并掉的命令）
     DISPLAY_CMD_CLEAR,      // 清屏
-    DISPLAY_CMD_CLEAR_LINE, // 清除指定行
-    DISPLAY_CMD_PRINT_LINE, // 行打印
-    DISPLAY_CMD_PRINT,      // 指定位置打印
-    DISPLAY_CMD_PRINT_32,   // 32px字体行打印
-    DISPLAY_CMD_REFRESH,    // 刷新显示
-    DISPLAY_CMD_PICTURE,    // 显示图片
-    DISPLAY_CMD_PROGRESS_BAR
+    DISPLAY_CMD_CLEAR_LINE, // 清除指定行，x=行号
+    DISPLAY_CMD_PRINT_LINE, // 行打印，x=行号，负载为文本
+    DISPLAY_CMD_PRINT,      // 指定位置打印，负载为文本
+    DISPLAY_CMD_PRINT_32,   // 24px字体行打印（占两行），x=行号，负载为文本
+    DISPLAY_CMD_REFRESH,    // 刷新显示（帧末统一送屏，本命令只用来唤醒服务任务）
+    DISPLAY_CMD_PICTURE,    // 显示图片，负载为 display_picture_t
+    DISPLAY_CMD_PROGRESS_BAR, // 进度条，负载为 display_progress_t
+    DISPLAY_CMD_COMPOSE     // 合成刷新（页面切换动画），负载为 display_compose_t，完成后通知发送任务
 } display_cmd_type_t;
 
-// 显示消息结构体
+// 显示消息（队列元素，6字节）
 typedef struct
 {
-    display_cmd_type_t cmd;
-    uint8_t x;     // 左上角 X
-    uint8_t y;     // 左上角 Y
-    char text[32]; // 文本缓冲（PRINT 类命令用）
-
-    union
-    {
-        struct
-        {
-            uint8_t width;
-            uint8_t height;
-            const unsigned char *data;
-        } pic;
-
-        struct
-        {
-            uint8_t width;
-            uint8_t height;
-            int32_t value;
-            int32_t min_val;
-            int32_t max_val;
-            uint8_t show_border;
-            uint8_t fill_mode;
-        } progress;
-    } extra;
+    uint8_t cmd;            // display_cmd_type_t
+    uint8_t x;              // 左上角 X，行命令为行号
+    uint8_t y;              // 左上角 Y
+    uint8_t len;            // 负载字节数，0-无负载
+    uint16_t off;           // 负载在文本区中的偏移
 } display_msg_t;
 
+// 图片负载
+typedef struct
+{
+    const unsigned char *data;  // 图片数据，须长期有效（一般在 Flash）
+    uint8_t width;
+    uint8_t height;
+    uint8_t mode;
+} display_picture_t;
+
+// 进度条负载
+typedef struct
+{
+    int32_t value;
+    int32_t min_val;
+    int32_t max_val;
+    uint8_t width;
+    uint8_t height;
+    uint8_t show_border;
+    uint8_t fill_mode;
+} display_progress_t;
+
+// 合成刷新负载
+typedef struct
+{
+    const uint8_t *back;        // 旧画面，在发送任务栈上，等待期间有效
+    TaskHandle_t waiter;        // 完成后通知的任务
+    int16_t back_x;
+    int16_t front_x;
+    uint8_t x1;
+    uint8_t x2;
+} display_compose_t;
+
+// ==================================
+// 统计
+// ==================================
+
+typedef struct
+{
+    uint32_t frames;        // 送屏次数
+    uint32_t commands;      // 收到的命令数
+    uint32_t coalesced;     // 被后续命令覆盖、没有执行的命令数
+    uint16_t dropped;       // 队列或文本区满丢弃的命令数
+    uint8_t max_batch;      // 一帧最多合并的命令数
+    uint16_t stale;         // 发送任务等待超时后作废、没有执行的合成刷新数
+    uint32_t compose_us;    // 最近一次合成刷新的送屏耗时（只计 OLED_Refresh_Compose，不含排队和等待）
+} display_stats_t;
+
+// ==================================
+// 函数声明
+// ==================================
+
+/**
+ * @brief 创建命令队列和显示服务任务（启动调度器前、开机画面画完后调用）
+ * @return 0-成功，-1-队列创建失败，-2-任务创建失败
+ * @note 服务任务开始运行时才接管总线，之前 OLED_Refresh 系列照常直接送屏
+ */
+int display_server_init(void);
+
+/**
+ * @brief 获取统计
+ */
+const display_stats_t *display_server_get_stats(void);
+
+/**
+ * @brief 打印统计
+ */
+void display_server_print(void);
 
+// 以下接口任何任务都可调用（不可在中断中调用）；未初始化服务时直接画并送屏
+// 返回值：0-成功，-1-队列满，-2-文本区满
 
+int display_clear(void);
+int display_clear_line(uint8_t line);
+int display_print_line(uint8_t line, const char *format, ...);
+int display_print_line_32(uint8_t line, const char *format, ...);
+int display_print(uint8_t x, uint8_t y, const char *text);
+int display_picture(uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                    const unsigned char *data, uint8_t mode);
+int display_DrawProgressBar(
+    uint8_t x, uint8_t y,
+    uint8_t width, uint8_t height,
+    int32_t value,
+    int32_t min_val, int32_t max_val,
+    uint8_t show_border,
+    uint8_t fill_mode);
+int display_refresh(void);
+
+/**
+ * @brief 合成刷新（同 OLED_Refresh_Compose），服务任务运行时交给它执行并等待完成
+ * @return 0-成功，-1-队列满，-2-文本区满，-3-等待超时（命令已作废，服务任务不会再读 back）
+ * @note 服务任务已经开始送屏时超时不返回，等它发完；成功后 display_server_get_stats()->compose_us 为这一次的送屏耗时；
+ *       显存画面覆盖 x1~x2 全部列时不读 back，可以传 NULL
+ */
+int display_compose(const uint8_t *back, int16_t back_x, int16_t front_x, uint8_t x1, uint8_t x2);
 
 #endif
@@ -0,0 +1,61 @@
+/**
+ * @file history_page.h
+ * @brief 历史曲线页面头文件
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#ifndef __HISTORY_PAGE_H
+#define __HISTORY_PAGE_H
+
+#include "stm32f10x.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "unified_menu.h"
+#include "oled_print.h"
+#include "oled_chart.h"
+#include "history.h"
+
+// ==================================
+// 宏定义
+// ==================================
+
+#define HISTORY_PAGE_CHART_Y        16      // 第0行为标题，其余6页画图
+#define HISTORY_PAGE_ZOOM_COUNT     3       // 缩放级别：全天 / 6小时 / 2小时
+#define HISTORY_PAGE_REFRESH_MS     1000    // 检查是否跨分钟（跨分钟才重画曲线）
+
+// 置1后打印每次重绘的CPU周期数（解码两遍 + 抽取 + 写显存，不含I2C刷新）
+#define HISTORY_PAGE_PROFILE        0
+
+// ==================================
+// 历史页面状态结构体
+// ==================================
+
+typedef struct {
+    uint8_t series;             // history_series_t
+    uint8_t zoom;               // 缩放级别
+    uint16_t first;             // 窗口起始分钟
+    uint16_t drawn_minute;      // 上次绘制时的当前分钟（跨分钟自动重绘）
+    uint8_t need_refresh;       // 需要刷新标志
+    oled_chart_t chart;
+} history_page_state_t;
+
+// ==================================
+// 函数声明
+// ==================================
+
+extern const menu_item_t g_history_pages[HISTORY_SERIES_COUNT];   // 各序列的页面节点（常量）
+
+/**
+ * @brief 构造历史曲线页面（首次进入时由菜单框架调用）
+ * @return 0-成功，-1-不是历史曲线页面
+ */
+int8_t history_page_on_create(const menu_item_t *item);
+
+void history_page_on_enter(const menu_item_t *item);
+void history_page_on_exit(const menu_item_t *item);
+void history_page_key_handler(const menu_item_t *item, uint8_t key_event);
+void history_page_draw_function(void* context);
+
+#endif // __HISTORY_PAGE_H
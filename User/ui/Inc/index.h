@@ -16,6 +16,8 @@
 #include "unified_menu.h"
 #include "oled_print.h"
 #include "rtc_date.h"
+#include "rtc_clock.h"
+#include "activity.h"
 
 // ==================================
 // 首页状态数据结构
@@ -50,11 +52,13 @@ extern index_state_t g_index_state;
 // 函数声明
 // ==================================
 
+extern const menu_item_t g_index_page;       // 页面节点（常量）
+
 /**
- * @brief 初始化首页
- * @return 创建的首页菜单项指针
+ * @brief 构造首页（首次进入时由菜单框架调用）
+ * @return 0-成功
  */
-menu_item_t* index_init(void);
+int8_t index_on_create(const menu_item_t *item);
 
 /**
  * @brief 首页自定义绘制函数
@@ -67,7 +71,7 @@ void index_draw_function(void* context);
  * @param item 菜单项
  * @param key_event 按键事件
  */
-void index_key_handler(menu_item_t* item, uint8_t key_event);
+void index_key_handler(const menu_item_t *item, uint8_t key_event);
 
 /**
  * @brief 更新首页时间信息
@@ -89,12 +93,12 @@ void index_refresh_display(void);
  * @brief 首页进入回调
  * @param item 菜单项
  */
-void index_on_enter(menu_item_t* item);
+void index_on_enter(const menu_item_t *item);
 
 /**
  * @brief 首页退出回调
  * @param item 菜单项
  */
-void index_on_exit(menu_item_t* item);
+void index_on_exit(const menu_item_t *item);
 
 #endif // __INDEX_H
@@ -33,22 +33,19 @@ typedef enum {
 // 函数声明
 // ==================================
 
-/**
- * @brief 初始化主菜单
- * @return 创建的主菜单项指针
- */
-menu_item_t* main_menu_init(void);
+extern const menu_item_t g_main_menu;                          // 主菜单节点（常量）
+extern const menu_item_t g_main_menu_items[MAIN_MENU_COUNT];    // 主菜单图标项
 
 /**
  * @brief 主菜单进入回调
  * @param item 菜单项
  */
-void main_menu_on_enter(menu_item_t* item);
+void main_menu_on_enter(const menu_item_t *item);
 
 /**
  * @brief 主菜单退出回调
  * @param item 菜单项
  */
-void main_menu_on_exit(menu_item_t* item);
+void main_menu_on_exit(const menu_item_t *item);
 
 #endif // __MAIN_MENU_H
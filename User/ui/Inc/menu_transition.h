@@ -0,0 +1,91 @@
+/**
+ * @file menu_transition.h
+ * @brief 页面切换动画头文件
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 切换时先拍下旧页面画面，暂停刷新执行退出/进入回调并把新页面画进显存，
+ *       再按固定帧间隔把两幅画面按列平移合成送屏，不再出现清屏黑帧。
+ *       动画进度按时间计算，总线慢时少发几帧而不拉长动画；
+ *       送屏耗时按"每帧固定开销 + 每列开销"估算，整屏耗时放不下最少帧数时直接切换（只刷一帧），
+ *       之后每次切换先重新测一次整屏，总线恢复后自动恢复动画
+ */
+
+#ifndef __MENU_TRANSITION_H
+#define __MENU_TRANSITION_H
+
+#include "unified_menu.h"
+
+// ==================================
+// 配置
+// ==================================
+
+#define MENU_TRANSITION_MS          300     // 动画时长
+#define MENU_TRANSITION_FRAME_MS    40      // 帧间隔（目标25fps）
+#define MENU_TRANSITION_MIN_FRAMES  3       // 动画时长内至少能刷这么多整屏才播放，否则直接切换
+#define MENU_TRANSITION_PROBE_COLS  16      // 测量固定开销用的窄帧列数；列数更少的帧不用来更新估算
+#define MENU_TRANSITION_LOG         0       // 1-每次动画后打印帧数和实际帧率
+
+// ==================================
+// 动画样式和方向
+// ==================================
+
+typedef enum {
+    MENU_TRANSITION_NONE = 0,       // 直接切换
+    MENU_TRANSITION_SLIDE,          // 新页面滑入覆盖旧页面（只发送新页面覆盖的列）
+    MENU_TRANSITION_PUSH            // 新页面把旧页面推出屏幕（每帧整屏）
+} menu_transition_style_t;
+
+typedef enum {
+    MENU_TRANSITION_FORWARD = 0,    // 进入：新页面从右侧进入
+    MENU_TRANSITION_BACKWARD        // 返回：新页面从左侧进入
+} menu_transition_dir_t;
+
+// ==================================
+// 统计
+// ==================================
+
+typedef struct {
+    uint32_t frame_us;              // 整屏送屏耗时（启动时和超预算时测量，播放时按实际帧更新）
+    uint32_t base_us;               // 其中与列数无关的每帧固定开销（8页寻址命令等）
+    uint16_t frames;                // 上一次动画发送的帧数（含最后一帧）
+    uint16_t elapsed_ms;            // 上一次动画耗时
+    uint16_t fps_x10;               // 上一次动画实际帧率 x10
+    uint16_t played;                // 播放次数
+    uint16_t cancelled;             // 被按键/闹钟打断的次数
+    uint16_t fallbacks;             // 超出总线预算改为直接切换的次数
+} menu_transition_stats_t;
+
+// ==================================
+// 函数声明
+// ==================================
+
+/**
+ * @brief 初始化：测量整屏和窄帧的送屏耗时作为总线预算依据
+ * @note 在 OLED_Init 之后调用，会把当前显存重新送屏（画面不变）
+ */
+void menu_transition_init(void);
+
+/**
+ * @brief 设置动画样式
+ * @param style 样式，MENU_TRANSITION_NONE 关闭动画
+ */
+void menu_transition_set_style(menu_transition_style_t style);
+
+/**
+ * @brief 带动画切换页面
+ * @param swap 切换函数：执行旧页面退出、新页面进入等状态切换（期间刷新被暂停）
+ * @param target 新页面，传给 swap
+ * @param dir 方向
+ * @note 只在菜单任务中调用；旧画面暂存在静态缓冲区（OLED_FRAME_BYTES 字节），不占菜单任务栈。
+ *       队列中出现按键或闹钟事件时立即跳到最后一帧，事件留给菜单任务处理
+ */
+void menu_transition_switch(void (*swap)(const menu_item_t *target),
+                            const menu_item_t *target, menu_transition_dir_t dir);
+
+/**
+ * @brief 获取动画统计
+ */
+const menu_transition_stats_t *menu_transition_get_stats(void);
+
+#endif // __MENU_TRANSITION_H
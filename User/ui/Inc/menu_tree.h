@@ -0,0 +1,98 @@
+/**
+ * @file menu_tree.h
+ * @brief 菜单树节点编号和节点表
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 菜单树由各页面文件中的 const 节点静态连接而成（放在 Flash），启动时不再分配和拼接。
+ *       节点编号用于索引运行时状态数组（选中项、上下文、重绘间隔、生命周期），每个节点只占几字节 RAM。
+ *       新增页面：在此处加编号，在页面文件中定义节点，挂到父节点的子项数组，并登记到节点表；
+ *       需要按路径跳转的页面再在 menu_tree.c 的路径表中登记路径
+ */
+
+#ifndef __MENU_TREE_H
+#define __MENU_TREE_H
+
+#include "unified_menu.h"
+
+// ==================================
+// 节点编号
+// ==================================
+
+typedef enum {
+    MENU_ID_INDEX = 0,              // 首页（根）
+    MENU_ID_MAIN_MENU,              // 主菜单
+    MENU_ID_MAIN_STOPWATCH,         // 主菜单图标项
+    MENU_ID_MAIN_SETTINGS,
+    MENU_ID_MAIN_TEMPHUMI,
+    MENU_ID_MAIN_FLASHLIGHT,
+    MENU_ID_MAIN_ALARM,
+    MENU_ID_MAIN_STEP,
+    MENU_ID_MAIN_TEST,
+    MENU_ID_STOPWATCH,              // 秒表
+    MENU_ID_SETTING_MENU,           // 设置菜单
+    MENU_ID_SETTING_SETTIME,        // 设置菜单图标项
+    MENU_ID_SETTING_SETDATE,
+    MENU_ID_SETTING_IMUCALIB,
+    MENU_ID_SET_TIME,               // 设置时间
+    MENU_ID_SET_DATE,               // 设置日期
+    MENU_ID_IMU_CALIB,              // 传感器校准
+    MENU_ID_TANDH,                  // 温湿度
+    MENU_ID_HISTORY_STEPS,          // 历史曲线，顺序与 history_series_t 一致
+    MENU_ID_HISTORY_TEMP,
+    MENU_ID_HISTORY_HUMI,
+    MENU_ID_GAME2048,               // 2048
+    MENU_ID_ALARM_MENU,             // 闹钟菜单
+    MENU_ID_ALARM_MENU_CREATE,      // 闹钟菜单图标项
+    MENU_ID_ALARM_MENU_LIST,
+    MENU_ID_ALARM_ADD,              // 新建闹钟
+    MENU_ID_ALARM_LIST,             // 闹钟列表
+    MENU_ID_STEP_COUNTER,           // 计步
+    MENU_ID_TESTLIST_MENU,          // 测试列表
+    MENU_ID_TESTLIST_SPI_TEST,      // 测试列表文本项
+    MENU_ID_TESTLIST_2048_OLED,
+    MENU_ID_TESTLIST_FRID,
+    MENU_ID_TESTLIST_IWDG,
+    MENU_ID_TESTLIST_AIR_LEVEL,
+    MENU_ID_TESTLIST_SENSOR_TRACE,
+    MENU_ID_AIR_LEVEL,              // 水平仪
+    MENU_ID_SENSOR_TRACE,           // 传感器曲线
+    MENU_ID_ALARM_ALERT,            // 闹钟提醒（不在树中，闹钟事件时进入）
+    MENU_NODE_COUNT                 // 节点总数
+} menu_node_id_t;
+
+#define MENU_ID_ROOT        MENU_ID_INDEX
+
+#define MENU_PATH_SLOTS     32          // 路径哈希表槽数（2的幂，不少于路径数的1.5倍）
+
+// ==================================
+// 节点表
+// ==================================
+
+extern const menu_item_t *const g_menu_nodes[MENU_NODE_COUNT];
+
+// ==================================
+// 函数声明
+// ==================================
+
+/**
+ * @brief 建立路径哈希表（菜单树本身是常量，无需创建；页面在首次进入时构造）
+ */
+void menu_tree_init(void);
+
+/**
+ * @brief 按路径查找页面（哈希表，O(1)）
+ * @param path 路径，如 "Main/Settings/SetTime"，首页之下的各级页面名用 '/' 分隔
+ * @param len 路径长度（可只取前缀查找上级页面）
+ * @return 页面节点，NULL-未登记
+ */
+const menu_item_t *menu_tree_find(const char *path, uint8_t len);
+
+/**
+ * @brief 页面的路径
+ * @param item 页面节点
+ * @return 路径，NULL-未登记（如图标项、列表项）
+ */
+const char *menu_tree_path(const menu_item_t *item);
+
+#endif // __MENU_TREE_H
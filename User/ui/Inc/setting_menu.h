@@ -9,15 +9,17 @@
 typedef enum {
   SETTING_MENU_SETTIME = 0, // 设置时间界面
   SETTING_MENU_SETDATE, // 设置日期界面
+  SETTING_MENU_IMUCALIB, // 传感器校准界面
   SETTING_MENU_COUNT // 选项总数
 
 }setting_menu_option_t;
 
 
-menu_item_t* setting_menu_init(void);
+extern const menu_item_t g_setting_menu;                            // 设置菜单节点（常量）
+extern const menu_item_t g_setting_menu_items[SETTING_MENU_COUNT];  // 设置菜单图标项
 
-void setting_menu_on_enter(menu_item_t* item);
+void setting_menu_on_enter(const menu_item_t *item);
 
-void setting_menu_on_exit(menu_item_t* item);
+void setting_menu_on_exit(const menu_item_t *item);
 
 #endif
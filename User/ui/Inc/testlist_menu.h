@@ -17,18 +17,20 @@ typedef enum {
     TESTLIST_MENU_Frid,
     TESTLIST_MENU_iwdg,
     TESTLIST_MENU_AIR_LEVEL,
+    TESTLIST_MENU_SENSOR_TRACE,
     TESTLIST_MENU_COUNT             // 选项总数
 } testlist_menu_option_t;
 // ==================================
 // 函数声明
 // ==================================
 
-menu_item_t* testlist_menu_init(void);
+extern const menu_item_t g_testlist_menu;                               // 测试列表节点（常量）
+extern const menu_item_t g_testlist_menu_items[TESTLIST_MENU_COUNT];    // 测试列表文本项
 
 
-void testlist_menu_on_enter(menu_item_t* item);
+void testlist_menu_on_enter(const menu_item_t *item);
 
 
-void testlist_menu_on_exit(menu_item_t* item);
+void testlist_menu_on_exit(const menu_item_t *item);
 
 #endif
@@ -0,0 +1,42 @@
+/**
+ * @file trace_page.h
+ * @brief 传感器抓包页面头文件
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#ifndef __TRACE_PAGE_H
+#define __TRACE_PAGE_H
+
+#include "stm32f10x.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "unified_menu.h"
+#include "oled_print.h"
+#include "sensor_trace.h"
+#include "MPU6050_hardware_i2c.h"
+
+#define TRACE_PAGE_REFRESH_MS 1000  // 抓包计时/帧数重绘间隔
+
+// ==================================
+// 抓包页面状态结构体
+// ==================================
+
+typedef struct {
+    uint8_t need_refresh;    // 需要刷新标志
+    TickType_t start_tick;   // 开始抓包时刻
+} trace_page_state_t;
+
+// ==================================
+// 函数声明
+// ==================================
+
+extern const menu_item_t g_trace_page;       // 页面节点（常量）
+
+void trace_page_on_enter(const menu_item_t *item);
+void trace_page_on_exit(const menu_item_t *item);
+void trace_page_key_handler(const menu_item_t *item, uint8_t key_event);
+void trace_page_draw_function(void* context);
+
+#endif // __TRACE_PAGE_H
@@ -19,6 +19,12 @@
 #include <stdio.h>
 #include "beep.h"
 
+// ==================================
+// 配置
+// ==================================
+
+#define MENU_TASK_PROFILE 0         // 1-每5秒打印菜单任务唤醒次数、按键延迟和栈余量
+
 // ==================================
 // 菜单类型枚举
 // ==================================
@@ -58,42 +64,60 @@ typedef union {
 // 菜单项结构体
 // ==================================
 
+/**
+ * @brief 菜单节点（常量，放在 Flash）
+ * @note 菜单树用 MENU_NODE_* 宏在各页面文件中静态定义，运行时不修改；
+ *       选中项、上下文、重绘间隔等可变数据在 menu_node_state_t 数组中，按 id 索引
+ */
 typedef struct menu_item {
     // 基本信息
     const char *name;                    // 菜单项名称（内部使用）
     menu_type_t type;                   // 菜单类型
+    uint8_t id;                          // 节点编号（menu_tree.h），索引运行时状态
+    uint16_t refresh_ms;                // 周期重绘间隔(ms)，0-只在按键/事件/请求时重绘
     
     // 显示内容
-    menu_content_t content;             // 显示内容（图标或文本）
-    
-    // 位置和布局信息
-    uint8_t display_index;              // 显示索引
-    uint8_t x_pos;                      // X坐标
-    uint8_t y_pos;                      // Y坐标
-    uint8_t width;                      // 宽度
-    uint8_t height;                     // 高度
-    
-    // 状态信息
-    uint8_t is_selected;                // 是否选中
-    uint8_t is_visible;                 // 是否可见
-    uint8_t is_enabled;                 // 是否启用
+    menu_content_t content;             // 显示内容（图标、文本或自定义绘制）
     
     // 回调函数
-    void (*on_enter)(struct menu_item *item);        // 进入时回调
-    void (*on_exit)(struct menu_item *item);         // 退出时回调
-    void (*on_select)(struct menu_item *item);       // 选中时回调
-    void (*on_key)(struct menu_item *item, uint8_t key); // 按键处理
+    void (*on_enter)(const struct menu_item *item);        // 进入时回调
+    void (*on_exit)(const struct menu_item *item);         // 退出时回调
+    void (*on_select)(const struct menu_item *item);       // 选中时回调
+    void (*on_key)(const struct menu_item *item, uint8_t key); // 按键处理
     
-    // 层次关系
-    struct menu_item *parent;           // 父菜单
-    struct menu_item **children;         // 子菜单数组
-    uint8_t child_count;                 // 子菜单数量
-    uint8_t selected_child;              // 选中的子项索引
+    // 生命周期（可选）
+    int8_t (*on_create)(const struct menu_item *item);     // 首次进入前构造（初始化状态/硬件），返回非0时不进入
+    void (*on_destroy)(const struct menu_item *item);      // 销毁（释放状态），再次进入时重新构造；为NULL的页面常驻
     
-    // 上下文数据
-    void *context;                       // 自定义上下文
+    // 层次关系
+    const struct menu_item *const *children;   // 子菜单数组
+    uint8_t child_count;                        // 子菜单数量
 } menu_item_t;
 
+/**
+ * @brief 菜单节点运行时状态（RAM，每个节点8字节）
+ * @note 返回路径不记在节点上，由导航栈记录
+ */
+typedef struct {
+    void *context;                       // 页面上下文，初值为节点的 draw_context，页面进入时可替换
+    uint16_t refresh_ms;                 // 当前周期重绘间隔(ms)，初值为节点的 refresh_ms
+    uint8_t selected_child;              // 选中的子项索引
+    uint8_t life;                        // 生命周期状态 menu_page_life_t
+} menu_node_state_t;
+
+/**
+ * @brief 页面生命周期
+ * @note 未构造 --首次进入--> 当前页面 <--进入/退出--> 挂起 --销毁--> 未构造。
+ *       挂起的页面保留状态，退出回调已释放显示和传感器等临时资源
+ */
+typedef enum {
+    MENU_PAGE_NONE = 0,                  // 未构造（启动后未进入过，或已销毁）
+    MENU_PAGE_SUSPENDED,                 // 已构造，不在屏幕上
+    MENU_PAGE_ACTIVE                     // 当前页面
+} menu_page_life_t;
+
+#define MENU_NAV_DEPTH      8           // 导航栈深度，满了丢弃最早的一层
+
 // ==================================
 // 菜单布局配置结构体
 // ==================================
@@ -127,8 +151,8 @@ typedef struct {
 
 typedef struct {
     // 当前状态
-    menu_item_t *current_menu;           // 当前菜单
-    menu_item_t *root_menu;              // 根菜单
+    const menu_item_t *current_menu;     // 当前菜单
+    const menu_item_t *root_menu;        // 根菜单
     uint8_t menu_active;                 // 菜单激活状态
     
     // 布局配置
@@ -146,11 +170,6 @@ typedef struct {
     
     // FreeRTOS资源
     QueueHandle_t event_queue;           // 事件队列
-    SemaphoreHandle_t display_mutex;     // 显示互斥量
-    
-    // 按键处理
-    uint32_t last_key_time;              // 上次按键时间
-    uint8_t key_debounce_time;           // 按键去抖时间(ms)
 } menu_system_t;
 
 // ==================================
@@ -165,15 +184,23 @@ typedef enum {
     MENU_EVENT_KEY_ENTER,    // KEY3 - 确认/进入
     MENU_EVENT_REFRESH,      // 刷新显示
     MENU_EVENT_TIMEOUT,      // 超时
-    MENU_EVENT_ALARM         // 闹钟事件
+    MENU_EVENT_ALARM,        // 闹钟事件
+    MENU_EVENT_KEY_REPEAT_UP,    // KEY0 按住连发（需要连续调节的页面自行处理）
+    MENU_EVENT_KEY_REPEAT_DOWN,  // KEY1 按住连发
+    MENU_EVENT_KEY_LONG,     // 长按（KEY2/KEY3），param 为键码1~4
+    MENU_EVENT_KEY_CHORD,    // 组合键，param 为两键位掩码 KEY_MASK(a) | KEY_MASK(b)
+    MENU_EVENT_GOTO          // 跳转到页面，param 为节点编号（menu_request_open 发出）
 } menu_event_type_t;
 
 typedef struct {
     menu_event_type_t type;
-    uint32_t timestamp;
-    uint8_t param;
+    uint32_t timestamp;      // 事件时刻（系统节拍），按键事件为按键驱动检测到的时刻
+    uint16_t param;          // 事件参数（闹钟事件为闹钟ID，连发为连发序号，长按/组合键见上）
 } menu_event_t;
 
+// 组合键：KEY2+KEY3 同时按下回到首页
+#define MENU_CHORD_HOME     (KEY_MASK(3) | KEY_MASK(4))
+
 // ==================================
 // 全局菜单系统实例
 // ==================================
@@ -191,62 +218,72 @@ extern menu_system_t g_menu_sys;
 int8_t menu_system_init(void);
 
 /**
- * @brief 创建菜单项
- * @param name 菜单名称
- * @param type 菜单类型
- * @param content 菜单内容
- * @return 创建的菜单项指针，NULL表示失败
+ * @brief 设置页面的周期重绘间隔
+ * @param item 菜单项
+ * @param interval_ms 重绘间隔(ms)，0-静态页面，只在按键或 menu_request_refresh 时重绘
+ * @return 0-成功，其他-失败
  */
-menu_item_t* menu_item_create(const char *name, menu_type_t type, menu_content_t content);
+int8_t menu_item_set_refresh(const menu_item_t *item, uint16_t interval_ms);
 
 /**
- * @brief 添加子菜单项
- * @param parent 父菜单项
- * @param child 子菜单项
- * @return 0-成功，其他-失败
+ * @brief 获取页面上下文
+ * @param item 菜单项
+ * @return 上下文指针，未设置时为节点定义中的 draw_context
  */
-int8_t menu_add_child(menu_item_t *parent, menu_item_t *child);
+void *menu_item_get_context(const menu_item_t *item);
 
 /**
- * @brief 设置菜单项位置
+ * @brief 设置页面上下文（进入时分配状态的页面使用，退出时置 NULL）
  * @param item 菜单项
- * @param x X坐标
- * @param y Y坐标
- * @param width 宽度
- * @param height 高度
+ * @param context 上下文指针
  * @return 0-成功，其他-失败
  */
-int8_t menu_item_set_position(menu_item_t *item, uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+int8_t menu_item_set_context(const menu_item_t *item, void *context);
 
 /**
- * @brief 设置菜单项回调函数
+ * @brief 为页面分配状态并设为上下文（构造或进入时调用）
  * @param item 菜单项
- * @param on_enter 进入回调
- * @param on_exit 退出回调
- * @param on_select 选中回调
- * @param on_key 按键处理回调
- * @return 0-成功，其他-失败
+ * @param size 状态结构体大小
+ * @return 状态指针（未清零），NULL-没有足够大的空闲块
+ * @note 从页面状态内存池按大小分级分配，O(1) 且不占用 FreeRTOS 堆；
+ *       没有空闲块时先销毁一个占着合适块的挂起页面再重试
  */
-int8_t menu_item_set_callbacks(menu_item_t *item, 
-                               void (*on_enter)(menu_item_t*),
-                               void (*on_exit)(menu_item_t*),
-                               void (*on_select)(menu_item_t*),
-                               void (*on_key)(menu_item_t*, uint8_t));
+void *menu_item_alloc_context(const menu_item_t *item, size_t size);
 
 /**
- * @brief 删除指定的菜单项，并释放内存
- * @param menu 要删除的菜单项指针
- * @return 0-成功，其他-失败
+ * @brief 释放页面状态并清空上下文（销毁或退出时调用）
+ * @param item 菜单项
  */
-int8_t menu_item_delete(menu_item_t *menu);
+void menu_item_free_context(const menu_item_t *item);
 
 /**
- * @brief 从父菜单中移除指定的子菜单项
- * @param parent 父菜单项
- * @param child 要移除的子菜单项
- * @return 0-成功，其他-失败
+ * @brief 打印页面状态内存池用量
+ */
+void menu_context_pool_print(void);
+
+// ==================================
+// 页面生命周期API
+// ==================================
+
+/**
+ * @brief 构造页面（未构造时调用 on_create），导航函数进入页面前自动调用
+ * @param item 页面
+ * @return 0-成功或已构造，-1-参数错误，-2-构造失败
+ */
+int8_t menu_page_create(const menu_item_t *item);
+
+/**
+ * @brief 销毁挂起的页面（调用 on_destroy），下次进入时重新构造
+ * @param item 页面
+ * @return 0-成功或未构造，-1-参数错误，-2-是当前页面或在导航栈中，-3-常驻页面
+ * @note menu_item_alloc_context 找不到空闲块时会自动销毁占用合适块的挂起页面再重试
  */
-int8_t menu_remove_child(menu_item_t *parent, menu_item_t *child);
+int8_t menu_page_destroy(const menu_item_t *item);
+
+/**
+ * @brief 打印各页面生命周期状态和菜单框架的内存预算
+ */
+void menu_page_print(void);
 
 // ==================================
 // 菜单显示API
@@ -257,23 +294,34 @@ int8_t menu_remove_child(menu_item_t *parent, menu_item_t *child);
  */
 void menu_refresh_display(void);
 
+/**
+ * @brief 请求重绘当前页面（其他任务调用，唤醒菜单任务）
+ */
+void menu_request_refresh(void);
+
+/**
+ * @brief 请求重绘当前页面（中断中调用）
+ * @param woken 唤醒了更高优先级任务时置 pdTRUE
+ */
+void menu_request_refresh_from_isr(BaseType_t *woken);
+
 /**
  * @brief 显示横向图标菜单
  * @param menu 菜单项
  */
-void menu_display_horizontal(menu_item_t *menu);
+void menu_display_horizontal(const menu_item_t *menu);
 
 /**
  * @brief 显示竖向列表菜单
  * @param menu 菜单项
  */
-void menu_display_vertical(menu_item_t *menu);
+void menu_display_vertical(const menu_item_t *menu);
 
 /**
  * @brief 显示自定义页面
  * @param menu 菜单项
  */
-void menu_display_custom(menu_item_t *menu);
+void menu_display_custom(const menu_item_t *menu);
 
 /**
  * @brief 清屏并重绘当前菜单
@@ -292,11 +340,13 @@ void menu_clear_and_redraw(void);
 int8_t menu_process_event(menu_event_t *event);
 
 /**
- * @brief 按键转换为菜单事件
- * @param key 按键值
- * @return 菜单事件
+ * @brief 按键事件转换为菜单事件
+ * @param key 按键驱动事件
+ * @return 菜单事件，不需要处理的按键事件返回 MENU_EVENT_NONE
+ * @note KEY0/KEY1 按下即响应（按住后连发）；KEY2/KEY3 松开时响应，
+ *       已报告过长按或组合键的松开不再响应
  */
-menu_event_t menu_key_to_event(uint8_t key);
+menu_event_t menu_key_to_event(const key_event_t *key);
 
 /**
  * @brief 处理横向菜单按键事件
@@ -304,7 +354,7 @@ menu_event_t menu_key_to_event(uint8_t key);
  * @param key 按键值
  * @return 0-成功，其他-失败
  */
-int8_t menu_handle_horizontal_key(menu_item_t *menu, uint8_t key);
+int8_t menu_handle_horizontal_key(const menu_item_t *menu, uint8_t key);
 
 /**
  * @brief 处理竖向菜单按键事件
@@ -312,25 +362,67 @@ int8_t menu_handle_horizontal_key(menu_item_t *menu, uint8_t key);
  * @param key 按键值
  * @return 0-成功，其他-失败
  */
-int8_t menu_handle_vertical_key(menu_item_t *menu, uint8_t key);
+int8_t menu_handle_vertical_key(const menu_item_t *menu, uint8_t key);
 
 // ==================================
 // 菜单导航API
 // ==================================
 
 /**
- * @brief 进入指定菜单
+ * @brief 进入指定菜单（当前页面压入导航栈）
  * @param menu 目标菜单
  * @return 0-成功，其他-失败
  */
-int8_t menu_enter(menu_item_t *menu);
+int8_t menu_enter(const menu_item_t *menu);
 
 /**
- * @brief 返回父菜单
- * @return 0-成功，其他-失败
+ * @brief 返回上一级（弹出导航栈）
+ * @return 0-成功，-1-栈空（已在最上层），-2-页面构造失败
  */
 int8_t menu_back_to_parent(void);
 
+/**
+ * @brief 替换当前页面，导航栈不变（返回时回到当前页面的上一级）
+ * @param menu 目标菜单
+ * @return 0-成功，其他-失败
+ */
+int8_t menu_nav_replace(const menu_item_t *menu);
+
+/**
+ * @brief 清空导航栈并切换到指定页面（回首页）
+ * @param menu 目标菜单
+ * @return 0-成功，其他-失败
+ */
+int8_t menu_nav_reset(const menu_item_t *menu);
+
+/**
+ * @brief 跳转到页面，导航栈按页面路径重建
+ * @param menu 目标页面，须在路径表中登记
+ * @return 0-成功，-1-页面没有路径，-2-页面构造失败
+ * @note 例如跳到 "Main/Settings/SetTime" 后，返回依次经过设置菜单、主菜单、首页，
+ *       沿途菜单的选中项指向路径上的下一级
+ */
+int8_t menu_nav_goto(const menu_item_t *menu);
+
+/**
+ * @brief 按路径跳转（菜单任务中调用）
+ * @param path 页面路径，如 "Main/Settings/SetTime"
+ * @return 0-成功，-1-路径不存在
+ */
+int8_t menu_nav_open(const char *path);
+
+/**
+ * @brief 请求按路径跳转（其他任务调用，由菜单任务执行）
+ * @param path 页面路径
+ * @return 0-成功，-1-路径不存在，-2-事件队列满
+ */
+int8_t menu_request_open(const char *path);
+
+/**
+ * @brief 导航栈深度（当前页面之下的层数）
+ */
+uint8_t menu_nav_depth(void);
+
 /**
  * @brief 选择下一个菜单项
  * @return 0-成功，其他-失败
@@ -365,21 +457,30 @@ void menu_task(void *pvParameters);
  */
 void menu_key_task(void *pvParameters);
 
-// 创建自定义菜单项
-#define MENU_ITEM_CUSTOM(name, draw_func, context) \
-    menu_item_create(name, MENU_TYPE_CUSTOM, \
-        (menu_content_t){.custom = {draw_func, context}})
-
-// 便利宏定义
-// 创建图标菜单项
-#define MENU_ITEM_ICON(name, icon_ptr, w, h) \
-    menu_item_create(name, MENU_TYPE_HORIZONTAL_ICON, \
-        (menu_content_t){.icon = {icon_ptr, w, h}})
-
-// 创建文本菜单项
-#define MENU_ITEM_TEXT(name, text_str, max_len) \
-    menu_item_create(name, MENU_TYPE_VERTICAL_LIST, \
-        (menu_content_t){.text = {text_str, max_len}})
+// ==================================
+// 节点定义宏
+// ==================================
+
+// 用法：const menu_item_t g_xxx = { MENU_NODE_CUSTOM(...), .on_enter = ..., MENU_CHILDREN(s_xxx_children) };
+
+// 自定义页面节点
+#define MENU_NODE_CUSTOM(node_id, node_name, draw_func, ctx) \
+    .id = (node_id), .name = (node_name), .type = MENU_TYPE_CUSTOM, \
+    .content = {.custom = {(draw_func), (ctx)}}
+
+// 图标菜单节点（横向菜单本身及其图标项）
+#define MENU_NODE_ICON(node_id, node_name, icon_ptr, w, h) \
+    .id = (node_id), .name = (node_name), .type = MENU_TYPE_HORIZONTAL_ICON, \
+    .content = {.icon = {(icon_ptr), (w), (h)}}
+
+// 文本菜单节点（竖向列表本身及其文本项）
+#define MENU_NODE_TEXT(node_id, node_name, text_str, max_len) \
+    .id = (node_id), .name = (node_name), .type = MENU_TYPE_VERTICAL_LIST, \
+    .content = {.text = {(text_str), (max_len)}}
+
+// 子项数组（const menu_item_t *const 数组）
+#define MENU_CHILDREN(list) \
+    .children = (list), .child_count = (uint8_t)(sizeof(list) / sizeof((list)[0]))
 
 // 常用布局配置预设
 #define LAYOUT_HORIZONTAL_MAIN() { \
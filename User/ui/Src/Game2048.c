@@ -7,6 +7,7 @@
  */
 
 #include "Game2048.h"
+#include "menu_tree.h"
 #include <stdlib.h>
 
 // ==================================
@@ -17,31 +18,19 @@ static void game2048_cleanup_sensor_data(game2048_state_t *state);
 static char game2048_number_to_char(int number);
 
 // ==================================
-// 页面初始化
+// 页面节点
 // ==================================
 
-/**
- * @brief 初始化2048游戏页面
- * @return 创建的2048游戏页面指针
- */
-menu_item_t *game2048_init(void)
-{
-    // 创建自定义菜单项，不分配具体状态数据
-    menu_item_t *game2048_page = MENU_ITEM_CUSTOM("2048 Game", game2048_draw_function, NULL);
-    if (game2048_page == NULL) {
-        return NULL;
-    }
-    
-    // 设置回调函数
-    menu_item_set_callbacks(game2048_page, 
-                           game2048_on_enter, 
-                           game2048_on_exit, 
-                           NULL, 
-                           game2048_key_handler);
-    
-    printf("2048 Game page created successfully\r\n");
-    return game2048_page;
-}
+// 不带状态数据，构造时分配；退出后棋局保留，内存紧张时销毁
+const menu_item_t g_game2048_page = {
+    MENU_NODE_CUSTOM(MENU_ID_GAME2048, "2048 Game", game2048_draw_function, NULL),
+    .refresh_ms = GAME2048_REFRESH_MS,
+    .on_create = game2048_on_create,
+    .on_destroy = game2048_on_destroy,
+    .on_enter = game2048_on_enter,
+    .on_exit = game2048_on_exit,
+    .on_key = game2048_key_handler,
+};
 
 // ==================================
 // 自定义绘制函数
@@ -64,7 +53,7 @@ void game2048_draw_function(void *context)
     
     // 检查是否需要刷新
     TickType_t current_time = xTaskGetTickCount();
-    if (state->need_refresh || (current_time - state->last_update) > pdMS_TO_TICKS(100)) {
+    if (state->need_refresh || (current_time - state->last_update) >= pdMS_TO_TICKS(GAME2048_REFRESH_MS)) {
         // 更新传感器数据（如果传感器就绪）
         if (state->sensor_ready) {
             game2048_update_sensor_data(state);
@@ -102,9 +91,9 @@ void game2048_draw_function(void *context)
  * @param item 菜单项
  * @param key_event 按键事件
  */
-void game2048_key_handler(menu_item_t *item, uint8_t key_event)
+void game2048_key_handler(const menu_item_t *item, uint8_t key_event)
 {
-    game2048_state_t *state = (game2048_state_t *)item->content.custom.draw_context;
+    game2048_state_t *state = (game2048_state_t *)menu_item_get_context(item);
     
     switch (key_event) {
         case MENU_EVENT_KEY_UP:
@@ -120,7 +109,7 @@ void game2048_key_handler(menu_item_t *item, uint8_t key_event)
             // KEY1 - 切换显示模式
             printf("2048: KEY1 pressed - Toggle mode\r\n");
             if (state) {
-                state->display_mode = (state->display_mode + 1) % DISPLAY_MODE_MAX;
+                state->display_mode = (state->display_mode + 1) % GAME_DISPLAY_MODE_MAX;
                 state->need_refresh = 1;
             }
             break;
@@ -135,12 +124,12 @@ void game2048_key_handler(menu_item_t *item, uint8_t key_event)
             // KEY3 - 初始化传感器或方向控制
             printf("2048: KEY3 pressed - Initialize sensor\r\n");
             if (state && !state->sensor_ready) {
-                if (MPU_Init() == 0) {
+                if (imu_attitude_is_ready()) {
                     state->sensor_ready = 1;
-                    printf("MPU6050 initialized successfully\r\n");
+                    printf("IMU attitude ready\r\n");
                     state->need_refresh = 1;
                 } else {
-                    printf("MPU6050 initialization failed\r\n");
+                    printf("IMU attitude not ready, check MPU6050\r\n");
                     OLED_Printf_Line(1,"MPU605");
                     OLED_Printf_Line(2,"nitialization failed");
                     OLED_Printf_Line(3,"check uart");
@@ -166,43 +155,66 @@ void game2048_key_handler(menu_item_t *item, uint8_t key_event)
 // ==================================
 
 /**
- * @brief 2048游戏页面进入回调
+ * @brief 2048游戏页面构造回调：分配状态并开新局
  * @param item 菜单项
+ * @return 0-成功，-1-内存池无空闲块
  */
-void game2048_on_enter(menu_item_t *item)
+int8_t game2048_on_create(const menu_item_t *item)
 {
-    printf("Enter 2048 Game page\r\n");
-    
-    // 分配状态数据结构
-    game2048_state_t *state = (game2048_state_t *)pvPortMalloc(sizeof(game2048_state_t));
+    // 从页面状态内存池分配，同时设为菜单项上下文
+    game2048_state_t *state = (game2048_state_t *)menu_item_alloc_context(item, sizeof(game2048_state_t));
     if (state == NULL) {
         printf("Error: Failed to allocate 2048 game state memory!\r\n");
-        return;
+        return -1;
     }
     
-    printf("MALLOC: game2048_on_enter, state addr=%p, size=%d bytes\r\n", 
+    printf("ALLOC: game2048_on_create, state addr=%p, size=%d bytes\r\n", 
            state, sizeof(game2048_state_t));
     
     // 初始化状态数据
     game2048_init_game_data(state);
     
-    // 设置到菜单项上下文
-    item->content.custom.draw_context = state;
+    return 0;
+}
+
+/**
+ * @brief 2048游戏页面销毁回调：释放状态，棋局丢弃
+ * @param item 菜单项
+ */
+void game2048_on_destroy(const menu_item_t *item)
+{
+    printf("FREE: game2048_on_destroy, state addr=%p, size=%d bytes\r\n", 
+           menu_item_get_context(item), sizeof(game2048_state_t));
+    menu_item_free_context(item);
+}
+
+/**
+ * @brief 2048游戏页面进入回调
+ * @param item 菜单项
+ */
+void game2048_on_enter(const menu_item_t *item)
+{
+    printf("Enter 2048 Game page\r\n");
+    
+    game2048_state_t *state = (game2048_state_t *)menu_item_get_context(item);
+    if (state == NULL) {
+        return;
+    }
     
-    // 清屏并标记需要刷新
+    // 清屏并标记需要刷新（棋局从上次退出处继续）
     OLED_Clear();
     state->need_refresh = 1;
 }
 
 /**
- * @brief 2048游戏页面退出回调
+ * @brief 2048游戏页面退出回调（挂起：棋局保留）
  * @param item 菜单项
  */
-void game2048_on_exit(menu_item_t *item)
+void game2048_on_exit(const menu_item_t *item)
 {
     printf("Exit 2048 Game page\r\n");
     
-    game2048_state_t *state = (game2048_state_t *)item->content.custom.draw_context;
+    game2048_state_t *state = (game2048_state_t *)menu_item_get_context(item);
     if (state == NULL) {
         return;
     }
@@ -210,14 +222,6 @@ void game2048_on_exit(menu_item_t *item)
     // 清理传感器相关数据
     game2048_cleanup_sensor_data(state);
     
-    // 释放状态结构体本身
-    printf("FREE: game2048_on_exit, state addr=%p, size=%d bytes\r\n", 
-           state, sizeof(game2048_state_t));
-    vPortFree(state);
-    
-    // 清空指针，防止野指针
-    item->content.custom.draw_context = NULL;
-    
     // 清屏
     OLED_Clear();
 }
@@ -244,7 +248,7 @@ static void game2048_init_game_data(game2048_state_t *state)
     state->last_update = xTaskGetTickCount();
     state->last_move = xTaskGetTickCount();
     state->sensor_ready = 0;
-    state->display_mode = DISPLAY_MODE_NORMAL;
+    state->display_mode = GAME_DISPLAY_MODE_NORMAL;
     state->game_state = GAME_STATE_PLAYING;
     
     // 初始化文本缓冲区
@@ -267,7 +271,8 @@ static void game2048_cleanup_sensor_data(game2048_state_t *state)
         return;
     }
     
-    
+    // 挂起期间不跟随姿态，回来后按KEY3重新启用体感
+    state->sensor_ready = 0;
     
     printf("2048 Game sensor data cleaned up\r\n");
 }
@@ -536,25 +541,6 @@ int game2048_is_game_over(game2048_state_t *state)
 // 传感器数据处理
 // ==================================
 
-/**
- * @brief 计算倾斜角度
- * @param ax X轴加速度
- * @param ay Y轴加速度
- * @param az Z轴加速度
- * @param angle_x 输出X轴角度
- * @param angle_y 输出Y轴角度
- */
-void game2048_calculate_tilt_angles(short ax, short ay, short az, float *angle_x, float *angle_y)
-{
-    // 使用双精度浮点数计算以提高精度
-    double ax_d = (double)ax;
-    double ay_d = (double)ay;
-    double az_d = (double)az;
-    
-    *angle_x = atan2(ax_d, sqrt(ay_d * ay_d + az_d * az_d)) * 180.0 / 3.14159265;
-    *angle_y = atan2(ay_d, sqrt(ax_d * ax_d + az_d * az_d)) * 180.0 / 3.14159265;
-}
-
 /**
  * @brief 更新传感器数据
  * @param state 游戏状态
@@ -565,16 +551,15 @@ void game2048_update_sensor_data(game2048_state_t *state)
         return;
     }
     
-    short ax, ay, az;
+    imu_attitude_t attitude;
+    imu_attitude_get(&attitude);
     
-    if (MPU_Get_Accelerometer(&ax, &ay, &az) == 0) {
-        // 计算原始角度
-        game2048_calculate_tilt_angles(ax, ay, az, &state->angle_x, &state->angle_y);
-        
-        // 平滑处理角度数据
-        const float smoothing_factor = 0.3f;
-        state->last_angle_x = state->last_angle_x * (1 - smoothing_factor) + state->angle_x * smoothing_factor;
-        state->last_angle_y = state->last_angle_y * (1 - smoothing_factor) + state->angle_y * smoothing_factor;
+    if (attitude.valid) {
+        // 姿态由传感器任务融合陀螺仪与加速度计得到，无需再做平滑
+        state->angle_x = attitude.pitch / 100.0f;
+        state->angle_y = attitude.roll / 100.0f;
+        state->last_angle_x = state->angle_x;
+        state->last_angle_y = state->angle_y;
         
         // 确定方向文本
         const float trigger_threshold = 20.0f;
@@ -0,0 +1,222 @@
+#include "ImuCalib.h"
+#include "menu_tree.h"
+
+// ==================================
+// 本页面变量定义
+// ==================================
+static ImuCalib_state_t s_ImuCalib_state = {0};
+
+// 各步骤的摆放提示
+static const char *const s_pose_names[MPU_CALIB_STEP_COUNT] = {
+    "X axis up",
+    "X axis down",
+    "Y axis up",
+    "Y axis down",
+    "Screen up",
+    "Screen down",
+    "Gyro: keep still"};
+
+// ==================================
+// 静态函数声明
+// ==================================
+static void ImuCalib_display_info(void);
+
+// ==================================
+// 页面节点
+// ==================================
+const menu_item_t g_ImuCalib_page = {
+    MENU_NODE_CUSTOM(MENU_ID_IMU_CALIB, "IMU Calib", ImuCalib_draw_function, &s_ImuCalib_state),
+    .refresh_ms = IMUCALIB_REFRESH_MS,
+    .on_create = ImuCalib_on_create,
+    .on_enter = ImuCalib_on_enter,
+    .on_exit = ImuCalib_on_exit,
+    .on_key = ImuCalib_key_handler,
+};
+
+/**
+ * @brief 构造传感器校准页面：初始化状态（首次进入时调用，之后状态常驻）
+ */
+int8_t ImuCalib_on_create(const menu_item_t *item)
+{
+  memset(&s_ImuCalib_state, 0, sizeof(s_ImuCalib_state));
+  s_ImuCalib_state.need_refresh = 1;
+  s_ImuCalib_state.last_update = xTaskGetTickCount();
+
+  printf("ImuCalib_page initialized successfully\r\n");
+  return 0;
+}
+
+/**
+ * @brief 校准页面自定义绘制函数
+ * @param context 绘制上下文
+ */
+void ImuCalib_draw_function(void *context)
+{
+  ImuCalib_state_t *state = (ImuCalib_state_t *)context;
+  if (state == NULL)
+  {
+    return;
+  }
+
+  // 当前步骤采集完成后自动进入下一步
+  if (state->capturing && state->step < MPU_CALIB_STEP_COUNT &&
+      mpu_calib_capture_status((mpu_calib_step_t)state->step, NULL) == MPU_CALIB_CAPTURE_DONE)
+  {
+    state->capturing = 0;
+    state->step++;
+  }
+
+  ImuCalib_display_info();
+
+  OLED_Refresh_Dirty();
+}
+
+/**
+ * @brief 校准页面按键处理函数
+ * @param item 菜单项
+ * @param key_event 按键事件
+ */
+void ImuCalib_key_handler(const menu_item_t *item, uint8_t key_event)
+{
+  ImuCalib_state_t *state = (ImuCalib_state_t *)menu_item_get_context(item);
+  switch (key_event)
+  {
+  case MENU_EVENT_KEY_UP:
+    // KEY0 - 上一步
+    if (state->step > 0 && !state->saved)
+    {
+      state->step--;
+      state->capturing = 0;
+    }
+    break;
+
+  case MENU_EVENT_KEY_DOWN:
+    // KEY1 - 跳过当前步骤（可只做陀螺仪校准）
+    if (state->step < IMUCALIB_STEP_SAVE && !state->saved)
+    {
+      state->step++;
+      state->capturing = 0;
+    }
+    break;
+
+  case MENU_EVENT_KEY_SELECT:
+    // KEY2 - 返回（未保存则放弃本次校准）
+    menu_back_to_parent();
+    break;
+
+  case MENU_EVENT_KEY_ENTER:
+    // KEY3 - 采集当前步骤 / 保存
+    if (state->saved)
+    {
+      break;
+    }
+    if (state->step < MPU_CALIB_STEP_COUNT)
+    {
+      state->capturing = (mpu_calib_capture_start((mpu_calib_step_t)state->step) == 0);
+    }
+    else
+    {
+      state->result = (int8_t)mpu_calib_finish();
+      state->saved = (state->result == 0);
+      printf("ImuCalib: save result %d\r\n", state->result);
+    }
+    break;
+
+  case MENU_EVENT_REFRESH:
+    // 刷新显示
+    state->need_refresh = 1;
+    break;
+
+  default:
+    break;
+  }
+
+  // 标记需要刷新
+  state->need_refresh = 1;
+}
+
+/**
+ * @brief 进入校准页面时的回调
+ * @param item 菜单项
+ */
+void ImuCalib_on_enter(const menu_item_t *item)
+{
+  printf("Enter ImuCalib page\r\n");
+  OLED_Clear();
+
+  // 开始校准会话，驱动层切换为原始输出
+  mpu_calib_begin();
+  s_ImuCalib_state.step = 0;
+  s_ImuCalib_state.saved = 0;
+  s_ImuCalib_state.result = 0;
+  s_ImuCalib_state.capturing = 0;
+
+  s_ImuCalib_state.need_refresh = 1;
+}
+
+/**
+ * @brief 退出校准页面时的回调
+ * @param item 菜单项
+ */
+void ImuCalib_on_exit(const menu_item_t *item)
+{
+  printf("Exit ImuCalib page\r\n");
+
+  if (!s_ImuCalib_state.saved)
+  {
+    mpu_calib_cancel();
+  }
+  OLED_Clear();
+}
+
+/**
+ * @brief 显示校准界面信息
+ */
+static void ImuCalib_display_info(void)
+{
+  uint8_t step = s_ImuCalib_state.step;
+  uint8_t progress = 0;
+
+  if (step < MPU_CALIB_STEP_COUNT)
+  {
+    OLED_Printf_Line(0, "IMU Calib   %d/%d", step + 1, MPU_CALIB_STEP_COUNT);
+    OLED_Printf_Line(1, "%s", s_pose_names[step]);
+
+    switch (mpu_calib_capture_status((mpu_calib_step_t)step, &progress))
+    {
+    case MPU_CALIB_CAPTURE_RUNNING:
+      OLED_Printf_Line(2, "Hold still %3d%%", progress);
+      break;
+    case MPU_CALIB_CAPTURE_DONE:
+      OLED_Printf_Line(2, "Done  KEY3: redo");
+      break;
+    case MPU_CALIB_CAPTURE_BAD_POSE:
+      OLED_Printf_Line(2, "Wrong pose, retry");
+      break;
+    default:
+      OLED_Printf_Line(2, "KEY3: capture");
+      break;
+    }
+    OLED_Printf_Line(3, "K0:< K1:> K2:ret");
+    return;
+  }
+
+  // 保存页
+  OLED_Printf_Line(0, "IMU Calib  save");
+  if (s_ImuCalib_state.saved)
+  {
+    OLED_Printf_Line(1, "Saved to flash");
+    OLED_Printf_Line(2, "");
+  }
+  else if (s_ImuCalib_state.result != 0)
+  {
+    OLED_Printf_Line(1, "Save failed: %d", s_ImuCalib_state.result);
+    OLED_Printf_Line(2, "K0: redo steps");
+  }
+  else
+  {
+    OLED_Printf_Line(1, "KEY3: save");
+    OLED_Printf_Line(2, "");
+  }
+  OLED_Printf_Line(3, "K0:prev  K2:return");
+}
@@ -1,4 +1,5 @@
 #include "SetDate.h"
+#include "menu_tree.h"
 
 // ==================================
 // 本页面变量定义
@@ -41,27 +42,29 @@ uint8_t get_max_days_in_month(u8 year, u8 month)
     }
 }
 
+// ==================================
+// 页面节点
+// ==================================
+const menu_item_t g_SetDate_page = {
+    MENU_NODE_CUSTOM(MENU_ID_SET_DATE, "Set Date", SetDate_draw_function, &s_SetDate_state),
+    .on_create = SetDate_on_create,
+    .on_enter = SetDate_on_enter,
+    .on_exit = SetDate_on_exit,
+    .on_key = SetDate_key_handler,
+};
+
 /**
- * @brief 初始化日期设置页面
- * @return 创建的日期设置菜单项指针
+ * @brief 构造日期设置页面：初始化状态（首次进入时调用，之后状态常驻）
  */
-menu_item_t *SetDate_init(void)
+int8_t SetDate_on_create(const menu_item_t *item)
 {
   memset(&s_SetDate_state, 0, sizeof(s_SetDate_state));
   s_SetDate_state.need_refresh = 1;
   s_SetDate_state.last_update = xTaskGetTickCount();
   s_SetDate_state.set_step = 0;
 
-  menu_item_t *SetDate_page = MENU_ITEM_CUSTOM("Set Date", SetDate_draw_function, &s_SetDate_state);
-  if (SetDate_page == NULL)
-  {
-    return NULL;
-  }
-
-  menu_item_set_callbacks(SetDate_page, SetDate_on_enter, SetDate_on_exit, NULL, SetDate_key_handler);
-
   printf("SetDate_page initialized successfully\r\n");
-  return SetDate_page;
+  return 0;
 }
 
 /**
@@ -86,12 +89,13 @@ void SetDate_draw_function(void *context)
  * @param item 菜单项
  * @param key_event 按键事件
  */
-void SetDate_key_handler(menu_item_t *item, uint8_t key_event)
+void SetDate_key_handler(const menu_item_t *item, uint8_t key_event)
 {
-  SetDate_state_t *state = (SetDate_state_t *)item->content.custom.draw_context;
+  SetDate_state_t *state = (SetDate_state_t *)menu_item_get_context(item);
   switch (key_event)
   {
   case MENU_EVENT_KEY_UP:
+  case MENU_EVENT_KEY_REPEAT_UP:
     // KEY0 - 增加当前设置项的值
     switch (state->set_step)
     {
@@ -132,6 +136,7 @@ void SetDate_key_handler(menu_item_t *item, uint8_t key_event)
     break;
 
   case MENU_EVENT_KEY_DOWN:
+  case MENU_EVENT_KEY_REPEAT_DOWN:
     // KEY1 - 减少当前设置项的值
     switch (state->set_step)
     {
@@ -174,6 +179,7 @@ void SetDate_key_handler(menu_item_t *item, uint8_t key_event)
   case MENU_EVENT_KEY_SELECT:
     // KEY2 - 确认保存并返回
     RTC_SetDate_Manual(s_SetDate_state.temp_year, s_SetDate_state.temp_month, s_SetDate_state.temp_day);
+    RTC_Clock_Sync();
     menu_back_to_parent();
     break;
 
@@ -221,17 +227,18 @@ void SetDate_refresh_display(void)
  * @brief 进入日期设置页面时的回调
  * @param item 菜单项
  */
-void SetDate_on_enter(menu_item_t *item)
+void SetDate_on_enter(const menu_item_t *item)
 {
   printf("Enter SetDate page\r\n");
   OLED_Clear();
   
-  // 获取当前RTC日期
-  MyRTC_ReadTime();
-  printf("year:%d",RTC_data.year);
-  s_SetDate_state.temp_year = RTC_data.year;
-  s_SetDate_state.temp_month = RTC_data.mon;
-  s_SetDate_state.temp_day = RTC_data.day;
+  // 获取当前日期
+  rtc_clock_time_t now;
+  RTC_Clock_Get(&now);
+  printf("year:%d",now.year);
+  s_SetDate_state.temp_year = now.year;
+  s_SetDate_state.temp_month = now.month;
+  s_SetDate_state.temp_day = now.day;
   s_SetDate_state.set_step = 0;
   
   s_SetDate_state.need_refresh = 1;
@@ -241,7 +248,7 @@ void SetDate_on_enter(menu_item_t *item)
  * @brief 退出日期设置页面时的回调
  * @param item 菜单项
  */
-void SetDate_on_exit(menu_item_t *item)
+void SetDate_on_exit(const menu_item_t *item)
 {
   printf("Exit SetDate page\r\n");
   OLED_Clear();
@@ -1,4 +1,5 @@
 #include "SetTime.h"
+#include "menu_tree.h"
 
 // ==================================
 // 本页面变量定义
@@ -10,27 +11,29 @@ static SetTime_state_t s_SetTime_state = {0};
 // ==================================
 static void SetTime_display_info(void);
 
+// ==================================
+// 页面节点
+// ==================================
+const menu_item_t g_SetTime_page = {
+    MENU_NODE_CUSTOM(MENU_ID_SET_TIME, "Set Time", SetTime_draw_function, &s_SetTime_state),
+    .on_create = SetTime_on_create,
+    .on_enter = SetTime_on_enter,
+    .on_exit = SetTime_on_exit,
+    .on_key = SetTime_key_handler,
+};
+
 /**
- * @brief 初始化时间设置页面
- * @return 创建的时间设置菜单项指针
+ * @brief 构造时间设置页面：初始化状态（首次进入时调用，之后状态常驻）
  */
-menu_item_t *SetTime_init(void)
+int8_t SetTime_on_create(const menu_item_t *item)
 {
   memset(&s_SetTime_state, 0, sizeof(s_SetTime_state));
   s_SetTime_state.need_refresh = 1;
   s_SetTime_state.last_update = xTaskGetTickCount();
   s_SetTime_state.set_step = 0;
 
-  menu_item_t *SetTime_page = MENU_ITEM_CUSTOM("Set Time", SetTime_draw_function, &s_SetTime_state);
-  if (SetTime_page == NULL)
-  {
-    return NULL;
-  }
-
-  menu_item_set_callbacks(SetTime_page, SetTime_on_enter, SetTime_on_exit, NULL, SetTime_key_handler);
-
   printf("SetTime_page initialized successfully\r\n");
-  return SetTime_page;
+  return 0;
 }
 
 /**
@@ -55,12 +58,13 @@ void SetTime_draw_function(void *context)
  * @param item 菜单项
  * @param key_event 按键事件
  */
-void SetTime_key_handler(menu_item_t *item, uint8_t key_event)
+void SetTime_key_handler(const menu_item_t *item, uint8_t key_event)
 {
-  SetTime_state_t *state = (SetTime_state_t *)item->content.custom.draw_context;
+  SetTime_state_t *state = (SetTime_state_t *)menu_item_get_context(item);
   switch (key_event)
   {
   case MENU_EVENT_KEY_UP:
+  case MENU_EVENT_KEY_REPEAT_UP:
     // KEY0 - 增加当前设置项的值
     switch (state->set_step)
     {
@@ -77,6 +81,7 @@ void SetTime_key_handler(menu_item_t *item, uint8_t key_event)
     break;
 
   case MENU_EVENT_KEY_DOWN:
+  case MENU_EVENT_KEY_REPEAT_DOWN:
     // KEY1 - 减少当前设置项的值
     switch (state->set_step)
     {
@@ -95,6 +100,7 @@ void SetTime_key_handler(menu_item_t *item, uint8_t key_event)
   case MENU_EVENT_KEY_SELECT:
     // KEY2 - 确认保存并返回
     RTC_SetTime_Manual(state->temp_hours, state->temp_minutes, state->temp_seconds);
+    RTC_Clock_Sync();
     menu_back_to_parent();
     break;
 
@@ -142,16 +148,17 @@ void SetTime_refresh_display(void)
  * @brief 进入时间设置页面时的回调
  * @param item 菜单项
  */
-void SetTime_on_enter(menu_item_t *item)
+void SetTime_on_enter(const menu_item_t *item)
 {
   printf("Enter SetTime page\r\n");
   OLED_Clear();
   
-  // 获取当前RTC时间
-  MyRTC_ReadTime();
-  s_SetTime_state.temp_hours = RTC_data.hours;
-  s_SetTime_state.temp_minutes = RTC_data.minutes;
-  s_SetTime_state.temp_seconds = RTC_data.seconds;
+  // 获取当前时间
+  rtc_clock_time_t now;
+  RTC_Clock_Get(&now);
+  s_SetTime_state.temp_hours = now.hours;
+  s_SetTime_state.temp_minutes = now.minutes;
+  s_SetTime_state.temp_seconds = now.seconds;
   s_SetTime_state.set_step = 0;
   
   s_SetTime_state.need_refresh = 1;
@@ -161,7 +168,7 @@ void SetTime_on_enter(menu_item_t *item)
  * @brief 退出时间设置页面时的回调
  * @param item 菜单项
  */
-void SetTime_on_exit(menu_item_t *item)
+void SetTime_on_exit(const menu_item_t *item)
 {
   printf("Exit SetTime page\r\n");
   OLED_Clear();
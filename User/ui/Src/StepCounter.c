@@ -7,6 +7,7 @@
  */
 
 #include "StepCounter.h"
+#include "menu_tree.h"
 #include <string.h>
 #include <stdlib.h>
 
@@ -21,27 +22,37 @@ static StepCounter_state_t s_StepCounter_state = {0};
 static void StepCounter_display_info(void);
 static void StepCounter_reset_confirm(void);
 
+// ==================================
+// 页面节点
+// ==================================
+
+// 步数历史曲线（KEY3进入）
+static const menu_item_t *const s_StepCounter_children[] = {
+    &g_history_pages[HISTORY_SERIES_STEPS],
+};
+
+const menu_item_t g_StepCounter_page = {
+    MENU_NODE_CUSTOM(MENU_ID_STEP_COUNTER, "Step Counter", StepCounter_draw_function, &s_StepCounter_state),
+    .refresh_ms = STEPCOUNTER_REFRESH_MS,
+    .on_create = StepCounter_on_create,
+    .on_enter = StepCounter_on_enter,
+    .on_exit = StepCounter_on_exit,
+    .on_key = StepCounter_key_handler,
+    MENU_CHILDREN(s_StepCounter_children),
+};
+
 /**
- * @brief 初始化步数页面
- * @return 创建的步数菜单项指针
+ * @brief 构造步数页面：初始化状态（首次进入时调用，之后状态常驻）
  */
-menu_item_t *StepCounter_init(void)
+int8_t StepCounter_on_create(const menu_item_t *item)
 {
     memset(&s_StepCounter_state, 0, sizeof(s_StepCounter_state));
     s_StepCounter_state.need_refresh = 1;
     s_StepCounter_state.last_update = xTaskGetTickCount();
     s_StepCounter_state.show_reset_confirm = 0;
 
-    menu_item_t *StepCounter_page = MENU_ITEM_CUSTOM("Step Counter", StepCounter_draw_function, &s_StepCounter_state);
-    if (StepCounter_page == NULL)
-    {
-        return NULL;
-    }
-
-    menu_item_set_callbacks(StepCounter_page, StepCounter_on_enter, StepCounter_on_exit, NULL, StepCounter_key_handler);
-
     printf("StepCounter_page initialized successfully\r\n");
-    return StepCounter_page;
+    return 0;
 }
 
 /**
@@ -71,9 +82,9 @@ void StepCounter_draw_function(void *context)
  * @param item 菜单项
  * @param key_event 按键事件
  */
-void StepCounter_key_handler(menu_item_t *item, uint8_t key_event)
+void StepCounter_key_handler(const menu_item_t *item, uint8_t key_event)
 {
-    StepCounter_state_t *state = (StepCounter_state_t *)item->content.custom.draw_context;
+    StepCounter_state_t *state = (StepCounter_state_t *)menu_item_get_context(item);
     if (state == NULL) {
         return;
     }
@@ -89,6 +100,7 @@ void StepCounter_key_handler(menu_item_t *item, uint8_t key_event)
         } else {
             // 在确认界面按下KEY0，确认重置
             simple_pedometer_reset();
+            step_detector_reset();
             state->show_reset_confirm = 0;
             printf("StepCounter: Steps reset to 0\r\n");
         }
@@ -109,8 +121,11 @@ void StepCounter_key_handler(menu_item_t *item, uint8_t key_event)
         break;
 
     case MENU_EVENT_KEY_ENTER:
-        // KEY3 - 刷新显示（可选功能）
-        printf("StepCounter: Manual refresh\r\n");
+        // KEY3 - 查看今日步数曲线
+        if (!state->show_reset_confirm && item->child_count > 0) {
+            menu_enter(item->children[0]);
+            return;
+        }
         break;
 
     case MENU_EVENT_REFRESH:
@@ -148,7 +163,7 @@ void StepCounter_refresh_display(void)
  * @brief 进入步数页面时的回调
  * @param item 菜单项
  */
-void StepCounter_on_enter(menu_item_t *item)
+void StepCounter_on_enter(const menu_item_t *item)
 {
     printf("Enter StepCounter page\r\n");
     OLED_Clear();
@@ -164,7 +179,7 @@ void StepCounter_on_enter(menu_item_t *item)
  * @brief 退出步数页面时的回调
  * @param item 菜单项
  */
-void StepCounter_on_exit(menu_item_t *item)
+void StepCounter_on_exit(const menu_item_t *item)
 {
     printf("Exit StepCounter page\r\n");
     OLED_Clear();
@@ -179,6 +194,9 @@ void StepCounter_on_exit(menu_item_t *item)
 static void StepCounter_display_info(void)
 {
     unsigned long current_steps = simple_pedometer_get_steps();
+    activity_info_t activity;
+    
+    activity_get(&activity);
     
     // 显示标题
     OLED_Printf_Line_32(0, "   STEPS");
@@ -188,7 +206,13 @@ static void StepCounter_display_info(void)
     
     // 显示操作提示
     OLED_Printf_Line(4, "KEY0:Reset KEY2:Exit");
-    OLED_Printf_Line(5, "Keep walking to count!");
+    // 自适应计步流水线的结果（对比用），节律未确认时显示*
+    OLED_Printf_Line(5, "Adaptive:%06lu%c", step_detector_get_steps(),
+                     step_detector_is_locked() ? ' ' : '*');
+    
+    // 运动状态和步频
+    OLED_Printf_Line(6, "%-4s  %3u spm", activity_state_name((activity_state_t)activity.state),
+                     activity.cadence_spm);
 }
 
 /**
@@ -1,4 +1,5 @@
 #include "Stopwatch.h"
+#include "menu_tree.h"
 
 // ==================================
 // 本页面变量定义
@@ -10,26 +11,28 @@ static Stopwatch_state_t s_Stopwatch_state = {0};
 // ==================================
 static void Stopwatch_display_info(void);
 
+// ==================================
+// 页面节点
+// ==================================
+const menu_item_t g_Stopwatch_page = {
+    MENU_NODE_CUSTOM(MENU_ID_STOPWATCH, "Stopwatch", Stopwatch_draw_function, &s_Stopwatch_state),
+    .on_create = Stopwatch_on_create,
+    .on_enter = Stopwatch_on_enter,
+    .on_exit = Stopwatch_on_exit,
+    .on_key = Stopwatch_key_handler,
+};
+
 /**
- * @brief 初始化秒表页面
- * @return 创建的秒表菜单项指针
+ * @brief 构造秒表页面：初始化状态（首次进入时调用，之后状态常驻）
  */
-menu_item_t *Stopwatch_init(void)
+int8_t Stopwatch_on_create(const menu_item_t *item)
 {
   memset(&s_Stopwatch_state, 0, sizeof(s_Stopwatch_state));
   s_Stopwatch_state.need_refresh = 1;
   s_Stopwatch_state.last_update = xTaskGetTickCount();
 
-  menu_item_t *Stopwatch_page = MENU_ITEM_CUSTOM("Stopwatch", Stopwatch_draw_function, &s_Stopwatch_state);
-  if (Stopwatch_page == NULL)
-  {
-    return NULL;
-  }
-
-  menu_item_set_callbacks(Stopwatch_page, Stopwatch_on_enter, Stopwatch_on_exit, NULL, Stopwatch_key_handler);
-
   printf("Stopwatch_page initialized successfully\r\n");
-  return Stopwatch_page;
+  return 0;
 }
 
 /**
@@ -47,7 +50,7 @@ void Stopwatch_draw_function(void *context)
   // 如果正在运行，计算实时时间
   if (state->running)
   {
-    uint32_t current_time = xTaskGetTickCount();
+    uint32_t current_time = RTC_Mono_Ms();
     state->elapsed_time = (current_time - state->start_time) + state->pause_time;
   }
 
@@ -61,9 +64,9 @@ void Stopwatch_draw_function(void *context)
  * @param item 菜单项
  * @param key_event 按键事件
  */
-void Stopwatch_key_handler(menu_item_t *item, uint8_t key_event)
+void Stopwatch_key_handler(const menu_item_t *item, uint8_t key_event)
 {
-  Stopwatch_state_t *state = (Stopwatch_state_t *)item->content.custom.draw_context;
+  Stopwatch_state_t *state = (Stopwatch_state_t *)menu_item_get_context(item);
   switch (key_event)
   {
   case MENU_EVENT_KEY_UP:
@@ -71,7 +74,8 @@ void Stopwatch_key_handler(menu_item_t *item, uint8_t key_event)
     if (!state->running)
     {
       state->running = 1;
-      state->start_time = xTaskGetTickCount();
+      state->start_time = RTC_Mono_Ms();
+      menu_item_set_refresh(item, STOPWATCH_UPDATE_INTERVAL);
       printf("Stopwatch started\r\n");
     }
     break;
@@ -81,7 +85,8 @@ void Stopwatch_key_handler(menu_item_t *item, uint8_t key_event)
     if (state->running)
     {
       state->running = 0;
-      state->pause_time += (xTaskGetTickCount() - state->start_time);
+      state->pause_time += (RTC_Mono_Ms() - state->start_time);
+      menu_item_set_refresh(item, 0);
       printf("Stopwatch paused\r\n");
     }
     break;
@@ -98,6 +103,7 @@ void Stopwatch_key_handler(menu_item_t *item, uint8_t key_event)
     state->start_time = 0;
     state->pause_time = 0;
     state->elapsed_time = 0;
+    menu_item_set_refresh(item, 0);
     printf("Stopwatch reset\r\n");
     break;
 
@@ -136,7 +142,7 @@ void Stopwatch_refresh_display(void)
  * @brief 进入秒表页面时的回调
  * @param item 菜单项
  */
-void Stopwatch_on_enter(menu_item_t *item)
+void Stopwatch_on_enter(const menu_item_t *item)
 {
   printf("Enter Stopwatch page\r\n");
   OLED_Clear();
@@ -154,7 +160,7 @@ void Stopwatch_on_enter(menu_item_t *item)
  * @brief 退出秒表页面时的回调
  * @param item 菜单项
  */
-void Stopwatch_on_exit(menu_item_t *item)
+void Stopwatch_on_exit(const menu_item_t *item)
 {
   printf("Exit Stopwatch page\r\n");
   OLED_Clear();
@@ -1,4 +1,5 @@
 #include "TandH.h"
+#include "menu_tree.h"
 
 // ==================================
 // 本页面变量定义
@@ -30,11 +31,30 @@ void OLED_DrawHumidityBar_Line3(uint8_t humi)
 
 static void TandH_display_info(void);
 
+// ==================================
+// 页面节点
+// ==================================
+
+// 温度/湿度历史曲线（KEY0/KEY1进入）
+static const menu_item_t *const s_TandH_children[] = {
+    &g_history_pages[HISTORY_SERIES_TEMP],
+    &g_history_pages[HISTORY_SERIES_HUMI],
+};
+
+const menu_item_t g_TandH_page = {
+    MENU_NODE_CUSTOM(MENU_ID_TANDH, "Temp&Humid", TandH_draw_function, &s_TandH_state),
+    .refresh_ms = TANDH_REFRESH_MS,
+    .on_create = TandH_on_create,
+    .on_enter = TandH_on_enter,
+    .on_exit = TandH_on_exit,
+    .on_key = TandH_key_handler,
+    MENU_CHILDREN(s_TandH_children),
+};
+
 /**
- * @brief 初始化温湿度页面
- * @return 创建的温湿菜单项指针
+ * @brief 构造温湿度页面：初始化状态（首次进入时调用，之后状态常驻）
  */
-menu_item_t *TandH_init(void)
+int8_t TandH_on_create(const menu_item_t *item)
 {
   //
   memset(&s_TandH_state, 0, sizeof(s_TandH_state));
@@ -46,18 +66,8 @@ menu_item_t *TandH_init(void)
 
   s_TandH_state.result = 1;
 
-  DHT11_Init();
-
-  menu_item_t *TandH_page = MENU_ITEM_CUSTOM("Temp&Humid", TandH_draw_function, &s_TandH_state);
-  if (TandH_page == NULL)
-  {
-    return NULL;
-  }
-
-  menu_item_set_callbacks(TandH_page, TandH_on_enter, TandH_on_exit, NULL, TandH_key_handler);
-
   printf("TandH_page initialized successfully\r\n");
-  return TandH_page;
+  return 0;
 }
 
 /**
@@ -79,19 +89,27 @@ void TandH_draw_function(void *context)
   OLED_Refresh_Dirty();
 }
 
-void TandH_key_handler(menu_item_t *item, uint8_t key_event)
+void TandH_key_handler(const menu_item_t *item, uint8_t key_event)
 {
-  TandH_state_t *state = (TandH_state_t *)item->content.custom.draw_context;
+  TandH_state_t *state = (TandH_state_t *)menu_item_get_context(item);
   switch (key_event)
   {
   case MENU_EVENT_KEY_UP:
-    // KEY0 - 可以用来切换某些状态或进入特定功能
-    printf("Index: KEY0 pressed\r\n");
+    // KEY0 - 今日温度曲线
+    if (item->child_count > 0)
+    {
+      menu_enter(item->children[0]);
+      return;
+    }
     break;
 
   case MENU_EVENT_KEY_DOWN:
-    // KEY1 - 可以用来切换某些状态或进入特定功能
-    printf("Index: KEY1 pressed\r\n");
+    // KEY1 - 今日湿度曲线
+    if (item->child_count > 1)
+    {
+      menu_enter(item->children[1]);
+      return;
+    }
     break;
 
   case MENU_EVENT_KEY_SELECT:
@@ -140,14 +158,14 @@ void TandH_refresh_display(void)
   s_TandH_state.last_update = xTaskGetTickCount();
 }
 
-void TandH_on_enter(menu_item_t *item)
+void TandH_on_enter(const menu_item_t *item)
 {
   printf("Enter TandH page\r\n");
   OLED_Clear();
   s_TandH_state.need_refresh = 1;
 }
 
-void TandH_on_exit(menu_item_t *item)
+void TandH_on_exit(const menu_item_t *item)
 {
   printf("Exit TandH page\r\n");
     OLED_Clear();
@@ -1,4 +1,5 @@
 #include "air_level.h"
+#include "menu_tree.h"
 #include <stdlib.h>  // 添加stdlib.h用于动态内存管理
 
 // ==================================
@@ -9,31 +10,17 @@ static void air_level_init_sensor_data(air_level_state_t *state);
 static void air_level_cleanup_sensor_data(air_level_state_t *state);
 
 // ==================================
-// 页面初始化
+// 页面节点
 // ==================================
 
-/**
- * @brief 初始化水平仪页面
- * @return 创建的水平仪页面指针
- */
-menu_item_t *air_level_init(void)
-{
-    // 创建自定义菜单项，不分配具体状态数据
-    menu_item_t *air_level_page = MENU_ITEM_CUSTOM("Air Level", air_level_draw_function, NULL);
-    if (air_level_page == NULL) {
-        return NULL;
-    }
-    
-    // 设置回调函数
-    menu_item_set_callbacks(air_level_page, 
-                           air_level_on_enter, 
-                           air_level_on_exit, 
-                           NULL, 
-                           air_level_key_handler);
-    
-    printf("Air Level page created successfully\r\n");
-    return air_level_page;
-}
+// 不带状态数据，进入时分配
+const menu_item_t g_air_level_page = {
+    MENU_NODE_CUSTOM(MENU_ID_AIR_LEVEL, "Air Level", air_level_draw_function, NULL),
+    .refresh_ms = AIR_LEVEL_REFRESH_MS,
+    .on_enter = air_level_on_enter,
+    .on_exit = air_level_on_exit,
+    .on_key = air_level_key_handler,
+};
 
 // ==================================
 // 自定义绘制函数
@@ -74,9 +61,9 @@ void air_level_draw_function(void *context)
  * @param item 菜单项
  * @param key_event 按键事件
  */
-void air_level_key_handler(menu_item_t *item, uint8_t key_event)
+void air_level_key_handler(const menu_item_t *item, uint8_t key_event)
 {
-    air_level_state_t *state = (air_level_state_t *)item->content.custom.draw_context;
+    air_level_state_t *state = (air_level_state_t *)menu_item_get_context(item);
     
     switch (key_event) {
         case MENU_EVENT_KEY_UP:
@@ -108,12 +95,12 @@ void air_level_key_handler(menu_item_t *item, uint8_t key_event)
             // KEY3 - 初始化传感器
             printf("Air Level: KEY3 pressed - Initialize sensor\r\n");
             if (state && !state->sensor_ready) {
-                if (MPU_Init() == 0) {
+                if (imu_attitude_is_ready()) {
                     state->sensor_ready = 1;
-                    printf("MPU6050 initialized successfully\r\n");
+                    printf("IMU attitude ready\r\n");
                     state->need_refresh = 1;
                 } else {
-                    printf("MPU6050 initialization failed\r\n");
+                    printf("IMU attitude not ready, check MPU6050\r\n");
                 }
             }
             break;
@@ -138,26 +125,23 @@ void air_level_key_handler(menu_item_t *item, uint8_t key_event)
  * @brief 水平仪页面进入回调
  * @param item 菜单项
  */
-void air_level_on_enter(menu_item_t *item)
+void air_level_on_enter(const menu_item_t *item)
 {
     printf("Enter Air Level page\r\n");
     
-    // 分配状态数据结构
-    air_level_state_t *state = (air_level_state_t *)pvPortMalloc(sizeof(air_level_state_t));
+    // 从页面状态内存池分配，同时设为菜单项上下文
+    air_level_state_t *state = (air_level_state_t *)menu_item_alloc_context(item, sizeof(air_level_state_t));
     if (state == NULL) {
         printf("Error: Failed to allocate air level state memory!\r\n");
         return;
     }
     
-    printf("MALLOC: air_level_on_enter, state addr=%p, size=%d bytes\r\n", 
+    printf("ALLOC: air_level_on_enter, state addr=%p, size=%d bytes\r\n", 
            state, sizeof(air_level_state_t));
     
     // 初始化状态数据
     air_level_init_sensor_data(state);
     
-    // 设置到菜单项上下文
-    item->content.custom.draw_context = state;
-    
     // 可以在这里分配其他动态数据，比如校准数据、历史记录等
     // state->calibration_data = (calibration_t *)pvPortMalloc(sizeof(calibration_t));
     
@@ -170,11 +154,11 @@ void air_level_on_enter(menu_item_t *item)
  * @brief 水平仪页面退出回调
  * @param item 菜单项
  */
-void air_level_on_exit(menu_item_t *item)
+void air_level_on_exit(const menu_item_t *item)
 {
     printf("Exit Air Level page\r\n");
     
-    air_level_state_t *state = (air_level_state_t *)item->content.custom.draw_context;
+    air_level_state_t *state = (air_level_state_t *)menu_item_get_context(item);
     if (state == NULL) {
         return;
     }
@@ -190,10 +174,7 @@ void air_level_on_exit(menu_item_t *item)
     // 释放状态结构体本身
     printf("FREE: air_level_on_exit, state addr=%p, size=%d bytes\r\n", 
            state, sizeof(air_level_state_t));
-    vPortFree(state);
-    
-    // 清空指针，防止野指针
-    item->content.custom.draw_context = NULL;
+    menu_item_free_context(item);
     
     // 清屏
     OLED_Clear();
@@ -255,25 +236,6 @@ static void air_level_cleanup_sensor_data(air_level_state_t *state)
 // 传感器数据处理
 // ==================================
 
-/**
- * @brief 计算倾斜角度
- * @param ax X轴加速度
- * @param ay Y轴加速度
- * @param az Z轴加速度
- * @param angle_x 输出X轴角度
- * @param angle_y 输出Y轴角度
- */
-void calculate_tilt_angles(short ax, short ay, short az, float *angle_x, float *angle_y)
-{
-    // 使用双精度浮点数计算以提高精度
-    double ax_d = (double)ax;
-    double ay_d = (double)ay;
-    double az_d = (double)az;
-    
-    *angle_x = atan2(ax_d, sqrt(ay_d * ay_d + az_d * az_d)) * 180.0 / 3.14159265;
-    *angle_y = atan2(ay_d, sqrt(ax_d * ax_d + az_d * az_d)) * 180.0 / 3.14159265;
-}
-
 /**
  * @brief 获取当前倾斜方向和角度
  * @param state 水平仪状态
@@ -284,16 +246,15 @@ void air_level_update_data(air_level_state_t *state)
         return;
     }
     
-    short ax, ay, az;
+    imu_attitude_t attitude;
+    imu_attitude_get(&attitude);
     
-    if (MPU_Get_Accelerometer(&ax, &ay, &az) == 0) {
-        // 计算原始角度
-        calculate_tilt_angles(ax, ay, az, &state->angle_x, &state->angle_y);
-        
-        // 平滑处理角度数据（避免跳动）
-        const float smoothing_factor = 0.3f;
-        state->last_angle_x = state->last_angle_y * (1 - smoothing_factor) + state->angle_y * smoothing_factor;
-        state->last_angle_y = state->last_angle_x * (1 - smoothing_factor) + state->angle_x * smoothing_factor;
+    if (attitude.valid) {
+        // 姿态由传感器任务融合陀螺仪与加速度计得到，无需再做平滑
+        state->angle_x = attitude.pitch / 100.0f;
+        state->angle_y = attitude.roll / 100.0f;
+        state->last_angle_x = state->angle_x;
+        state->last_angle_y = state->angle_y;
         
         // 确定方向文本
         const float trigger_threshold = 20.0f;
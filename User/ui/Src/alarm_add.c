@@ -7,6 +7,8 @@
  */
 
 #include "alarm_add.h"
+#include "menu_tree.h"
+#include "rtc_date.h"
 #include <stdlib.h>
 
 // ==================================
@@ -16,31 +18,16 @@ static void alarm_add_init_state(alarm_add_state_t *state);
 static void alarm_add_cleanup_state(alarm_add_state_t *state);
 
 // ==================================
-// 页面初始化
+// 页面节点
 // ==================================
 
-/**
- * @brief 初始化新建闹钟页面
- * @return 创建的页面指针
- */
-menu_item_t *alarm_add_init(void)
-{
-    // 创建自定义菜单项，不分配具体状态数据
-    menu_item_t *alarm_add_page = MENU_ITEM_CUSTOM("Alarm Add", alarm_add_draw_function, NULL);
-    if (alarm_add_page == NULL) {
-        return NULL;
-    }
-    
-    // 设置回调函数
-    menu_item_set_callbacks(alarm_add_page, 
-                           alarm_add_on_enter, 
-                           alarm_add_on_exit, 
-                           NULL, 
-                           alarm_add_key_handler);
-    
-    printf("Alarm Add page created successfully\r\n");
-    return alarm_add_page;
-}
+// 不带状态数据，进入时分配
+const menu_item_t g_alarm_add_page = {
+    MENU_NODE_CUSTOM(MENU_ID_ALARM_ADD, "Alarm Add", alarm_add_draw_function, NULL),
+    .on_enter = alarm_add_on_enter,
+    .on_exit = alarm_add_on_exit,
+    .on_key = alarm_add_key_handler,
+};
 
 // ==================================
 // 自定义绘制函数
@@ -72,18 +59,20 @@ void alarm_add_draw_function(void *context)
  * @param item 菜单项
  * @param key_event 按键事件
  */
-void alarm_add_key_handler(menu_item_t *item, uint8_t key_event)
+void alarm_add_key_handler(const menu_item_t *item, uint8_t key_event)
 {
-    alarm_add_state_t *state = (alarm_add_state_t *)item->content.custom.draw_context;
+    alarm_add_state_t *state = (alarm_add_state_t *)menu_item_get_context(item);
     
     switch (key_event) {
         case MENU_EVENT_KEY_UP:
+        case MENU_EVENT_KEY_REPEAT_UP:
             // KEY0 - 增加当前设置项的值
             printf("Alarm Add: KEY0 pressed - Increase value\r\n");
             alarm_add_process_setting(state, MENU_EVENT_KEY_UP);
             break;
             
         case MENU_EVENT_KEY_DOWN:
+        case MENU_EVENT_KEY_REPEAT_DOWN:
             // KEY1 - 减少当前设置项的值
             printf("Alarm Add: KEY1 pressed - Decrease value\r\n");
             alarm_add_process_setting(state, MENU_EVENT_KEY_DOWN);
@@ -101,10 +90,7 @@ void alarm_add_key_handler(menu_item_t *item, uint8_t key_event)
             // KEY3 - 下一个设置项
             printf("Alarm Add: KEY3 pressed - Next step\r\n");
             if (state) {
-                state->set_step++;
-                if (state->set_step >= SET_STEP_COUNT) {
-                    state->set_step = 0; // 循环回到第一项
-                }
+                state->set_step = alarm_add_next_step(&state->temp_alarm, state->set_step);
                 state->need_refresh = 1;
             }
             break;
@@ -129,26 +115,23 @@ void alarm_add_key_handler(menu_item_t *item, uint8_t key_event)
  * @brief 新建闹钟页面进入回调
  * @param item 菜单项
  */
-void alarm_add_on_enter(menu_item_t *item)
+void alarm_add_on_enter(const menu_item_t *item)
 {
     printf("Enter Alarm Add page\r\n");
     
-    // 分配状态数据结构
-    alarm_add_state_t *state = (alarm_add_state_t *)pvPortMalloc(sizeof(alarm_add_state_t));
+    // 从页面状态内存池分配，同时设为菜单项上下文
+    alarm_add_state_t *state = (alarm_add_state_t *)menu_item_alloc_context(item, sizeof(alarm_add_state_t));
     if (state == NULL) {
         printf("Error: Failed to allocate alarm add state memory!\r\n");
         return;
     }
     
-    printf("MALLOC: alarm_add_on_enter, state addr=%p, size=%d bytes\r\n", 
+    printf("ALLOC: alarm_add_on_enter, state addr=%p, size=%d bytes\r\n", 
            state, sizeof(alarm_add_state_t));
     
     // 初始化状态数据
     alarm_add_init_state(state);
     
-    // 设置到菜单项上下文
-    item->content.custom.draw_context = state;
-    
     // 清屏并标记需要刷新
     OLED_Clear();
     state->need_refresh = 1;
@@ -158,11 +141,11 @@ void alarm_add_on_enter(menu_item_t *item)
  * @brief 新建闹钟页面退出回调
  * @param item 菜单项
  */
-void alarm_add_on_exit(menu_item_t *item)
+void alarm_add_on_exit(const menu_item_t *item)
 {
     printf("Exit Alarm Add page\r\n");
     
-    alarm_add_state_t *state = (alarm_add_state_t *)item->content.custom.draw_context;
+    alarm_add_state_t *state = (alarm_add_state_t *)menu_item_get_context(item);
     if (state == NULL) {
         return;
     }
@@ -173,10 +156,7 @@ void alarm_add_on_exit(menu_item_t *item)
     // 释放状态结构体本身
     printf("FREE: alarm_add_on_exit, state addr=%p, size=%d bytes\r\n", 
            state, sizeof(alarm_add_state_t));
-    vPortFree(state);
-    
-    // 清空指针，防止野指针
-    item->content.custom.draw_context = NULL;
+    menu_item_free_context(item);
     
     // 清屏
     OLED_Clear();
@@ -209,11 +189,13 @@ static void alarm_add_init_state(alarm_add_state_t *state)
     state->temp_alarm.minute = 0;
     state->temp_alarm.second = 0;
     state->temp_alarm.enabled = 1;
-    state->temp_alarm.repeat = 0;
+    state->temp_alarm.days = ALARM_DAYS_ONCE;
+    state->temp_alarm.date = ALARM_DATE_NONE;
+    state->temp_alarm.snooze_min = ALARM_SNOOZE_DEFAULT_MIN;
     
     // 初始化文本缓冲区
     strcpy(state->time_text, "00:00:00");
-    strcpy(state->repeat_text, "NO");
+    strcpy(state->repeat_text, "Once");
     
     printf("Alarm Add state initialized\r\n");
 }
@@ -236,53 +218,150 @@ static void alarm_add_cleanup_state(alarm_add_state_t *state)
 // ==================================
 
 /**
- * @brief 显示闹钟设置界面
- * @param state 闹钟设置状态
+ * @brief 调整闹钟的一个设置项
+ * @param alarm 闹钟数据
+ * @param step 设置项（alarm_set_step_t）
+ * @param dir 1增加，-1减少
  */
-void alarm_add_display_setting(alarm_add_state_t *state)
+void alarm_add_adjust(Alarm_TypeDef *alarm, uint8_t step, int8_t dir)
 {
-    if (!state) {
-        return;
+    uint32_t now;
+    uint32_t first;
+
+    switch (step) {
+        case SET_STEP_HOUR: // 小时
+            alarm->hour = (alarm->hour + 24 + dir) % 24;
+            break;
+        case SET_STEP_MINUTE: // 分钟
+            alarm->minute = (alarm->minute + 60 + dir) % 60;
+            break;
+        case SET_STEP_SECOND: // 秒
+            alarm->second = (alarm->second + 60 + dir) % 60;
+            break;
+        case SET_STEP_REPEAT: // 重复方式：单次/每天/工作日/周末/指定日期
+            Alarm_Rule_Cycle(alarm, dir, MyRTC_GetLocalSeconds());
+            break;
+        case SET_STEP_DATE: // 日期：从下一次能响的那天到2099-12-31，跨月跨年由天数自动处理
+            now = MyRTC_GetLocalSeconds();
+            first = now / 86400;
+            if (first * 86400UL + alarm->hour * 3600UL + alarm->minute * 60UL + alarm->second <= now) {
+                first++;                    // 今天的时刻已过，最早明天
+            }
+            if (dir > 0 && alarm->date < ALARM_ADD_DATE_MAX) {
+                alarm->date++;
+            } else if (dir < 0 && alarm->date > first) {
+                alarm->date--;
+            }
+            if (alarm->date < first) {
+                alarm->date = (uint16_t)first;  // 改过时间后日期已过：跳到最早能响的一天
+            }
+            break;
+        case SET_STEP_SNOOZE: // 贪睡间隔：0（关闭）~ ALARM_SNOOZE_MAX_MIN
+            alarm->snooze_min = (alarm->snooze_min + ALARM_SNOOZE_MAX_MIN + ALARM_ADD_SNOOZE_STEP_MIN
+                                 + dir * ALARM_ADD_SNOOZE_STEP_MIN) % (ALARM_SNOOZE_MAX_MIN + ALARM_ADD_SNOOZE_STEP_MIN);
+            break;
     }
-    
-    // 根据设置步骤高亮显示当前设置项（参考你的代码格式）
-    switch (state->set_step) {
-        case SET_STEP_HOUR: // 设置小时
-            OLED_Clear_Line(1);
-            OLED_Printf_Line(1, " [%02d]:%02d:%02d-loop:%s", 
-                             state->temp_alarm.hour, state->temp_alarm.minute, 
-                             state->temp_alarm.second, state->temp_alarm.repeat ? "YES" : "NO ");
-            OLED_Clear_Line(2);
+}
+
+/**
+ * @brief 下一个设置项（不是指定日期的闹钟跳过日期）
+ * @param alarm 闹钟数据
+ * @param step 当前设置项
+ * @return 下一个设置项
+ */
+uint8_t alarm_add_next_step(const Alarm_TypeDef *alarm, uint8_t step)
+{
+    step = (step + 1) % SET_STEP_COUNT;
+    if (step == SET_STEP_DATE && alarm->date == ALARM_DATE_NONE) {
+        step++;
+    }
+    return step;
+}
+
+/**
+ * @brief 保存前检查：启用的指定日期闹钟必须还能触发
+ * @param alarm 闹钟数据
+ * @return 0-可以保存，-1-日期时刻已过（保存后永远不会响）
+ * @note 日期选好后又把时刻改到了当前时间之前时会出现这种情况
+ */
+int alarm_add_check(const Alarm_TypeDef *alarm)
+{
+    if (alarm->enabled && alarm->date != ALARM_DATE_NONE
+        && Alarm_Rule_Next(alarm, MyRTC_GetLocalSeconds()) == ALARM_NEVER) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 显示闹钟设置项（第1、2行）
+ * @param alarm 闹钟数据
+ * @param step 当前设置项
+ */
+void alarm_add_show_setting(const Alarm_TypeDef *alarm, uint8_t step)
+{
+    const char *label = Alarm_Rule_Label(alarm);
+    uint16_t year;
+    uint8_t month;
+    uint8_t day;
+
+    // 第1行：时间和重复方式，当前设置项加方括号
+    OLED_Clear_Line(1);
+    switch (step) {
+        case SET_STEP_HOUR:
+            OLED_Printf_Line(1, " [%02d]:%02d:%02d %s", alarm->hour, alarm->minute, alarm->second, label);
+            break;
+        case SET_STEP_MINUTE:
+            OLED_Printf_Line(1, " %02d:[%02d]:%02d %s", alarm->hour, alarm->minute, alarm->second, label);
+            break;
+        case SET_STEP_SECOND:
+            OLED_Printf_Line(1, " %02d:%02d:[%02d] %s", alarm->hour, alarm->minute, alarm->second, label);
+            break;
+        default:
+            OLED_Printf_Line(1, "  %02d:%02d:%02d %s", alarm->hour, alarm->minute, alarm->second, label);
+            break;
+    }
+
+    // 第2行：当前设置项说明
+    OLED_Clear_Line(2);
+    switch (step) {
+        case SET_STEP_HOUR:
             OLED_Printf_Line(2, "   Set Hours");
             break;
-            
-        case SET_STEP_MINUTE: // 设置分钟
-            OLED_Clear_Line(1);
-            OLED_Printf_Line(1, " %02d:[%02d]:%02d-loop:%s", 
-                             state->temp_alarm.hour, state->temp_alarm.minute, 
-                             state->temp_alarm.second, state->temp_alarm.repeat ? "YES" : "NO ");
-            OLED_Clear_Line(2);
+        case SET_STEP_MINUTE:
             OLED_Printf_Line(2, "  Set Minutes");
             break;
-            
-        case SET_STEP_SECOND: // 设置秒
-            OLED_Clear_Line(1);
-            OLED_Printf_Line(1, " %02d:%02d:[%02d]-loop:%s", 
-                             state->temp_alarm.hour, state->temp_alarm.minute, 
-                             state->temp_alarm.second, state->temp_alarm.repeat ? "YES" : "NO ");
-            OLED_Clear_Line(2);
+        case SET_STEP_SECOND:
             OLED_Printf_Line(2, "   Set Seconds");
             break;
-            
-        case SET_STEP_REPEAT: // 设置重复
-            OLED_Clear_Line(1);
-            OLED_Printf_Line(1, " %02d:%02d:%02d-loop:[%s]", 
-                             state->temp_alarm.hour, state->temp_alarm.minute, 
-                             state->temp_alarm.second, state->temp_alarm.repeat ? "YES" : "NO ");
-            OLED_Clear_Line(2);
-            OLED_Printf_Line(2, "   Set Repeat");
+        case SET_STEP_REPEAT:
+            OLED_Printf_Line(2, " Repeat:[%s]", label);
+            break;
+        case SET_STEP_DATE:
+            MyRTC_DateFromDays(alarm->date, &year, &month, &day);
+            OLED_Printf_Line(2, " Date:[%04d-%02d-%02d]", year, month, day);
+            break;
+        case SET_STEP_SNOOZE:
+            if (alarm->snooze_min > 0) {
+                OLED_Printf_Line(2, " Snooze:[%d min]", alarm->snooze_min);
+            } else {
+                OLED_Printf_Line(2, " Snooze:[OFF]");
+            }
             break;
     }
+}
+
+/**
+ * @brief 显示闹钟设置界面
+ * @param state 闹钟设置状态
+ */
+void alarm_add_display_setting(alarm_add_state_t *state)
+{
+    if (!state) {
+        return;
+    }
+    
+    alarm_add_show_setting(&state->temp_alarm, state->set_step);
     
     // 显示标题和操作提示（参考你的代码格式）
     OLED_Printf_Line(0, "  SET ALARM");
@@ -302,43 +381,17 @@ void alarm_add_process_setting(alarm_add_state_t *state, uint8_t key_event)
     
     switch (key_event) {
         case MENU_EVENT_KEY_UP: // 增加
-            switch (state->set_step) {
-                case SET_STEP_HOUR: // 小时
-                    state->temp_alarm.hour = (state->temp_alarm.hour + 1) % 24;
-                    break;
-                case SET_STEP_MINUTE: // 分钟
-                    state->temp_alarm.minute = (state->temp_alarm.minute + 1) % 60;
-                    break;
-                case SET_STEP_SECOND: // 秒
-                    state->temp_alarm.second = (state->temp_alarm.second + 1) % 60;
-                    break;
-                case SET_STEP_REPEAT: // 重复
-                    state->temp_alarm.repeat = !state->temp_alarm.repeat;
-                    break;
-            }
+            alarm_add_adjust(&state->temp_alarm, state->set_step, 1);
             state->need_refresh = 1;
             break;
             
         case MENU_EVENT_KEY_DOWN: // 减少
-            switch (state->set_step) {
-                case SET_STEP_HOUR: // 小时
-                    state->temp_alarm.hour = (state->temp_alarm.hour == 0) ? 23 : state->temp_alarm.hour - 1;
-                    break;
-                case SET_STEP_MINUTE: // 分钟
-                    state->temp_alarm.minute = (state->temp_alarm.minute == 0) ? 59 : state->temp_alarm.minute - 1;
-                    break;
-                case SET_STEP_SECOND: // 秒
-                    state->temp_alarm.second = (state->temp_alarm.second == 0) ? 59 : state->temp_alarm.second - 1;
-                    break;
-                case SET_STEP_REPEAT: // 重复
-                    state->temp_alarm.repeat = !state->temp_alarm.repeat;
-                    break;
-            }
+            alarm_add_adjust(&state->temp_alarm, state->set_step, -1);
             state->need_refresh = 1;
             break;
             
         case MENU_EVENT_KEY_SELECT: // 下一个设置项
-            state->set_step = (state->set_step + 1) % SET_STEP_COUNT;
+            state->set_step = alarm_add_next_step(&state->temp_alarm, state->set_step);
             state->need_refresh = 1;
             break;
     }
@@ -354,8 +407,21 @@ void alarm_add_save_alarm(alarm_add_state_t *state)
         return;
     }
     
+    // 日期时刻已过：提示后回到日期设置项
+    if (alarm_add_check(&state->temp_alarm) != 0) {
+        OLED_Clear();
+        OLED_Printf_Line(1, " TIME PASSED ");
+        OLED_Printf_Line(2, " CHANGE DATE ");
+        OLED_Refresh();
+        vTaskDelay(pdMS_TO_TICKS(1000));
+        
+        state->set_step = SET_STEP_DATE;
+        state->need_refresh = 1;
+        return;
+    }
+    
     // 保存新闹钟
-    if (Alarm_Add(&state->temp_alarm) == 0) {
+    if (Alarm_Add(&state->temp_alarm) > 0) {
         OLED_Clear();
         OLED_Printf_Line(1, " ALARM SET ");
         OLED_Printf_Line(2, " SUCCESS! ");
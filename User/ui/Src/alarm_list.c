@@ -7,7 +7,9 @@
  */
 
 #include "alarm_list.h"
+#include "menu_tree.h"
 #include "alarm_add.h"
+#include "rtc_date.h"
 #include <stdlib.h>
 
 // ==================================
@@ -22,31 +24,16 @@ static void alarm_list_exit_edit(alarm_list_state_t *state);
 static void alarm_list_display_edit(alarm_list_state_t *state);
 
 // ==================================
-// 页面初始化
+// 页面节点
 // ==================================
 
-/**
- * @brief 初始化闹钟列表页面
- * @return 创建的页面指针
- */
-menu_item_t *alarm_list_init(void)
-{
-    // 创建自定义菜单项，不分配具体状态数据
-    menu_item_t *alarm_list_page = MENU_ITEM_CUSTOM("Alarm List", alarm_list_draw_function, NULL);
-    if (alarm_list_page == NULL) {
-        return NULL;
-    }
-    
-    // 设置回调函数
-    menu_item_set_callbacks(alarm_list_page, 
-                           alarm_list_on_enter, 
-                           alarm_list_on_exit, 
-                           NULL, 
-                           alarm_list_key_handler);
-    
-    printf("Alarm List page created successfully\r\n");
-    return alarm_list_page;
-}
+// 不带状态数据，进入时分配
+const menu_item_t g_alarm_list_page = {
+    MENU_NODE_CUSTOM(MENU_ID_ALARM_LIST, "Alarm List", alarm_list_draw_function, NULL),
+    .on_enter = alarm_list_on_enter,
+    .on_exit = alarm_list_on_exit,
+    .on_key = alarm_list_key_handler,
+};
 
 // ==================================
 // 自定义绘制函数
@@ -69,7 +56,7 @@ void alarm_list_draw_function(void *context)
         alarm_list_display_edit(state);
     } else if (state->in_detail_view) {
         // 显示详情视图
-        alarm_list_display_detail(state, state->selected);
+        alarm_list_display_detail(state, state->detail_id);
     } else {
         // 显示列表视图
         if (Alarm_GetCount() == 0) {
@@ -91,9 +78,9 @@ void alarm_list_draw_function(void *context)
  * @param item 菜单项
  * @param key_event 按键事件
  */
-void alarm_list_key_handler(menu_item_t *item, uint8_t key_event)
+void alarm_list_key_handler(const menu_item_t *item, uint8_t key_event)
 {
-    alarm_list_state_t *state = (alarm_list_state_t *)item->content.custom.draw_context;
+    alarm_list_state_t *state = (alarm_list_state_t *)menu_item_get_context(item);
     if (state == NULL) {
         return;
     }
@@ -118,26 +105,23 @@ void alarm_list_key_handler(menu_item_t *item, uint8_t key_event)
  * @brief 闹钟列表页面进入回调
  * @param item 菜单项
  */
-void alarm_list_on_enter(menu_item_t *item)
+void alarm_list_on_enter(const menu_item_t *item)
 {
     printf("Enter Alarm List page\r\n");
     
-    // 分配状态数据结构
-    alarm_list_state_t *state = (alarm_list_state_t *)pvPortMalloc(sizeof(alarm_list_state_t));
+    // 从页面状态内存池分配，同时设为菜单项上下文
+    alarm_list_state_t *state = (alarm_list_state_t *)menu_item_alloc_context(item, sizeof(alarm_list_state_t));
     if (state == NULL) {
         printf("Error: Failed to allocate alarm list state memory!\r\n");
         return;
     }
     
-    printf("MALLOC: alarm_list_on_enter, state addr=%p, size=%d bytes\r\n", 
+    printf("ALLOC: alarm_list_on_enter, state addr=%p, size=%d bytes\r\n", 
            state, sizeof(alarm_list_state_t));
     
     // 初始化状态数据
     alarm_list_init_state(state);
     
-    // 设置到菜单项上下文
-    item->content.custom.draw_context = state;
-    
     // 清屏并标记需要刷新
     OLED_Clear();
     state->need_refresh = 1;
@@ -147,11 +131,11 @@ void alarm_list_on_enter(menu_item_t *item)
  * @brief 闹钟列表页面退出回调
  * @param item 菜单项
  */
-void alarm_list_on_exit(menu_item_t *item)
+void alarm_list_on_exit(const menu_item_t *item)
 {
     printf("Exit Alarm List page\r\n");
     
-    alarm_list_state_t *state = (alarm_list_state_t *)item->content.custom.draw_context;
+    alarm_list_state_t *state = (alarm_list_state_t *)menu_item_get_context(item);
     if (state == NULL) {
         return;
     }
@@ -162,10 +146,7 @@ void alarm_list_on_exit(menu_item_t *item)
     // 释放状态结构体本身
     printf("FREE: alarm_list_on_exit, state addr=%p, size=%d bytes\r\n", 
            state, sizeof(alarm_list_state_t));
-    vPortFree(state);
-    
-    // 清空指针，防止野指针
-    item->content.custom.draw_context = NULL;
+    menu_item_free_context(item);
     
     // 清屏
     OLED_Clear();
@@ -226,6 +207,7 @@ static void alarm_list_process_list(alarm_list_state_t *state, uint8_t key_event
 {
     switch (key_event) {
         case MENU_EVENT_KEY_UP:
+        case MENU_EVENT_KEY_REPEAT_UP:
             // KEY0 - 上一个闹钟
             printf("Alarm List: KEY0 pressed - Previous alarm\r\n");
             if (state->selected == 0) {
@@ -237,6 +219,7 @@ static void alarm_list_process_list(alarm_list_state_t *state, uint8_t key_event
             break;
             
         case MENU_EVENT_KEY_DOWN:
+        case MENU_EVENT_KEY_REPEAT_DOWN:
             // KEY1 - 下一个闹钟
             printf("Alarm List: KEY1 pressed - Next alarm\r\n");
             state->selected++;
@@ -256,7 +239,7 @@ static void alarm_list_process_list(alarm_list_state_t *state, uint8_t key_event
             // KEY3 - 进入当前选中闹钟的详情界面
             printf("Alarm List: KEY3 pressed - Enter detail\r\n");
             if (Alarm_GetCount() > 0) {
-                alarm_list_enter_detail(state, state->selected);
+                alarm_list_enter_detail(state, Alarm_GetIdAt(state->selected));
             }
             break;
             
@@ -296,7 +279,7 @@ void alarm_list_display_list(alarm_list_state_t *state)
     // 显示当前页的闹钟项目
     for (uint8_t i = 0; i < items_this_page; i++) {
         uint8_t current_idx = start_idx + i; // 实际在总列表中的索引
-        Alarm_TypeDef *alarm = Alarm_Get(current_idx);
+        const Alarm_TypeDef *alarm = Alarm_Get(Alarm_GetIdAt(current_idx));
         
         if (alarm == NULL) {
             continue;
@@ -310,7 +293,7 @@ void alarm_list_display_list(alarm_list_state_t *state)
                          arrow,
                          alarm->hour, alarm->minute, alarm->second,
                          alarm->enabled ? "ON " : "OFF",
-                         alarm->repeat ? "R" : " ");
+                         Alarm_Rule_Label(alarm));
     }
     
     // 如果本页不足ALARM_LIST_SHOWING_NUM行，下面几行清空
@@ -342,20 +325,21 @@ void alarm_list_display_empty(void)
 /**
  * @brief 进入详情视图
  * @param state 列表状态
- * @param alarm_index 闹钟索引
+ * @param id 闹钟ID
  */
-void alarm_list_enter_detail(alarm_list_state_t *state, uint8_t alarm_index)
+void alarm_list_enter_detail(alarm_list_state_t *state, alarm_id_t id)
 {
-    if (alarm_index >= Alarm_GetCount()) {
+    if (Alarm_Get(id) == NULL) {
         return;
     }
     
+    state->detail_id = id;
     state->in_detail_view = 1;
     state->detail_selected = 0;
     state->operating = 0;
     state->need_refresh = 1;
     
-    printf("Enter detail view for alarm index %d\r\n", alarm_index);
+    printf("Enter detail view for alarm ID %04X\r\n", id);
 }
 
 /**
@@ -364,6 +348,15 @@ void alarm_list_enter_detail(alarm_list_state_t *state, uint8_t alarm_index)
  */
 void alarm_list_exit_detail(alarm_list_state_t *state)
 {
+    // 选中项跟随刚才查看的闹钟（编辑后列表顺序可能变化，闹钟被删除则保持位置）
+    int position = Alarm_GetPosition(state->detail_id);
+    if (position >= 0) {
+        state->selected = (uint8_t)position;
+    } else if (state->selected >= Alarm_GetCount()) {
+        state->selected = (Alarm_GetCount() > 0) ? Alarm_GetCount() - 1 : 0;
+    }
+    
+    state->detail_id = ALARM_ID_NONE;
     state->in_detail_view = 0;
     state->detail_selected = 0;
     state->operating = 0;
@@ -424,52 +417,48 @@ void alarm_list_process_detail(alarm_list_state_t *state, uint8_t key_event)
  */
 void alarm_list_handle_detail_action(alarm_list_state_t *state)
 {
-    Alarm_TypeDef *alarm = Alarm_Get(state->selected);
+    const Alarm_TypeDef *alarm = Alarm_Get(state->detail_id);
     if (alarm == NULL) {
         return;
     }
     
+    Alarm_TypeDef updated;
+    
     switch (state->detail_selected) {
         case DETAIL_OPTION_TIME: // 时间选项 - 进入修改页面
             printf("Alarm Detail: Edit time\r\n");
-            // 调用闹钟编辑功能：先读取当前闹钟设置的时间，新建闹钟，再删除原闹钟
+            // 调用闹钟编辑功能：读取当前闹钟设置的时间，保存时原地更新（ID不变）
             alarm_list_edit_time(state);
             break;
             
         case DETAIL_OPTION_STATUS: // 切换状态
             printf("Alarm Detail: Toggle status\r\n");
             if (alarm->enabled) {
-                Alarm_Disable(state->selected);
+                Alarm_Disable(state->detail_id);
             } else {
-                Alarm_Enable(state->selected);
+                Alarm_Enable(state->detail_id);
             }
             state->need_refresh = 1;
             break;
             
-        case DETAIL_OPTION_REPEAT: // 切换重复状态
-            printf("Alarm Detail: Toggle repeat\r\n");
-            alarm->repeat = !alarm->repeat;
+        case DETAIL_OPTION_REPEAT: // 切换重复方式
+            printf("Alarm Detail: Cycle repeat\r\n");
+            updated = *alarm;
+            Alarm_Rule_Cycle(&updated, 1, MyRTC_GetLocalSeconds());
+            Alarm_Update(state->detail_id, &updated);
             state->need_refresh = 1;
             break;
             
         case DETAIL_OPTION_DELETE: // 删除闹钟
             printf("Alarm Detail: Delete alarm\r\n");
-            Alarm_Delete(state->selected);
+            Alarm_Delete(state->detail_id);
             OLED_Clear();
             OLED_Printf_Line(1, " ALARM DELETED ");
             OLED_Refresh();
             vTaskDelay(pdMS_TO_TICKS(1000));
             
-            // 如果删除后没有闹钟了，直接退出详情视图
-            if (Alarm_GetCount() == 0) {
-                alarm_list_exit_detail(state);
-            } else {
-                // 调整选中项
-                if (state->selected >= Alarm_GetCount()) {
-                    state->selected = Alarm_GetCount() - 1;
-                }
-                alarm_list_exit_detail(state);
-            }
+            // 退出详情视图时选中项自动调整
+            alarm_list_exit_detail(state);
             break;
     }
 }
@@ -477,15 +466,11 @@ void alarm_list_handle_detail_action(alarm_list_state_t *state)
 /**
  * @brief 显示闹钟详情
  * @param state 列表状态
- * @param alarm_index 闹钟索引
+ * @param id 闹钟ID
  */
-void alarm_list_display_detail(alarm_list_state_t *state, uint8_t alarm_index)
+void alarm_list_display_detail(alarm_list_state_t *state, alarm_id_t id)
 {
-    if (alarm_index >= Alarm_GetCount()) {
-        return;
-    }
-    
-    Alarm_TypeDef *alarm = Alarm_Get(alarm_index);
+    const Alarm_TypeDef *alarm = Alarm_Get(id);
     if (alarm == NULL) {
         return;
     }
@@ -499,7 +484,7 @@ void alarm_list_display_detail(alarm_list_state_t *state, uint8_t alarm_index)
                      alarm->enabled ? "ENABLED " : "DISABLED");
     OLED_Printf_Line(2, "%c Repeat: %s", 
                      state->detail_selected == DETAIL_OPTION_REPEAT ? '>' : ' ', 
-                     alarm->repeat ? "YES" : "NO");
+                     Alarm_Rule_Label(alarm));
     OLED_Printf_Line(3, "%c Delete", 
                      state->detail_selected == DETAIL_OPTION_DELETE ? '>' : ' ');
     
@@ -518,12 +503,8 @@ void alarm_list_display_detail(alarm_list_state_t *state, uint8_t alarm_index)
  */
 static void alarm_list_edit_time(alarm_list_state_t *state)
 {
-    if (state->selected >= Alarm_GetCount()) {
-        return;
-    }
-    
-    // 获取当前选中的闹钟
-    Alarm_TypeDef *original_alarm = Alarm_Get(state->selected);
+    // 获取详情视图中的闹钟
+    const Alarm_TypeDef *original_alarm = Alarm_Get(state->detail_id);
     if (original_alarm == NULL) {
         return;
     }
@@ -537,23 +518,8 @@ static void alarm_list_edit_time(alarm_list_state_t *state)
     OLED_Refresh();
     vTaskDelay(pdMS_TO_TICKS(500));
     
-    // 创建临时闹钟结构体，复制原闹钟数据
-    Alarm_TypeDef new_alarm;
-    memcpy(&new_alarm, original_alarm, sizeof(Alarm_TypeDef));
-    
-    // 创建新的闹钟设置状态结构体
-    alarm_add_state_t temp_state;
-    memset(&temp_state, 0, sizeof(alarm_add_state_t));
-    
-    // 使用原闹钟的时间初始化临时状态
-    temp_state.temp_alarm.hour = original_alarm->hour;
-    temp_state.temp_alarm.minute = original_alarm->minute;
-    temp_state.temp_alarm.second = original_alarm->second;
-    temp_state.temp_alarm.repeat = original_alarm->repeat;
-    temp_state.temp_alarm.enabled = original_alarm->enabled;
-    
-    temp_state.set_step = SET_STEP_HOUR;
-    temp_state.need_refresh = 1;
+    // 编辑从原闹钟数据开始
+    state->temp_alarm = *original_alarm;
     
     // 显示编辑界面标题
     OLED_Clear();
@@ -598,39 +564,13 @@ static void alarm_list_process_edit(alarm_list_state_t *state, uint8_t key_event
     switch (key_event) {
         case MENU_EVENT_KEY_UP:
             // KEY0 - 增加当前设置项的值
-            switch (state->edit_step) {
-                case SET_STEP_HOUR: // 小时
-                    state->temp_alarm.hour = (state->temp_alarm.hour + 1) % 24;
-                    break;
-                case SET_STEP_MINUTE: // 分钟
-                    state->temp_alarm.minute = (state->temp_alarm.minute + 1) % 60;
-                    break;
-                case SET_STEP_SECOND: // 秒
-                    state->temp_alarm.second = (state->temp_alarm.second + 1) % 60;
-                    break;
-                case SET_STEP_REPEAT: // 重复
-                    state->temp_alarm.repeat = !state->temp_alarm.repeat;
-                    break;
-            }
+            alarm_add_adjust(&state->temp_alarm, state->edit_step, 1);
             state->need_refresh = 1;
             break;
             
         case MENU_EVENT_KEY_DOWN:
             // KEY1 - 减少当前设置项的值
-            switch (state->edit_step) {
-                case SET_STEP_HOUR: // 小时
-                    state->temp_alarm.hour = (state->temp_alarm.hour == 0) ? 23 : state->temp_alarm.hour - 1;
-                    break;
-                case SET_STEP_MINUTE: // 分钟
-                    state->temp_alarm.minute = (state->temp_alarm.minute == 0) ? 59 : state->temp_alarm.minute - 1;
-                    break;
-                case SET_STEP_SECOND: // 秒
-                    state->temp_alarm.second = (state->temp_alarm.second == 0) ? 59 : state->temp_alarm.second - 1;
-                    break;
-                case SET_STEP_REPEAT: // 重复
-                    state->temp_alarm.repeat = !state->temp_alarm.repeat;
-                    break;
-            }
+            alarm_add_adjust(&state->temp_alarm, state->edit_step, -1);
             state->need_refresh = 1;
             break;
             
@@ -638,29 +578,29 @@ static void alarm_list_process_edit(alarm_list_state_t *state, uint8_t key_event
             // KEY2 - 确认保存
             printf("Alarm Edit: Save alarm\r\n");
             
-            // 保存新闹钟
-            if (Alarm_Add(&state->temp_alarm) == 0) {
-                // 删除原闹钟
-                Alarm_Delete(state->selected);
-                
+            // 日期时刻已过：提示后回到日期设置项
+            if (alarm_add_check(&state->temp_alarm) != 0) {
+                OLED_Clear();
+                OLED_Printf_Line(1, " TIME PASSED ");
+                OLED_Printf_Line(2, " CHANGE DATE ");
+                OLED_Refresh();
+                vTaskDelay(pdMS_TO_TICKS(1000));
+                state->edit_step = SET_STEP_DATE;
+                state->need_refresh = 1;
+                break;
+            }
+            
+            // 原地更新闹钟（ID不变，列表按新时间重新排序）
+            if (Alarm_Update(state->detail_id, &state->temp_alarm) == 0) {
                 OLED_Clear();
                 OLED_Printf_Line(1, " ALARM UPDATED ");
                 OLED_Printf_Line(2, " SUCCESSFULLY! ");
                 OLED_Refresh();
                 vTaskDelay(pdMS_TO_TICKS(1000));
                 
-                // 如果删除后没有闹钟了，直接退出详情视图
-                if (Alarm_GetCount() == 0) {
-                    alarm_list_exit_detail(state);
-                    alarm_list_exit_edit(state);
-                } else {
-                    // 调整选中项
-                    if (state->selected >= Alarm_GetCount()) {
-                        state->selected = Alarm_GetCount() - 1;
-                    }
-                    alarm_list_exit_detail(state);
-                    alarm_list_exit_edit(state);
-                }
+                // 退出详情视图，选中项跟随被编辑的闹钟
+                alarm_list_exit_detail(state);
+                alarm_list_exit_edit(state);
             } else {
                 OLED_Clear();
                 OLED_Printf_Line(1, " UPDATE FAILED ");
@@ -672,10 +612,7 @@ static void alarm_list_process_edit(alarm_list_state_t *state, uint8_t key_event
             
         case MENU_EVENT_KEY_ENTER:
             // KEY3 - 下一个设置项
-            state->edit_step++;
-            if (state->edit_step >= SET_STEP_COUNT) {
-                state->edit_step = 0; // 循环回到第一项
-            }
+            state->edit_step = alarm_add_next_step(&state->temp_alarm, state->edit_step);
             state->need_refresh = 1;
             break;
             
@@ -695,43 +632,7 @@ static void alarm_list_display_edit(alarm_list_state_t *state)
     }
     
     // 根据设置步骤高亮显示当前设置项
-    switch (state->edit_step) {
-        case SET_STEP_HOUR: // 设置小时
-            OLED_Clear_Line(1);
-            OLED_Printf_Line(1, " [%02d]:%02d:%02d-loop:%s", 
-                             state->temp_alarm.hour, state->temp_alarm.minute, 
-                             state->temp_alarm.second, state->temp_alarm.repeat ? "YES" : "NO ");
-            OLED_Clear_Line(2);
-            OLED_Printf_Line(2, "   Set Hours");
-            break;
-            
-        case SET_STEP_MINUTE: // 设置分钟
-            OLED_Clear_Line(1);
-            OLED_Printf_Line(1, " %02d:[%02d]:%02d-loop:%s", 
-                             state->temp_alarm.hour, state->temp_alarm.minute, 
-                             state->temp_alarm.second, state->temp_alarm.repeat ? "YES" : "NO ");
-            OLED_Clear_Line(2);
-            OLED_Printf_Line(2, "  Set Minutes");
-            break;
-            
-        case SET_STEP_SECOND: // 设置秒
-            OLED_Clear_Line(1);
-            OLED_Printf_Line(1, " %02d:%02d:[%02d]-loop:%s", 
-                             state->temp_alarm.hour, state->temp_alarm.minute, 
-                             state->temp_alarm.second, state->temp_alarm.repeat ? "YES" : "NO ");
-            OLED_Clear_Line(2);
-            OLED_Printf_Line(2, "   Set Seconds");
-            break;
-            
-        case SET_STEP_REPEAT: // 设置重复
-            OLED_Clear_Line(1);
-            OLED_Printf_Line(1, " %02d:%02d:%02d-loop:[%s]", 
-                             state->temp_alarm.hour, state->temp_alarm.minute, 
-                             state->temp_alarm.second, state->temp_alarm.repeat ? "YES" : "NO ");
-            OLED_Clear_Line(2);
-            OLED_Printf_Line(2, "   Set Repeat");
-            break;
-    }
+    alarm_add_show_setting(&state->temp_alarm, state->edit_step);
     
     // 显示标题和操作提示
     OLED_Printf_Line(0, "  EDIT ALARM");
@@ -1,81 +1,51 @@
 #include "alarm_menu.h"
 #include "alarm_add.h"
 #include "alarm_list.h"
+#include "menu_tree.h"
 
 //+++++++++++++++++++++++=
 // 页面
 //++++++++++++++++++++++++=
 
 // ==================================
-// 图标数组
+// 图标项的子页面
 // ==================================
 
-const unsigned char *alarm_menu_icons[] =
-    {
-        gImage_add, // 新建闹钟图标
-        gImage_list // 闹钟列表图标
+static const menu_item_t *const s_create_children[] = {&g_alarm_add_page};
+static const menu_item_t *const s_list_children[]   = {&g_alarm_list_page};
+
+// ==================================
+// 菜单节点
+// ==================================
+
+#define ALARM_MENU_ITEM(node_id, node_name, icon, list) { \
+    MENU_NODE_ICON(node_id, node_name, icon, 32, 32), \
+    .on_enter = alarm_menu_on_enter, \
+    .on_exit = alarm_menu_on_exit, \
+    MENU_CHILDREN(list), \
+}
+
+const menu_item_t g_alarm_menu_items[ALARM_MENU_COUNT] = {
+    [ALARM_MENU_CREATE] = ALARM_MENU_ITEM(MENU_ID_ALARM_MENU_CREATE, "AlarmAdd", gImage_add, s_create_children),    // 新建闹钟
+    [ALARM_MENU_LIST]   = ALARM_MENU_ITEM(MENU_ID_ALARM_MENU_LIST, "AlarmList", gImage_list, s_list_children),      // 闹钟列表
 };
 
-const char *alarm_menu_names[] =
-    {
-        "AlarmAdd",
-        "AlarmList"};
+static const menu_item_t *const s_alarm_menu_children[ALARM_MENU_COUNT] = {
+    &g_alarm_menu_items[ALARM_MENU_CREATE],
+    &g_alarm_menu_items[ALARM_MENU_LIST],
+};
 
-menu_item_t *alarm_menu_init(void)
-{
-  menu_item_t *alarm_menu = menu_item_create(
-      "Alarm Menu",
-      MENU_TYPE_HORIZONTAL_ICON,
-      (menu_content_t){0} // 主菜单不需要内容
-  );
-  if (alarm_menu == NULL)
-  {
-    return NULL;
-  }
-  for (uint8_t i = 0; i < ALARM_MENU_COUNT; i++)
-  {
-    menu_item_t *menu_item = MENU_ITEM_ICON(
-        alarm_menu_names[i],
-        alarm_menu_icons[i],
-        32, // 图标宽度
-        32  // 图标高度
-    );
+// 闹钟菜单（横向图标菜单，本身不需要内容）
+const menu_item_t g_alarm_menu = {
+    MENU_NODE_ICON(MENU_ID_ALARM_MENU, "Alarm Menu", NULL, 0, 0),
+    MENU_CHILDREN(s_alarm_menu_children),
+};
 
-    if (menu_item != NULL)
-    {
-      // 设置回调函数
-            menu_item_set_callbacks(menu_item, 
-                                   alarm_menu_on_enter,  // 进入回调
-                                   alarm_menu_on_exit,   // 退出回调
-                                   NULL,               // 选中回调（不需要特殊处理）
-                                   NULL); // 按键处理
- 
-  // 创建AlarmAdd页面
-  if(i==0){
-  menu_item_t *alarm_add_page = alarm_add_init();
-  if (alarm_add_page != NULL) {
-    menu_add_child(menu_item, alarm_add_page);
-  }
-}
-  // 创建AlarmList页面
-  if(i==1){
-  menu_item_t *alarm_list_page = alarm_list_init();
-  if (alarm_list_page != NULL) {
-    menu_add_child(menu_item, alarm_list_page);
-  }
-}
-  
-                menu_add_child(alarm_menu, menu_item);                     
-    }
-    
-  }
-  return alarm_menu;
-}
-void alarm_menu_on_enter(menu_item_t *item)
+void alarm_menu_on_enter(const menu_item_t *item)
 {
   printf("Enter alarm menu\r\n");
     OLED_Clear();
 }
-void alarm_menu_on_exit(menu_item_t *item){
+void alarm_menu_on_exit(const menu_item_t *item){
   printf("Exit alarm menu\r\n");
 }
@@ -1,66 +1,156 @@
+/**
+ * @file display_tools.c
+ * @brief 显示服务任务实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
 #include "display_tools.h"
+#include "cycle_counter.h"
 
-// 显示辅助函数
-void display_clear(void)
+// ==================================
+// 全局变量
+// ==================================
+
+static QueueHandle_t s_queue = NULL;
+static TaskHandle_t s_task = NULL;
+static display_stats_t s_stats;
+static volatile uint8_t s_refresh_pending;
+
+// 合成刷新：服务任务正在送屏；发送任务等待超时后作废的、还在队列中的命令数（总是队列中最早的几条）
+static volatile uint8_t s_compose_running;
+static volatile uint8_t s_compose_stale;
+
+// 文本区：发送方在 head 处追加负载，服务任务按命令顺序释放到 tail；head == tail 为空
+static uint8_t s_arena[DISPLAY_ARENA_SIZE];
+static uint16_t s_arena_head;
+static volatile uint16_t s_arena_tail;
+
+// ==================================
+// 静态函数声明
+// ==================================
+
+static int display_arena_reserve(uint8_t len, uint16_t *off);
+static int display_post(uint8_t cmd, uint8_t x, uint8_t y, const void *payload, uint8_t len);
+static int display_post_text(uint8_t cmd, uint8_t x, uint8_t y, const char *format, va_list args);
+static void display_refresh_hook(void);
+static uint8_t display_in_line(const display_msg_t *msg, uint8_t line);
+static uint8_t display_covers(const display_msg_t *cur, const display_msg_t *old);
+static void display_coalesce(display_msg_t *batch, uint8_t count);
+static void display_run_compose(const display_compose_t *compose);
+static void display_execute(const display_msg_t *msg);
+static void display_server_task(void *pvParameters);
+
+// ==================================
+// 服务任务管理
+// ==================================
+
+int display_server_init(void)
 {
-    display_msg_t msg = {.cmd = DISPLAY_CMD_CLEAR};
-    xQueueSend(displayQueue, &msg, 0);
+    s_queue = xQueueCreate(DISPLAY_QUEUE_LEN, sizeof(display_msg_t));
+    if (s_queue == NULL) {
+        return -1;
+    }
+
+    if (xTaskCreate(display_server_task, "Display", DISPLAY_TASK_STACK, NULL,
+                    DISPLAY_TASK_PRIORITY, &s_task) != pdPASS) {
+        vQueueDelete(s_queue);
+        s_queue = NULL;
+        return -2;
+    }
+
+    printf("Display server: %d x %d B commands, %d B arena\r\n",
+           DISPLAY_QUEUE_LEN, (int)sizeof(display_msg_t), DISPLAY_ARENA_SIZE);
+    return 0;
 }
 
-void display_clear_line(uint8_t line)
+const display_stats_t *display_server_get_stats(void)
 {
-    display_msg_t msg = {
-        .cmd = DISPLAY_CMD_CLEAR_LINE,
-        .x = line};
-    xQueueSend(displayQueue, &msg, 0);
+    return &s_stats;
 }
 
-void display_print_line(uint8_t line, const char *format, ...)
+void display_server_print(void)
 {
-    display_msg_t msg = {
-        .cmd = DISPLAY_CMD_PRINT_LINE,
-        .x = line};
+    printf("Display: %lu frames, %lu cmds, %lu coalesced, %u dropped, %u stale, max batch %u\r\n",
+           (unsigned long)s_stats.frames, (unsigned long)s_stats.commands,
+           (unsigned long)s_stats.coalesced, s_stats.dropped, s_stats.stale, s_stats.max_batch);
+}
+
+// ==================================
+// 显示辅助函数
+// ==================================
 
+int display_clear(void)
+{
+    if (s_queue == NULL) {
+        OLED_Clear();
+        return 0;
+    }
+    return display_post(DISPLAY_CMD_CLEAR, 0, 0, NULL, 0);
+}
+
+int display_clear_line(uint8_t line)
+{
+    if (s_queue == NULL) {
+        OLED_Clear_Line(line);
+        OLED_Set_Dirty_Area(0, line * OLED_LINE_HEIGHT, 127, (line + 1) * OLED_LINE_HEIGHT - 1);
+        OLED_Refresh_Dirty();
+        return 0;
+    }
+    return display_post(DISPLAY_CMD_CLEAR_LINE, line, 0, NULL, 0);
+}
+
+int display_print_line(uint8_t line, const char *format, ...)
+{
     va_list args;
+    int ret;
+
     va_start(args, format);
-    vsnprintf(msg.text, sizeof(msg.text), format, args);
+    ret = display_post_text(DISPLAY_CMD_PRINT_LINE, line, 0, format, args);
     va_end(args);
 
-    // 确保结尾为 \0（vsnprintf 会自动加，但防 buffer 满时截断无 \0）
-    msg.text[sizeof(msg.text) - 1] = '\0';
-
-    xQueueSend(displayQueue, &msg, 0);
+    return ret;
 }
 
-void display_print_line_32(uint8_t line, const char *format, ...)
+int display_print_line_32(uint8_t line, const char *format, ...)
 {
-    display_msg_t msg = {
-        .cmd = DISPLAY_CMD_PRINT_32,
-        .x = line};
-
     va_list args;
+    int ret;
+
     va_start(args, format);
-    vsnprintf(msg.text, sizeof(msg.text), format, args);
+    ret = display_post_text(DISPLAY_CMD_PRINT_32, line, 0, format, args);
     va_end(args);
 
-    // 确保结尾为 \0（vsnprintf 会自动加，但防 buffer 满时截断无 \0）
-    msg.text[sizeof(msg.text) - 1] = '\0';
+    return ret;
+}
+
+int display_print(uint8_t x, uint8_t y, const char *text)
+{
+    uint8_t len = (uint8_t)strnlen(text, DISPLAY_TEXT_MAX);
 
-    xQueueSend(displayQueue, &msg, 0);
+    if (s_queue == NULL) {
+        OLED_ShowString(x, y, (uint8_t *)text, 12, 1);
+        OLED_Refresh();
+        return 0;
+    }
+    return display_post(DISPLAY_CMD_PRINT, x, y, text, len);
 }
 
-void display_print(uint8_t x, uint8_t y, const char *text)
+int display_picture(uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                    const unsigned char *data, uint8_t mode)
 {
-    display_msg_t msg = {
-        .cmd = DISPLAY_CMD_PRINT,
-        .x = x,
-        .y = y};
-    strncpy(msg.text, text, sizeof(msg.text) - 1);
-    msg.text[sizeof(msg.text) - 1] = '\0';
-    xQueueSend(displayQueue, &msg, 0);
+    display_picture_t pic = {data, width, height, mode};
+
+    if (s_queue == NULL) {
+        OLED_ShowPicture(x, y, width, height, data, mode);
+        OLED_Refresh();
+        return 0;
+    }
+    return display_post(DISPLAY_CMD_PICTURE, x, y, &pic, sizeof(pic));
 }
 
-void display_DrawProgressBar(
+int display_DrawProgressBar(
     uint8_t x, uint8_t y,
     uint8_t width, uint8_t height,
     int32_t value,
@@ -68,25 +158,435 @@ void display_DrawProgressBar(
     uint8_t show_border,
     uint8_t fill_mode)
 {
-    display_msg_t msg; // 初始化为0（避免联合体垃圾数据）
-  memset(&msg, 0, sizeof(msg));  
-	msg.cmd = DISPLAY_CMD_PROGRESS_BAR;
-    msg.x = x;
-    msg.y = y;
+    display_progress_t bar = {value, min_val, max_val, width, height, show_border, fill_mode};
+
+    if (s_queue == NULL) {
+        OLED_DrawProgressBar(x, y, width, height, value, min_val, max_val, show_border, fill_mode, 1);
+        OLED_Set_Dirty_Area(x, y, x + width - 1, y + height - 1);
+        OLED_Refresh_Dirty();
+        return 0;
+    }
+    return display_post(DISPLAY_CMD_PROGRESS_BAR, x, y, &bar, sizeof(bar));
+}
+
+int display_refresh(void)
+{
+    if (s_queue == NULL) {
+        OLED_Refresh_Dirty();
+        return 0;
+    }
+    return display_post(DISPLAY_CMD_REFRESH, 0, 0, NULL, 0);
+}
+
+int display_compose(const uint8_t *back, int16_t back_x, int16_t front_x, uint8_t x1, uint8_t x2)
+{
+    display_compose_t compose = {back, NULL, back_x, front_x, x1, x2};
+    int ret;
+
+    // 服务任务还没接管总线时直接发送
+    if (s_queue == NULL || xTaskGetCurrentTaskHandle() == s_task) {
+        display_run_compose(&compose);
+        return 0;
+    }
+
+    compose.waiter = xTaskGetCurrentTaskHandle();
+    ret = display_post(DISPLAY_CMD_COMPOSE, 0, 0, &compose, sizeof(compose));
+    if (ret != 0) {
+        return ret;
+    }
+
+    // back 在调用者栈上，必须等服务任务发完再返回
+    if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(DISPLAY_COMPOSE_TIMEOUT_MS)) != 0) {
+        return 0;
+    }
+
+    // 超时：挂起调度器判断命令的去向，服务任务的开始/结束标记也在挂起调度器时修改
+    vTaskSuspendAll();
+    if (s_compose_running) {
+        ret = 1;                            // 正在送屏：不能返回，等它发完
+    } else if (ulTaskNotifyTake(pdTRUE, 0) != 0) {
+        ret = 0;                            // 刚好发完
+    } else {
+        s_compose_stale++;                  // 还在队列中：作废，服务任务跳过且不通知
+        ret = -3;
+    }
+    xTaskResumeAll();
+
+    if (ret == 1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        ret = 0;
+    }
+    return ret;
+}
+
+// ==================================
+// 静态函数实现
+// ==================================
+
+/**
+ * @brief 在文本区预留连续的 len 字节（调度器挂起时调用）
+ * @param len 字节数
+ * @param off 输出偏移
+ * @return 0-成功，-1-空间不足
+ * @note 尾部放不下时从头开始，尾部剩余字节随这条负载一起释放
+ */
+static int display_arena_reserve(uint8_t len, uint16_t *off)
+{
+    uint16_t head = s_arena_head;
+    uint16_t tail = s_arena_tail;
+
+    if (head >= tail) {
+        // 空闲区为 [head, 末尾) 和 [0, tail)，保留1字节区分空和满
+        if (head + len < DISPLAY_ARENA_SIZE || (head + len == DISPLAY_ARENA_SIZE && tail != 0)) {
+            *off = head;
+        } else if (len < tail) {
+            *off = 0;
+        } else {
+            return -1;
+        }
+    } else {
+        if (head + len < tail) {
+            *off = head;
+        } else {
+            return -1;
+        }
+    }
+
+    s_arena_head = (*off + len) % DISPLAY_ARENA_SIZE;
+    return 0;
+}
+
+/**
+ * @brief 发送一条命令
+ * @return 0-成功，-1-队列满，-2-文本区满
+ * @note 挂起调度器：预留、拷贝负载、入队是一个整体，保证负载在文本区中的顺序与命令顺序一致
+ */
+static int display_post(uint8_t cmd, uint8_t x, uint8_t y, const void *payload, uint8_t len)
+{
+    display_msg_t msg = {cmd, x, y, len, 0};
+    uint16_t head;
+    int ret = 0;
+
+    vTaskSuspendAll();
+    head = s_arena_head;
+    if (len > 0) {
+        if (display_arena_reserve(len, &msg.off) != 0) {
+            ret = -2;
+        } else {
+            memcpy(&s_arena[msg.off], payload, len);
+        }
+    }
+    if (ret == 0 && xQueueSend(s_queue, &msg, 0) != pdPASS) {
+        s_arena_head = head;
+        ret = -1;
+    }
+    if (ret != 0) {
+        s_stats.dropped++;
+    }
+    xTaskResumeAll();
+
+    return ret;
+}
+
+/**
+ * @brief 格式化文本并发送（只占用实际长度的文本区）
+ */
+static int display_post_text(uint8_t cmd, uint8_t x, uint8_t y, const char *format, va_list args)
+{
+    char text[DISPLAY_TEXT_MAX + 1];
+    int len = vsnprintf(text, sizeof(text), format, args);
+
+    if (len < 0) {
+        len = 0;
+    } else if (len > DISPLAY_TEXT_MAX) {
+        len = DISPLAY_TEXT_MAX;
+    }
+
+    if (s_queue == NULL) {
+        if (cmd == DISPLAY_CMD_PRINT_32) {
+            OLED_Printf_Line_32(x, "%s", text);
+        } else {
+            OLED_Printf_Line(x, "%s", text);
+        }
+        OLED_Refresh_Dirty();
+        return 0;
+    }
+
+    return display_post(cmd, x, y, text, (uint8_t)len);
+}
+
+/**
+ * @brief 刷新钩子：任何任务调用 OLED_Refresh 系列时请求服务任务送屏
+ * @note 一帧内只发一条刷新命令；服务任务自己执行命令时不发
+ */
+static void display_refresh_hook(void)
+{
+    display_msg_t msg = {DISPLAY_CMD_REFRESH, 0, 0, 0, 0};
+
+    if (xTaskGetCurrentTaskHandle() == s_task || s_refresh_pending) {
+        return;
+    }
+
+    s_refresh_pending = 1;
+    if (xQueueSend(s_queue, &msg, 0) != pdPASS) {
+        // 队列满说明服务任务本来就有活，它处理完会送屏
+        s_stats.dropped++;
+    }
+}
+
+/**
+ * @brief 命令的绘制区域是否完全落在某一行内（行高 OLED_LINE_HEIGHT）
+ */
+static uint8_t display_in_line(const display_msg_t *msg, uint8_t line)
+{
+    switch (msg->cmd) {
+        case DISPLAY_CMD_CLEAR_LINE:
+        case DISPLAY_CMD_PRINT_LINE:
+            return msg->x == line;
+
+        case DISPLAY_CMD_PRINT:
+            // 12px 字体
+            return msg->y >= line * OLED_LINE_HEIGHT && msg->y + 12 <= (line + 1) * OLED_LINE_HEIGHT;
+
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief 新命令是否完全覆盖旧命令的绘制结果（旧命令可以不执行）
+ */
+static uint8_t display_covers(const display_msg_t *cur, const display_msg_t *old)
+{
+    display_progress_t a, b;
+    display_picture_t p, q;
+
+    if (old->cmd == DISPLAY_CMD_NONE || old->cmd == DISPLAY_CMD_REFRESH || old->cmd == DISPLAY_CMD_COMPOSE) {
+        return 0;
+    }
+
+    switch (cur->cmd) {
+        case DISPLAY_CMD_CLEAR:
+            return 1;
+
+        case DISPLAY_CMD_CLEAR_LINE:
+        case DISPLAY_CMD_PRINT_LINE:
+        case DISPLAY_CMD_PRINT_32:
+            // 三者都先清除第 x 行
+            return display_in_line(old, cur->x);
+
+        case DISPLAY_CMD_PRINT:
+            // 字符格连背景一起画，同位置且不短于旧文本即覆盖
+            return old->cmd == DISPLAY_CMD_PRINT && old->x == cur->x && old->y == cur->y && old->len <= cur->len;
+
+        case DISPLAY_CMD_PROGRESS_BAR:
+            // 进度条先清除自身区域
+            if (old->cmd != DISPLAY_CMD_PROGRESS_BAR || old->x != cur->x || old->y != cur->y) {
+                return 0;
+            }
+            memcpy(&a, &s_arena[cur->off], sizeof(a));
+            memcpy(&b, &s_arena[old->off], sizeof(b));
+            return a.width == b.width && a.height == b.height;
+
+        case DISPLAY_CMD_PICTURE:
+            // 图片逐点画前景和背景
+            if (old->cmd != DISPLAY_CMD_PICTURE || old->x != cur->x || old->y != cur->y) {
+                return 0;
+            }
+            memcpy(&p, &s_arena[cur->off], sizeof(p));
+            memcpy(&q, &s_arena[old->off], sizeof(q));
+            return p.width == q.width && p.height == q.height;
+
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief 合并一帧内的命令：被后续命令完全覆盖的绘制和多余的刷新命令置为 DISPLAY_CMD_NONE
+ */
+static void display_coalesce(display_msg_t *batch, uint8_t count)
+{
+    for (uint8_t i = 0; i < count; i++) {
+        // 帧末统一送屏，刷新命令只用于唤醒
+        if (batch[i].cmd == DISPLAY_CMD_REFRESH) {
+            batch[i].cmd = DISPLAY_CMD_NONE;
+            s_stats.coalesced++;
+            continue;
+        }
+        for (uint8_t j = 0; j < i; j++) {
+            if (display_covers(&batch[i], &batch[j])) {
+                batch[j].cmd = DISPLAY_CMD_NONE;
+                s_stats.coalesced++;
+            }
+        }
+    }
+}
 
-    msg.extra.progress.width = width;
-    msg.extra.progress.height = height;
-    msg.extra.progress.value = value;
-    msg.extra.progress.min_val = min_val;
-    msg.extra.progress.max_val = max_val;
-    msg.extra.progress.show_border = show_border;
-    msg.extra.progress.fill_mode = fill_mode;
+/**
+ * @brief 执行合成刷新并记录送屏耗时
+ */
+static void display_run_compose(const display_compose_t *compose)
+{
+    uint32_t start = cycle_counter_get();
 
-    xQueueSend(displayQueue, &msg, 0);
+    OLED_Refresh_Compose(compose->back, compose->back_x, compose->front_x, compose->x1, compose->x2);
+    s_stats.compose_us = (cycle_counter_get() - start) / (SystemCoreClock / 1000000);
 }
 
-void display_refresh(void)
+/**
+ * @brief 执行一条命令（只改显存和脏区域，合成刷新除外）
+ * @note 挂起调度器执行，菜单任务不会在半条命令中间改写显存
+ */
+static void display_execute(const display_msg_t *msg)
 {
-    display_msg_t msg = {.cmd = DISPLAY_CMD_REFRESH};
-    xQueueSend(displayQueue, &msg, 0);
+    char text[DISPLAY_TEXT_MAX + 1];
+    display_picture_t pic;
+    display_progress_t bar;
+    display_compose_t compose;
+
+    switch (msg->cmd) {
+        case DISPLAY_CMD_PRINT_LINE:
+        case DISPLAY_CMD_PRINT_32:
+        case DISPLAY_CMD_PRINT:
+            memcpy(text, &s_arena[msg->off], msg->len);
+            text[msg->len] = '\0';
+            break;
+
+        case DISPLAY_CMD_PICTURE:
+            memcpy(&pic, &s_arena[msg->off], sizeof(pic));
+            break;
+
+        case DISPLAY_CMD_PROGRESS_BAR:
+            memcpy(&bar, &s_arena[msg->off], sizeof(bar));
+            break;
+
+        case DISPLAY_CMD_COMPOSE:
+            // 作废的命令 back 已经失效，跳过且不通知
+            vTaskSuspendAll();
+            if (s_compose_stale > 0) {
+                s_compose_stale--;
+                s_stats.stale++;
+            } else {
+                s_compose_running = 1;
+            }
+            xTaskResumeAll();
+            if (!s_compose_running) {
+                return;
+            }
+
+            // 发送任务在等待，显存不会变化，不必挂起调度器
+            memcpy(&compose, &s_arena[msg->off], sizeof(compose));
+            display_run_compose(&compose);
+
+            vTaskSuspendAll();
+            s_compose_running = 0;
+            xTaskNotifyGive(compose.waiter);
+            xTaskResumeAll();
+            return;
+
+        default:
+            break;
+    }
+
+    vTaskSuspendAll();
+    switch (msg->cmd) {
+        case DISPLAY_CMD_CLEAR:
+            OLED_Clear();
+            break;
+
+        case DISPLAY_CMD_CLEAR_LINE:
+            OLED_Clear_Line(msg->x);
+            OLED_Set_Dirty_Area(0, msg->x * OLED_LINE_HEIGHT, 127, (msg->x + 1) * OLED_LINE_HEIGHT - 1);
+            break;
+
+        case DISPLAY_CMD_PRINT_LINE:
+            OLED_Printf_Line(msg->x, "%s", text);
+            break;
+
+        case DISPLAY_CMD_PRINT_32:
+            OLED_Printf_Line_32(msg->x, "%s", text);
+            break;
+
+        case DISPLAY_CMD_PRINT:
+            if (msg->len > 0) {
+                OLED_ShowString(msg->x, msg->y, (uint8_t *)text, 12, 1);
+                OLED_Set_Dirty_Area(msg->x, msg->y, msg->x + msg->len * 6 - 1, msg->y + 11);
+            }
+            break;
+
+        case DISPLAY_CMD_PICTURE:
+            OLED_ShowPicture(msg->x, msg->y, pic.width, pic.height, pic.data, pic.mode);
+            OLED_Set_Dirty_Area(msg->x, msg->y, msg->x + pic.width - 1, msg->y + pic.height - 1);
+            break;
+
+        case DISPLAY_CMD_PROGRESS_BAR:
+            OLED_DrawProgressBar(msg->x, msg->y, bar.width, bar.height, bar.value,
+                                 bar.min_val, bar.max_val, bar.show_border, bar.fill_mode, 1);
+            OLED_Set_Dirty_Area(msg->x, msg->y, msg->x + bar.width - 1, msg->y + bar.height - 1);
+            break;
+
+        default:
+            break;
+    }
+    xTaskResumeAll();
+}
+
+/**
+ * @brief 显示服务任务：收集一帧内的命令，合并、执行，再把脏区域送屏一次
+ */
+static void display_server_task(void *pvParameters)
+{
+    display_msg_t batch[DISPLAY_QUEUE_LEN];
+    TickType_t frame_start = xTaskGetTickCount() - pdMS_TO_TICKS(DISPLAY_FRAME_MS);
+    TickType_t elapsed;
+    uint8_t count;
+    uint8_t x1, y1, x2, y2;
+    uint8_t dirty;
+
+    // 此后 OLED_Refresh 系列只标记脏区域，总线只在这里访问
+    OLED_Set_Refresh_Hook(display_refresh_hook);
+    printf("Display server started\r\n");
+
+    while (1) {
+        xQueueReceive(s_queue, &batch[0], portMAX_DELAY);
+        count = 1;
+
+        // 距上次送屏不足一帧时继续收集；合成刷新有任务在等，立即执行
+        while (count < DISPLAY_QUEUE_LEN && batch[count - 1].cmd != DISPLAY_CMD_COMPOSE) {
+            elapsed = xTaskGetTickCount() - frame_start;
+            if (xQueueReceive(s_queue, &batch[count],
+                              (elapsed < pdMS_TO_TICKS(DISPLAY_FRAME_MS)) ?
+                              pdMS_TO_TICKS(DISPLAY_FRAME_MS) - elapsed : 0) != pdPASS) {
+                break;
+            }
+            count++;
+        }
+
+        s_stats.commands += count;
+        if (count > s_stats.max_batch) {
+            s_stats.max_batch = count;
+        }
+
+        display_coalesce(batch, count);
+        for (uint8_t i = 0; i < count; i++) {
+            display_execute(&batch[i]);
+            // 按命令顺序释放负载（被合并掉的命令也要释放）
+            if (batch[i].len > 0) {
+                s_arena_tail = (batch[i].off + batch[i].len) % DISPLAY_ARENA_SIZE;
+            }
+        }
+
+        // 先清刷新请求再取脏区域：之后的绘制会发出新的刷新请求
+        vTaskSuspendAll();
+        s_refresh_pending = 0;
+        dirty = OLED_Take_Dirty(&x1, &y1, &x2, &y2);
+        xTaskResumeAll();
+
+        if (dirty) {
+            OLED_Send_Area(x1, y1, x2, y2);
+            s_stats.frames++;
+            frame_start = xTaskGetTickCount();
+        }
+    }
 }
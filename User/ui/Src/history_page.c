@@ -0,0 +1,253 @@
+#include "history_page.h"
+#include "menu_tree.h"
+#include "rtc_date.h"
+#if HISTORY_PAGE_PROFILE
+#include "cycle_counter.h"
+#endif
+
+// ==================================
+// 本页面变量定义
+// ==================================
+static history_page_state_t s_history_page_state[HISTORY_SERIES_COUNT];
+
+static const uint16_t s_zoom_minutes[HISTORY_PAGE_ZOOM_COUNT] = {HISTORY_MINUTES_PER_DAY, 360, 120};
+static const char *const s_series_names[HISTORY_SERIES_COUNT] = {"Step", "Temp", "Humi"};
+
+// ==================================
+// 静态函数
+// ==================================
+
+/**
+ * @brief 自动量程遍历回调
+ */
+static void history_page_range_visit(void *ctx, int16_t value)
+{
+    OLED_Chart_Range_Add((oled_chart_t *)ctx, value);
+}
+
+/**
+ * @brief 绘制遍历回调
+ */
+static void history_page_push_visit(void *ctx, int16_t value)
+{
+    OLED_Chart_Push((oled_chart_t *)ctx, value);
+}
+
+/**
+ * @brief 当前本地时间在当天的分钟数
+ */
+static uint16_t history_page_now_minute(void)
+{
+    return (uint16_t)((MyRTC_GetLocalSeconds() % 86400) / 60);
+}
+
+/**
+ * @brief 标题行：序列名、时间窗口、窗口内最大值
+ */
+static void history_page_draw_title(history_page_state_t *state, uint8_t has_data, int16_t hi)
+{
+    uint16_t last = state->first + s_zoom_minutes[state->zoom];
+    char value[8];
+
+    if (!has_data) {
+        snprintf(value, sizeof(value), "--");
+    } else if (state->series == HISTORY_SERIES_STEPS) {
+        snprintf(value, sizeof(value), "%d", hi);
+    } else {
+        snprintf(value, sizeof(value), "%s%d.%d", (hi < 0) ? "-" : "",
+                 (hi < 0 ? -hi : hi) / 10, (hi < 0 ? -hi : hi) % 10);
+    }
+
+    OLED_Printf_Line(0, "%s %02u:%02u-%02u:%02u %s", s_series_names[state->series],
+                     state->first / 60, state->first % 60, last / 60, last % 60, value);
+}
+
+// ==================================
+// 页面节点（每个序列一个，共用回调，上下文为各自的状态）
+// ==================================
+
+#define HISTORY_PAGE_NODE(node_id, series) { \
+    MENU_NODE_CUSTOM(node_id, "History", history_page_draw_function, &s_history_page_state[series]), \
+    .refresh_ms = HISTORY_PAGE_REFRESH_MS, \
+    .on_create = history_page_on_create, \
+    .on_enter = history_page_on_enter, \
+    .on_exit = history_page_on_exit, \
+    .on_key = history_page_key_handler, \
+}
+
+const menu_item_t g_history_pages[HISTORY_SERIES_COUNT] = {
+    [HISTORY_SERIES_STEPS] = HISTORY_PAGE_NODE(MENU_ID_HISTORY_STEPS, HISTORY_SERIES_STEPS),
+    [HISTORY_SERIES_TEMP]  = HISTORY_PAGE_NODE(MENU_ID_HISTORY_TEMP, HISTORY_SERIES_TEMP),
+    [HISTORY_SERIES_HUMI]  = HISTORY_PAGE_NODE(MENU_ID_HISTORY_HUMI, HISTORY_SERIES_HUMI),
+};
+
+// ==================================
+// 页面初始化
+// ==================================
+
+/**
+ * @brief 构造历史曲线页面：初始化状态和图表（首次进入时调用，之后状态常驻）
+ * @param item 页面节点，g_history_pages 中的一项
+ */
+int8_t history_page_on_create(const menu_item_t *item)
+{
+    history_page_state_t *state;
+    uint8_t series = (uint8_t)(item - g_history_pages);
+
+    if (series >= HISTORY_SERIES_COUNT) {
+        return -1;
+    }
+
+    state = &s_history_page_state[series];
+    memset(state, 0, sizeof(*state));
+    state->series = (uint8_t)series;
+    if (series == HISTORY_SERIES_STEPS) {
+        OLED_Chart_Init(&state->chart, 0, HISTORY_PAGE_CHART_Y, 128, 64 - HISTORY_PAGE_CHART_Y,
+                        OLED_CHART_BAR, OLED_CHART_FLAG_AUTO | OLED_CHART_FLAG_ZERO);
+    } else {
+        OLED_Chart_Init(&state->chart, 0, HISTORY_PAGE_CHART_Y, 128, 64 - HISTORY_PAGE_CHART_Y,
+                        OLED_CHART_LINE, OLED_CHART_FLAG_AUTO);
+    }
+
+    printf("History page (%s) initialized successfully\r\n", s_series_names[series]);
+    return 0;
+}
+
+// ==================================
+// 自定义绘制函数
+// ==================================
+
+/**
+ * @brief 历史曲线绘制函数（只在按键或跨分钟时重绘）
+ * @param context 绘制上下文
+ */
+void history_page_draw_function(void *context)
+{
+    history_page_state_t *state = (history_page_state_t *)context;
+    oled_chart_t *chart;
+    uint16_t window;
+    uint16_t now;
+    uint8_t has_data;
+    int16_t peak;
+#if HISTORY_PAGE_PROFILE
+    uint32_t profile_start;
+#endif
+
+    if (state == NULL) {
+        return;
+    }
+
+    now = history_page_now_minute();
+    if (!state->need_refresh && now == state->drawn_minute) {
+        return;
+    }
+    state->need_refresh = 0;
+    state->drawn_minute = now;
+
+#if HISTORY_PAGE_PROFILE
+    cycle_counter_init();
+    profile_start = cycle_counter_get();
+#endif
+
+    // 第一遍统计量程，第二遍逐列抽取写入显存，都是顺序解码，无需整天的缓冲区
+    chart = &state->chart;
+    window = s_zoom_minutes[state->zoom];
+    OLED_Chart_Range_Reset(chart);
+    history_visit_minutes((history_series_t)state->series, state->first, window,
+                          history_page_range_visit, chart);
+    has_data = (chart->lo <= chart->hi);
+    peak = chart->hi;
+
+    OLED_Chart_Begin(chart, window);
+    history_visit_minutes((history_series_t)state->series, state->first, window,
+                          history_page_push_visit, chart);
+    OLED_Chart_End(chart);
+
+#if HISTORY_PAGE_PROFILE
+    printf("history_page: redraw %lu cycles (%u min)\r\n",
+           (unsigned long)(cycle_counter_get() - profile_start), window);
+#endif
+
+    history_page_draw_title(state, has_data, peak);
+    OLED_Refresh_Dirty();
+}
+
+// ==================================
+// 按键处理
+// ==================================
+
+/**
+ * @brief 历史曲线按键处理函数
+ * @param item 菜单项
+ * @param key_event 按键事件
+ */
+void history_page_key_handler(const menu_item_t *item, uint8_t key_event)
+{
+    history_page_state_t *state = (history_page_state_t *)menu_item_get_context(item);
+    uint16_t window = s_zoom_minutes[state->zoom];
+    uint16_t center;
+
+    switch (key_event) {
+        case MENU_EVENT_KEY_UP:
+        case MENU_EVENT_KEY_REPEAT_UP:
+            // KEY0 - 窗口前移1/4
+            state->first = OLED_Chart_Scroll(state->first, -(int16_t)(window / 4), window,
+                                             HISTORY_MINUTES_PER_DAY);
+            break;
+
+        case MENU_EVENT_KEY_DOWN:
+        case MENU_EVENT_KEY_REPEAT_DOWN:
+            // KEY1 - 窗口后移1/4
+            state->first = OLED_Chart_Scroll(state->first, window / 4, window,
+                                             HISTORY_MINUTES_PER_DAY);
+            break;
+
+        case MENU_EVENT_KEY_SELECT:
+            // KEY2 - 返回上一级
+            menu_back_to_parent();
+            return;
+
+        case MENU_EVENT_KEY_ENTER:
+            // KEY3 - 切换缩放，保持窗口中心不变（从全天放大时以当前时间为中心）
+            center = (state->zoom == 0) ? history_page_now_minute() : state->first + window / 2;
+            state->zoom = (state->zoom + 1) % HISTORY_PAGE_ZOOM_COUNT;
+            window = s_zoom_minutes[state->zoom];
+            state->first = OLED_Chart_Scroll(0, (int16_t)center - (int16_t)(window / 2), window,
+                                             HISTORY_MINUTES_PER_DAY);
+            break;
+
+        default:
+            break;
+    }
+
+    state->need_refresh = 1;
+}
+
+// ==================================
+// 回调函数
+// ==================================
+
+/**
+ * @brief 历史曲线页面进入回调
+ * @param item 菜单项
+ */
+void history_page_on_enter(const menu_item_t *item)
+{
+    history_page_state_t *state = (history_page_state_t *)menu_item_get_context(item);
+
+    printf("Enter History page\r\n");
+    OLED_Clear();
+    state->zoom = 0;
+    state->first = 0;
+    state->need_refresh = 1;
+}
+
+/**
+ * @brief 历史曲线页面退出回调
+ * @param item 菜单项
+ */
+void history_page_on_exit(const menu_item_t *item)
+{
+    printf("Exit History page\r\n");
+    OLED_Clear();
+}
@@ -8,6 +8,7 @@
 
 #include "index.h"
 #include "main_menu.h"
+#include "menu_tree.h"
 #include <string.h>
 #include "simple_pedometer.h"
 // ==================================
@@ -22,12 +23,32 @@ index_state_t g_index_state = {0};
 
 static void index_display_time_info(void);
 static void index_display_status_info(void);
+static void index_on_clock(uint8_t events, const rtc_clock_time_t *now, BaseType_t *woken);
+
+// ==================================
+// 页面节点
+// ==================================
+
+// 主菜单（KEY3进入）
+static const menu_item_t *const s_index_children[] = {
+    &g_main_menu,
+};
+
+// 不设周期刷新：RTC秒中断到来时请求重绘，秒数跳变与RTC对齐
+const menu_item_t g_index_page = {
+    MENU_NODE_CUSTOM(MENU_ID_INDEX, "Index", index_draw_function, &g_index_state),
+    .on_create = index_on_create,
+    .on_enter = index_on_enter,
+    .on_exit = index_on_exit,
+    .on_key = index_key_handler,
+    MENU_CHILDREN(s_index_children),
+};
 
 // ==================================
 // 首页实现
 // ==================================
 
-menu_item_t* index_init(void)
+int8_t index_on_create(const menu_item_t *item)
 {
     // 初始化首页状态
     memset(&g_index_state, 0, sizeof(index_state_t));
@@ -36,30 +57,11 @@ menu_item_t* index_init(void)
     g_index_state.step_count = 0;
     g_index_state.step_active = 0;
     
-	  
-    // 初始化RTC
-    MyRTC_Init();
-    
-    // 创建首页菜单项
-    menu_item_t* index_menu = MENU_ITEM_CUSTOM("Index", index_draw_function, &g_index_state);
-    if (index_menu == NULL) {
-        return NULL;
-    }
-   
-
-    
-    // 设置回调函数
-    menu_item_set_callbacks(index_menu, index_on_enter, index_on_exit, NULL, index_key_handler);
-    
-    // 创建并添加主菜单作为子菜单
-    menu_item_t* main_menu = main_menu_init();
-    if (main_menu != NULL) {
-        menu_add_child(index_menu, main_menu);
-    }
+    // 秒事件到来时请求重绘
+    RTC_Clock_Subscribe(RTC_CLOCK_EVT_SECOND, index_on_clock);
     
     printf("Index page initialized successfully\r\n");
-    
-    return index_menu;
+    return 0;
 }
 
 void index_draw_function(void* context)
@@ -84,9 +86,9 @@ void index_draw_function(void* context)
     OLED_Refresh_Dirty();
 }
 
-void index_key_handler(menu_item_t* item, uint8_t key_event)
+void index_key_handler(const menu_item_t *item, uint8_t key_event)
 {
-    index_state_t* state = (index_state_t*)item->content.custom.draw_context;
+    index_state_t* state = (index_state_t*)menu_item_get_context(item);
     
     switch (key_event) {
         case MENU_EVENT_KEY_UP:
@@ -126,17 +128,18 @@ void index_key_handler(menu_item_t* item, uint8_t key_event)
 
 void index_update_time(void)
 {
-    // 读取RTC时间
-    MyRTC_ReadTime();
+    // 读取时钟服务的时间（结构体拷贝，不再读RTC分解日期）
+    rtc_clock_time_t now;
+    RTC_Clock_Get(&now);
     
     // 更新状态
-    g_index_state.hours = RTC_data.hours;
-    g_index_state.minutes = RTC_data.minutes;
-    g_index_state.seconds = RTC_data.seconds;
-    g_index_state.day = RTC_data.day;
-    g_index_state.month = RTC_data.mon;
-    g_index_state.year = RTC_data.year;
-    strncpy(g_index_state.weekday, RTC_data.weekday, sizeof(g_index_state.weekday) - 1);
+    g_index_state.hours = now.hours;
+    g_index_state.minutes = now.minutes;
+    g_index_state.seconds = now.seconds;
+    g_index_state.day = now.day;
+    g_index_state.month = now.month;
+    g_index_state.year = now.year;
+    strncpy(g_index_state.weekday, MyRTC_WeekdayName(now.weekday), sizeof(g_index_state.weekday) - 1);
     g_index_state.weekday[sizeof(g_index_state.weekday) - 1] = '\0';
 }
 
@@ -151,14 +154,14 @@ void index_refresh_display(void)
     g_index_state.last_update = xTaskGetTickCount();
 }
 
-void index_on_enter(menu_item_t* item)
+void index_on_enter(const menu_item_t *item)
 {
     printf("Enter index page\r\n");
     OLED_Clear();
     g_index_state.need_refresh = 1;
 }
 
-void index_on_exit(menu_item_t* item)
+void index_on_exit(const menu_item_t *item)
 {
     printf("Exit index page\r\n");
     OLED_Clear();
@@ -168,6 +171,16 @@ void index_on_exit(menu_item_t* item)
 // 静态函数实现
 // ==================================
 
+/**
+ * @brief 时钟秒事件（RTC中断中调用）：首页显示时请求重绘
+ */
+static void index_on_clock(uint8_t events, const rtc_clock_time_t *now, BaseType_t *woken)
+{
+    if (g_menu_sys.current_menu == &g_index_page) {
+        menu_request_refresh_from_isr(woken);
+    }
+}
+
 static void index_display_time_info(void)
 {
     // 显示日期和星期：第0行
@@ -187,8 +200,9 @@ static void index_display_time_info(void)
 static void index_display_status_info(void)
 {
     g_index_state.step_count=simple_pedometer_get_steps();
-    // 显示步数信息：第3行
-    OLED_Printf_Line(3, "step : %lu", g_index_state.step_count);
+    // 显示步数信息和运动状态：第3行
+    OLED_Printf_Line(3, "step : %lu %s", g_index_state.step_count,
+                     activity_state_name(activity_get_state()));
     
     // 计算一天中的分钟数
     int time_of_day = (g_index_state.hours * 60 + g_index_state.minutes);
@@ -18,164 +18,74 @@
 
 #include "alarm_menu.h"
 #include "testlist_menu.h"
+#include "menu_tree.h"
+
+// ==================================
+// 图标项的子页面
 // ==================================
-// 图标数组
+
+static const menu_item_t *const s_stopwatch_children[]  = {&g_Stopwatch_page};
+static const menu_item_t *const s_settings_children[]   = {&g_setting_menu};
+static const menu_item_t *const s_temphumi_children[]   = {&g_TandH_page};
+static const menu_item_t *const s_flashlight_children[] = {&g_game2048_page};
+static const menu_item_t *const s_alarm_children[]      = {&g_alarm_menu};
+static const menu_item_t *const s_step_children[]       = {&g_StepCounter_page};
+static const menu_item_t *const s_test_children[]       = {&g_testlist_menu};
+
 // ==================================
+// 菜单节点
+// ==================================
+
+#define MAIN_MENU_ITEM(node_id, node_name, icon, list) { \
+    MENU_NODE_ICON(node_id, node_name, icon, 32, 32), \
+    .on_enter = main_menu_on_enter, \
+    .on_exit = main_menu_on_exit, \
+    MENU_CHILDREN(list), \
+}
 
-const unsigned char *main_menu_icons[] = {
-    gImage_stopwatch,    // 秒表
-    gImage_setting,      // 设置
-    gImage_TandH,        // 温湿度
-    gImage_flashlight,   // 手电筒
-    gImage_bell,         // 闹钟
-    gImage_step,         // 步数
-    gImage_test          // 测试
+const menu_item_t g_main_menu_items[MAIN_MENU_COUNT] = {
+    [MAIN_MENU_STOPWATCH]  = MAIN_MENU_ITEM(MENU_ID_MAIN_STOPWATCH, "Stopwatch", gImage_stopwatch, s_stopwatch_children),
+    [MAIN_MENU_SETTINGS]   = MAIN_MENU_ITEM(MENU_ID_MAIN_SETTINGS, "Settings", gImage_setting, s_settings_children),
+    [MAIN_MENU_TEMPHUMI]   = MAIN_MENU_ITEM(MENU_ID_MAIN_TEMPHUMI, "TandH_page", gImage_TandH, s_temphumi_children),
+    [MAIN_MENU_FLASHLIGHT] = MAIN_MENU_ITEM(MENU_ID_MAIN_FLASHLIGHT, "Flashlight", gImage_flashlight, s_flashlight_children),
+    [MAIN_MENU_ALARM]      = MAIN_MENU_ITEM(MENU_ID_MAIN_ALARM, "Alarm", gImage_bell, s_alarm_children),
+    [MAIN_MENU_STEP]       = MAIN_MENU_ITEM(MENU_ID_MAIN_STEP, "Step Counter", gImage_step, s_step_children),
+    [MAIN_MENU_TEST]       = MAIN_MENU_ITEM(MENU_ID_MAIN_TEST, "Test", gImage_test, s_test_children),
 };
 
-const char *main_menu_names[] = {
-    "Stopwatch",
-    "Settings",
-    "TandH_page",
-    "Flashlight",
-    "Alarm",
-    "Step Counter",
-    "Test"
+static const menu_item_t *const s_main_menu_children[MAIN_MENU_COUNT] = {
+    &g_main_menu_items[MAIN_MENU_STOPWATCH],
+    &g_main_menu_items[MAIN_MENU_SETTINGS],
+    &g_main_menu_items[MAIN_MENU_TEMPHUMI],
+    &g_main_menu_items[MAIN_MENU_FLASHLIGHT],
+    &g_main_menu_items[MAIN_MENU_ALARM],
+    &g_main_menu_items[MAIN_MENU_STEP],
+    &g_main_menu_items[MAIN_MENU_TEST],
+};
+
+// 主菜单（横向图标菜单，本身不需要内容）
+const menu_item_t g_main_menu = {
+    MENU_NODE_ICON(MENU_ID_MAIN_MENU, "Main Menu", NULL, 0, 0),
+    .on_enter = main_menu_on_enter,
+    .on_exit = main_menu_on_exit,
+    MENU_CHILDREN(s_main_menu_children),
 };
 
 // ==================================
 // 函数实现
 // ==================================
 
-menu_item_t* main_menu_init(void)
-{
-
-    // 创建主菜单（横向图标菜单）
-    menu_item_t* main_menu = menu_item_create(
-        "Main Menu",
-        MENU_TYPE_HORIZONTAL_ICON,
-        (menu_content_t){0}  // 主菜单不需要内容
-    );
-    
-    if (main_menu == NULL) {
-        return NULL;
-    }
-    menu_item_set_callbacks(main_menu, 
-                                   main_menu_on_enter,  // 进入回调
-                                   main_menu_on_exit,   // 退出回调
-                                   NULL,               // 选中回调（不需要特殊处理）
-                                   NULL); // 按键处理
-    // 创建各个子菜单项
-    for (uint8_t i = 0; i < MAIN_MENU_COUNT; i++) {
-        menu_item_t* menu_item = MENU_ITEM_ICON(
-            main_menu_names[i],
-            main_menu_icons[i],
-            32,  // 图标宽度
-            32   // 图标高度
-        );
-
-        
-        if (menu_item != NULL) {
-            // 设置回调函数
-            menu_item_set_callbacks(menu_item, 
-                                   main_menu_on_enter,  // 进入回调
-                                   main_menu_on_exit,   // 退出回调
-                                   NULL,               // 选中回调（不需要特殊处理）
-                                   NULL); // 按键处理
-            
-            // 特殊处理：将TandH页面绑定到温湿度图标项
-            if (i == 2) { // "Temp&Humid" 是第3个菜单项（索引2）
-                menu_item_t* TandH_page = TandH_init();
-                if (TandH_page != NULL) {
-                    menu_add_child(menu_item, TandH_page);
-                }
-            }
-            if (i == 1)
-            {
-                menu_item_t* setting_menu =setting_menu_init();
-                if (setting_menu != NULL)
-                {
-                    menu_add_child(menu_item, setting_menu);
-                }
-                
-            }
-            if (i == 0)
-            {
-                menu_item_t* Stopwatch_page =Stopwatch_init();
-                if (Stopwatch_page != NULL)
-                {
-                    menu_add_child(menu_item, Stopwatch_page);
-                }
-            }
-            
-            if (i == 3)
-            {
-                printf("Game2048_init start init->\r\n");
-                menu_item_t* game2048_page = game2048_init();
-                if (game2048_page != NULL)
-                {
-                    menu_add_child(menu_item, game2048_page);
-                }
-            }
-            
-            if (i == 3)
-            {
-                printf("Game2048_init start init->\r\n");
-                menu_item_t* game2048_page = game2048_init();
-                if (game2048_page != NULL)
-                {
-                    menu_add_child(menu_item, game2048_page);
-                }
-            }
-            
-            if (i == 4)
-            {
-                  menu_item_t* alarm_menu =alarm_menu_init();
-                if (alarm_menu != NULL)
-                {
-                    menu_add_child(menu_item, alarm_menu);
-                }
-            }
-            
-            if (i == 5)
-            {
-                printf("StepCounter_init start init->\r\n");
-                menu_item_t* step_counter_page = StepCounter_init();
-                if (step_counter_page != NULL)
-                {
-                    menu_add_child(menu_item, step_counter_page);
-                }
-            }
-            
-            if (i == 6)
-            {
-               printf("testlist_menu_init start init->\r\n");
-                     menu_item_t* testlist_menu =testlist_menu_init();
-                if (testlist_menu != NULL)
-                {
-                    menu_add_child(menu_item, testlist_menu);
-                }
-            }
-            
-            
-            
-            // 添加到主菜单
-            menu_add_child(main_menu, menu_item);
-            
-        }
-    }
-    
-    return main_menu;
-}
-
-void main_menu_on_enter(menu_item_t* item)
+void main_menu_on_enter(const menu_item_t *item)
 {printf("================================\n");
-    printf("Free heap before deletion: %d bytes\n", xPortGetFreeHeapSize());
+    printf("Free heap: %d bytes (min %d), menu stack free: %d words\n",
+           xPortGetFreeHeapSize(), xPortGetMinimumEverFreeHeapSize(),
+           (int)uxTaskGetStackHighWaterMark(NULL));
     printf("Enter main menu\r\n");
     OLED_Clear();
     // 主菜单进入时的初始化操作
 }
 
-void main_menu_on_exit(menu_item_t* item)
+void main_menu_on_exit(const menu_item_t *item)
 {
     printf("Exit main menu\r\n");
     // 主菜单退出时的清理操作
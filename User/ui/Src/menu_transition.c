@@ -0,0 +1,268 @@
+/**
+ * @file menu_transition.c
+ * @brief 页面切换动画实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "menu_transition.h"
+#include "cycle_counter.h"
+#include "display_tools.h"
+
+// ==================================
+// 全局变量
+// ==================================
+
+static menu_transition_style_t s_style = MENU_TRANSITION_SLIDE;
+static menu_transition_stats_t s_stats;
+static uint8_t s_prev[OLED_FRAME_BYTES];    // 旧页面画面，只在菜单任务切换期间使用
+
+// ==================================
+// 静态函数声明
+// ==================================
+
+static int menu_transition_probe(void);
+static uint8_t menu_transition_in_budget(void);
+static void menu_transition_sample(uint8_t cols);
+static uint8_t menu_transition_offset(uint32_t elapsed_ms);
+static uint8_t menu_transition_wait(TickType_t until);
+static void menu_transition_play(const uint8_t *prev, menu_transition_dir_t dir);
+
+// ==================================
+// 对外接口
+// ==================================
+
+void menu_transition_init(void)
+{
+    cycle_counter_init();
+    menu_transition_probe();
+
+    printf("Transition: full frame %lu us (%lu us fixed), %s\r\n",
+           (unsigned long)s_stats.frame_us, (unsigned long)s_stats.base_us,
+           menu_transition_in_budget() ? "animated" : "over bus budget, instant switch");
+}
+
+void menu_transition_set_style(menu_transition_style_t style)
+{
+    s_style = style;
+}
+
+void menu_transition_switch(void (*swap)(const menu_item_t *target),
+                            const menu_item_t *target, menu_transition_dir_t dir)
+{
+    uint8_t animate = 0;
+
+    if (s_style != MENU_TRANSITION_NONE && g_menu_sys.current_menu != NULL) {
+        // 超预算时重新测一次：一次偶然的慢帧不会永久关闭动画
+        if (!menu_transition_in_budget()) {
+            menu_transition_probe();
+        }
+        if (menu_transition_in_budget()) {
+            OLED_Snapshot(s_prev);
+            animate = 1;
+        } else {
+            s_stats.fallbacks++;
+        }
+    }
+
+    // 退出/进入回调里的清屏和新页面首帧只写显存；动画期间继续保持，显示服务不会把新页面提前送屏
+    OLED_Refresh_Hold(1);
+    swap(target);
+    menu_refresh_display();
+
+    if (animate) {
+        menu_transition_play(s_prev, dir);
+    }
+
+    OLED_Refresh_Hold(0);
+    OLED_Refresh();
+}
+
+const menu_transition_stats_t *menu_transition_get_stats(void)
+{
+    return &s_stats;
+}
+
+// ==================================
+// 静态函数实现
+// ==================================
+
+/**
+ * @brief 把当前显存分别按整屏和 MENU_TRANSITION_PROBE_COLS 列送屏一次，
+ *        解出每帧固定开销和整屏耗时
+ * @return 0-成功，-1-送屏失败（保留原来的估算）
+ * @note 发送的就是屏上已有的画面，看不出变化；耗时只计送屏本身，不含排队
+ */
+static int menu_transition_probe(void)
+{
+    uint32_t full_us;
+    uint32_t part_us;
+    uint32_t column_us;
+
+    if (display_compose(NULL, 0, 0, 0, 127) != 0) {
+        return -1;
+    }
+    full_us = display_server_get_stats()->compose_us;
+
+    if (display_compose(NULL, 0, 0, 0, MENU_TRANSITION_PROBE_COLS - 1) != 0) {
+        return -1;
+    }
+    part_us = display_server_get_stats()->compose_us;
+
+    // full = base + 128 * col，part = base + PROBE_COLS * col
+    column_us = (full_us > part_us) ? full_us - part_us : 0;
+    column_us = column_us * 128 / (128 - MENU_TRANSITION_PROBE_COLS);   // 128 列的部分
+    s_stats.frame_us = full_us;
+    s_stats.base_us = (full_us > column_us) ? full_us - column_us : 0;
+    return 0;
+}
+
+/**
+ * @brief 动画时长内能否刷完最少帧数
+ * @return 1-能，0-超出总线预算
+ */
+static uint8_t menu_transition_in_budget(void)
+{
+    return (s_stats.frame_us * MENU_TRANSITION_MIN_FRAMES <= MENU_TRANSITION_MS * 1000UL) ? 1 : 0;
+}
+
+/**
+ * @brief 用一帧的实际送屏耗时更新整屏估算
+ * @param cols 这一帧发送的列数
+ * @note 只有固定开销以外的部分按列数折算到 128 列；列数太少时折算误差大，不采用
+ */
+static void menu_transition_sample(uint8_t cols)
+{
+    uint32_t used_us = display_server_get_stats()->compose_us;
+    uint32_t full_us;
+
+    if (cols < MENU_TRANSITION_PROBE_COLS) {
+        return;
+    }
+
+    full_us = s_stats.base_us;
+    if (used_us > s_stats.base_us) {
+        full_us += (used_us - s_stats.base_us) * 128 / cols;
+    }
+    s_stats.frame_us = (s_stats.frame_us * 3 + full_us) / 4;
+}
+
+/**
+ * @brief 按时间计算新页面已进入的列数（二次缓出：先快后慢）
+ * @param elapsed_ms 动画已进行的时间
+ * @return 1~128
+ */
+static uint8_t menu_transition_offset(uint32_t elapsed_ms)
+{
+    uint32_t remain;
+    uint32_t offset;
+
+    if (elapsed_ms >= MENU_TRANSITION_MS) {
+        return 128;
+    }
+
+    remain = MENU_TRANSITION_MS - elapsed_ms;
+    offset = 128 - 128UL * remain * remain / ((uint32_t)MENU_TRANSITION_MS * MENU_TRANSITION_MS);
+
+    return (offset == 0) ? 1 : (uint8_t)offset;
+}
+
+/**
+ * @brief 等到下一帧时刻，期间出现按键或闹钟事件提前返回
+ * @param until 下一帧时刻
+ * @return 1-被事件打断，0-正常到时
+ * @note 只查看不取出事件；刷新请求不打断动画（动画结束后新页面会整屏刷新）
+ */
+static uint8_t menu_transition_wait(TickType_t until)
+{
+    menu_event_t event;
+    TickType_t now = xTaskGetTickCount();
+    TickType_t wait = ((int32_t)(until - now) > 0) ? until - now : 0;
+
+    if (xQueuePeek(g_menu_sys.event_queue, &event, wait) != pdPASS) {
+        return 0;
+    }
+    if (event.type != MENU_EVENT_REFRESH) {
+        return 1;
+    }
+
+    // 队首是刷新请求时 Peek 立即返回，剩余时间直接延时
+    now = xTaskGetTickCount();
+    if ((int32_t)(until - now) > 0) {
+        vTaskDelay(until - now);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 播放动画：旧画面在 prev，新页面已画在显存中
+ * @param prev 旧画面（s_prev，display_compose 等服务任务发完才返回）
+ * @param dir 方向
+ */
+static void menu_transition_play(const uint8_t *prev, menu_transition_dir_t dir)
+{
+    TickType_t start = xTaskGetTickCount();
+    TickType_t next = start;
+    uint32_t elapsed;
+    uint16_t frames = 0;
+    uint8_t cancelled = 0;
+    uint8_t offset;
+    uint8_t push = (s_style == MENU_TRANSITION_PUSH) ? 1 : 0;
+    uint8_t x1, x2;
+    int ret;
+
+    while (1) {
+        elapsed = (xTaskGetTickCount() - start) * portTICK_PERIOD_MS;
+        offset = menu_transition_offset(elapsed);
+        if (offset >= 128) {
+            break;
+        }
+
+        // 滑入时旧页面不动，只需发送新页面覆盖的列；推出时两幅画面都在动，整屏发送
+        if (dir == MENU_TRANSITION_FORWARD) {
+            x1 = push ? 0 : 128 - offset;
+            x2 = 127;
+            ret = display_compose(prev, push ? -(int16_t)offset : 0, 128 - offset, x1, x2);
+        } else {
+            x1 = 0;
+            x2 = push ? 127 : offset - 1;
+            ret = display_compose(prev, push ? offset : 0, (int16_t)offset - 128, x1, x2);
+        }
+        frames++;
+
+        // 送屏耗时折算成整屏，平滑后作为下次的预算依据；失败的帧没有耗时
+        if (ret == 0) {
+            menu_transition_sample(x2 - x1 + 1);
+        }
+
+        // 总线慢于帧间隔时不补帧，从当前时刻重新计时
+        next += pdMS_TO_TICKS(MENU_TRANSITION_FRAME_MS);
+        if ((int32_t)(next - xTaskGetTickCount()) < 0) {
+            next = xTaskGetTickCount();
+        }
+        if (menu_transition_wait(next)) {
+            cancelled = 1;
+            break;
+        }
+    }
+
+    // 最后一帧（完整的新页面）由调用者解除保持后刷新
+    frames++;
+
+    elapsed = (xTaskGetTickCount() - start) * portTICK_PERIOD_MS;
+    s_stats.frames = frames;
+    s_stats.elapsed_ms = (uint16_t)elapsed;
+    s_stats.fps_x10 = (uint16_t)(elapsed ? frames * 10000UL / elapsed : 0);
+    s_stats.played++;
+    if (cancelled) {
+        s_stats.cancelled++;
+    }
+
+#if MENU_TRANSITION_LOG
+    printf("Transition: %u frames in %lu ms, %u.%u fps, frame %lu us%s\r\n",
+           frames, (unsigned long)elapsed, s_stats.fps_x10 / 10, s_stats.fps_x10 % 10,
+           (unsigned long)s_stats.frame_us, cancelled ? ", cancelled" : "");
+#endif
+}
@@ -0,0 +1,183 @@
+/**
+ * @file menu_tree.c
+ * @brief 菜单树节点表和页面状态初始化
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "menu_tree.h"
+#include "index.h"
+#include "main_menu.h"
+#include "Stopwatch.h"
+#include "setting_menu.h"
+#include "SetTime.h"
+#include "SetDate.h"
+#include "ImuCalib.h"
+#include "TandH.h"
+#include "history_page.h"
+#include "Game2048.h"
+#include "alarm_menu.h"
+#include "alarm_add.h"
+#include "alarm_list.h"
+#include "StepCounter.h"
+#include "testlist_menu.h"
+#include "air_level.h"
+#include "trace_page.h"
+#include "../../alarm/Inc/alarm_alert.h"
+#include <string.h>
+
+// ==================================
+// 节点表（编号 -> 节点）
+// ==================================
+
+const menu_item_t *const g_menu_nodes[MENU_NODE_COUNT] = {
+    [MENU_ID_INDEX]                 = &g_index_page,
+    [MENU_ID_MAIN_MENU]             = &g_main_menu,
+    [MENU_ID_MAIN_STOPWATCH]        = &g_main_menu_items[MAIN_MENU_STOPWATCH],
+    [MENU_ID_MAIN_SETTINGS]         = &g_main_menu_items[MAIN_MENU_SETTINGS],
+    [MENU_ID_MAIN_TEMPHUMI]         = &g_main_menu_items[MAIN_MENU_TEMPHUMI],
+    [MENU_ID_MAIN_FLASHLIGHT]       = &g_main_menu_items[MAIN_MENU_FLASHLIGHT],
+    [MENU_ID_MAIN_ALARM]            = &g_main_menu_items[MAIN_MENU_ALARM],
+    [MENU_ID_MAIN_STEP]             = &g_main_menu_items[MAIN_MENU_STEP],
+    [MENU_ID_MAIN_TEST]             = &g_main_menu_items[MAIN_MENU_TEST],
+    [MENU_ID_STOPWATCH]             = &g_Stopwatch_page,
+    [MENU_ID_SETTING_MENU]          = &g_setting_menu,
+    [MENU_ID_SETTING_SETTIME]       = &g_setting_menu_items[SETTING_MENU_SETTIME],
+    [MENU_ID_SETTING_SETDATE]       = &g_setting_menu_items[SETTING_MENU_SETDATE],
+    [MENU_ID_SETTING_IMUCALIB]      = &g_setting_menu_items[SETTING_MENU_IMUCALIB],
+    [MENU_ID_SET_TIME]              = &g_SetTime_page,
+    [MENU_ID_SET_DATE]              = &g_SetDate_page,
+    [MENU_ID_IMU_CALIB]             = &g_ImuCalib_page,
+    [MENU_ID_TANDH]                 = &g_TandH_page,
+    [MENU_ID_HISTORY_STEPS]         = &g_history_pages[HISTORY_SERIES_STEPS],
+    [MENU_ID_HISTORY_TEMP]          = &g_history_pages[HISTORY_SERIES_TEMP],
+    [MENU_ID_HISTORY_HUMI]          = &g_history_pages[HISTORY_SERIES_HUMI],
+    [MENU_ID_GAME2048]              = &g_game2048_page,
+    [MENU_ID_ALARM_MENU]            = &g_alarm_menu,
+    [MENU_ID_ALARM_MENU_CREATE]     = &g_alarm_menu_items[ALARM_MENU_CREATE],
+    [MENU_ID_ALARM_MENU_LIST]       = &g_alarm_menu_items[ALARM_MENU_LIST],
+    [MENU_ID_ALARM_ADD]             = &g_alarm_add_page,
+    [MENU_ID_ALARM_LIST]            = &g_alarm_list_page,
+    [MENU_ID_STEP_COUNTER]          = &g_StepCounter_page,
+    [MENU_ID_TESTLIST_MENU]         = &g_testlist_menu,
+    [MENU_ID_TESTLIST_SPI_TEST]     = &g_testlist_menu_items[TESTLIST_MENU_SPI_TEST],
+    [MENU_ID_TESTLIST_2048_OLED]    = &g_testlist_menu_items[TESTLIST_MENU_2048_OLED],
+    [MENU_ID_TESTLIST_FRID]         = &g_testlist_menu_items[TESTLIST_MENU_Frid],
+    [MENU_ID_TESTLIST_IWDG]         = &g_testlist_menu_items[TESTLIST_MENU_iwdg],
+    [MENU_ID_TESTLIST_AIR_LEVEL]    = &g_testlist_menu_items[TESTLIST_MENU_AIR_LEVEL],
+    [MENU_ID_TESTLIST_SENSOR_TRACE] = &g_testlist_menu_items[TESTLIST_MENU_SENSOR_TRACE],
+    [MENU_ID_AIR_LEVEL]             = &g_air_level_page,
+    [MENU_ID_SENSOR_TRACE]          = &g_trace_page,
+    [MENU_ID_ALARM_ALERT]           = &g_alarm_alert_page,
+};
+
+// ==================================
+// 路径表（编号 -> 路径）
+// ==================================
+
+// 首页之下按进入顺序用 '/' 连接页面名；图标项、列表项本身不是页面，不登记
+static const char *const s_menu_paths[MENU_NODE_COUNT] = {
+    [MENU_ID_INDEX]         = "Home",
+    [MENU_ID_MAIN_MENU]     = "Main",
+    [MENU_ID_STOPWATCH]     = "Main/Stopwatch",
+    [MENU_ID_SETTING_MENU]  = "Main/Settings",
+    [MENU_ID_SET_TIME]      = "Main/Settings/SetTime",
+    [MENU_ID_SET_DATE]      = "Main/Settings/SetDate",
+    [MENU_ID_IMU_CALIB]     = "Main/Settings/ImuCalib",
+    [MENU_ID_TANDH]         = "Main/TandH",
+    [MENU_ID_HISTORY_TEMP]  = "Main/TandH/TempHistory",
+    [MENU_ID_HISTORY_HUMI]  = "Main/TandH/HumiHistory",
+    [MENU_ID_GAME2048]      = "Main/Game2048",
+    [MENU_ID_ALARM_MENU]    = "Main/Alarm",
+    [MENU_ID_ALARM_ADD]     = "Main/Alarm/Add",
+    [MENU_ID_ALARM_LIST]    = "Main/Alarm/List",
+    [MENU_ID_STEP_COUNTER]  = "Main/Steps",
+    [MENU_ID_HISTORY_STEPS] = "Main/Steps/History",
+    [MENU_ID_TESTLIST_MENU] = "Main/Test",
+    [MENU_ID_AIR_LEVEL]     = "Main/Test/AirLevel",
+    [MENU_ID_SENSOR_TRACE]  = "Main/Test/SensorTrace",
+    [MENU_ID_ALARM_ALERT]   = "AlarmAlert",
+};
+
+// 路径哈希表：槽内存 节点编号+1，0-空槽；线性探测
+static uint8_t s_path_slots[MENU_PATH_SLOTS];
+
+/**
+ * @brief 路径哈希（FNV-1a）
+ */
+static uint32_t menu_path_hash(const char *path, uint8_t len)
+{
+    uint32_t hash = 2166136261UL;
+    
+    for (uint8_t i = 0; i < len; i++) {
+        hash ^= (uint8_t)path[i];
+        hash *= 16777619UL;
+    }
+    
+    return hash;
+}
+
+/**
+ * @brief 建立路径哈希表
+ * @return 最长探测次数（调试打印用）
+ */
+static uint8_t menu_path_index_init(void)
+{
+    uint8_t slot;
+    uint8_t probes;
+    uint8_t max_probes = 0;
+    
+    memset(s_path_slots, 0, sizeof(s_path_slots));
+    for (uint8_t id = 0; id < MENU_NODE_COUNT; id++) {
+        if (s_menu_paths[id] == NULL) {
+            continue;
+        }
+        slot = menu_path_hash(s_menu_paths[id], strlen(s_menu_paths[id])) & (MENU_PATH_SLOTS - 1);
+        for (probes = 1; s_path_slots[slot] != 0; probes++) {
+            slot = (slot + 1) & (MENU_PATH_SLOTS - 1);
+        }
+        s_path_slots[slot] = id + 1;
+        if (probes > max_probes) {
+            max_probes = probes;
+        }
+    }
+    
+    return max_probes;
+}
+
+const menu_item_t *menu_tree_find(const char *path, uint8_t len)
+{
+    uint8_t slot = menu_path_hash(path, len) & (MENU_PATH_SLOTS - 1);
+    const char *candidate;
+    
+    while (s_path_slots[slot] != 0) {
+        candidate = s_menu_paths[s_path_slots[slot] - 1];
+        if (strncmp(candidate, path, len) == 0 && candidate[len] == '\0') {
+            return g_menu_nodes[s_path_slots[slot] - 1];
+        }
+        slot = (slot + 1) & (MENU_PATH_SLOTS - 1);
+    }
+    
+    return NULL;
+}
+
+const char *menu_tree_path(const menu_item_t *item)
+{
+    return (item == NULL) ? NULL : s_menu_paths[item->id];
+}
+
+// ==================================
+// 菜单树初始化
+// ==================================
+
+/**
+ * @brief 建立路径索引并打印内存预算
+ * @note 页面不在这里初始化：各页面的 on_create 在首次进入时由菜单框架调用
+ */
+void menu_tree_init(void)
+{
+    printf("Menu tree: %d nodes in flash, path index max probe %d\r\n",
+           MENU_NODE_COUNT, menu_path_index_init());
+    menu_page_print();
+}
@@ -1,80 +1,50 @@
 #include "setting_menu.h"
 #include "SetDate.h"
 #include "SetTime.h"
+#include "ImuCalib.h"
+#include "menu_tree.h"
+
 // ==================================
-// 图标数组
+// 图标项的子页面
 // ==================================
-const unsigned char *setting_menu_icons[] =
-    {
-        gImage_clock,
-        gImage_calendar};
+static const menu_item_t *const s_settime_children[]  = {&g_SetTime_page};
+static const menu_item_t *const s_setdate_children[]  = {&g_SetDate_page};
+static const menu_item_t *const s_imucalib_children[] = {&g_ImuCalib_page};
 
-const char *setting_menu_names[] =
-    {
-        "SetTime",
-        "SetDate"};
+// ==================================
+// 菜单节点
+// ==================================
+#define SETTING_MENU_ITEM(node_id, node_name, icon, list) { \
+    MENU_NODE_ICON(node_id, node_name, icon, 32, 32), \
+    .on_enter = setting_menu_on_enter, \
+    .on_exit = setting_menu_on_exit, \
+    MENU_CHILDREN(list), \
+}
 
-menu_item_t *setting_menu_init(void)
-{
-  // 创建设置菜单
-  menu_item_t *setting_menu = menu_item_create(
-      "Setting Menu",
-      MENU_TYPE_HORIZONTAL_ICON,
-      (menu_content_t){0} // 不需要内容
-  );
+const menu_item_t g_setting_menu_items[SETTING_MENU_COUNT] = {
+    [SETTING_MENU_SETTIME]  = SETTING_MENU_ITEM(MENU_ID_SETTING_SETTIME, "SetTime", gImage_clock, s_settime_children),
+    [SETTING_MENU_SETDATE]  = SETTING_MENU_ITEM(MENU_ID_SETTING_SETDATE, "SetDate", gImage_calendar, s_setdate_children),
+    [SETTING_MENU_IMUCALIB] = SETTING_MENU_ITEM(MENU_ID_SETTING_IMUCALIB, "Calib", gImage_setting, s_imucalib_children),
+};
 
-  if (setting_menu == NULL)
-  {
-    return NULL;
-  }
-  // 创建各个子菜单项
-  for (uint8_t i = 0; i < SETTING_MENU_COUNT; i++)
-  {
-    menu_item_t *menu_item = MENU_ITEM_ICON(
-        setting_menu_names[i],
-        setting_menu_icons[i],
-        32, // 图标宽度
-        32  // 图标高度
-    );
-    if (menu_item != NULL)
-    {
-      // 设置回调函数
-      menu_item_set_callbacks(menu_item,
-                              setting_menu_on_enter, // 进入回调
-                              setting_menu_on_exit,  // 退出回调
-                              NULL,                  // 选中回调（不需要特殊处理）
-                              NULL);                 // 按键处理
+static const menu_item_t *const s_setting_menu_children[SETTING_MENU_COUNT] = {
+    &g_setting_menu_items[SETTING_MENU_SETTIME],
+    &g_setting_menu_items[SETTING_MENU_SETDATE],
+    &g_setting_menu_items[SETTING_MENU_IMUCALIB],
+};
 
-              if (i==0)
-              {
-                menu_item_t* SetTime_page =SetTime_init();
-                if (SetTime_page != NULL)
-                {
-                    menu_add_child(menu_item, SetTime_page);
-                }
-              }
-              if (i == 1)
-              {
-                 menu_item_t* SetDate_page =SetDate_init();
-                if (SetDate_page != NULL)
-                {
-                    menu_add_child(menu_item, SetDate_page);
-                }
-              }
-              
-              
-    }
-    menu_add_child(setting_menu, menu_item);
-  }
-  return setting_menu;
-}
+// 设置菜单（横向图标菜单，本身不需要内容）
+const menu_item_t g_setting_menu = {
+    MENU_NODE_ICON(MENU_ID_SETTING_MENU, "Setting Menu", NULL, 0, 0),
+    MENU_CHILDREN(s_setting_menu_children),
+};
 
-void setting_menu_on_enter(menu_item_t *item){
+void setting_menu_on_enter(const menu_item_t *item){
   printf("Enter setting menu\r\n");
     OLED_Clear();
 }
 
-void setting_menu_on_exit(menu_item_t *item)
+void setting_menu_on_exit(const menu_item_t *item)
 {
   printf("Exit setting menu\r\n");
 }
@@ -2,77 +2,68 @@
 
 
 #include "air_level.h"
-// 引用全局菜单系统变量
-extern menu_system_t g_menu_sys;
+#include "trace_page.h"
+#include "menu_tree.h"
 
-const char *testlist_menu_text[] = {
-    "SPI_test",
-    "2048_oled",
-    "frid_test",
-    "iwdg_test",
-    "air_level"};
+// ==================================
+// 文本项的子页面
+// ==================================
 
-menu_item_t *testlist_menu_init(void)
-{
-  menu_item_t *testlist_menu = menu_item_create(
-      "TestList Menu",
-      MENU_TYPE_VERTICAL_LIST,
-      (menu_content_t){0} // 主菜单不需要内容
-  );
+static const menu_item_t *const s_air_level_children[]    = {&g_air_level_page};
+static const menu_item_t *const s_sensor_trace_children[] = {&g_trace_page};
 
-  if (testlist_menu == NULL)
-  {
-    printf("testlist init fail\r\n");
-    return NULL;
-  }
+// ==================================
+// 菜单节点
+// ==================================
 
-    for (uint8_t i = 0; i < TESTLIST_MENU_COUNT; i++)
-    {
-    menu_item_t *menu_item = MENU_ITEM_TEXT(
-        testlist_menu_text[i],
-        testlist_menu_text[i],
-        15);
-    if (menu_item != NULL)
-    {
-      // 先设置回调函数
-      menu_item_set_callbacks(menu_item,
-                              testlist_menu_on_enter,
-                              testlist_menu_on_exit,
-                              NULL,
-                              NULL); // on_key 使用默认的按键处理
-      
-      // 如果是air_level项，先添加子页面，再添加到父菜单
-      if (i == TESTLIST_MENU_AIR_LEVEL) {
-          menu_item_t* air_level_page = air_level_init();
-          if (air_level_page != NULL) {
-              menu_add_child(menu_item, air_level_page);
-              printf("Air Level page added as child to %s, child_count: %d\r\n", 
-                     testlist_menu_text[i], menu_item->child_count);
-          } else {
-              printf("Air Level page init failed!\r\n");
-          }
-      }
-      
-      // 最后添加到TestList Menu
-      menu_add_child(testlist_menu, menu_item);  
-    }
-    }
-  
-  // 设置第一个子项为选中状态
-  if (testlist_menu->child_count > 0) {
-      testlist_menu->selected_child = 0;
-  }
-  
- return testlist_menu;
+// 没有子页面的项进入时只调用 on_enter
+#define TESTLIST_MENU_ITEM(node_id, text) { \
+    MENU_NODE_TEXT(node_id, text, text, 15), \
+    .on_enter = testlist_menu_on_enter, \
+    .on_exit = testlist_menu_on_exit, \
 }
 
-void testlist_menu_on_enter(menu_item_t *item)
+const menu_item_t g_testlist_menu_items[TESTLIST_MENU_COUNT] = {
+    [TESTLIST_MENU_SPI_TEST]  = TESTLIST_MENU_ITEM(MENU_ID_TESTLIST_SPI_TEST, "SPI_test"),
+    [TESTLIST_MENU_2048_OLED] = TESTLIST_MENU_ITEM(MENU_ID_TESTLIST_2048_OLED, "2048_oled"),
+    [TESTLIST_MENU_Frid]      = TESTLIST_MENU_ITEM(MENU_ID_TESTLIST_FRID, "frid_test"),
+    [TESTLIST_MENU_iwdg]      = TESTLIST_MENU_ITEM(MENU_ID_TESTLIST_IWDG, "iwdg_test"),
+    [TESTLIST_MENU_AIR_LEVEL] = {
+        MENU_NODE_TEXT(MENU_ID_TESTLIST_AIR_LEVEL, "air_level", "air_level", 15),
+        .on_enter = testlist_menu_on_enter,
+        .on_exit = testlist_menu_on_exit,
+        MENU_CHILDREN(s_air_level_children),
+    },
+    [TESTLIST_MENU_SENSOR_TRACE] = {
+        MENU_NODE_TEXT(MENU_ID_TESTLIST_SENSOR_TRACE, "sensor_trace", "sensor_trace", 15),
+        .on_enter = testlist_menu_on_enter,
+        .on_exit = testlist_menu_on_exit,
+        MENU_CHILDREN(s_sensor_trace_children),
+    },
+};
+
+static const menu_item_t *const s_testlist_menu_children[TESTLIST_MENU_COUNT] = {
+    &g_testlist_menu_items[TESTLIST_MENU_SPI_TEST],
+    &g_testlist_menu_items[TESTLIST_MENU_2048_OLED],
+    &g_testlist_menu_items[TESTLIST_MENU_Frid],
+    &g_testlist_menu_items[TESTLIST_MENU_iwdg],
+    &g_testlist_menu_items[TESTLIST_MENU_AIR_LEVEL],
+    &g_testlist_menu_items[TESTLIST_MENU_SENSOR_TRACE],
+};
+
+// 测试列表（竖向列表菜单，本身不需要内容）
+const menu_item_t g_testlist_menu = {
+    MENU_NODE_TEXT(MENU_ID_TESTLIST_MENU, "TestList Menu", NULL, 0),
+    MENU_CHILDREN(s_testlist_menu_children),
+};
+
+void testlist_menu_on_enter(const menu_item_t *item)
 {
   printf("Enter testlist menu\r\n");
   OLED_Clear();
 }
 
-void testlist_menu_on_exit(menu_item_t *item)
+void testlist_menu_on_exit(const menu_item_t *item)
 {
    printf("Exit testlist menu\r\n");
 }
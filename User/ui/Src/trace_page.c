@@ -0,0 +1,114 @@
+#include "trace_page.h"
+#include "menu_tree.h"
+
+// ==================================
+// 本页面变量定义
+// ==================================
+static trace_page_state_t s_trace_page_state = {0};
+
+// ==================================
+// 页面节点
+// ==================================
+
+const menu_item_t g_trace_page = {
+    MENU_NODE_CUSTOM(MENU_ID_SENSOR_TRACE, "Sensor Trace", trace_page_draw_function, &s_trace_page_state),
+    .refresh_ms = TRACE_PAGE_REFRESH_MS,
+    .on_enter = trace_page_on_enter,
+    .on_exit = trace_page_on_exit,
+    .on_key = trace_page_key_handler,
+};
+
+// ==================================
+// 自定义绘制函数
+// ==================================
+
+/**
+ * @brief 抓包页面绘制函数
+ * @param context 绘制上下文
+ */
+void trace_page_draw_function(void *context)
+{
+    trace_page_state_t *state = (trace_page_state_t *)context;
+    if (state == NULL) {
+        return;
+    }
+
+    OLED_Printf_Line(0, "Sensor Trace %dHz", MPU_SAMPLE_RATE_HZ);
+    if (sensor_trace_is_active()) {
+        uint32_t seconds = (xTaskGetTickCount() - state->start_tick) / configTICK_RATE_HZ;
+        OLED_Printf_Line(1, "REC  %02lu:%02lu",
+                         (unsigned long)(seconds / 60), (unsigned long)(seconds % 60));
+        OLED_Printf_Line(2, "frames: %lu", (unsigned long)sensor_trace_get_frames());
+        OLED_Printf_Line(3, "KEY3:stop KEY2:back");
+    } else {
+        OLED_Printf_Line(1, "idle (UART1 bin)");
+        OLED_Printf_Line(2, "last: %lu frames", (unsigned long)sensor_trace_get_frames());
+        OLED_Printf_Line(3, "KEY3:start KEY2:back");
+    }
+
+    OLED_Refresh_Dirty();
+}
+
+// ==================================
+// 按键处理
+// ==================================
+
+/**
+ * @brief 抓包页面按键处理函数
+ * @param item 菜单项
+ * @param key_event 按键事件
+ */
+void trace_page_key_handler(const menu_item_t *item, uint8_t key_event)
+{
+    trace_page_state_t *state = (trace_page_state_t *)menu_item_get_context(item);
+
+    switch (key_event) {
+        case MENU_EVENT_KEY_SELECT:
+            // KEY2 - 返回上一级（抓包在后台继续，方便带着手表走动）
+            menu_back_to_parent();
+            break;
+
+        case MENU_EVENT_KEY_ENTER:
+            // KEY3 - 开始/停止抓包
+            if (sensor_trace_is_active()) {
+                sensor_trace_stop();
+            } else {
+                state->start_tick = xTaskGetTickCount();
+                sensor_trace_start(MPU_SAMPLE_RATE_HZ);
+            }
+            state->need_refresh = 1;
+            break;
+
+        case MENU_EVENT_REFRESH:
+            state->need_refresh = 1;
+            break;
+
+        default:
+            break;
+    }
+}
+
+// ==================================
+// 回调函数
+// ==================================
+
+/**
+ * @brief 抓包页面进入回调
+ * @param item 菜单项
+ */
+void trace_page_on_enter(const menu_item_t *item)
+{
+    printf("Enter Sensor Trace page\r\n");
+    OLED_Clear();
+    s_trace_page_state.need_refresh = 1;
+}
+
+/**
+ * @brief 抓包页面退出回调
+ * @param item 菜单项
+ */
+void trace_page_on_exit(const menu_item_t *item)
+{
+    printf("Exit Sensor Trace page\r\n");
+    OLED_Clear();
+}
@@ -10,6 +10,9 @@
 #include <string.h>
 #include <stdlib.h>
 #include "../../alarm/Inc/alarm_alert.h"
+#include "menu_tree.h"
+#include "mem_pool.h"
+#include "menu_transition.h"
 
 // ==================================
 // 全局菜单系统实例
@@ -18,19 +21,55 @@
 menu_system_t g_menu_sys = {0};
 
 // ==================================
-// 全局闹钟提醒页面
+// 菜单节点运行时状态
 // ==================================
 
-static menu_item_t *g_alarm_alert_page = NULL;
+static menu_node_state_t s_menu_state[MENU_NODE_COUNT];
+
+// ==================================
+// 导航栈（节点编号，栈顶为当前页面的上一级）
+// ==================================
+
+static uint8_t s_nav_stack[MENU_NAV_DEPTH];
+static uint8_t s_nav_depth;
+
+// ==================================
+// 页面状态内存池
+// ==================================
+
+// 按页面状态结构体大小分级，小到大排列：
+// 32B-闹钟列表(24B)，64B-新建闹钟(48B)/水平仪(56B)，136B-2048(132B)
+// 闹钟和水平仪进入时分配、退出即归还；2048构造时分配，挂起时仍占着136B块，
+// 别的页面要用时先销毁它。每级1块即可，某级用完时退到更大一级
+#define MENU_CTX_SMALL_SIZE     32
+#define MENU_CTX_MEDIUM_SIZE    64
+#define MENU_CTX_LARGE_SIZE     136
+#define MENU_CTX_CLASS_COUNT    3
+
+static uint32_t s_ctx_small_buf[MEM_POOL_BUF_WORDS(MENU_CTX_SMALL_SIZE, 1)];
+static uint32_t s_ctx_medium_buf[MEM_POOL_BUF_WORDS(MENU_CTX_MEDIUM_SIZE, 1)];
+static uint32_t s_ctx_large_buf[MEM_POOL_BUF_WORDS(MENU_CTX_LARGE_SIZE, 1)];
+
+static mem_pool_t s_ctx_pools[MENU_CTX_CLASS_COUNT];
 
 // ==================================
 // 静态函数声明
 // ==================================
 
-static void menu_update_page_info(menu_item_t *menu);
-static void menu_item_deselect_all(menu_item_t *menu);
-static void menu_item_update_selection(menu_item_t *menu, uint8_t new_index);
+static int8_t menu_state_init(void);
+static int8_t menu_context_pool_init(void);
+static menu_node_state_t *menu_state(const menu_item_t *item);
+static void menu_nav_push(const menu_item_t *item);
+static const char *menu_nav_top_name(void);
+static void menu_nav_select_towards(const menu_item_t *menu, const menu_item_t *target);
+static uint8_t menu_nav_contains(const menu_item_t *item);
+static void *menu_context_pool_alloc(size_t size);
+static uint8_t menu_page_reclaim(size_t size);
+static void menu_update_page_info(const menu_item_t *menu);
+static void menu_item_update_selection(const menu_item_t *menu, uint8_t new_index);
 static void menu_set_layout_for_type(menu_type_t type);
+static void menu_switch_to(const menu_item_t *menu);
+static TickType_t menu_next_timeout(void);
 
 // ==================================
 // 菜单系统初始化
@@ -44,11 +83,6 @@ int8_t menu_system_init(void)
         return -1;
     }
     
-    g_menu_sys.display_mutex = xSemaphoreCreateMutex();
-    if (g_menu_sys.display_mutex == NULL) {
-        return -2;
-    }
-    
     // 初始化状态
     g_menu_sys.current_menu = NULL;
     g_menu_sys.root_menu = NULL;
@@ -60,289 +94,183 @@ int8_t menu_system_init(void)
     g_menu_sys.total_pages = 1;
     g_menu_sys.items_per_page = 4;
     
-    // 初始化按键处理
-    g_menu_sys.last_key_time = 0;
-    g_menu_sys.key_debounce_time = (uint8_t)500; // 500ms去抖
-    
     // 设置默认布局配置
     g_menu_sys.layout = (menu_layout_config_t)LAYOUT_HORIZONTAL_MAIN();
     
-    // 预先创建闹钟提醒页面
-    g_alarm_alert_page = alarm_alert_init();
-    if (g_alarm_alert_page == NULL) {
-        printf("Warning: Failed to create alarm alert page\r\n");
-    } else {
-        printf("Alarm alert page created successfully\r\n");
+    // 菜单树是常量表，这里只初始化各节点的运行时状态
+    if (menu_state_init() != 0) {
+        return -3;
     }
     
+    if (menu_context_pool_init() != 0) {
+        return -4;
+    }
+    
+    // 测量整屏刷新耗时，决定页面切换是否播放动画
+    menu_transition_init();
+    
     printf("Menu system initialized successfully\r\n");
     return 0;
 }
 
 // ==================================
-// 菜单项创建和管理
+// 菜单项状态访问
 // ==================================
 
-menu_item_t* menu_item_create(const char *name, menu_type_t type, menu_content_t content)
+int8_t menu_item_set_refresh(const menu_item_t *item, uint16_t interval_ms)
 {
-    menu_item_t *item = (menu_item_t*)pvPortMalloc(sizeof(menu_item_t));
     if (item == NULL) {
-        return NULL;
+        return -1;
     }
-    printf("MALLOC: menu_item_create %s, size=%d bytes, addr=%p (menu_item_t structure allocation)\n", name, sizeof(menu_item_t), item);
-    
-    // 清零结构体
-    memset(item, 0, sizeof(menu_item_t));
-    
-    // 设置基本信息
-    item->name = name;
-    item->type = type;
-    item->content = content;
-    item->display_index = 0;
-    item->x_pos = 0;
-    item->y_pos = 0;
-    item->width = (type == MENU_TYPE_HORIZONTAL_ICON) ? 32 : 128;
-    item->height = (type == MENU_TYPE_HORIZONTAL_ICON) ? 32 : 16;
-    
-    // 设置默认状态
-    item->is_selected = 0;
-    item->is_visible = 1;
-    item->is_enabled = 1;
     
-    // 设置默认关系
-    item->parent = NULL;
-    item->children = NULL;
-    item->child_count = 0;
-    item->selected_child = 0;
+    menu_state(item)->refresh_ms = interval_ms;
     
-    // 设置默认上下文
-    item->context = NULL;
-    
-    return item;
+    return 0;
 }
 
-int8_t menu_add_child(menu_item_t *parent, menu_item_t *child)
+void *menu_item_get_context(const menu_item_t *item)
 {
-    if (parent == NULL || child == NULL) {
-        return -1;
-    }
-
-    // 不允许重复添加同一 child（防循环/重复）
-    for (uint8_t i = 0; i < parent->child_count; i++) {
-        if (parent->children && parent->children[i] == child) {
-            return -3; // already exists
-        }
-    }
-
-    // 分配新的指针数组（多一个 slot）
-    menu_item_t **new_children = (menu_item_t **)pvPortMalloc(
-        sizeof(menu_item_t *) * (parent->child_count + 1)
-    );
-    if (new_children == NULL) {
-        return -2; // malloc failed
-    }
-    printf("MALLOC: menu_add_child %s->%s, size=%d bytes, addr=%p (new children pointer array allocation)\n", 
-           parent->name, child->name, sizeof(menu_item_t *) * (parent->child_count + 1), new_children);
-
-    // 拷贝旧指针（如果有）
-    if (parent->child_count > 0 && parent->children != NULL) {
-        memcpy(new_children, parent->children, sizeof(menu_item_t *) * parent->child_count);
-        printf("FREE: menu_add_child %s, old children pointer array addr=%p, size=%d bytes (old children array release)\n", 
-               parent->name, parent->children, sizeof(menu_item_t *) * parent->child_count);
-        vPortFree(parent->children); // 释放旧数组
+    if (item == NULL) {
+        return NULL;
     }
-
-    // 添加新 child 指针到末尾
-    new_children[parent->child_count] = child;  // ←←← 存的是指针！不是结构体！
-
-    // 更新 parent
-    parent->children = new_children;
-    parent->child_count++;
-    child->parent = parent; 
-
-    return 0;
+    
+    return menu_state(item)->context;
 }
 
-int8_t menu_item_set_position(menu_item_t *item, uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+int8_t menu_item_set_context(const menu_item_t *item, void *context)
 {
     if (item == NULL) {
         return -1;
     }
     
-    item->x_pos = x;
-    item->y_pos = y;
-    item->width = width;
-    item->height = height;
+    menu_state(item)->context = context;
     
     return 0;
 }
 
-int8_t menu_item_set_callbacks(menu_item_t *item, 
-                               void (*on_enter)(menu_item_t*),
-                               void (*on_exit)(menu_item_t*),
-                               void (*on_select)(menu_item_t*),
-                               void (*on_key)(menu_item_t*, uint8_t))
+void *menu_item_alloc_context(const menu_item_t *item, size_t size)
 {
+    void *state = NULL;
+    
     if (item == NULL) {
-        return -1;
+        return NULL;
     }
     
-    item->on_enter = on_enter;
-    item->on_exit = on_exit;
-    item->on_select = on_select;
-    item->on_key = on_key;
+    state = menu_context_pool_alloc(size);
+    if (state == NULL && menu_page_reclaim(size) > 0) {
+        state = menu_context_pool_alloc(size);
+    }
     
-    return 0;
+    if (state == NULL) {
+        printf("Error: no context block for %s (%d bytes)\r\n", item->name, (int)size);
+        return NULL;
+    }
+    
+    menu_state(item)->context = state;
+    
+    return state;
 }
 
-int8_t menu_remove_child(menu_item_t *parent, menu_item_t *child)
+void menu_item_free_context(const menu_item_t *item)
 {
-    if (parent == NULL || child == NULL || parent->child_count == 0 || parent->children == NULL) {
-        return -1;
+    void *state;
+    
+    if (item == NULL) {
+        return;
     }
-
-    // 查找 child 指针在 children 数组中的位置（指针比较！）
-    int8_t index = -1;
-    for (uint8_t i = 0; i < parent->child_count; i++) {
-        if (parent->children[i] == child) {  //
-            index = i;
-            break;
-        }
+    
+    state = menu_state(item)->context;
+    if (state == NULL) {
+        return;
     }
-    if (index == -1) return -2; // 未找到
-
-    // 调整 selected_child
-    if (parent->selected_child == index) {
-        if (parent->child_count > 1) {
-            parent->selected_child = (index == 0) ? 0 : index - 1;
-        } else {
-            parent->selected_child = 0;
+    
+    for (uint8_t i = 0; i < MENU_CTX_CLASS_COUNT; i++) {
+        if (mem_pool_owns(&s_ctx_pools[i], state)) {
+            mem_pool_free(&s_ctx_pools[i], state);
+            break;
         }
-    } else if (parent->selected_child > index) {
-        parent->selected_child--;
     }
+    
+    // 清空指针，防止野指针
+    menu_state(item)->context = NULL;
+}
 
-    // 重新分配 children 指针数组（少一个）
-    menu_item_t **new_children = NULL;
-    uint8_t new_count = parent->child_count - 1;
-
-    if (new_count > 0) {
-        new_children = (menu_item_t**)pvPortMalloc(sizeof(menu_item_t*) * new_count);
-        if (new_children == NULL) return -3;
-
-        uint8_t j = 0;
-        for (uint8_t i = 0; i < parent->child_count; i++) {
-            if (i != index) {
-                new_children[j++] = parent->children[i]; // 拷贝指针
-            }
-        }
+void menu_context_pool_print(void)
+{
+    for (uint8_t i = 0; i < MENU_CTX_CLASS_COUNT; i++) {
+        mem_pool_print(&s_ctx_pools[i]);
     }
+}
 
-    // 释放旧数组，更新
-    printf("FREE: menu_remove_child %s, old children pointer array addr=%p, size=%d bytes (old children array release during removal)\n", 
-           parent->name, parent->children, sizeof(menu_item_t *) * parent->child_count);
-    vPortFree(parent->children);
-    parent->children = new_children;
-    parent->child_count = new_count;
-
-    // 清除 child 的 parent 指针（防止野指针）
-    child->parent = NULL;
+// ==================================
+// 页面生命周期
+// ==================================
 
-    return 0;
-}
-int8_t menu_item_delete(menu_item_t *item)
+int8_t menu_page_create(const menu_item_t *item)
 {
-    if (!item) return -1;
-    if (item == g_menu_sys.current_menu || item == g_menu_sys.root_menu) return -2;
-
-    // 🔐 加锁
-    if (g_menu_sys.display_mutex) {
-        if (xSemaphoreTake(g_menu_sys.display_mutex, pdMS_TO_TICKS(100)) != pdTRUE)
-            return -5;
+    menu_node_state_t *state;
+    
+    if (item == NULL) {
+        return -1;
     }
-
-    printf("================================\n");
-    printf("Free heap before deletion: %d bytes\n", xPortGetFreeHeapSize());
-    printf("Deleting menu item: %s (addr=%p)\n", item->name, item);
-    printf("================================\n");
     
-    // 📦 用栈模拟递归（避免爆栈）
-    #define MAX_STACK_DEPTH 32  // 增加深度
-    menu_item_t *stack[MAX_STACK_DEPTH];
-    int top = 0;
+    state = menu_state(item);
+    if (state->life != MENU_PAGE_NONE) {
+        return 0;
+    }
     
-    // 安全检查：防止循环引用
-    for (int i = 0; i < top; i++) {
-        if (stack[i] == item) {
-            printf("ERROR: Circular reference detected!\n");
-            if (g_menu_sys.display_mutex) xSemaphoreGive(g_menu_sys.display_mutex);
-            return -6;
-        }
+    if (item->on_create != NULL && item->on_create(item) != 0) {
+        printf("Error: failed to create page %s\r\n", item->name);
+        return -2;
     }
+    state->life = (item == g_menu_sys.current_menu) ? MENU_PAGE_ACTIVE : MENU_PAGE_SUSPENDED;
     
-    stack[top++] = item;
+    return 0;
+}
 
-    while (top > 0) {
-        menu_item_t *cur = stack[--top];
-        
-        // 安全检查
-        if (!cur) continue;
-        
-        printf("Processing: %s (child_count=%d)\n", cur->name, cur->child_count);
-        
-        // 子项入栈（后进先出）
-        if (cur->child_count > 0 && cur->children != NULL) {
-            for (int8_t i = cur->child_count - 1; i >= 0; i--) {
-                if (cur->children[i] != NULL && top < MAX_STACK_DEPTH - 1) {
-                    // 安全检查：防止重复入栈
-                    int already_in_stack = 0;
-                    for (int j = 0; j < top; j++) {
-                        if (stack[j] == cur->children[i]) {
-                            already_in_stack = 1;
-                            break;
-                        }
-                    }
-                    if (!already_in_stack) {
-                        stack[top++] = cur->children[i];
-                    }
-                }
-            }
-        }
-        
-        // 释放当前项的资源
-        // 1. 释放子项指针数组
-        if (cur->children != NULL) {
-            printf("FREE: %s children array, addr=%p, size=%d bytes\n", 
-                   cur->name, cur->children, sizeof(menu_item_t *) * cur->child_count);
-            vPortFree(cur->children);
-            cur->children = NULL;
-            cur->child_count = 0;
-        }
-        
-        // 2. 释放上下文（如果有）
-        if (cur->context != NULL) {
-            printf("FREE: %s context, addr=%p\n", cur->name, cur->context);
-            vPortFree(cur->context);
-            cur->context = NULL;
-        }
-        
-        // 3. 释放菜单项结构本身
-        printf("FREE: %s menu_item, addr=%p, size=%d bytes\n", 
-               cur->name, cur, sizeof(menu_item_t));
-        vPortFree(cur);
-        
-        printf("Heap after freeing %s: %d bytes\n", cur->name, xPortGetFreeHeapSize());
+int8_t menu_page_destroy(const menu_item_t *item)
+{
+    menu_node_state_t *state;
+    
+    if (item == NULL) {
+        return -1;
     }
-
-    g_menu_sys.need_refresh = 1;
-    if (g_menu_sys.display_mutex) xSemaphoreGive(g_menu_sys.display_mutex);
     
-    printf("================================\n");
-    printf("Free heap after deletion: %d bytes\n", xPortGetFreeHeapSize());
-    printf("================================\n");
+    state = menu_state(item);
+    if (state->life == MENU_PAGE_NONE) {
+        return 0;
+    }
+    if (state->life == MENU_PAGE_ACTIVE || menu_nav_contains(item)) {
+        return -2;
+    }
+    if (item->on_destroy == NULL) {
+        return -3;
+    }
+    
+    item->on_destroy(item);
+    state->life = MENU_PAGE_NONE;
+    printf("Page %s destroyed\r\n", item->name);
     
     return 0;
 }
+
+void menu_page_print(void)
+{
+    static const char *const life_names[] = {"-", "suspended", "active"};
+    uint32_t pool_bytes = sizeof(s_ctx_small_buf) + sizeof(s_ctx_medium_buf) + sizeof(s_ctx_large_buf);
+    
+    printf("Menu RAM: node state %d B, nav stack %d B, context pools %lu B\r\n",
+           (int)sizeof(s_menu_state), (int)(sizeof(s_nav_stack) + sizeof(s_nav_depth)),
+           (unsigned long)pool_bytes);
+    for (uint8_t id = 0; id < MENU_NODE_COUNT; id++) {
+        if (s_menu_state[id].life != MENU_PAGE_NONE) {
+            printf("  %-12s %s%s\r\n", g_menu_nodes[id]->name, life_names[s_menu_state[id].life],
+                   g_menu_nodes[id]->on_destroy ? "" : " (resident)");
+        }
+    }
+    menu_context_pool_print();
+}
+
 // ==================================
 // 菜单显示实现
 // ==================================
@@ -353,10 +281,7 @@ void menu_refresh_display(void)
         return;
     }
     
-    if (xSemaphoreTake(g_menu_sys.display_mutex, pdMS_TO_TICKS(50)) != pdTRUE) {
-        return;
-    }
-    
+    // 只在菜单任务中绘制，其他任务经显示服务（display_tools.h）画屏
     switch (g_menu_sys.current_menu->type) {
         case MENU_TYPE_HORIZONTAL_ICON:
             menu_display_horizontal(g_menu_sys.current_menu);
@@ -376,18 +301,33 @@ void menu_refresh_display(void)
     
     g_menu_sys.last_refresh_time = xTaskGetTickCount();
     g_menu_sys.need_refresh = 0;
+}
+
+void menu_request_refresh(void)
+{
+    menu_event_t event = {MENU_EVENT_REFRESH, 0, 0};
     
-    xSemaphoreGive(g_menu_sys.display_mutex);
+    event.timestamp = xTaskGetTickCount();
+    // 队列里已有事件时菜单任务本来就会醒，满了不必等待
+    xQueueSend(g_menu_sys.event_queue, &event, 0);
 }
 
-void menu_display_horizontal(menu_item_t *menu)
+void menu_request_refresh_from_isr(BaseType_t *woken)
+{
+    menu_event_t event = {MENU_EVENT_REFRESH, 0, 0};
+    
+    event.timestamp = xTaskGetTickCountFromISR();
+    xQueueSendFromISR(g_menu_sys.event_queue, &event, woken);
+}
+
+void menu_display_horizontal(const menu_item_t *menu)
 {
     if (menu == NULL || menu->child_count == 0) {
         return;
     }
     
     // 计算可见范围（显示3个：左、中、右）
-    uint8_t center_index = menu->selected_child;
+    uint8_t center_index = menu_state(menu)->selected_child;
     uint8_t left_index = (center_index == 0) ? menu->child_count - 1 : center_index - 1;
     uint8_t right_index = (center_index + 1) % menu->child_count;
     
@@ -412,7 +352,7 @@ void menu_display_horizontal(menu_item_t *menu)
     OLED_Refresh();
 }
 
-void menu_display_vertical(menu_item_t *menu)
+void menu_display_vertical(const menu_item_t *menu)
 {
     if (menu == NULL || menu->child_count == 0) {
         return;
@@ -430,9 +370,10 @@ void menu_display_vertical(menu_item_t *menu)
     
     
     // 显示当前页的项目（类似你想要的tsetlist_RE功能）
+    uint8_t selected = menu_state(menu)->selected_child;
     for (uint8_t i = start_index; i < end_index; i++) {
         uint8_t line = i - start_index;
-        char arrow = (i == menu->selected_child) ? '>' : ' ';
+        char arrow = (i == selected) ? '>' : ' ';
         
         OLED_Printf_Line(line, "%c %s", arrow, menu->children[i]->content.text.text);
     }
@@ -455,28 +396,55 @@ void menu_clear_and_redraw(void)
 // 菜单事件处理
 // ==================================
 
-menu_event_t menu_key_to_event(uint8_t key)
+menu_event_t menu_key_to_event(const key_event_t *key)
 {
     menu_event_t event;
     memset(&event, 0, sizeof(menu_event_t));
-    event.timestamp = xTaskGetTickCount();
-    BEEP_Buzz(5);
-    printf("key press - > %d\n",key-1);
-    switch (key) {
-        case 1:
-            event.type = MENU_EVENT_KEY_UP;
+    event.type = MENU_EVENT_NONE;
+    event.timestamp = key->timestamp;
+    
+    switch (key->type) {
+        case KEY_EVENT_PRESS:
+            BEEP_Buzz(5);
+            printf("key press - > %d\n",key->key-1);
+            // 上/下键按下即响应，按住时接着连发
+            if (key->key == 1) {
+                event.type = MENU_EVENT_KEY_UP;
+            } else if (key->key == 2) {
+                event.type = MENU_EVENT_KEY_DOWN;
+            }
             break;
-        case 2:
-            event.type = MENU_EVENT_KEY_DOWN;
+            
+        case KEY_EVENT_REPEAT:
+            event.type = (key->key == 1) ? MENU_EVENT_KEY_REPEAT_UP : MENU_EVENT_KEY_REPEAT_DOWN;
+            event.param = key->repeat;
             break;
-        case 3:
-            event.type = MENU_EVENT_KEY_SELECT;
+            
+        case KEY_EVENT_RELEASE:
+            // 返回/确认键松开时响应，长按或组合键之后的松开忽略
+            if (key->flags & KEY_FLAG_CONSUMED) {
+                break;
+            }
+            if (key->key == 3) {
+                event.type = MENU_EVENT_KEY_SELECT;
+            } else if (key->key == 4) {
+                event.type = MENU_EVENT_KEY_ENTER;
+            }
             break;
-        case 4:
-            event.type = MENU_EVENT_KEY_ENTER;
+            
+        case KEY_EVENT_LONG:
+            printf("key long - > %d\n",key->key-1);
+            event.type = MENU_EVENT_KEY_LONG;
+            event.param = key->key;
             break;
+            
+        case KEY_EVENT_CHORD:
+            printf("key chord - > 0x%02X\n",key->key);
+            event.type = MENU_EVENT_KEY_CHORD;
+            event.param = key->key;
+            break;
+            
         default:
-            event.type = MENU_EVENT_NONE;
             break;
     }
     
@@ -491,45 +459,56 @@ int8_t menu_process_event(menu_event_t *event)
     
     // 处理闹钟事件（特殊处理，不需要当前菜单）
     if (event->type == MENU_EVENT_ALARM) {
-        printf("Processing alarm event, index: %d\n", event->param);
-        
-        // 检查闹钟提醒页面是否已创建
-        if (g_alarm_alert_page == NULL) {
-            printf("Error: Alarm alert page not created\n");
-            return -1;
-        }
+        printf("Processing alarm event, ID: %04X\n", event->param);
         
         // 触发闹钟提醒
         if (alarm_alert_trigger(event->param) == 0) {
-            // 设置闹钟提醒页面的父菜单为当前菜单（如果存在）
-            if (g_menu_sys.current_menu != NULL) {
-                g_alarm_alert_page->parent = g_menu_sys.current_menu;
+            // 压栈进入提醒页面，关闭后回到闹钟响起时所在的页面；已在提醒页面时原地替换
+            if (g_menu_sys.current_menu == &g_alarm_alert_page) {
+                menu_nav_replace(&g_alarm_alert_page);
+            } else {
+                menu_enter(&g_alarm_alert_page);
             }
-            // 切换到闹钟提醒页面
-            menu_enter(g_alarm_alert_page);
             printf("Switched to alarm alert page\n");
         }
         return 0;
     }
     
+    // 按路径跳转请求
+    if (event->type == MENU_EVENT_GOTO) {
+        if (event->param < MENU_NODE_COUNT) {
+            menu_nav_goto(g_menu_nodes[event->param]);
+        }
+        return 0;
+    }
+    
     if (g_menu_sys.current_menu == NULL) {
         return -1;
     }
     
-    menu_item_t *current = g_menu_sys.current_menu;
+    const menu_item_t *current = g_menu_sys.current_menu;
     
-    // 按键去抖处理
-    uint32_t current_time = xTaskGetTickCount();
-    if (event->type != MENU_EVENT_NONE && event->type != MENU_EVENT_REFRESH) {
-        if (current_time - g_menu_sys.last_key_time < pdMS_TO_TICKS(g_menu_sys.key_debounce_time)) {
-            return 0; // 去抖，忽略按键
+    // 重绘请求：由菜单任务统一重绘，自定义页面仍会收到 MENU_EVENT_REFRESH
+    if (event->type == MENU_EVENT_REFRESH) {
+        g_menu_sys.need_refresh = 1;
+        if (current->on_key == NULL) {
+            return 0;
+        }
+    }
+    
+    // 组合键回到首页（去抖已在按键驱动中完成，这里不再限制按键间隔）
+    if (event->type == MENU_EVENT_KEY_CHORD) {
+        if (event->param == MENU_CHORD_HOME && g_menu_sys.root_menu != NULL && current != g_menu_sys.root_menu) {
+            menu_nav_reset(g_menu_sys.root_menu);
+            return 0;
         }
-        g_menu_sys.last_key_time = current_time;
     }
     
     // 调用自定义按键处理（如果存在）
     if (current->on_key) {
         current->on_key(current, event->type);
+        // 按键后当前页面（或切换到的新页面）立即重绘，静态页面不再靠周期刷新补画
+        g_menu_sys.need_refresh = 1;
          // 返回0表示事件已处理
             return 0;
         
@@ -548,22 +527,26 @@ int8_t menu_process_event(menu_event_t *event)
     }
 }
 
-int8_t menu_handle_horizontal_key(menu_item_t *menu, uint8_t key_event)
+int8_t menu_handle_horizontal_key(const menu_item_t *menu, uint8_t key_event)
 {
     if (menu == NULL || menu->child_count == 0) {
         return -1;
     }
     
+    uint8_t selected = menu_state(menu)->selected_child;
+    
     switch (key_event) {
         case MENU_EVENT_KEY_UP:
+        case MENU_EVENT_KEY_REPEAT_UP:
             // 上一个选项
-            menu_item_update_selection(menu, (menu->selected_child == 0) ? 
-                                       menu->child_count - 1 : menu->selected_child - 1);
+            menu_item_update_selection(menu, (selected == 0) ? 
+                                       menu->child_count - 1 : selected - 1);
             break;
             
         case MENU_EVENT_KEY_DOWN:
+        case MENU_EVENT_KEY_REPEAT_DOWN:
             // 下一个选项
-            menu_item_update_selection(menu, (menu->selected_child + 1) % menu->child_count);
+            menu_item_update_selection(menu, (selected + 1) % menu->child_count);
             break;
             
         case MENU_EVENT_KEY_SELECT:
@@ -585,30 +568,34 @@ int8_t menu_handle_horizontal_key(menu_item_t *menu, uint8_t key_event)
     return 0;
 }
 
-int8_t menu_handle_vertical_key(menu_item_t *menu, uint8_t key_event)
+int8_t menu_handle_vertical_key(const menu_item_t *menu, uint8_t key_event)
 {
     if (menu == NULL || menu->child_count == 0) {
         return -1;
     }
     
+    menu_node_state_t *state = menu_state(menu);
+    
     switch (key_event) {
         case MENU_EVENT_KEY_UP:
+        case MENU_EVENT_KEY_REPEAT_UP:
             // 上一个选项（类似你想要的testlist循环选择）
-            if (menu->selected_child == 0) {
-                menu->selected_child = menu->child_count - 1;
+            if (state->selected_child == 0) {
+                state->selected_child = menu->child_count - 1;
             } else {
-                menu->selected_child--;
+                state->selected_child--;
             }
-             printf("selected : %d\n",menu->selected_child);
+             printf("selected : %d\n",state->selected_child);
             // 更新分页信息
             menu_update_page_info(menu);
             g_menu_sys.need_refresh = 1;
             break;
             
         case MENU_EVENT_KEY_DOWN:
+        case MENU_EVENT_KEY_REPEAT_DOWN:
             // 下一个选项（循环选择）
-            menu->selected_child = (menu->selected_child + 1) % menu->child_count;
-            printf("selected : %d\n",menu->selected_child);
+            state->selected_child = (state->selected_child + 1) % menu->child_count;
+            printf("selected : %d\n",state->selected_child);
             // 更新分页信息
             menu_update_page_info(menu);
             g_menu_sys.need_refresh = 1;
@@ -637,86 +624,156 @@ int8_t menu_handle_vertical_key(menu_item_t *menu, uint8_t key_event)
 // 菜单导航实现
 // ==================================
 
-int8_t menu_enter(menu_item_t *menu)
+int8_t menu_enter(const menu_item_t *menu)
 {
     if (menu == NULL) {
         return -1;
     }
-    
-    
-    // 调用退出回调
-    if (g_menu_sys.current_menu && g_menu_sys.current_menu->on_exit) {
-        g_menu_sys.current_menu->on_exit(g_menu_sys.current_menu);
+    if (menu_page_create(menu) != 0) {
+        return -2;
     }
     
-    // 设置新菜单
-    g_menu_sys.current_menu = menu;
-    g_menu_sys.menu_active = 1;
-    g_menu_sys.need_refresh = 1;
+    // 当前页面压栈，返回时回到这里
+    if (g_menu_sys.current_menu != NULL && g_menu_sys.current_menu != menu) {
+        menu_nav_push(g_menu_sys.current_menu);
+    }
     
-    // 根据菜单类型设置布局配置
-    menu_set_layout_for_type(menu->type);
+    menu_transition_switch(menu_switch_to, menu, MENU_TRANSITION_FORWARD);
     
-    // 重置分页信息
-    g_menu_sys.current_page = 0;
-    menu_update_page_info(menu);
-    
-    // 调用进入回调
-    if (menu->on_enter) {
-        menu->on_enter(menu);
-    }
-    printf("parent : %s ,\n current : %s \n",g_menu_sys.current_menu->parent->name,g_menu_sys.current_menu->name);
+    printf("parent : %s ,\n current : %s \n",menu_nav_top_name(),menu->name);
     return 0;
 }
 
 int8_t menu_back_to_parent(void)
 {
     printf("menu_back_to_parent\n");
-    printf("parent : %s ,\n current : %s \n",g_menu_sys.current_menu->parent->name,g_menu_sys.current_menu->name);
-    if (g_menu_sys.current_menu == NULL || g_menu_sys.current_menu->parent == NULL) {
+    if (g_menu_sys.current_menu == NULL) {
+        return -1;
+    }
+    printf("parent : %s ,\n current : %s \n",menu_nav_top_name(),g_menu_sys.current_menu->name);
+    if (s_nav_depth == 0) {
         return -1;
     }
-    OLED_Clear();
-    menu_item_t *parent = g_menu_sys.current_menu->parent;
     
-    // 调用退出回调
-    if (g_menu_sys.current_menu->on_exit) {
-        g_menu_sys.current_menu->on_exit(g_menu_sys.current_menu);
+    // 弹出上一级（按路径跳转重建的栈里可能有还没构造的页面）
+    const menu_item_t *parent = g_menu_nodes[s_nav_stack[s_nav_depth - 1]];
+    if (menu_page_create(parent) != 0) {
+        return -2;
+    }
+    s_nav_depth--;
+    menu_transition_switch(menu_switch_to, parent, MENU_TRANSITION_BACKWARD);
+    
+    printf("back to ->  %s\n",parent->name);
+    return 0;
+}
+
+int8_t menu_nav_replace(const menu_item_t *menu)
+{
+    if (menu == NULL) {
+        return -1;
+    }
+    if (menu_page_create(menu) != 0) {
+        return -2;
     }
     
-    // 返回父菜单
-    g_menu_sys.current_menu = parent;
+    menu_transition_switch(menu_switch_to, menu, MENU_TRANSITION_FORWARD);
     
+    printf("replace -> %s\n", menu->name);
+    return 0;
+}
 
-    //根据父菜单类型设置布局
-    menu_set_layout_for_type(parent->type);
+int8_t menu_nav_reset(const menu_item_t *menu)
+{
+    if (menu == NULL) {
+        return -1;
+    }
+    if (menu_page_create(menu) != 0) {
+        return -2;
+    }
     
-    // 重置分页信息
-    g_menu_sys.current_page = 0;
-    menu_update_page_info(parent);
+    s_nav_depth = 0;
+    menu_transition_switch(menu_switch_to, menu, MENU_TRANSITION_BACKWARD);
     
+    printf("reset -> %s\n", menu->name);
+    return 0;
+}
 
-    // 刷新显示
-    g_menu_sys.need_refresh = 1;
+int8_t menu_nav_goto(const menu_item_t *menu)
+{
+    const char *path = menu_tree_path(menu);
+    const menu_item_t *level;
+    
+    if (path == NULL) {
+        return -1;
+    }
+    if (menu_page_create(menu) != 0) {
+        return -2;
+    }
+    
+    // 按路径前缀重建导航栈：首页、各级上级页面（未登记的前缀跳过）
+    s_nav_depth = 0;
+    if (menu != g_menu_sys.root_menu) {
+        menu_nav_push(g_menu_sys.root_menu);
+    }
+    for (uint8_t i = 0; path[i] != '\0'; i++) {
+        if (path[i] == '/' && (level = menu_tree_find(path, i)) != NULL) {
+            menu_nav_select_towards(g_menu_nodes[s_nav_stack[s_nav_depth - 1]], level);
+            menu_nav_push(level);
+        }
+    }
+    if (s_nav_depth > 0) {
+        menu_nav_select_towards(g_menu_nodes[s_nav_stack[s_nav_depth - 1]], menu);
+    }
+    
+    menu_transition_switch(menu_switch_to, menu, MENU_TRANSITION_FORWARD);
+    
+    printf("goto -> %s (depth %d)\n", path, s_nav_depth);
+    return 0;
+}
 
+int8_t menu_nav_open(const char *path)
+{
+    const menu_item_t *menu;
+    
+    if (path == NULL || (menu = menu_tree_find(path, strlen(path))) == NULL) {
+        printf("menu_nav_open: no page at \"%s\"\n", path ? path : "");
+        return -1;
+    }
+    
+    return menu_nav_goto(menu);
+}
 
-    printf("back to ->  %s\n",parent->name);
-    // 调用父菜单的进入回调
-    if (parent->on_enter) {
-        parent->on_enter(parent);
+int8_t menu_request_open(const char *path)
+{
+    menu_event_t event = {MENU_EVENT_GOTO, 0, 0};
+    const menu_item_t *menu;
+    
+    if (path == NULL || (menu = menu_tree_find(path, strlen(path))) == NULL) {
+        return -1;
+    }
+    
+    event.timestamp = xTaskGetTickCount();
+    event.param = menu->id;
+    if (xQueueSend(g_menu_sys.event_queue, &event, 0) != pdPASS) {
+        return -2;
     }
     
     return 0;
 }
 
+uint8_t menu_nav_depth(void)
+{
+    return s_nav_depth;
+}
+
 int8_t menu_select_next(void)
 {
     if (g_menu_sys.current_menu == NULL || g_menu_sys.current_menu->child_count == 0) {
         return -1;
     }
     
-    menu_item_t *menu = g_menu_sys.current_menu;
-    menu->selected_child = (menu->selected_child + 1) % menu->child_count;
+    menu_node_state_t *state = menu_state(g_menu_sys.current_menu);
+    state->selected_child = (state->selected_child + 1) % g_menu_sys.current_menu->child_count;
     g_menu_sys.need_refresh = 1;
     
     return 0;
@@ -728,11 +785,11 @@ int8_t menu_select_previous(void)
         return -1;
     }
     
-    menu_item_t *menu = g_menu_sys.current_menu;
-    if (menu->selected_child == 0) {
-        menu->selected_child = menu->child_count - 1;
+    menu_node_state_t *state = menu_state(g_menu_sys.current_menu);
+    if (state->selected_child == 0) {
+        state->selected_child = g_menu_sys.current_menu->child_count - 1;
     } else {
-        menu->selected_child--;
+        state->selected_child--;
     }
     g_menu_sys.need_refresh = 1;
     
@@ -745,8 +802,9 @@ int8_t menu_enter_selected(void)
         return -1;
     }
     
-    menu_item_t *menu = g_menu_sys.current_menu;
-    menu_item_t *selected = menu->children[menu->selected_child];
+    const menu_item_t *menu = g_menu_sys.current_menu;
+    uint8_t selected_index = menu_state(menu)->selected_child;
+    const menu_item_t *selected = menu->children[selected_index];
     
     printf("menu_enter_selected: current=%s, selected=%s, child_count=%d\n", 
            menu->name, selected->name, selected->child_count);
@@ -761,14 +819,12 @@ int8_t menu_enter_selected(void)
         // 对于横向图标菜单和纵向列表菜单，直接进入第一个子菜单
         if(menu->type == MENU_TYPE_HORIZONTAL_ICON || menu->type == MENU_TYPE_VERTICAL_LIST){
             // 进入第一个子菜单
-            menu_item_t *child_menu = selected->children[0];
-            child_menu->parent = g_menu_sys.current_menu;
-            printf("menu_enter_selected\nparent : %s ,\n current : %s \n",child_menu->parent->name,child_menu->name);
+            const menu_item_t *child_menu = selected->children[0];
+            printf("menu_enter_selected\nparent : %s ,\n current : %s \n",menu->name,child_menu->name);
             return menu_enter(child_menu);
         } else {
-            // 设置子菜单的父菜单为当前菜单
-            selected->parent = g_menu_sys.current_menu;
-            printf("menu_enter_selected\nparent : %s ,\n current : %s \n",selected->parent->name,selected->name);
+            // 进入子菜单
+            printf("menu_enter_selected\nparent : %s ,\n current : %s \n",menu->name,selected->name);
             return menu_enter(selected);
         }
     } else {
@@ -776,7 +832,7 @@ int8_t menu_enter_selected(void)
         if (selected->on_enter) {
             selected->on_enter(selected);
         }
-        return menu->selected_child;
+        return selected_index;
     }
 }
 
@@ -784,41 +840,81 @@ int8_t menu_enter_selected(void)
 // FreeRTOS任务实现
 // ==================================
 
+/**
+ * @brief 菜单任务：阻塞等待事件，超时时间为当前页面的下一次重绘时刻
+ * @note 按键和闹钟事件到达即处理；静态页面没有事件时一直阻塞，不再周期唤醒
+ */
 void menu_task(void *pvParameters)
 {
-    const TickType_t delay_20ms = pdMS_TO_TICKS(20);
     menu_event_t event;
+#if MENU_TASK_PROFILE
+    TickType_t profile_start = xTaskGetTickCount();
+    uint32_t wakeups = 0;
+    uint32_t keys = 0;
+    uint32_t key_latency_max = 0;
+    uint32_t key_latency_sum = 0;
+#endif
     
     while (1) {
-        // 处理菜单事件
-        if (xQueueReceive(g_menu_sys.event_queue, &event, 0) == pdPASS) {
-            menu_process_event(&event);
+        // 阻塞到事件或重绘时刻，醒来后把积压的事件一次处理完
+        if (xQueueReceive(g_menu_sys.event_queue, &event, menu_next_timeout()) == pdPASS) {
+            do {
+#if MENU_TASK_PROFILE
+                if (event.type >= MENU_EVENT_KEY_UP && event.type <= MENU_EVENT_KEY_ENTER) {
+                    uint32_t latency = xTaskGetTickCount() - event.timestamp;
+                    keys++;
+                    key_latency_sum += latency;
+                    if (latency > key_latency_max) {
+                        key_latency_max = latency;
+                    }
+                }
+#endif
+                menu_process_event(&event);
+            } while (xQueueReceive(g_menu_sys.event_queue, &event, 0) == pdPASS);
         }
+#if MENU_TASK_PROFILE
+        wakeups++;
+#endif
         
-        // 定时刷新显示
-        if (g_menu_sys.need_refresh || 
-            (xTaskGetTickCount() - g_menu_sys.last_refresh_time) > pdMS_TO_TICKS(100)) {
+        // 有重绘请求或到了页面的重绘周期
+        if (menu_next_timeout() == 0) {
             menu_refresh_display();
         }
         
-        vTaskDelay(delay_20ms);
+#if MENU_TASK_PROFILE
+        if (xTaskGetTickCount() - profile_start >= pdMS_TO_TICKS(5000)) {
+            // 栈余量是任务启动以来的最低值：走遍各页面和切换动画后读数即实测余量
+            printf("menu_task: %lu wakeups/5s, %lu keys, latency avg %lu max %lu ticks, stack free %lu words\r\n",
+                   (unsigned long)wakeups, (unsigned long)keys,
+                   (unsigned long)(keys ? key_latency_sum / keys : 0), (unsigned long)key_latency_max,
+                   (unsigned long)uxTaskGetStackHighWaterMark(NULL));
+            profile_start = xTaskGetTickCount();
+            wakeups = keys = key_latency_sum = key_latency_max = 0;
+        }
+#endif
     }
 }
 
+/**
+ * @brief 按键任务：按固定周期扫描按键，把按键事件转换后送入菜单事件队列
+ * @note 扫描不阻塞，按住不放时照常产生长按和连发事件
+ */
 void menu_key_task(void *pvParameters)
 {
-    const TickType_t delay_10ms = pdMS_TO_TICKS(10);
-    uint8_t key;
+    const TickType_t scan_period = pdMS_TO_TICKS(KEY_SCAN_MS);
+    TickType_t last_wake = xTaskGetTickCount();
+    key_event_t key;
     
     while (1) {
-        if ((key = KEY_Get()) != 0) {
-            menu_event_t event = menu_key_to_event(key);
+        Key_Scan();
+        while (Key_GetEvent(&key)) {
+            menu_event_t event = menu_key_to_event(&key);
             if (event.type != MENU_EVENT_NONE) {
                 xQueueSend(g_menu_sys.event_queue, &event, 0);
             }
         }
         
-        vTaskDelay(delay_10ms);
+        vTaskDelayUntil(&last_wake, scan_period);
     }
 }
 
@@ -826,12 +922,176 @@ void menu_key_task(void *pvParameters)
 // 静态辅助函数实现
 // ==================================
 
-static void menu_update_page_info(menu_item_t *menu)
+/**
+ * @brief 初始化页面状态内存池
+ * @return 0-成功，-1-失败
+ */
+static int8_t menu_context_pool_init(void)
+{
+    if (mem_pool_init(&s_ctx_pools[0], "ctx32", s_ctx_small_buf, MENU_CTX_SMALL_SIZE, 1) != 0 ||
+        mem_pool_init(&s_ctx_pools[1], "ctx64", s_ctx_medium_buf, MENU_CTX_MEDIUM_SIZE, 1) != 0 ||
+        mem_pool_init(&s_ctx_pools[2], "ctx136", s_ctx_large_buf, MENU_CTX_LARGE_SIZE, 1) != 0) {
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief 初始化各节点的运行时状态
+ * @return 0-成功，-1-节点表缺项或编号不一致
+ */
+static int8_t menu_state_init(void)
+{
+    const menu_item_t *node;
+    
+    for (uint8_t id = 0; id < MENU_NODE_COUNT; id++) {
+        node = g_menu_nodes[id];
+        if (node == NULL || node->id != id) {
+            printf("Menu tree error: node %d missing or misnumbered\r\n", id);
+            return -1;
+        }
+        s_menu_state[id].context = (node->type == MENU_TYPE_CUSTOM) ? node->content.custom.draw_context : NULL;
+        s_menu_state[id].refresh_ms = node->refresh_ms;
+        s_menu_state[id].selected_child = 0;
+        s_menu_state[id].life = MENU_PAGE_NONE;
+    }
+    
+    s_nav_depth = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief 节点的运行时状态
+ */
+static menu_node_state_t *menu_state(const menu_item_t *item)
+{
+    return &s_menu_state[item->id];
+}
+
+/**
+ * @brief 压入导航栈，栈满时丢弃最早的一层
+ */
+static void menu_nav_push(const menu_item_t *item)
+{
+    if (s_nav_depth == MENU_NAV_DEPTH) {
+        memmove(&s_nav_stack[0], &s_nav_stack[1], MENU_NAV_DEPTH - 1);
+        s_nav_depth--;
+    }
+    s_nav_stack[s_nav_depth++] = item->id;
+}
+
+/**
+ * @brief 栈顶（上一级）名称（调试打印用）
+ */
+static const char *menu_nav_top_name(void)
+{
+    return (s_nav_depth == 0) ? "none" : g_menu_nodes[s_nav_stack[s_nav_depth - 1]]->name;
+}
+
+/**
+ * @brief 页面是否在导航栈中
+ * @return 1-是，0-否
+ */
+static uint8_t menu_nav_contains(const menu_item_t *item)
+{
+    for (uint8_t i = 0; i < s_nav_depth; i++) {
+        if (s_nav_stack[i] == item->id) {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief 从页面状态内存池按大小分配一块，某级用完时退到更大一级
+ * @return 块指针，NULL-没有足够大的空闲块
+ */
+static void *menu_context_pool_alloc(size_t size)
+{
+    void *block = NULL;
+    
+    for (uint8_t i = 0; i < MENU_CTX_CLASS_COUNT && block == NULL; i++) {
+        if (size <= s_ctx_pools[i].block_size) {
+            block = mem_pool_alloc(&s_ctx_pools[i]);
+        }
+    }
+    
+    return block;
+}
+
+/**
+ * @brief 内存紧张：销毁一个状态块够 size 字节的挂起页面
+ * @return 销毁的页面数（0或1）
+ */
+static uint8_t menu_page_reclaim(size_t size)
+{
+    void *context;
+    
+    for (uint8_t id = 0; id < MENU_NODE_COUNT; id++) {
+        context = s_menu_state[id].context;
+        if (s_menu_state[id].life != MENU_PAGE_SUSPENDED || context == NULL) {
+            continue;
+        }
+        for (uint8_t i = 0; i < MENU_CTX_CLASS_COUNT; i++) {
+            if (size <= s_ctx_pools[i].block_size && mem_pool_owns(&s_ctx_pools[i], context)) {
+                if (menu_page_destroy(g_menu_nodes[id]) == 0) {
+                    return 1;
+                }
+                break;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief 把菜单的选中项设为通向目标页面的子项（子项本身或子项的第一个子菜单）
+ */
+static void menu_nav_select_towards(const menu_item_t *menu, const menu_item_t *target)
+{
+    for (uint8_t i = 0; i < menu->child_count; i++) {
+        if (menu->children[i] == target ||
+            (menu->children[i]->child_count > 0 && menu->children[i]->children[0] == target)) {
+            menu_state(menu)->selected_child = i;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 距离当前页面下一次重绘的节拍数
+ * @return 0-需要立即重绘，portMAX_DELAY-静态页面，等事件即可
+ */
+static TickType_t menu_next_timeout(void)
+{
+    const menu_item_t *menu = g_menu_sys.current_menu;
+    TickType_t elapsed;
+    TickType_t interval;
+    
+    if (g_menu_sys.need_refresh) {
+        return 0;
+    }
+    if (menu == NULL || menu_state(menu)->refresh_ms == 0) {
+        return portMAX_DELAY;
+    }
+    
+    interval = pdMS_TO_TICKS(menu_state(menu)->refresh_ms);
+    elapsed = xTaskGetTickCount() - g_menu_sys.last_refresh_time;
+    return (elapsed >= interval) ? 0 : interval - elapsed;
+}
+
+static void menu_update_page_info(const menu_item_t *menu)
 {
     if (menu == NULL || menu->type != MENU_TYPE_VERTICAL_LIST) {
         return;
     }
     
+    uint8_t selected = menu_state(menu)->selected_child;
+    
     g_menu_sys.items_per_page = g_menu_sys.layout.vertical.items_per_page;
     g_menu_sys.total_pages = (menu->child_count + g_menu_sys.items_per_page - 1) / g_menu_sys.items_per_page;
     
@@ -844,37 +1104,21 @@ static void menu_update_page_info(menu_item_t *menu)
     uint8_t page_start = g_menu_sys.current_page * g_menu_sys.items_per_page;
     uint8_t page_end = page_start + g_menu_sys.items_per_page - 1;
     
-    if (menu->selected_child < page_start) {
-        g_menu_sys.current_page = menu->selected_child / g_menu_sys.items_per_page;
-    } else if (menu->selected_child > page_end) {
-        g_menu_sys.current_page = menu->selected_child / g_menu_sys.items_per_page;
+    if (selected < page_start) {
+        g_menu_sys.current_page = selected / g_menu_sys.items_per_page;
+    } else if (selected > page_end) {
+        g_menu_sys.current_page = selected / g_menu_sys.items_per_page;
     }
 }
 
-static void menu_item_deselect_all(menu_item_t *menu)
-{
-    if (menu == NULL) {
-        return;
-    }
-    
-    // 取消选中所有子项
-    for (uint8_t i = 0; i < menu->child_count; i++) {
-        menu->children[i]->is_selected = 0;
-    }
-}
-
-static void menu_item_update_selection(menu_item_t *menu, uint8_t new_index)
+static void menu_item_update_selection(const menu_item_t *menu, uint8_t new_index)
 {
     if (menu == NULL || new_index >= menu->child_count) {
         return;
     }
     
-    // 取消所有选中
-    menu_item_deselect_all(menu);
-    
     // 设置新选中项
-    menu->selected_child = new_index;
-    menu->children[new_index]->is_selected = 1;
+    menu_state(menu)->selected_child = new_index;
     
     g_menu_sys.need_refresh = 1;
 }
@@ -883,14 +1127,51 @@ static void menu_item_update_selection(menu_item_t *menu, uint8_t new_index)
 // 自定义页面显示实现
 // ==================================
 
-void menu_display_custom(menu_item_t *menu)
+void menu_display_custom(const menu_item_t *menu)
 {
     if (menu == NULL || menu->content.custom.draw_function == NULL) {
         return;
     }
     
-    // 调用自定义绘制函数
-    menu->content.custom.draw_function(menu->content.custom.draw_context);
+    // 调用自定义绘制函数，上下文取运行时状态（页面进入时可能替换）
+    menu->content.custom.draw_function(menu_state(menu)->context);
+}
+
+// ==================================
+// 页面切换
+// ==================================
+
+/**
+ * @brief 切换当前页面：旧页面退出、新页面进入（由 menu_transition_switch 调用，期间刷新暂停）
+ * @param menu 新页面
+ */
+static void menu_switch_to(const menu_item_t *menu)
+{
+    // 调用退出回调，旧页面转为挂起
+    if (g_menu_sys.current_menu) {
+        if (g_menu_sys.current_menu->on_exit) {
+            g_menu_sys.current_menu->on_exit(g_menu_sys.current_menu);
+        }
+        menu_state(g_menu_sys.current_menu)->life = MENU_PAGE_SUSPENDED;
+    }
+    
+    // 设置新菜单
+    g_menu_sys.current_menu = menu;
+    menu_state(menu)->life = MENU_PAGE_ACTIVE;
+    g_menu_sys.menu_active = 1;
+    g_menu_sys.need_refresh = 1;
+    
+    // 根据菜单类型设置布局配置
+    menu_set_layout_for_type(menu->type);
+    
+    // 重置分页信息
+    g_menu_sys.current_page = 0;
+    menu_update_page_info(menu);
+    
+    // 调用进入回调
+    if (menu->on_enter) {
+        menu->on_enter(menu);
+    }
 }
 
 // ==================================
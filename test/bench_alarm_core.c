@@ -0,0 +1,332 @@
+/**
+ * @file bench_alarm_core.c
+ * @brief alarm_core 一致性检查与增删查耗时
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 1. 随机增删改/启停/检查 20 万次，每步之后与暴力结果比对：
+ *          堆顶 = 所有闹钟 Alarm_Rule_Next（被贪睡的取贪睡时刻）的最小值，显示顺序按时分秒有序
+ *       2. 满表（MAX_ALARMS 个）时分别计时 Add、Delete、Update、Check（无到期/有到期）、
+ *          Reschedule，以及按分钟唤醒模拟30天
+ *       alarm_core.c 编译时用 host_noprint.h 屏蔽串口打印，只测数据结构本身
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "host_stub.h"
+#include "cycle_counter.h"
+#include "alarm_core.h"
+#include "alarm_rule.h"
+
+#define BENCH_START_DAY     9000            // 2024-08-22，星期任意
+#define CHECK_OPS           200000UL
+#define TIMED_OPS           200000UL
+
+static uint32_t s_rng = 7;
+
+static uint32_t rng_next(void)
+{
+    s_rng = s_rng * 1664525u + 1013904223u;
+    return s_rng >> 8;
+}
+
+/**
+ * @brief 随机闹钟：每天/工作日/周末/自定义星期/单次/指定日期，约1/4禁用
+ */
+static Alarm_TypeDef random_alarm(uint32_t now)
+{
+    Alarm_TypeDef a;
+    uint32_t kind = rng_next() % 6;
+
+    memset(&a, 0, sizeof(a));
+    a.hour = (uint8_t)(rng_next() % 24);
+    a.minute = (uint8_t)(rng_next() % 60);
+    a.second = (uint8_t)(rng_next() % 60);
+    a.enabled = (rng_next() % 4) != 0;
+    a.snooze_min = ALARM_SNOOZE_DEFAULT_MIN;
+
+    switch (kind) {
+    case 0: a.days = ALARM_DAYS_DAILY; break;
+    case 1: a.days = ALARM_DAYS_WEEKDAYS; break;
+    case 2: a.days = ALARM_DAYS_WEEKEND; break;
+    case 3: a.days = (uint8_t)(1 + rng_next() % 0x7F); break;
+    case 4: a.days = ALARM_DAYS_ONCE; break;
+    default: a.date = (uint16_t)(now / 86400 + rng_next() % 10); break;
+    }
+    return a;
+}
+
+/**
+ * @brief 贪睡模型：被贪睡的闹钟触发时刻由规则时刻换成贪睡时刻，
+ *        直到它响铃、被修改/启停/删除或整体重排
+ */
+static struct {
+    alarm_id_t id;
+    uint32_t at;
+} s_snooze[MAX_ALARMS];
+
+static uint32_t *snooze_find(alarm_id_t id)
+{
+    uint8_t i;
+
+    for (i = 0; i < MAX_ALARMS; i++) {
+        if (s_snooze[i].id == id && id != ALARM_ID_NONE) {
+            return &s_snooze[i].at;
+        }
+    }
+    return NULL;
+}
+
+static void snooze_set(alarm_id_t id, uint32_t at)
+{
+    uint32_t *slot = snooze_find(id);
+    uint8_t i;
+
+    if (slot == NULL) {
+        for (i = 0; i < MAX_ALARMS && s_snooze[i].id != ALARM_ID_NONE; i++) {
+        }
+        s_snooze[i].id = id;
+        slot = &s_snooze[i].at;
+    }
+    *slot = at;
+}
+
+static void snooze_clear(alarm_id_t id)
+{
+    uint8_t i;
+
+    for (i = 0; i < MAX_ALARMS; i++) {
+        if (s_snooze[i].id == id || id == ALARM_ID_NONE) {
+            s_snooze[i].id = ALARM_ID_NONE;
+        }
+    }
+}
+
+/**
+ * @brief 时间推进到 now 后，到期的贪睡已经响过，恢复规则时刻
+ */
+static void snooze_expire(uint32_t now)
+{
+    uint8_t i;
+
+    for (i = 0; i < MAX_ALARMS; i++) {
+        if (s_snooze[i].id != ALARM_ID_NONE && s_snooze[i].at <= now) {
+            s_snooze[i].id = ALARM_ID_NONE;
+        }
+    }
+}
+
+static uint32_t time_key(const Alarm_TypeDef *a)
+{
+    return a->hour * 3600UL + a->minute * 60UL + a->second;
+}
+
+/**
+ * @brief 与暴力结果比对堆顶和显示顺序
+ */
+static int verify(uint32_t now)
+{
+    uint32_t want = ALARM_NEVER;
+    uint32_t prev_key = 0;
+    uint8_t i;
+
+    for (i = 0; i < Alarm_GetCount(); i++) {
+        const Alarm_TypeDef *a = Alarm_Get(Alarm_GetIdAt(i));
+        const uint32_t *snoozed;
+        uint32_t next;
+
+        if (a == NULL || Alarm_GetPosition(a->id) != i) {
+            printf("  position %u: bad id/position\n", i);
+            return -1;
+        }
+        if (time_key(a) < prev_key) {
+            printf("  position %u: display order not sorted\n", i);
+            return -1;
+        }
+        prev_key = time_key(a);
+
+        snoozed = snooze_find(a->id);
+        next = snoozed ? *snoozed : Alarm_Rule_Next(a, now);
+        if (next < want) {
+            want = next;
+        }
+    }
+
+    if (Alarm_NextFire() != want) {
+        printf("  next fire %lu, brute force %lu\n", (unsigned long)Alarm_NextFire(), (unsigned long)want);
+        return -1;
+    }
+    return 0;
+}
+
+static void clear_all(void)
+{
+    while (Alarm_GetCount() > 0) {
+        Alarm_Delete(Alarm_GetIdAt(0));
+    }
+}
+
+static void fill(uint32_t now)
+{
+    while (Alarm_GetCount() < MAX_ALARMS) {
+        Alarm_TypeDef a = random_alarm(now);
+        Alarm_Add(&a);
+    }
+}
+
+/**
+ * @brief 随机操作序列，每步后比对
+ */
+static void test_consistency(void)
+{
+    uint32_t now = BENCH_START_DAY * 86400UL;
+    uint32_t op;
+
+    g_host_rtc_counter = now;
+    clear_all();
+    snooze_clear(ALARM_ID_NONE);
+
+    for (op = 0; op < CHECK_OPS; op++) {
+        uint32_t action = rng_next() % 8;
+        uint8_t count = Alarm_GetCount();
+        alarm_id_t id = count ? Alarm_GetIdAt((uint8_t)(rng_next() % count)) : ALARM_ID_NONE;
+
+        if (action <= 1 && count < MAX_ALARMS) {
+            Alarm_TypeDef a = random_alarm(now);
+            HOST_CHECK(Alarm_Add(&a) > 0);
+        } else if (action == 2 && id != ALARM_ID_NONE) {
+            HOST_CHECK(Alarm_Delete(id) == 0);
+            snooze_clear(id);
+            HOST_CHECK(Alarm_Get(id) == NULL);
+        } else if (action == 3 && id != ALARM_ID_NONE) {
+            Alarm_TypeDef a = random_alarm(now);
+            HOST_CHECK(Alarm_Update(id, &a) == 0);
+            snooze_clear(id);
+        } else if (action == 4 && id != ALARM_ID_NONE) {
+            HOST_CHECK(((rng_next() & 1) ? Alarm_Enable(id) : Alarm_Disable(id)) == 0);
+            snooze_clear(id);
+        } else if (action == 5 && id != ALARM_ID_NONE) {
+            if (Alarm_Snooze(id, now) == 0) {
+                snooze_set(id, now + Alarm_Get(id)->snooze_min * 60UL);
+            }
+        } else {
+            // 时间随机前进0~2小时并处理到期闹钟；堆里到期未处理的时刻会早于暴力结果，
+            // 所以时间只在这里推进，推进后立即检查
+            now += rng_next() % 7200;
+            g_host_rtc_counter = now;
+            while (Alarm_Check(now) >= 0) {
+            }
+            snooze_expire(now);
+            HOST_CHECK(Alarm_NextFire() > now);
+        }
+
+        if (action == 6) {
+            Alarm_Reschedule(now);      // 重建堆会取消贪睡
+            snooze_clear(ALARM_ID_NONE);
+        }
+
+        if (verify(now) != 0) {
+            printf("consistency: failed at op %lu (action %lu)\n", (unsigned long)op, (unsigned long)action);
+            g_host_failures++;
+            return;
+        }
+    }
+    printf("consistency: %lu random ops ok\n", CHECK_OPS);
+}
+
+static void report(const char *what, uint64_t tsc, uint64_t ns, uint32_t ops)
+{
+    printf("  %-22s %8.1f tsc  %7.1f ns per op\n", what, (double)tsc / ops, (double)ns / ops);
+}
+
+/**
+ * @brief 满表计时
+ */
+static void bench(void)
+{
+    uint32_t now = BENCH_START_DAY * 86400UL + 3 * 3600;
+    uint64_t c0, t0;
+    uint64_t add_tsc = 0, del_tsc = 0, add_ns = 0, del_ns = 0;
+    uint32_t i;
+    long fired = 0;
+    volatile int sink = 0;
+
+    g_host_rtc_counter = now;
+    clear_all();
+    fill(now);
+    Alarm_Reschedule(now);
+    printf("bench: %u alarms\n", Alarm_GetCount());
+
+    // 删除任意一个再加回：表满时 Add 要扫描空槽位
+    for (i = 0; i < TIMED_OPS; i++) {
+        alarm_id_t id = Alarm_GetIdAt((uint8_t)(rng_next() % MAX_ALARMS));
+        Alarm_TypeDef a = random_alarm(now);
+
+        t0 = host_now_ns();
+        c0 = cycle_counter_get64();
+        Alarm_Delete(id);
+        del_tsc += cycle_counter_get64() - c0;
+        del_ns += host_now_ns() - t0;
+
+        t0 = host_now_ns();
+        c0 = cycle_counter_get64();
+        Alarm_Add(&a);
+        add_tsc += cycle_counter_get64() - c0;
+        add_ns += host_now_ns() - t0;
+    }
+    report("Alarm_Delete", del_tsc, del_ns, TIMED_OPS);
+    report("Alarm_Add", add_tsc, add_ns, TIMED_OPS);
+
+    t0 = host_now_ns();
+    c0 = cycle_counter_get64();
+    for (i = 0; i < TIMED_OPS; i++) {
+        alarm_id_t id = Alarm_GetIdAt((uint8_t)(i % MAX_ALARMS));
+        Alarm_TypeDef a = *Alarm_Get(id);
+        a.hour = (uint8_t)((a.hour + 1) % 24);
+        sink += Alarm_Update(id, &a);
+    }
+    report("Alarm_Update", cycle_counter_get64() - c0, host_now_ns() - t0, TIMED_OPS);
+
+    // 没有到期：只看堆顶
+    Alarm_Reschedule(now);
+    t0 = host_now_ns();
+    c0 = cycle_counter_get64();
+    for (i = 0; i < TIMED_OPS * 10; i++) {
+        sink += Alarm_Check(Alarm_NextFire() - 1);
+    }
+    report("Alarm_Check (none due)", cycle_counter_get64() - c0, host_now_ns() - t0, TIMED_OPS * 10);
+
+    t0 = host_now_ns();
+    c0 = cycle_counter_get64();
+    for (i = 0; i < 20000; i++) {
+        Alarm_Reschedule(now);
+    }
+    report("Alarm_Reschedule", cycle_counter_get64() - c0, host_now_ns() - t0, 20000);
+
+    // 每分钟唤醒一次模拟30天：单次闹钟逐渐被禁用，到期检查包含推进和出堆
+    t0 = host_now_ns();
+    c0 = cycle_counter_get64();
+    for (i = 0; i < 30 * 1440; i++) {
+        now += 60;
+        g_host_rtc_counter = now;
+        while (Alarm_Check(now) >= 0) {
+            fired++;
+        }
+    }
+    report("minute wake, 30 days", cycle_counter_get64() - c0, host_now_ns() - t0, 30 * 1440);
+    printf("  fired %ld alarms\n", fired);
+    (void)sink;
+}
+
+int main(void)
+{
+    test_consistency();
+    bench();
+
+    if (g_host_failures != 0) {
+        printf("bench_alarm_core: %d FAILED\n", g_host_failures);
+        return 1;
+    }
+    printf("bench_alarm_core: OK\n");
+    return 0;
+}
@@ -0,0 +1,25 @@
+/**
+ * @file FreeRTOS.h
+ * @brief 主机测试用 FreeRTOS 替身（只提供被测模块用到的类型和宏）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 被测模块都是单线程调用，临界区在主机上为空操作
+ */
+
+#ifndef __HOST_FREERTOS_H
+#define __HOST_FREERTOS_H
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef void *TaskHandle_t;
+
+#define configTICK_RATE_HZ      1000
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms))
+#define pdTRUE                  1
+#define pdFALSE                 0
+
+#endif
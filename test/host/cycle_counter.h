@@ -0,0 +1,53 @@
+/**
+ * @file cycle_counter.h
+ * @brief 主机测试用周期计数器（替代 DWT，x86 上读 TSC）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 主机 TSC 频率与 Cortex-M3 主频无关，结果只用于同一主机上的相对比较；
+ *       目标板上的周期数需打开各模块的 *_PROFILE 宏用 DWT 实测
+ */
+
+#ifndef __CYCLE_COUNTER_H
+#define __CYCLE_COUNTER_H
+
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+// 不用 x86intrin.h：其中的形参名 __I 会被 CMSIS 的同名宏替换
+static inline void cycle_counter_init(void)
+{
+}
+
+static inline uint64_t cycle_counter_get64(void)
+{
+    uint32_t lo, hi;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+}
+
+static inline uint32_t cycle_counter_get(void)
+{
+    return (uint32_t)cycle_counter_get64();
+}
+#else
+#include <time.h>
+
+static inline void cycle_counter_init(void)
+{
+}
+
+static inline uint64_t cycle_counter_get64(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static inline uint32_t cycle_counter_get(void)
+{
+    return (uint32_t)cycle_counter_get64();
+}
+#endif
+
+#endif
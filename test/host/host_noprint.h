@@ -0,0 +1,17 @@
+/**
+ * @file host_noprint.h
+ * @brief 计时用：屏蔽被测文件中的 printf（用 -include 强制包含）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 串口打印在目标板上耗时远超算法本身，基准只测数据结构的开销
+ */
+
+#ifndef __HOST_NOPRINT_H
+#define __HOST_NOPRINT_H
+
+#include <stdio.h>
+
+#define printf(...) ((void)0)
+
+#endif
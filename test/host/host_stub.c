@@ -0,0 +1,98 @@
+/**
+ * @file host_stub.c
+ * @brief 主机测试公共设施实现
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "host_stub.h"
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "debug.h"
+#include "mpu_calib.h"
+#include "rtc_tz.h"
+#include "alarm_sched.h"
+
+FILE *g_host_uart = NULL;
+uint32_t g_host_tick = 0;
+uint32_t g_host_rtc_counter = 0;
+int g_host_failures = 0;
+
+uint64_t host_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void host_mute_stdout(int mute)
+{
+    static int saved_fd = -1;
+
+    fflush(stdout);
+    if (mute && saved_fd < 0) {
+        int null_fd = open("/dev/null", O_WRONLY);
+        if (null_fd >= 0) {
+            saved_fd = dup(STDOUT_FILENO);
+            dup2(null_fd, STDOUT_FILENO);
+            close(null_fd);
+        }
+    } else if (!mute && saved_fd >= 0) {
+        dup2(saved_fd, STDOUT_FILENO);
+        close(saved_fd);
+        saved_fd = -1;
+    }
+}
+
+// ==================================
+// FreeRTOS 替身
+// ==================================
+
+TickType_t xTaskGetTickCount(void)
+{
+    return g_host_tick;
+}
+
+// ==================================
+// 串口/外设替身
+// ==================================
+
+void Usart1_send_bytes(uint8_t *buf, uint16_t len)
+{
+    if (g_host_uart != NULL) {
+        fwrite(buf, 1, len, g_host_uart);
+    }
+}
+
+void debug_set_quiet(uint8_t quiet)
+{
+    (void)quiet;
+}
+
+uint8_t mpu_calib_is_valid(void)
+{
+    return 1;
+}
+
+// ==================================
+// RTC/闹钟调度替身
+// ==================================
+
+uint32_t RTC_GetCounter(void)
+{
+    return g_host_rtc_counter;
+}
+
+uint32_t RTC_TZ_UtcToLocal(uint32_t utc)
+{
+    return utc;
+}
+
+void Alarm_Sched_Kick(void)
+{
+}
@@ -0,0 +1,49 @@
+/**
+ * @file host_stub.h
+ * @brief 主机测试公共设施：硬件/RTOS 接口替身与计时
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#ifndef __HOST_STUB_H
+#define __HOST_STUB_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+// Usart1_send_bytes 的输出文件（NULL 时丢弃），用于把 sensor_trace 帧写入文件
+extern FILE *g_host_uart;
+
+// xTaskGetTickCount 的返回值，由测试程序推进
+extern uint32_t g_host_tick;
+
+// RTC_GetCounter 的返回值（UTC 秒数），主机上时区固定为 UTC+0
+extern uint32_t g_host_rtc_counter;
+
+/**
+ * @brief 单调时钟（纳秒）
+ * @return 当前时间
+ */
+uint64_t host_now_ns(void);
+
+/**
+ * @brief 静默/恢复标准输出（被测模块的 printf 在计时循环里会刷屏）
+ * @param mute 1-静默，0-恢复
+ */
+void host_mute_stdout(int mute);
+
+/**
+ * @brief 检查条件，失败时打印位置并累计失败数
+ */
+#define HOST_CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("CHECK FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+            g_host_failures++; \
+        } \
+    } while (0)
+
+extern int g_host_failures;
+
+#endif
@@ -0,0 +1,19 @@
+/**
+ * @file task.h
+ * @brief 主机测试用 task.h 替身
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#ifndef __HOST_TASK_H
+#define __HOST_TASK_H
+
+#include "FreeRTOS.h"
+
+#define taskENTER_CRITICAL()    ((void)0)
+#define taskEXIT_CRITICAL()     ((void)0)
+
+TickType_t xTaskGetTickCount(void);
+
+#endif
@@ -0,0 +1,286 @@
+/**
+ * @file test_alarm_rule.c
+ * @brief Alarm_Rule_Next 暴力参考对比与随机测试
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 参考实现不用天数取模求星期，而是从 2000-01-01 起按月份表逐日走公历，
+ *       星期用蔡勒公式单独计算，再从 after 所在日期逐日向后找第一个满足规则的时刻。
+ *       1. 穷举：128 种星期掩码（另加最高位脏位）× 7 个起始星期 × 时刻在当前时间之前/相等/之后
+ *       2. 随机：300 万组 2000~2099 年内的闹钟与当前时间，约 1/8 落在到点前后 1 秒
+ *       3. 单次判断与重复方式预设循环切换
+ *       最后给出 Alarm_Rule_Next 的主机周期计数
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "host_stub.h"
+#include "cycle_counter.h"
+#include "alarm_rule.h"
+
+#define REF_DAYS        (36525 + 16)    // 2000~2099 年，再留出跨周的余量
+#define FUZZ_CASES      3000000UL
+#define BENCH_CALLS     4000000UL
+
+static uint8_t s_ref_weekday[REF_DAYS];
+
+static uint32_t s_rng = 2026;
+
+static uint32_t rng_next(void)
+{
+    s_rng = s_rng * 1664525u + 1013904223u;
+    return s_rng >> 8;
+}
+
+static int is_leap(int y)
+{
+    return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+}
+
+static int days_in_month(int y, int m)
+{
+    static const uint8_t dim[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    return dim[m - 1] + (m == 2 && is_leap(y));
+}
+
+/**
+ * @brief 蔡勒公式求星期
+ * @return 0=周日 ... 6=周六
+ */
+static uint8_t zeller(int y, int m, int d)
+{
+    int k, j, h;
+
+    if (m < 3) {
+        m += 12;
+        y--;
+    }
+    k = y % 100;
+    j = y / 100;
+    h = (d + 13 * (m + 1) / 5 + k + k / 4 + j / 4 + 5 * j) % 7;   // 0=周六
+    return (uint8_t)((h + 6) % 7);
+}
+
+/**
+ * @brief 逐日走公历，建立天数到星期的参考表
+ */
+static void ref_init(void)
+{
+    int y = 2000, m = 1, d = 1;
+    uint32_t day;
+
+    for (day = 0; day < REF_DAYS; day++) {
+        s_ref_weekday[day] = zeller(y, m, d);
+        if (++d > days_in_month(y, m)) {
+            d = 1;
+            if (++m > 12) {
+                m = 1;
+                y++;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 参考实现：从 after 所在日期起逐日查找
+ */
+static uint32_t ref_next(const Alarm_TypeDef *a, uint32_t after)
+{
+    uint32_t tod = a->hour * 3600UL + a->minute * 60UL + a->second;
+    uint32_t day;
+
+    if (!a->enabled) {
+        return ALARM_NEVER;
+    }
+    if (a->date != ALARM_DATE_NONE) {
+        uint32_t fire = a->date * 86400UL + tod;
+        return (fire > after) ? fire : ALARM_NEVER;
+    }
+
+    for (day = after / 86400; day < REF_DAYS; day++) {
+        uint32_t fire = day * 86400UL + tod;
+        uint8_t mask = a->days & ALARM_DAYS_DAILY;
+
+        if (fire > after && (mask == ALARM_DAYS_ONCE || (mask >> s_ref_weekday[day]) & 1)) {
+            return fire;
+        }
+    }
+    return ALARM_NEVER;
+}
+
+static int check_one(const Alarm_TypeDef *a, uint32_t after)
+{
+    uint32_t got = Alarm_Rule_Next(a, after);
+    uint32_t want = ref_next(a, after);
+
+    if (got != want) {
+        printf("  %02u:%02u:%02u days %02X date %u enabled %u after %lu: got %lu, reference %lu\n",
+               a->hour, a->minute, a->second, a->days, a->date, a->enabled,
+               (unsigned long)after, (unsigned long)got, (unsigned long)want);
+        g_host_failures++;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 穷举星期掩码、起始星期和时刻先后关系
+ */
+static void test_exhaustive(void)
+{
+    static const int32_t delta[] = { -86399, -3600, -1, 0, 1, 3600, 86399 };
+    Alarm_TypeDef a;
+    unsigned long cases = 0;
+    uint32_t mask, start, i;
+
+    memset(&a, 0, sizeof(a));
+    a.enabled = 1;
+    a.hour = 7;
+    a.minute = 30;
+    a.second = 15;
+
+    for (mask = 0; mask < 256; mask++) {
+        a.days = (uint8_t)mask;                     // 最高位是脏位，规则应忽略
+        for (start = 9000; start < 9007; start++) {  // 连续7天，覆盖每个起始星期
+            for (i = 0; i < sizeof(delta) / sizeof(delta[0]); i++) {
+                uint32_t after = start * 86400UL + 7 * 3600UL + 30 * 60UL + 15 + delta[i];
+                if (check_one(&a, after) != 0) {
+                    return;
+                }
+                cases++;
+            }
+        }
+    }
+    printf("exhaustive: %lu mask/weekday/offset cases ok\n", cases);
+}
+
+static Alarm_TypeDef random_alarm(void)
+{
+    Alarm_TypeDef a;
+    uint32_t kind = rng_next() % 4;
+
+    memset(&a, 0, sizeof(a));
+    a.hour = (uint8_t)(rng_next() % 24);
+    a.minute = (uint8_t)(rng_next() % 60);
+    a.second = (uint8_t)(rng_next() % 60);
+    a.enabled = (rng_next() % 10) != 0;
+    a.days = (kind == 0) ? ALARM_DAYS_ONCE : (uint8_t)rng_next();
+    if (kind == 3) {
+        a.date = (uint16_t)(2 + rng_next() % 36523);    // 留出前2天，当前时间不回绕
+    }
+    return a;
+}
+
+/**
+ * @brief 随机闹钟与当前时间（指定日期的闹钟，当前时间取在该日期前后）
+ */
+static void test_fuzz(void)
+{
+    unsigned long i;
+
+    for (i = 0; i < FUZZ_CASES; i++) {
+        Alarm_TypeDef a = random_alarm();
+        uint32_t tod = a.hour * 3600UL + a.minute * 60UL + a.second;
+        uint32_t after;
+
+        if (a.date != ALARM_DATE_NONE) {
+            after = a.date * 86400UL + tod - 2 * 86400 + rng_next() % (4 * 86400);
+        } else {
+            after = (rng_next() % 36525) * 86400UL + rng_next() % 86400;
+        }
+        if (rng_next() % 8 == 0) {
+            after = after - after % 86400 + tod - rng_next() % 2;   // 恰在到点时刻或前1秒
+        }
+        if (check_one(&a, after) != 0) {
+            return;
+        }
+    }
+    printf("fuzz: %lu random cases ok\n", FUZZ_CASES);
+}
+
+/**
+ * @brief 单次判断、预设循环切换
+ */
+static void test_presets(void)
+{
+    Alarm_TypeDef a;
+    uint32_t now = 9000 * 86400UL + 12 * 3600UL;
+    uint8_t i;
+
+    memset(&a, 0, sizeof(a));
+    a.enabled = 1;
+    a.hour = 6;
+
+    HOST_CHECK(Alarm_Rule_Is_OneShot(&a));
+    a.days = ALARM_DAYS_WEEKDAYS;
+    HOST_CHECK(!Alarm_Rule_Is_OneShot(&a));
+    a.date = 9001;
+    HOST_CHECK(Alarm_Rule_Is_OneShot(&a));
+
+    // 从单次开始向后切换一圈：每天、工作日、周末、指定日期，再回到单次
+    a.days = ALARM_DAYS_ONCE;
+    a.date = ALARM_DATE_NONE;
+    for (i = 0; i < 5; i++) {
+        HOST_CHECK(Alarm_Rule_Preset(&a) == i);
+        Alarm_Rule_Cycle(&a, 1, now);
+    }
+    HOST_CHECK(Alarm_Rule_Preset(&a) == 0);
+
+    // 切到指定日期时取下一次06:00所在日期（当前12:00，即明天）
+    Alarm_Rule_Cycle(&a, -1, now);
+    HOST_CHECK(Alarm_Rule_Preset(&a) == ALARM_RULE_PRESET_DATE);
+    HOST_CHECK(a.date == 9001);
+
+    // 自定义掩码显示为 Cust，切换时回到第一个预设
+    a.date = ALARM_DATE_NONE;
+    a.days = ALARM_DAY_MON | ALARM_DAY_WED;
+    HOST_CHECK(strcmp(Alarm_Rule_Label(&a), "Cust") == 0);
+    Alarm_Rule_Cycle(&a, 1, now);
+    HOST_CHECK(Alarm_Rule_Preset(&a) == 0);
+    printf("presets: done\n");
+}
+
+static void bench(void)
+{
+    static Alarm_TypeDef alarms[256];
+    static uint32_t afters[256];
+    volatile uint32_t sink = 0;
+    uint64_t c0, cycles;
+    unsigned long i;
+
+    for (i = 0; i < 256; i++) {
+        alarms[i] = random_alarm();
+        alarms[i].enabled = 1;
+        alarms[i].date = ALARM_DATE_NONE;
+        afters[i] = (rng_next() % 36525) * 86400UL + rng_next() % 86400;
+    }
+
+    c0 = cycle_counter_get64();
+    for (i = 0; i < BENCH_CALLS; i++) {
+        sink += Alarm_Rule_Next(&alarms[i & 255], afters[(i >> 8) & 255]);
+    }
+    cycles = cycle_counter_get64() - c0;
+    (void)sink;
+    printf("Alarm_Rule_Next: host tsc %.1f per call\n", (double)cycles / BENCH_CALLS);
+}
+
+int main(void)
+{
+    ref_init();
+    // 参考表自检：2000-01-01 周六，2000-02-29 周二，2099-12-31 周四
+    HOST_CHECK(s_ref_weekday[0] == 6);
+    HOST_CHECK(s_ref_weekday[59] == 2);
+    HOST_CHECK(s_ref_weekday[36524] == 4);
+
+    test_exhaustive();
+    test_fuzz();
+    test_presets();
+    bench();
+
+    if (g_host_failures != 0) {
+        printf("test_alarm_rule: %d FAILED\n", g_host_failures);
+        return 1;
+    }
+    printf("test_alarm_rule: OK\n");
+    return 0;
+}
@@ -0,0 +1,293 @@
+/**
+ * @file test_history_codec.c
+ * @brief history_codec 往返、边界与吞吐测试
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 覆盖：典型一天的分钟数据（须放进 history 的缓冲区）、整段/交替的 HISTORY_NO_DATA、
+ *       int16 全量程跳变、最长游程、流式编码器未落盘游程、空间不足与损坏数据、随机序列，
+ *       最后给出主机上的编解码吞吐
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "host_stub.h"
+#include "history_codec.h"
+#include "history.h"
+
+#define MAX_SAMPLES     0xFFFF
+#define RAMP_SAMPLES    21846       // 3 * 21845 = 65535
+#define PAIR_SAMPLES    30000       // 每两个样本 3+1 字节，共 60000 字节，不超过 uint16 容量
+
+static int16_t s_in[MAX_SAMPLES];
+static int16_t s_out[MAX_SAMPLES];
+static uint8_t s_buf[MAX_SAMPLES * HISTORY_CODEC_MAX_TOKEN];
+
+static uint32_t s_rng = 1;
+
+static uint32_t rng_next(void)
+{
+    s_rng = s_rng * 1664525u + 1013904223u;
+    return s_rng >> 8;
+}
+
+/**
+ * @brief 编码后解码，要求逐样本一致
+ * @return 编码字节数，失败返回-1
+ */
+static int roundtrip(const char *what, const int16_t *values, uint16_t count)
+{
+    int len = history_codec_encode(values, count, s_buf, 0xFFFF);
+    int n;
+
+    if (len < 0) {
+        printf("  %s: encode failed\n", what);
+        g_host_failures++;
+        return -1;
+    }
+    // 每个样本最多一个记号，长度不超过 HISTORY_CODEC_MAX_TOKEN
+    HOST_CHECK(len <= (int)count * HISTORY_CODEC_MAX_TOKEN);
+
+    n = history_codec_decode(s_buf, (uint16_t)len, s_out, count);
+    if (n != count || memcmp(values, s_out, count * sizeof(int16_t)) != 0) {
+        printf("  %s: roundtrip mismatch (%d of %u samples)\n", what, n, count);
+        g_host_failures++;
+        return -1;
+    }
+    return len;
+}
+
+/**
+ * @brief 生成一天的分钟数据：前半小时未开机，中间有传感器读取失败
+ */
+static void make_day(int16_t *steps, int16_t *temp, int16_t *humi)
+{
+    int t = 235, h = 550;
+    uint16_t i;
+
+    for (i = 0; i < HISTORY_MINUTES_PER_DAY; i++) {
+        uint8_t active = (i > 420 && i < 480) || (i > 720 && i < 750) || (i > 1080 && i < 1140) ||
+                         (rng_next() % 40 == 0 && i > 400 && i < 1320);
+        if (rng_next() % 15 == 0) t += (int)(rng_next() % 3) - 1;
+        if (rng_next() % 12 == 0) h += (int)(rng_next() % 3) - 1;
+
+        steps[i] = active ? (int16_t)(80 + rng_next() % 50) : 0;
+        temp[i] = (int16_t)t;
+        humi[i] = (int16_t)h;
+
+        if (i < 30 || (i >= 600 && i < 605)) {
+            steps[i] = temp[i] = humi[i] = HISTORY_NO_DATA;
+        }
+    }
+}
+
+static void test_day(void)
+{
+    static int16_t steps[HISTORY_MINUTES_PER_DAY], temp[HISTORY_MINUTES_PER_DAY], humi[HISTORY_MINUTES_PER_DAY];
+    int ls, lt, lh;
+
+    make_day(steps, temp, humi);
+    ls = roundtrip("day steps", steps, HISTORY_MINUTES_PER_DAY);
+    lt = roundtrip("day temp", temp, HISTORY_MINUTES_PER_DAY);
+    lh = roundtrip("day humi", humi, HISTORY_MINUTES_PER_DAY);
+
+    // 典型的一天须放进 history 模块的缓冲区
+    HOST_CHECK(ls <= HISTORY_STEPS_BUF_SIZE);
+    HOST_CHECK(lt <= HISTORY_TEMP_BUF_SIZE);
+    HOST_CHECK(lh <= HISTORY_HUMI_BUF_SIZE);
+    printf("day: steps %d/%d B, temp %d/%d B, humi %d/%d B\n",
+           ls, HISTORY_STEPS_BUF_SIZE, lt, HISTORY_TEMP_BUF_SIZE, lh, HISTORY_HUMI_BUF_SIZE);
+}
+
+static void test_no_data(void)
+{
+    uint32_t i;
+    int len;
+
+    // 整天缺测：一个差分记号 + 一个游程
+    for (i = 0; i < HISTORY_MINUTES_PER_DAY; i++) {
+        s_in[i] = HISTORY_NO_DATA;
+    }
+    len = roundtrip("all no-data", s_in, HISTORY_MINUTES_PER_DAY);
+    HOST_CHECK(len > 0 && len <= 2 * HISTORY_CODEC_MAX_TOKEN);
+
+    // 缺测与最大值交替：每个样本都是 int16 全量程差分
+    for (i = 0; i < HISTORY_MINUTES_PER_DAY; i++) {
+        s_in[i] = (i & 1) ? 32767 : HISTORY_NO_DATA;
+    }
+    len = roundtrip("no-data/max alternating", s_in, HISTORY_MINUTES_PER_DAY);
+    HOST_CHECK(len == HISTORY_MINUTES_PER_DAY * HISTORY_CODEC_MAX_TOKEN);
+
+    // 缺测段夹在数据中间，段长 1~200
+    for (i = 0; i < HISTORY_MINUTES_PER_DAY; ) {
+        uint32_t seg = 1 + rng_next() % 200;
+        int16_t v = (rng_next() & 1) ? HISTORY_NO_DATA : (int16_t)(rng_next() % 400);
+        while (seg-- > 0 && i < HISTORY_MINUTES_PER_DAY) {
+            s_in[i++] = v;
+        }
+    }
+    roundtrip("no-data segments", s_in, HISTORY_MINUTES_PER_DAY);
+}
+
+static void test_extremes(void)
+{
+    uint32_t i;
+    int len;
+
+    // 首样本与0做差：两个端点各自成段
+    s_in[0] = -32768;
+    HOST_CHECK(roundtrip("single min", s_in, 1) == HISTORY_CODEC_MAX_TOKEN);
+    s_in[0] = 32767;
+    HOST_CHECK(roundtrip("single max", s_in, 1) == HISTORY_CODEC_MAX_TOKEN);
+
+    // 步长3扫过 int16 全量程（编码长度受 uint16 容量限制，逐一遍历放不下），以及反向
+    for (i = 0; i < RAMP_SAMPLES; i++) {
+        s_in[i] = (int16_t)(-32768 + 3 * (int32_t)i);
+    }
+    roundtrip("ramp up", s_in, RAMP_SAMPLES);
+    for (i = 0; i < RAMP_SAMPLES; i++) {
+        s_in[i] = (int16_t)(32767 - 3 * (int32_t)i);
+    }
+    roundtrip("ramp down", s_in, RAMP_SAMPLES);
+
+    // 最长游程：编码器样本数上限 0xFFFF，游程记号不超过3字节
+    for (i = 0; i < MAX_SAMPLES; i++) {
+        s_in[i] = 1234;
+    }
+    len = roundtrip("longest run", s_in, MAX_SAMPLES);
+    HOST_CHECK(len > 0 && len <= 2 * HISTORY_CODEC_MAX_TOKEN);
+
+    // 差分记号与游程交替（每个记号后跟长度为1的游程）
+    for (i = 0; i < PAIR_SAMPLES; i++) {
+        s_in[i] = (int16_t)(((i >> 1) & 1) ? 32767 : -32768);
+    }
+    roundtrip("min/max pairs", s_in, PAIR_SAMPLES);
+}
+
+/**
+ * @brief 流式编码：边写边读（含未落盘游程），以及空间不足后状态不变
+ */
+static void test_stream(void)
+{
+    history_enc_t enc;
+    history_dec_t dec;
+    uint8_t small[8];
+    int16_t v;
+    uint32_t i, k;
+
+    history_enc_init(&enc, s_buf, HISTORY_TEMP_BUF_SIZE);
+    for (i = 0; i < 500; i++) {
+        s_in[i] = (int16_t)((i / 7) % 3 == 0 ? HISTORY_NO_DATA : 200 + (int16_t)(i / 50));
+        HOST_CHECK(history_enc_put(&enc, s_in[i]) == 0);
+
+        // 每写一个样本都从头读一遍，读到的须与已写的完全一致
+        history_dec_init_enc(&dec, &enc);
+        for (k = 0; k <= i; k++) {
+            if (history_dec_next(&dec, &v) != 0 || v != s_in[k]) {
+                printf("  stream: sample %u of %u mismatch\n", k, i + 1);
+                g_host_failures++;
+                return;
+            }
+        }
+        HOST_CHECK(history_dec_next(&dec, &v) == -1);
+    }
+
+    // 空间不足：put 失败后编码器不变，已有数据仍可解码
+    history_enc_init(&enc, small, sizeof(small));
+    for (i = 0; history_enc_put(&enc, (int16_t)((i & 1) ? 32767 : -32768)) == 0; i++) {
+    }
+    HOST_CHECK(i == sizeof(small) / HISTORY_CODEC_MAX_TOKEN);
+    HOST_CHECK(enc.count == i);
+    HOST_CHECK(history_codec_decode(small, enc.len, s_out, 16) == (int)i);
+
+    HOST_CHECK(history_codec_encode(s_in, 500, s_buf, 4) == -1);
+}
+
+static void test_corrupt(void)
+{
+    static const uint8_t truncated[] = { 0x80 };                            // 续位后无数据
+    static const uint8_t zero_run[] = { 0x02, 0x01 };                       // 长度为0的游程
+    static const uint8_t too_long[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x00 };
+    static const uint8_t three[] = { 0x02, 0x07 };                          // 1 后接3个相同样本
+
+    HOST_CHECK(history_codec_decode(truncated, sizeof(truncated), s_out, 16) == -1);
+    HOST_CHECK(history_codec_decode(zero_run, sizeof(zero_run), s_out, 16) == -1);
+    HOST_CHECK(history_codec_decode(too_long, sizeof(too_long), s_out, 16) == -1);
+    HOST_CHECK(history_codec_decode(three, sizeof(three), s_out, 4) == 4);
+    HOST_CHECK(history_codec_decode(three, sizeof(three), s_out, 3) == -2);
+    HOST_CHECK(history_codec_decode(three, 0, s_out, 4) == 0);
+}
+
+static void test_random(void)
+{
+    uint32_t r, i;
+
+    for (r = 0; r < 3000; r++) {
+        uint16_t n = (uint16_t)(1 + rng_next() % 3000);
+        uint32_t mode = rng_next() % 3;
+
+        for (i = 0; i < n; i++) {
+            uint32_t x = rng_next();
+            if (mode == 0) {
+                s_in[i] = (int16_t)x;                                       // 白噪声
+            } else if (mode == 1) {
+                s_in[i] = (x % 3) ? (i ? s_in[i - 1] : 0) : (int16_t)x;    // 长游程 + 大跳变
+            } else {
+                s_in[i] = (x % 5 == 0) ? HISTORY_NO_DATA : (int16_t)(x % 64);
+            }
+        }
+        if (roundtrip("random", s_in, n) < 0) {
+            return;
+        }
+    }
+    printf("random: 3000 series ok\n");
+}
+
+static void bench(void)
+{
+    static int16_t steps[HISTORY_MINUTES_PER_DAY], temp[HISTORY_MINUTES_PER_DAY], humi[HISTORY_MINUTES_PER_DAY];
+    int16_t *series[3] = { steps, temp, humi };
+    const char *names[3] = { "steps", "temp", "humi" };
+    uint8_t k;
+
+    make_day(steps, temp, humi);
+    for (k = 0; k < 3; k++) {
+        uint64_t t0, enc_ns, dec_ns;
+        uint32_t r, rounds = 5000;
+        int len = 0;
+
+        t0 = host_now_ns();
+        for (r = 0; r < rounds; r++) {
+            len = history_codec_encode(series[k], HISTORY_MINUTES_PER_DAY, s_buf, 0xFFFF);
+        }
+        enc_ns = host_now_ns() - t0;
+
+        t0 = host_now_ns();
+        for (r = 0; r < rounds; r++) {
+            history_codec_decode(s_buf, (uint16_t)len, s_out, HISTORY_MINUTES_PER_DAY);
+        }
+        dec_ns = host_now_ns() - t0;
+
+        printf("bench %-5s %4d B/day: encode %.1f ns/sample, decode %.1f ns/sample\n", names[k], len,
+               (double)enc_ns / ((double)rounds * HISTORY_MINUTES_PER_DAY),
+               (double)dec_ns / ((double)rounds * HISTORY_MINUTES_PER_DAY));
+    }
+}
+
+int main(void)
+{
+    test_day();
+    test_no_data();
+    test_extremes();
+    test_stream();
+    test_corrupt();
+    test_random();
+    bench();
+
+    if (g_host_failures != 0) {
+        printf("test_history_codec: %d FAILED\n", g_host_failures);
+        return 1;
+    }
+    printf("test_history_codec: OK\n");
+    return 0;
+}
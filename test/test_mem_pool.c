@@ -0,0 +1,177 @@
+/**
+ * @file test_mem_pool.c
+ * @brief mem_pool 固定块内存池：分配释放、错误检出、并发释放与耗时
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 直接包含 mem_pool.c，并把临界区换成测试钩子：进入临界区之前可以"插入"
+ *       另一个任务对同一块的释放，模拟它在检查之后、加锁之前抢占。
+ *       Makefile 分别按 MEM_POOL_DEBUG=0 和 1 编译两份。
+ *       1. 分配顺序、池满、释放非本池/未对齐指针、用量和峰值统计
+ *       2. 重复释放：调试模式总能检出，非调试模式在池全空时检出
+ *       3. 并发释放同一块（调试模式）：只有一次成功，空闲链表不会重复链入
+ *       4. 释放后写入（调试模式）：下一次分配时打印出来，不影响分配
+ *       最后给出一次分配 + 释放的主机周期计数
+ */
+
+#include "host_stub.h"
+#include "cycle_counter.h"
+#include "task.h"
+
+// 进入临界区前执行一次插入的释放（模拟被抢占），临界区本身在主机上仍是空操作
+static void host_enter_critical(void);
+
+#undef taskENTER_CRITICAL
+#define taskENTER_CRITICAL()    host_enter_critical()
+
+#include "mem_pool.c"
+
+#define BLOCK_SIZE      132
+#define BLOCK_COUNT     3
+#define BENCH_CALLS     10000000UL
+
+static uint32_t s_buf[MEM_POOL_BUF_WORDS(BLOCK_SIZE, BLOCK_COUNT)];
+static mem_pool_t s_pool;
+
+static void *s_preempt_ptr;     // 非NULL：下一次进入临界区前先释放这一块
+static int s_preempt_ret;
+
+static void host_enter_critical(void)
+{
+    void *ptr = s_preempt_ptr;
+
+    if (ptr != NULL) {
+        s_preempt_ptr = NULL;
+        s_preempt_ret = mem_pool_free(&s_pool, ptr);
+    }
+}
+
+/**
+ * @brief 把池中的块全部分配出来，检查互不相同且数量正确，再全部释放
+ * @return 分配到的块数
+ */
+static int drain_and_refill(void)
+{
+    void *blocks[BLOCK_COUNT + 1];
+    int n = 0;
+    int i, j;
+
+    while (n <= BLOCK_COUNT && (blocks[n] = mem_pool_alloc(&s_pool)) != NULL) {
+        n++;
+    }
+    for (i = 0; i < n; i++) {
+        for (j = i + 1; j < n; j++) {
+            HOST_CHECK(blocks[i] != blocks[j]);
+        }
+    }
+    for (i = 0; i < n; i++) {
+        HOST_CHECK(mem_pool_free(&s_pool, blocks[i]) == 0);
+    }
+    HOST_CHECK(s_pool.used == 0);
+    return n;
+}
+
+static void test_basic(void)
+{
+    void *a, *b, *c;
+    int x;
+
+    HOST_CHECK(mem_pool_init(&s_pool, "test", s_buf, 0, BLOCK_COUNT) == -1);
+    HOST_CHECK(mem_pool_init(&s_pool, "test", s_buf, BLOCK_SIZE, BLOCK_COUNT) == 0);
+
+    // 从低地址开始分配，池满返回 NULL 并计数
+    a = mem_pool_alloc(&s_pool);
+    b = mem_pool_alloc(&s_pool);
+    c = mem_pool_alloc(&s_pool);
+    HOST_CHECK(a != NULL && b != NULL && c != NULL);
+    HOST_CHECK((uint8_t *)a < (uint8_t *)b && (uint8_t *)b < (uint8_t *)c);
+    HOST_CHECK(((uintptr_t)a & 3) == 0);
+    HOST_CHECK(mem_pool_alloc(&s_pool) == NULL);
+    HOST_CHECK(s_pool.used == 3 && s_pool.peak == 3 && s_pool.fails == 1);
+
+    // 非本池和未对齐的指针
+    HOST_CHECK(mem_pool_free(&s_pool, &x) == -1);
+    HOST_CHECK(mem_pool_free(&s_pool, (uint8_t *)a + 4) == -1);
+    HOST_CHECK(s_pool.used == 3);
+
+    HOST_CHECK(mem_pool_free(&s_pool, b) == 0);
+    HOST_CHECK(mem_pool_free(&s_pool, a) == 0);
+    HOST_CHECK(mem_pool_free(&s_pool, c) == 0);
+    HOST_CHECK(s_pool.used == 0 && s_pool.peak == 3);
+
+    // 池已全空时的重复释放两种模式都能检出
+    HOST_CHECK(mem_pool_free(&s_pool, c) == -2);
+    HOST_CHECK(drain_and_refill() == BLOCK_COUNT);
+    printf("basic: done\n");
+}
+
+static void test_double_free(void)
+{
+#if MEM_POOL_DEBUG
+    void *a, *b;
+
+    mem_pool_init(&s_pool, "test", s_buf, BLOCK_SIZE, BLOCK_COUNT);
+    a = mem_pool_alloc(&s_pool);
+    b = mem_pool_alloc(&s_pool);
+    HOST_CHECK(mem_pool_free(&s_pool, a) == 0);
+    HOST_CHECK(mem_pool_free(&s_pool, a) == -2);
+    HOST_CHECK(s_pool.used == 1);
+    HOST_CHECK(mem_pool_free(&s_pool, b) == 0);
+    HOST_CHECK(drain_and_refill() == BLOCK_COUNT);
+
+    // 两个任务同时释放同一块：另一个任务在本次检查和加锁之间完成释放
+    mem_pool_init(&s_pool, "test", s_buf, BLOCK_SIZE, BLOCK_COUNT);
+    a = mem_pool_alloc(&s_pool);
+    b = mem_pool_alloc(&s_pool);
+    s_preempt_ptr = a;
+    s_preempt_ret = 1;
+    HOST_CHECK(mem_pool_free(&s_pool, a) == -2);
+    HOST_CHECK(s_preempt_ret == 0);
+    HOST_CHECK(s_pool.used == 1);
+    HOST_CHECK(mem_pool_free(&s_pool, b) == 0);
+    HOST_CHECK(drain_and_refill() == BLOCK_COUNT);
+
+    // 释放后写入：下次分配到这一块时打印，分配照常成功
+    a = mem_pool_alloc(&s_pool);
+    HOST_CHECK(mem_pool_free(&s_pool, a) == 0);
+    HOST_CHECK(((uint8_t *)a)[20] == MEM_POOL_FILL);
+    ((uint8_t *)a)[20] = 1;
+    printf("expect a write-after-free report:\n");
+    HOST_CHECK(mem_pool_alloc(&s_pool) == a);
+    HOST_CHECK(mem_pool_free(&s_pool, a) == 0);
+    printf("double free: done\n");
+#else
+    printf("double free: only the empty-pool case without MEM_POOL_DEBUG\n");
+#endif
+}
+
+static void bench(void)
+{
+    uint64_t c0, cycles;
+    unsigned long i;
+    void *p;
+
+    mem_pool_init(&s_pool, "test", s_buf, BLOCK_SIZE, BLOCK_COUNT);
+    c0 = cycle_counter_get64();
+    for (i = 0; i < BENCH_CALLS; i++) {
+        p = mem_pool_alloc(&s_pool);
+        mem_pool_free(&s_pool, p);
+    }
+    cycles = cycle_counter_get64() - c0;
+    printf("alloc + free: host tsc %.1f per pair (MEM_POOL_DEBUG %d)\n",
+           (double)cycles / BENCH_CALLS, MEM_POOL_DEBUG);
+}
+
+int main(void)
+{
+    test_basic();
+    test_double_free();
+    bench();
+
+    if (g_host_failures != 0) {
+        printf("test_mem_pool: %d FAILED\n", g_host_failures);
+        return 1;
+    }
+    printf("test_mem_pool: OK\n");
+    return 0;
+}
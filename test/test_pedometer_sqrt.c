@@ -0,0 +1,198 @@
+/**
+ * @file test_pedometer_sqrt.c
+ * @brief simple_pedometer 合加速度开方：新旧实现等价性与耗时
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 直接包含 simple_pedometer.c 以调用其中的静态函数 calculate_magnitude；
+ *       旧实现取自改用 fx_isqrt32 之前的版本（二分查找），
+ *       其中的 long 在 ARMCC 下为32位，这里用 int32_t 还原目标板上的行为
+ */
+
+#include "simple_pedometer.c"
+#include <string.h>
+#include "host_stub.h"
+
+#define BENCH_INPUTS    4096
+#define BENCH_ROUNDS    2000
+
+/**
+ * @brief 旧实现（目标板语义：long 为32位，平方和超过 2^31 时回绕为负数）
+ */
+static short old_calculate_magnitude(short ax, short ay, short az)
+{
+    int32_t magnitude_sq = (int32_t)((uint32_t)((int32_t)ax * ax)
+                                   + (uint32_t)((int32_t)ay * ay)
+                                   + (uint32_t)((int32_t)az * az));
+    short low = 0;
+    short high = 0x7FFF;
+
+    if (magnitude_sq <= 0) {
+        return 0;
+    }
+
+    while (high - low > 1) {
+        short mid = (low + high) / 2;
+        int32_t sq = (int32_t)mid * mid;
+        if (sq <= magnitude_sq) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static uint32_t s_rng = 12345;
+
+static uint32_t rng_next(void)
+{
+    s_rng = s_rng * 1664525u + 1013904223u;
+    return s_rng;
+}
+
+static uint32_t sum_sq(short ax, short ay, short az)
+{
+    return (uint32_t)((int32_t)ax * ax) + (uint32_t)((int32_t)ay * ay) + (uint32_t)((int32_t)az * az);
+}
+
+/**
+ * @brief 比较一组输入：平方和低于 2^31 时两者必须一致，
+ *        否则旧实现溢出，新实现必须饱和到 PEDOMETER_MAGNITUDE_MAX
+ */
+static void check_one(short ax, short ay, short az, unsigned long *compared, unsigned long *old_wrong)
+{
+    short got = calculate_magnitude(ax, ay, az);
+    uint32_t sq = sum_sq(ax, ay, az);
+
+    if (sq < 0x80000000UL) {
+        short want = old_calculate_magnitude(ax, ay, az);
+        if (got != want) {
+            printf("  mismatch (%d,%d,%d): new %d old %d\n", ax, ay, az, got, want);
+            g_host_failures++;
+        }
+        (*compared)++;
+    } else {
+        HOST_CHECK(got == PEDOMETER_MAGNITUDE_MAX);
+        if (old_calculate_magnitude(ax, ay, az) != PEDOMETER_MAGNITUDE_MAX) {
+            (*old_wrong)++;
+        }
+    }
+}
+
+/**
+ * @brief 等价性：单轴穷举、平方数边界、随机三轴
+ */
+static void test_equivalence(void)
+{
+    unsigned long compared = 0, old_wrong = 0;
+    int32_t v;
+    uint32_t k;
+    uint32_t i;
+
+    // 1. 单轴穷举（含 -32768）
+    for (v = -32768; v <= 32767; v++) {
+        check_one((short)v, 0, 0, &compared, &old_wrong);
+        check_one(0, (short)v, 0, &compared, &old_wrong);
+    }
+
+    // 2. 每个平方数两侧：k^2-1、k^2、k^2+2k（开方结果在这些点跳变）
+    for (k = 1; k < 32768; k++) {
+        uint32_t sq = k * k;
+        uint32_t targets[3];
+        uint8_t t;
+
+        targets[0] = sq - 1;
+        targets[1] = sq;
+        targets[2] = sq + 2 * k;
+        for (t = 0; t < 3; t++) {
+            // 拆成 a^2 + b^2 + c^2 的形式：a 取最大可能值，余数再分给 b、c
+            uint32_t rest = targets[t];
+            uint32_t a = fx_isqrt32(rest);
+            uint32_t b, c;
+
+            if (a > 32767) a = 32767;
+            rest -= a * a;
+            b = fx_isqrt32(rest);
+            if (b > 32767) b = 32767;
+            rest -= b * b;
+            c = fx_isqrt32(rest);
+            if (c > 32767) c = 32767;
+            check_one((short)a, (short)b, (short)c, &compared, &old_wrong);
+        }
+    }
+
+    // 3. 随机三轴（全量程）
+    for (i = 0; i < 20000000UL; i++) {
+        uint32_t r = rng_next();
+        uint32_t r2 = rng_next();
+        check_one((short)r, (short)(r >> 16), (short)r2, &compared, &old_wrong);
+    }
+
+    printf("equivalence: %lu inputs below 2^31 identical, "
+           "%lu inputs above 2^31 where the old path overflowed (new saturates to %d)\n",
+           compared, old_wrong, PEDOMETER_MAGNITUDE_MAX);
+}
+
+/**
+ * @brief 耗时：同一组输入分别跑新旧实现，输入取 1g 附近（走路时的典型范围）
+ */
+static void bench(void)
+{
+    short in[BENCH_INPUTS][3];
+    volatile short sink = 0;
+    uint64_t c0, old_cycles, new_cycles, upd_cycles;
+    uint32_t r, i;
+
+    for (i = 0; i < BENCH_INPUTS; i++) {
+        in[i][0] = (short)((int32_t)(rng_next() % 8001) - 4000);
+        in[i][1] = (short)((int32_t)(rng_next() % 8001) - 4000);
+        in[i][2] = (short)(16384 + (int32_t)(rng_next() % 12001) - 6000);
+    }
+
+    c0 = cycle_counter_get64();
+    for (r = 0; r < BENCH_ROUNDS; r++) {
+        for (i = 0; i < BENCH_INPUTS; i++) {
+            sink += old_calculate_magnitude(in[i][0], in[i][1], in[i][2]);
+        }
+    }
+    old_cycles = cycle_counter_get64() - c0;
+
+    c0 = cycle_counter_get64();
+    for (r = 0; r < BENCH_ROUNDS; r++) {
+        for (i = 0; i < BENCH_INPUTS; i++) {
+            sink += calculate_magnitude(in[i][0], in[i][1], in[i][2]);
+        }
+    }
+    new_cycles = cycle_counter_get64() - c0;
+
+    host_mute_stdout(1);
+    simple_pedometer_init();
+    c0 = cycle_counter_get64();
+    for (r = 0; r < BENCH_ROUNDS; r++) {
+        for (i = 0; i < BENCH_INPUTS; i++) {
+            simple_pedometer_update(in[i][0], in[i][1], in[i][2], (r * BENCH_INPUTS + i) * 20UL);
+        }
+    }
+    upd_cycles = cycle_counter_get64() - c0;
+    host_mute_stdout(0);
+
+    (void)sink;
+    printf("host tsc/call: magnitude old %.1f new %.1f, simple_pedometer_update %.1f per sample\n",
+           (double)old_cycles / ((double)BENCH_ROUNDS * BENCH_INPUTS),
+           (double)new_cycles / ((double)BENCH_ROUNDS * BENCH_INPUTS),
+           (double)upd_cycles / ((double)BENCH_ROUNDS * BENCH_INPUTS));
+}
+
+int main(void)
+{
+    test_equivalence();
+    bench();
+
+    if (g_host_failures != 0) {
+        printf("test_pedometer_sqrt: %d FAILED\n", g_host_failures);
+        return 1;
+    }
+    printf("test_pedometer_sqrt: OK\n");
+    return 0;
+}
@@ -0,0 +1,231 @@
+/**
+ * @file test_rtc_date.c
+ * @brief rtc_date 日期与天数互转：2000~2099 年逐日穷举与耗时
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 直接包含 rtc_date.c 以调用其中的静态函数 DateTimeToSeconds / SecondsToDateTime；
+ *       旧实现取自改用闭式算法之前的版本（逐年、逐月累加），作为参考和耗时对照。
+ *       1. 穷举 2000-01-01 ~ 2099-12-31 每一天：天数连续、往返一致、星期与蔡勒公式一致、
+ *          带时分秒的互转与旧实现一致
+ *       2. 年份越界、日期超出当月天数时的截断行为与旧实现一致
+ *       3. 年初和年末（2000、2099）两端各自计时：旧实现耗时随年份增长，新实现应与日期无关
+ */
+
+#include "rtc_date.c"
+#include <string.h>
+#include "host_stub.h"
+#include "cycle_counter.h"
+
+#define BENCH_CALLS     1000000UL
+
+static uint8_t old_is_leap(uint16_t year)
+{
+    return (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)) ? 1 : 0;
+}
+
+/**
+ * @brief 旧实现：年月日时分秒 → 秒数（逐年、逐月累加）
+ */
+static uint32_t old_datetime_to_seconds(uint16_t year, uint8_t month, uint8_t day,
+                                        uint8_t hours, uint8_t minutes, uint8_t seconds)
+{
+    static const uint8_t days_in_month[] = {31,28,31,30,31,30,31,31,30,31,30,31};
+    uint32_t days = 0;
+    uint8_t dim;
+    uint16_t y;
+    uint8_t m;
+
+    if (year < RTC_EPOCH_YEAR) year = RTC_EPOCH_YEAR;
+    if (year > 2099) year = 2099;
+
+    for (y = RTC_EPOCH_YEAR; y < year; y++) {
+        days += 365 + old_is_leap(y);
+    }
+
+    dim = days_in_month[month - 1] + (month == 2 && old_is_leap(year));
+    if (day > dim) day = dim;
+
+    for (m = 1; m < month; m++) {
+        days += days_in_month[m - 1] + (m == 2 && old_is_leap(year));
+    }
+    days += day - 1;
+
+    return days * 86400UL + hours * 3600UL + minutes * 60UL + seconds;
+}
+
+/**
+ * @brief 旧实现：天数 → 年月日（逐年、逐月扣减）
+ */
+static void old_date_from_days(uint32_t days, uint16_t *year, uint8_t *month, uint8_t *day)
+{
+    static const uint8_t days_in_month[] = {31,28,31,30,31,30,31,31,30,31,30,31};
+
+    *year = RTC_EPOCH_YEAR;
+    while (1) {
+        uint32_t year_days = 365 + old_is_leap(*year);
+        if (days < year_days) break;
+        days -= year_days;
+        (*year)++;
+    }
+
+    *month = 1;
+    while (*month <= 12) {
+        uint8_t d = days_in_month[*month - 1] + (*month == 2 && old_is_leap(*year));
+        if (days < d) break;
+        days -= d;
+        (*month)++;
+    }
+    *day = (uint8_t)(days + 1);
+}
+
+/**
+ * @brief 蔡勒公式求星期（0=周日 ... 6=周六）
+ */
+static uint8_t zeller(uint16_t year, uint8_t month, uint8_t day)
+{
+    uint32_t k, j, h;
+
+    if (month < 3) {
+        month += 12;
+        year--;
+    }
+    k = year % 100;
+    j = year / 100;
+    h = (day + 13 * (month + 1) / 5 + k + k / 4 + j / 4 + 5 * j) % 7;   // 0=周六
+    return (uint8_t)((h + 6) % 7);
+}
+
+/**
+ * @brief 逐日穷举
+ */
+static void test_exhaustive(void)
+{
+    uint32_t days = 0;
+    uint16_t y;
+    uint8_t m, d;
+
+    for (y = 2000; y <= 2099; y++) {
+        for (m = 1; m <= 12; m++) {
+            for (d = 1; d <= MyRTC_DaysInMonth(y, m); d++) {
+                uint16_t y1, y2;
+                uint8_t m1, d1, t1[5], t2[5];
+                uint8_t hh = (uint8_t)(days % 24), mm = (uint8_t)(days % 60), ss = (uint8_t)(days * 7 % 60);
+                uint32_t sec = days * 86400UL + hh * 3600UL + mm * 60UL + ss;
+
+                if (MyRTC_DaysFromDate(y, m, d) != days) {
+                    printf("  %04u-%02u-%02u: days %lu, want %lu\n", y, m, d,
+                           (unsigned long)MyRTC_DaysFromDate(y, m, d), (unsigned long)days);
+                    g_host_failures++;
+                    return;
+                }
+
+                MyRTC_DateFromDays(days, &y1, &m1, &d1);
+                if (y1 != y || m1 != m || d1 != d) {
+                    printf("  day %lu: got %04u-%02u-%02u, want %04u-%02u-%02u\n",
+                           (unsigned long)days, y1, m1, d1, y, m, d);
+                    g_host_failures++;
+                    return;
+                }
+
+                HOST_CHECK(MyRTC_WeekdayFromDays(days) == zeller(y, m, d));
+                HOST_CHECK(DateTimeToSeconds(y, m, d, hh, mm, ss) == sec);
+                HOST_CHECK(old_datetime_to_seconds(y, m, d, hh, mm, ss) == sec);
+
+                SecondsToDateTime(sec, &y1, &t1[0], &t1[1], &t1[2], &t1[3], &t1[4]);
+                old_date_from_days(days, &y2, &t2[0], &t2[1]);
+                t2[2] = hh;
+                t2[3] = mm;
+                t2[4] = ss;
+                HOST_CHECK(y1 == y2 && memcmp(t1, t2, sizeof(t1)) == 0);
+
+                days++;
+            }
+        }
+    }
+    HOST_CHECK(days == 36525);
+    printf("exhaustive: %lu days 2000-01-01..2099-12-31 ok\n", (unsigned long)days);
+}
+
+/**
+ * @brief 越界输入：年份截断到 2000~2099，日期截断到月末
+ */
+static void test_clamp(void)
+{
+    unsigned long cases = 0;
+    uint16_t y;
+    uint8_t m, d;
+
+    for (y = 1990; y < 2110; y++) {
+        for (m = 1; m <= 12; m++) {
+            for (d = 1; d <= 31; d++) {
+                HOST_CHECK(DateTimeToSeconds(y, m, d, 1, 2, 3) == old_datetime_to_seconds(y, m, d, 1, 2, 3));
+                cases++;
+            }
+        }
+    }
+    printf("clamp: %lu out-of-range dates ok\n", cases);
+}
+
+/**
+ * @brief 耗时：2000 年和 2099 年各测一次
+ */
+static void bench(void)
+{
+    static const uint16_t years[2] = { 2000, 2099 };
+    volatile uint32_t sink = 0;
+    uint8_t k;
+
+    for (k = 0; k < 2; k++) {
+        uint32_t base = MyRTC_DaysFromDate(years[k], 1, 1);
+        uint64_t c0, old_d2n, new_d2n, old_n2d, new_n2d;
+        uint16_t y;
+        uint8_t m, d;
+        uint32_t i;
+
+        c0 = cycle_counter_get64();
+        for (i = 0; i < BENCH_CALLS; i++) {
+            sink += old_datetime_to_seconds(years[k], (uint8_t)(1 + i % 12), (uint8_t)(1 + i % 28), 0, 0, 0);
+        }
+        old_d2n = cycle_counter_get64() - c0;
+
+        c0 = cycle_counter_get64();
+        for (i = 0; i < BENCH_CALLS; i++) {
+            sink += DateTimeToSeconds(years[k], (uint8_t)(1 + i % 12), (uint8_t)(1 + i % 28), 0, 0, 0);
+        }
+        new_d2n = cycle_counter_get64() - c0;
+
+        c0 = cycle_counter_get64();
+        for (i = 0; i < BENCH_CALLS; i++) {
+            old_date_from_days(base + i % 365, &y, &m, &d);
+            sink += y + m + d;
+        }
+        old_n2d = cycle_counter_get64() - c0;
+
+        c0 = cycle_counter_get64();
+        for (i = 0; i < BENCH_CALLS; i++) {
+            MyRTC_DateFromDays(base + i % 365, &y, &m, &d);
+            sink += y + m + d;
+        }
+        new_n2d = cycle_counter_get64() - c0;
+
+        printf("%u: host tsc/call date->seconds old %.1f new %.1f, days->date old %.1f new %.1f\n",
+               years[k], (double)old_d2n / BENCH_CALLS, (double)new_d2n / BENCH_CALLS,
+               (double)old_n2d / BENCH_CALLS, (double)new_n2d / BENCH_CALLS);
+    }
+    (void)sink;
+}
+
+int main(void)
+{
+    test_exhaustive();
+    test_clamp();
+    bench();
+
+    if (g_host_failures != 0) {
+        printf("test_rtc_date: %d FAILED\n", g_host_failures);
+        return 1;
+    }
+    printf("test_rtc_date: OK\n");
+    return 0;
+}
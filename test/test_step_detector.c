@@ -0,0 +1,134 @@
+/**
+ * @file test_step_detector.c
+ * @brief step_detector 标注抓包回放测试与单采样耗时
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 用法：test_step_detector <抓包目录>（目录下需有 trace_gen 生成的 labels.txt）
+ *       每个抓包按采样率初始化后逐帧回放，步数误差须在 2 步 + 2% 以内；
+ *       同时逐次计时 step_detector_update，给出平均、中位数和 99% 分位的主机周期计数
+ *       （最大值受主机中断和调度影响，没有参考意义）
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_stub.h"
+#include "cycle_counter.h"
+#include "trace_file.h"
+#include "step_detector.h"
+
+#define STEP_TOLERANCE_ABS      2
+#define STEP_TOLERANCE_PERCENT  2
+#define STEP_MAX_TIMED_SAMPLES  (1UL << 20)
+
+static uint32_t s_cycles[STEP_MAX_TIMED_SAMPLES];
+static uint32_t s_timed;
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 回放一个抓包
+ * @return 0-完成，-1-文件无法读取
+ */
+static int replay_one(const char *path, uint16_t rate_hz, long truth)
+{
+    trace_file_t file;
+    trace_sample_t s;
+    unsigned long steps;
+    long err, limit;
+
+    if (trace_file_open(&file, path) != 0) {
+        return -1;
+    }
+
+    host_mute_stdout(1);
+    step_detector_init(rate_hz);
+    while (trace_file_next(&file, &s)) {
+        uint64_t c0 = cycle_counter_get64();
+        uint32_t used;
+
+        step_detector_update(s.ax, s.ay, s.az, s.timestamp_ms);
+        used = (uint32_t)(cycle_counter_get64() - c0);
+        if (s_timed < STEP_MAX_TIMED_SAMPLES) {
+            s_cycles[s_timed++] = used;
+        }
+    }
+    host_mute_stdout(0);
+    trace_file_close(&file);
+
+    // 抓包里记录的采样率应与标注一致
+    HOST_CHECK(file.sample_rate_hz == rate_hz);
+
+    steps = step_detector_get_steps();
+    err = (long)steps - truth;
+    limit = STEP_TOLERANCE_ABS + truth * STEP_TOLERANCE_PERCENT / 100;
+    printf("  %-24s %3uHz truth %4ld got %4lu %s\n", strrchr(path, '/') + 1,
+           rate_hz, truth, steps, (labs(err) <= limit) ? "ok" : "FAIL");
+    if (labs(err) > limit) {
+        g_host_failures++;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    char path[512];
+    char line[256];
+    char name[128];
+    uint64_t sum = 0;
+    uint32_t i;
+    unsigned traces = 0;
+    FILE *labels;
+
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <trace_dir>\n", argv[0]);
+        return 2;
+    }
+
+    snprintf(path, sizeof(path), "%s/labels.txt", argv[1]);
+    labels = fopen(path, "r");
+    if (labels == NULL) {
+        fprintf(stderr, "cannot read %s\n", path);
+        return 2;
+    }
+
+    while (fgets(line, sizeof(line), labels)) {
+        unsigned rate;
+        long steps, tilts;
+
+        if (line[0] == '#' || sscanf(line, "%127s %u %ld %ld", name, &rate, &steps, &tilts) != 4) {
+            continue;
+        }
+        snprintf(path, sizeof(path), "%s/%s", argv[1], name);
+        if (replay_one(path, (uint16_t)rate, steps) != 0) {
+            printf("  %s: cannot read\n", path);
+            g_host_failures++;
+        }
+        traces++;
+    }
+    fclose(labels);
+
+    HOST_CHECK(traces > 0);
+    if (s_timed > 0) {
+        for (i = 0; i < s_timed; i++) {
+            sum += s_cycles[i];
+        }
+        qsort(s_cycles, s_timed, sizeof(s_cycles[0]), cmp_u32);
+        printf("step_detector_update: %lu samples, host tsc avg %.1f median %lu p99 %lu per sample\n",
+               (unsigned long)s_timed, (double)sum / s_timed,
+               (unsigned long)s_cycles[s_timed / 2], (unsigned long)s_cycles[s_timed * 99 / 100]);
+    }
+
+    if (g_host_failures != 0) {
+        printf("test_step_detector: %d FAILED\n", g_host_failures);
+        return 1;
+    }
+    printf("test_step_detector: OK\n");
+    return 0;
+}
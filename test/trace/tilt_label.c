@@ -0,0 +1,62 @@
+/**
+ * @file tilt_label.c
+ * @brief 倾斜方向触发计数
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "tilt_label.h"
+#include <stdlib.h>
+
+/**
+ * @brief 初始化计数状态
+ * @param label 计数状态
+ */
+void tilt_label_init(tilt_label_t *label)
+{
+    label->dir = TILT_NONE;
+    label->events = 0;
+}
+
+/**
+ * @brief 按 Game2048 的规则判定倾斜方向
+ * @param pitch_cdeg 俯仰角（0.01°）
+ * @param roll_cdeg 横滚角（0.01°）
+ * @return 方向
+ */
+tilt_dir_t tilt_label_classify(int32_t pitch_cdeg, int32_t roll_cdeg)
+{
+    if (labs(pitch_cdeg) > labs(roll_cdeg)) {
+        if (pitch_cdeg < -TILT_TRIGGER_CDEG) {
+            return TILT_RIGHT;
+        }
+        if (pitch_cdeg > TILT_TRIGGER_CDEG) {
+            return TILT_LEFT;
+        }
+    } else {
+        if (roll_cdeg > TILT_TRIGGER_CDEG) {
+            return TILT_DOWN;
+        }
+        if (roll_cdeg < -TILT_TRIGGER_CDEG) {
+            return TILT_UP;
+        }
+    }
+    return TILT_NONE;
+}
+
+/**
+ * @brief 输入一帧姿态，方向变为非水平的新方向时计一次触发
+ * @param label 计数状态
+ * @param pitch_cdeg 俯仰角（0.01°）
+ * @param roll_cdeg 横滚角（0.01°）
+ */
+void tilt_label_feed(tilt_label_t *label, int32_t pitch_cdeg, int32_t roll_cdeg)
+{
+    tilt_dir_t dir = tilt_label_classify(pitch_cdeg, roll_cdeg);
+
+    if (dir != TILT_NONE && dir != label->dir) {
+        label->events++;
+    }
+    label->dir = dir;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file tilt_label.h
+ * @brief 倾斜方向触发计数（与 Game2048 的方向判定规则一致）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 取俯仰/横滚中绝对值较大的一轴，超过 20° 视为向该方向倾斜；
+ *       方向从无到有或换向时计一次触发
+ */
+
+#ifndef __TILT_LABEL_H
+#define __TILT_LABEL_H
+
+#include <stdint.h>
+
+#define TILT_TRIGGER_CDEG   2000    // Game2048 trigger_threshold = 20°
+
+typedef enum {
+    TILT_NONE = 0,
+    TILT_LEFT,
+    TILT_RIGHT,
+    TILT_UP,
+    TILT_DOWN
+} tilt_dir_t;
+
+typedef struct {
+    tilt_dir_t dir;             // 当前方向
+    unsigned long events;       // 触发次数
+} tilt_label_t;
+
+void tilt_label_init(tilt_label_t *label);
+tilt_dir_t tilt_label_classify(int32_t pitch_cdeg, int32_t roll_cdeg);
+void tilt_label_feed(tilt_label_t *label, int32_t pitch_cdeg, int32_t roll_cdeg);
+
+#endif
@@ -0,0 +1,149 @@
+/**
+ * @file trace_file.c
+ * @brief sensor_trace 抓包文件读取（主机端）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ */
+
+#include "trace_file.h"
+#include <string.h>
+#include "sensor_trace.h"
+
+static uint16_t trace_get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t trace_get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief 打开抓包文件
+ * @param trace 读取状态
+ * @param path 文件路径
+ * @return 0-成功，-1-参数错误，-2-打开失败
+ */
+int trace_file_open(trace_file_t *trace, const char *path)
+{
+    if (trace == NULL || path == NULL) {
+        return -1;
+    }
+
+    memset(trace, 0, sizeof(*trace));
+    trace->fp = fopen(path, "rb");
+    if (trace->fp == NULL) {
+        return -2;
+    }
+    return 0;
+}
+
+/**
+ * @brief 读取下一帧采样（开始/结束帧在内部处理）
+ * @param trace 读取状态
+ * @param sample 输出采样
+ * @return 1-读到采样，0-文件结束
+ */
+int trace_file_next(trace_file_t *trace, trace_sample_t *sample)
+{
+    uint8_t frame[4 + 255 + 1];
+    int c;
+
+    while ((c = fgetc(trace->fp)) != EOF) {
+        uint8_t sum;
+        uint16_t i;
+        uint8_t len;
+
+        // 1. 帧头同步
+        if (c != SENSOR_TRACE_HEAD0) {
+            continue;
+        }
+        c = fgetc(trace->fp);
+        if (c != SENSOR_TRACE_HEAD1) {
+            if (c == SENSOR_TRACE_HEAD0) {
+                ungetc(c, trace->fp);
+            }
+            continue;
+        }
+
+        // 2. 读取类型、长度、数据和校验和
+        frame[0] = SENSOR_TRACE_HEAD0;
+        frame[1] = SENSOR_TRACE_HEAD1;
+        if (fread(&frame[2], 1, 2, trace->fp) != 2) {
+            return 0;
+        }
+        len = frame[3];
+        if (fread(&frame[4], 1, len + 1, trace->fp) != (size_t)len + 1) {
+            return 0;
+        }
+
+        sum = 0;
+        for (i = 0; i < len + 4; i++) {
+            sum += frame[i];
+        }
+        if (sum != frame[len + 4]) {
+            // 校验失败：回退到帧头之后重新同步
+            trace->bad_frames++;
+            fseek(trace->fp, -(long)(len + 3), SEEK_CUR);
+            continue;
+        }
+
+        // 3. 按类型解析
+        switch (frame[2]) {
+        case SENSOR_TRACE_TYPE_SAMPLE:
+            if (len != 16) {
+                trace->bad_frames++;
+                break;
+            }
+            sample->timestamp_ms = trace_get_u32(&frame[4]);
+            sample->ax = (int16_t)trace_get_u16(&frame[8]);
+            sample->ay = (int16_t)trace_get_u16(&frame[10]);
+            sample->az = (int16_t)trace_get_u16(&frame[12]);
+            sample->gx = (int16_t)trace_get_u16(&frame[14]);
+            sample->gy = (int16_t)trace_get_u16(&frame[16]);
+            sample->gz = (int16_t)trace_get_u16(&frame[18]);
+            trace->samples++;
+            return 1;
+
+        case SENSOR_TRACE_TYPE_START:
+            if (len != 8) {
+                trace->bad_frames++;
+                break;
+            }
+            trace->version = frame[4];
+            trace->calibrated = frame[5];
+            trace->sample_rate_hz = trace_get_u16(&frame[6]);
+            break;
+
+        case SENSOR_TRACE_TYPE_STOP:
+            if (len != 8) {
+                trace->bad_frames++;
+                break;
+            }
+            trace->has_stop = 1;
+            trace->stop_frames = trace_get_u32(&frame[4]);
+            trace->stop_gaps = trace_get_u32(&frame[8]);
+            break;
+
+        default:
+            trace->bad_frames++;
+            break;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 关闭抓包文件
+ * @param trace 读取状态
+ */
+void trace_file_close(trace_file_t *trace)
+{
+    if (trace != NULL && trace->fp != NULL) {
+        fclose(trace->fp);
+        trace->fp = NULL;
+    }
+}
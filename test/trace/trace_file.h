@@ -0,0 +1,39 @@
+/**
+ * @file trace_file.h
+ * @brief sensor_trace 抓包文件读取（主机端）
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 按帧头+校验和逐帧同步，帧格式见 sensor_trace.h；
+ *       抓包前后残留的串口文本和校验失败的帧被跳过并计数
+ */
+
+#ifndef __TRACE_FILE_H
+#define __TRACE_FILE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct {
+    uint32_t timestamp_ms;
+    int16_t ax, ay, az;
+    int16_t gx, gy, gz;
+} trace_sample_t;
+
+typedef struct {
+    FILE *fp;
+    uint8_t version;            // 开始帧中的协议版本（0 表示未见开始帧）
+    uint8_t calibrated;         // 抓包时是否已校准
+    uint16_t sample_rate_hz;    // 采样率（未见开始帧时为0）
+    uint32_t samples;           // 已读出的采样帧数
+    uint32_t bad_frames;        // 校验失败或长度不符的帧数
+    uint8_t has_stop;           // 是否读到结束帧
+    uint32_t stop_frames;       // 结束帧记录的发送帧数
+    uint32_t stop_gaps;         // 结束帧记录的采样间隔异常数
+} trace_file_t;
+
+int trace_file_open(trace_file_t *trace, const char *path);
+int trace_file_next(trace_file_t *trace, trace_sample_t *sample);
+void trace_file_close(trace_file_t *trace);
+
+#endif
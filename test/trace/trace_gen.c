@@ -0,0 +1,307 @@
+/**
+ * @file trace_gen.c
+ * @brief 生成带标注的合成抓包文件
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 用法：trace_gen <输出目录>
+ *       每个场景按真实的重力方向、步态相位和角速度合成六轴原始值，
+ *       经固件的 sensor_trace.c 编码写成与串口抓包相同的文件，
+ *       标注（真实步数、倾斜触发次数）写入 labels.txt；
+ *       随机数用固定种子的 LCG，生成结果与平台无关
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "sensor_trace.h"
+#include "host_stub.h"
+#include "tilt_label.h"
+
+// ==================================
+// 场景定义
+// ==================================
+
+typedef struct {
+    double start_s;             // 段开始时间
+    double pitch_deg;           // 目标俯仰角
+    double roll_deg;            // 目标横滚角
+} tilt_keyframe_t;
+
+typedef struct {
+    const char *name;
+    uint16_t rate_hz;           // 采样率
+    double duration_s;          // 总时长
+    double cadence_hz;          // 步频（0 表示不走路）
+    double step_amp;            // 步态加速度幅度（LSB，16384 = 1g）
+    double arm_amp;             // 半步频摆臂分量幅度
+    double noise;               // 加速度白噪声标准差
+    double walk_s;              // 走/停交替：走的时长（0 表示一直走）
+    double stop_s;              // 走/停交替：停的时长
+    double drop_ratio;          // 丢帧概率（模拟读传感器失败）
+    double jitter_ms;           // 时间戳抖动幅度
+    const tilt_keyframe_t *tilt;    // 倾斜关键帧（NULL 表示保持水平）
+    uint8_t tilt_count;
+} trace_scenario_t;
+
+static const tilt_keyframe_t s_tilt_table[] = {
+    {  0.0,   0.0,   0.0 },
+    {  2.0,  35.0,   0.0 },     // 左
+    {  5.0,   0.0,   0.0 },
+    {  7.0, -35.0,   0.0 },     // 右
+    { 10.0,   0.0,   0.0 },
+    { 12.0,   0.0,  35.0 },     // 下
+    { 15.0,   0.0,   0.0 },
+    { 17.0,   0.0, -35.0 },     // 上
+    { 20.0,   0.0,   0.0 },
+    { 22.0,  12.0,   8.0 },     // 只到趋势区，不触发
+    { 25.0,   0.0,   0.0 },
+};
+
+static const tilt_keyframe_t s_tilt_hold[] = {
+    {  0.0,   0.0,   0.0 },
+    {  3.0,  30.0,   0.0 },     // 手持走路时向左倾
+    { 20.0,   0.0,   0.0 },
+};
+
+static const trace_scenario_t s_scenarios[] = {
+    // name               rate  dur  cad  step   arm   noise walk stop drop  jit  tilt
+    { "walk_1p8hz",        50,  60, 1.8,  4000, 1500,  500,   0,  0, 0.00, 0.0, NULL, 0 },
+    { "walk_1p8hz_25hz",   25,  60, 1.8,  4000, 1500,  500,   0,  0, 0.00, 0.0, NULL, 0 },
+    { "walk_1p8hz_100hz", 100,  60, 1.8,  4000, 1500,  500,   0,  0, 0.00, 0.0, NULL, 0 },
+    { "slow_1p0hz",        50,  60, 1.0,  2000, 1000,  400,   0,  0, 0.00, 0.0, NULL, 0 },
+    { "slow_0p8hz",        50,  60, 0.8,  1500,  600,  300,   0,  0, 0.00, 0.0, NULL, 0 },
+    { "run_2p8hz",         50,  60, 2.8, 12000, 4000,  800,   0,  0, 0.00, 0.0, NULL, 0 },
+    { "walk_stop_10_5",    50,  90, 1.7,  4500, 2000,  500,  10,  5, 0.00, 0.0, NULL, 0 },
+    { "walk_stop_6_4",     50,  90, 1.1,  2500, 1200,  400,   6,  4, 0.00, 0.0, NULL, 0 },
+    { "walk_jitter_drop",  50,  60, 1.8,  4000, 1500,  500,   0,  0, 0.02, 4.0, NULL, 0 },
+    { "idle_desk",         50,  60, 0.0,     0,    0,  300,   0,  0, 0.00, 0.0, NULL, 0 },
+    { "tilt_desk",         50,  28, 0.0,     0,    0,  300,   0,  0, 0.00, 0.0,
+      s_tilt_table, sizeof(s_tilt_table) / sizeof(s_tilt_table[0]) },
+    { "walk_tilted",       50,  30, 1.8,  4000, 1000,  500,   0,  0, 0.00, 0.0,
+      s_tilt_hold, sizeof(s_tilt_hold) / sizeof(s_tilt_hold[0]) },
+};
+
+#define SCENARIO_COUNT  (sizeof(s_scenarios) / sizeof(s_scenarios[0]))
+
+#define TILT_RAMP_S     0.6     // 关键帧之间的过渡时间
+#define GYRO_LSB_DPS    16.4    // ±2000dps
+#define GYRO_NOISE      4.0     // 陀螺仪白噪声（LSB）
+#define ACC_ONE_G       16384.0
+
+// ==================================
+// 随机数（固定种子，平台无关）
+// ==================================
+
+static uint64_t s_rng;
+
+static double rng_uniform(void)
+{
+    s_rng = s_rng * 6364136223846793005ULL + 1442695040888963407ULL;
+    return ((double)(s_rng >> 11) + 0.5) / 9007199254740992.0;
+}
+
+static double rng_normal(void)
+{
+    double u = rng_uniform();
+    double v = rng_uniform();
+    return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+// ==================================
+// 合成
+// ==================================
+
+/**
+ * @brief 计算某时刻的目标姿态（关键帧之间余弦过渡）
+ */
+static void scenario_attitude(const trace_scenario_t *sc, double t, double *pitch, double *roll)
+{
+    uint8_t i;
+
+    *pitch = 0.0;
+    *roll = 0.0;
+    if (sc->tilt == NULL) {
+        return;
+    }
+
+    for (i = 0; i < sc->tilt_count; i++) {
+        const tilt_keyframe_t *k = &sc->tilt[i];
+        if (t < k->start_s) {
+            break;
+        }
+        if (i > 0 && t < k->start_s + TILT_RAMP_S) {
+            const tilt_keyframe_t *p = &sc->tilt[i - 1];
+            double w = 0.5 - 0.5 * cos(M_PI * (t - k->start_s) / TILT_RAMP_S);
+            *pitch = p->pitch_deg + (k->pitch_deg - p->pitch_deg) * w;
+            *roll = p->roll_deg + (k->roll_deg - p->roll_deg) * w;
+        } else {
+            *pitch = k->pitch_deg;
+            *roll = k->roll_deg;
+        }
+    }
+}
+
+/**
+ * @brief 姿态角 -> 机体系重力单位向量（pitch 对应 x 分量，与 imu_attitude 的角度定义一致）
+ */
+static void attitude_to_gravity(double pitch_deg, double roll_deg, double g[3])
+{
+    double p = pitch_deg * M_PI / 180.0;
+    double r = roll_deg * M_PI / 180.0;
+
+    g[0] = sin(p);
+    g[1] = cos(p) * sin(r);
+    g[2] = cos(p) * cos(r);
+}
+
+static short clamp_short(double v)
+{
+    if (v > 32767.0) {
+        return 32767;
+    }
+    if (v < -32768.0) {
+        return -32768;
+    }
+    return (short)lround(v);
+}
+
+/**
+ * @brief 生成一个场景
+ * @param sc 场景
+ * @param path 输出文件
+ * @param steps 输出真实步数
+ * @param tilts 输出真实倾斜触发次数
+ * @return 0-成功，-1-文件打开失败
+ */
+static int scenario_generate(const trace_scenario_t *sc, const char *path,
+                             unsigned long *steps, unsigned long *tilts)
+{
+    double dt = 1.0 / sc->rate_hz;
+    double step_phase = 0.0;
+    double arm_phase = 0.0;
+    tilt_label_t label;
+    uint32_t n;
+    uint32_t count = (uint32_t)(sc->duration_s * sc->rate_hz);
+    FILE *fp = fopen(path, "wb");
+
+    if (fp == NULL) {
+        return -1;
+    }
+
+    s_rng = 0x9E3779B97F4A7C15ULL ^ (uint64_t)sc->rate_hz;
+    for (n = 0; sc->name[n] != '\0'; n++) {
+        s_rng = s_rng * 31 + (uint8_t)sc->name[n];
+    }
+
+    *steps = 0;
+    tilt_label_init(&label);
+
+    // 抓包前残留的串口文本，读取端应能跳过
+    fputs("Sensor trace start\r\n", fp);
+    g_host_uart = fp;
+    sensor_trace_start(sc->rate_hz);
+
+    for (n = 0; n < count; n++) {
+        double t = n * dt;
+        double pitch, roll, pitch_next, roll_next;
+        double g[3], g_next[3], gdot[3], w[3];
+        double mag = ACC_ONE_G;
+        uint8_t walking = sc->cadence_hz > 0.0 &&
+                          (sc->walk_s <= 0.0 || fmod(t, sc->walk_s + sc->stop_s) < sc->walk_s);
+        double ts;
+        uint8_t i;
+
+        // 1. 姿态与角速度：ω = ġ × g，使 imu_attitude 的 dg/dt = g × ω 成立
+        scenario_attitude(sc, t, &pitch, &roll);
+        scenario_attitude(sc, t + dt, &pitch_next, &roll_next);
+        attitude_to_gravity(pitch, roll, g);
+        attitude_to_gravity(pitch_next, roll_next, g_next);
+        for (i = 0; i < 3; i++) {
+            gdot[i] = (g_next[i] - g[i]) / dt;
+        }
+        w[0] = gdot[1] * g[2] - gdot[2] * g[1];
+        w[1] = gdot[2] * g[0] - gdot[0] * g[2];
+        w[2] = gdot[0] * g[1] - gdot[1] * g[0];
+
+        tilt_label_feed(&label, (int32_t)lround(pitch * 100.0), (int32_t)lround(roll * 100.0));
+
+        // 2. 步态：每完成一个相位周期计一步，步频带少量逐步抖动
+        if (walking) {
+            double cad = sc->cadence_hz * (1.0 + 0.01 * rng_normal());
+            double next = step_phase + 2.0 * M_PI * cad * dt;
+            if (floor(next / (2.0 * M_PI)) > floor(step_phase / (2.0 * M_PI))) {
+                (*steps)++;
+            }
+            step_phase = next;
+            mag += sc->step_amp * sin(step_phase) + 0.3 * sc->step_amp * sin(2.0 * step_phase);
+
+            arm_phase += M_PI * sc->cadence_hz * dt;
+            mag += sc->arm_amp * sin(arm_phase);
+        }
+
+        // 3. 丢帧：步态和姿态照常推进，只是这一帧没有读到
+        if (sc->drop_ratio > 0.0 && rng_uniform() < sc->drop_ratio) {
+            continue;
+        }
+
+        ts = t * 1000.0 + 1000.0;
+        if (sc->jitter_ms > 0.0) {
+            ts += (rng_uniform() - 0.5) * sc->jitter_ms;
+        }
+
+        sensor_trace_feed((uint32_t)ts,
+                          clamp_short(g[0] * mag + sc->noise * rng_normal()),
+                          clamp_short(g[1] * mag + sc->noise * rng_normal()),
+                          clamp_short(g[2] * mag + sc->noise * rng_normal()),
+                          clamp_short(w[0] * 180.0 / M_PI * GYRO_LSB_DPS + GYRO_NOISE * rng_normal()),
+                          clamp_short(w[1] * 180.0 / M_PI * GYRO_LSB_DPS + GYRO_NOISE * rng_normal()),
+                          clamp_short(w[2] * 180.0 / M_PI * GYRO_LSB_DPS + GYRO_NOISE * rng_normal()));
+    }
+
+    // 结束帧在下一次喂数据时发出
+    sensor_trace_stop();
+    sensor_trace_feed(0, 0, 0, 0, 0, 0, 0);
+    g_host_uart = NULL;
+    fclose(fp);
+
+    *tilts = label.events;
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    char path[512];
+    FILE *labels;
+    unsigned i;
+
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <out_dir>\n", argv[0]);
+        return 2;
+    }
+
+    snprintf(path, sizeof(path), "%s/labels.txt", argv[1]);
+    labels = fopen(path, "w");
+    if (labels == NULL) {
+        fprintf(stderr, "cannot write %s\n", path);
+        return 1;
+    }
+    fprintf(labels, "# file rate_hz steps tilts\n");
+
+    for (i = 0; i < SCENARIO_COUNT; i++) {
+        const trace_scenario_t *sc = &s_scenarios[i];
+        unsigned long steps, tilts;
+
+        snprintf(path, sizeof(path), "%s/%s.bin", argv[1], sc->name);
+        if (scenario_generate(sc, path, &steps, &tilts) != 0) {
+            fprintf(stderr, "cannot write %s\n", path);
+            fclose(labels);
+            return 1;
+        }
+        fprintf(labels, "%s.bin %u %lu %lu\n", sc->name, sc->rate_hz, steps, tilts);
+    }
+
+    fclose(labels);
+    return 0;
+}
@@ -0,0 +1,355 @@
+/**
+ * @file trace_replay.c
+ * @brief 抓包回放：把 sensor_trace 文件喂给固件的计步与姿态算法
+ * @author flowkite-0689
+ * @version v1.0
+ * @date 2026.10.19
+ * @note 用法：trace_replay [-l labels.txt] trace.bin ...
+ *       调用顺序与 Pedometer_Task 一致（姿态 -> 简单计步 -> 自适应计步 -> 运动识别），
+ *       输出步数、峰值数、倾斜触发次数（Game2048 的 20° 规则）、运动状态切换次数，
+ *       以及各算法每个采样的主机耗时；给出标注文件时同时打印真值与误差。
+ *       主机耗时只用于比较改动前后，目标板周期数需用各模块的 *_PROFILE 宏实测
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_stub.h"
+#include "cycle_counter.h"
+#include "trace_file.h"
+#include "tilt_label.h"
+#include "simple_pedometer.h"
+#include "step_detector.h"
+#include "imu_attitude.h"
+#include "activity.h"
+
+#define REPLAY_DEFAULT_RATE_HZ  50          // 没有开始帧时按固件默认采样率
+#define REPLAY_MIN_BENCH_NS     20000000ULL // 每项计时至少跑 20ms
+
+typedef struct {
+    trace_sample_t *samples;
+    uint32_t count;
+    uint16_t rate_hz;
+    uint32_t bad_frames;
+    uint32_t gaps;
+} replay_trace_t;
+
+typedef struct {
+    unsigned long simple_steps;
+    unsigned long steps;
+    unsigned long peaks;
+    unsigned long tilts;
+    unsigned long activity_changes;
+    uint8_t activity_state;
+    uint32_t acc_used;
+    int32_t pitch_min, pitch_max;
+    int32_t roll_min, roll_max;
+} replay_result_t;
+
+typedef enum {
+    BENCH_ATTITUDE = 0,
+    BENCH_SIMPLE,
+    BENCH_STEP,
+    BENCH_STEP_ACTIVITY,
+    BENCH_ALL,
+    BENCH_COUNT
+} replay_bench_t;
+
+static const char *const s_bench_name[BENCH_COUNT] = {
+    "attitude", "simple", "step", "step+act", "all"
+};
+
+// ==================================
+// 读取
+// ==================================
+
+/**
+ * @brief 把整个抓包读入内存，计时不包含文件解析
+ * @return 0-成功，-1-打开失败，-2-内存不足
+ */
+static int replay_load(const char *path, replay_trace_t *trace)
+{
+    trace_file_t file;
+    trace_sample_t sample;
+    uint32_t capacity = 1024;
+    uint32_t i;
+
+    memset(trace, 0, sizeof(*trace));
+    if (trace_file_open(&file, path) != 0) {
+        return -1;
+    }
+
+    trace->samples = malloc(capacity * sizeof(trace_sample_t));
+    if (trace->samples == NULL) {
+        trace_file_close(&file);
+        return -2;
+    }
+
+    while (trace_file_next(&file, &sample)) {
+        if (trace->count == capacity) {
+            trace_sample_t *grown = realloc(trace->samples, capacity * 2 * sizeof(trace_sample_t));
+            if (grown == NULL) {
+                trace_file_close(&file);
+                return -2;
+            }
+            trace->samples = grown;
+            capacity *= 2;
+        }
+        trace->samples[trace->count++] = sample;
+    }
+
+    trace->rate_hz = file.sample_rate_hz ? file.sample_rate_hz : REPLAY_DEFAULT_RATE_HZ;
+    trace->bad_frames = file.bad_frames;
+    if (file.has_stop) {
+        trace->gaps = file.stop_gaps;
+    } else {
+        // 没有结束帧（抓包被截断）时按同样的 1.5 倍周期规则自己统计
+        uint32_t period = 1000 / trace->rate_hz;
+        for (i = 1; i < trace->count; i++) {
+            if ((trace->samples[i].timestamp_ms - trace->samples[i - 1].timestamp_ms) * 2 > period * 3) {
+                trace->gaps++;
+            }
+        }
+    }
+
+    trace_file_close(&file);
+    return 0;
+}
+
+// ==================================
+// 回放
+// ==================================
+
+static void replay_init(uint16_t rate_hz)
+{
+    imu_attitude_init(rate_hz);
+    simple_pedometer_init();
+    step_detector_init(rate_hz);
+    activity_init(rate_hz);
+}
+
+static uint16_t replay_dt(const replay_trace_t *trace, uint32_t i)
+{
+    if (i == 0) {
+        return (uint16_t)(1000 / trace->rate_hz);
+    }
+    return (uint16_t)(trace->samples[i].timestamp_ms - trace->samples[i - 1].timestamp_ms);
+}
+
+/**
+ * @brief 按 Pedometer_Task 的顺序完整回放一遍并统计结果
+ */
+static void replay_run(const replay_trace_t *trace, replay_result_t *result)
+{
+    tilt_label_t tilt;
+    unsigned long peaks_start;
+    uint32_t i;
+
+    memset(result, 0, sizeof(*result));
+    result->pitch_min = result->roll_min = 18000;
+    result->pitch_max = result->roll_max = -18000;
+    tilt_label_init(&tilt);
+
+    host_mute_stdout(1);
+    replay_init(trace->rate_hz);
+    peaks_start = step_detector_get_peaks();    // 峰值计数不随初始化清零
+
+    for (i = 0; i < trace->count; i++) {
+        const trace_sample_t *s = &trace->samples[i];
+        imu_attitude_t att;
+        activity_info_t info;
+
+        g_host_tick = s->timestamp_ms;
+        imu_attitude_update(s->ax, s->ay, s->az, s->gx, s->gy, s->gz, replay_dt(trace, i));
+        simple_pedometer_update(s->ax, s->ay, s->az, s->timestamp_ms);
+        step_detector_update(s->ax, s->ay, s->az, s->timestamp_ms);
+        activity_update(s->ax, s->ay, s->az, s->timestamp_ms);
+
+        imu_attitude_get(&att);
+        if (att.valid) {
+            tilt_label_feed(&tilt, att.pitch, att.roll);
+            result->acc_used += att.acc_used;
+            if (att.pitch < result->pitch_min) result->pitch_min = att.pitch;
+            if (att.pitch > result->pitch_max) result->pitch_max = att.pitch;
+            if (att.roll < result->roll_min) result->roll_min = att.roll;
+            if (att.roll > result->roll_max) result->roll_max = att.roll;
+        }
+
+        activity_get(&info);
+        if (i > 0 && info.state != result->activity_state) {
+            result->activity_changes++;
+        }
+        result->activity_state = info.state;
+    }
+
+    host_mute_stdout(0);
+
+    result->simple_steps = simple_pedometer_get_steps();
+    result->steps = step_detector_get_steps();
+    result->peaks = step_detector_get_peaks() - peaks_start;
+    result->tilts = tilt.events;
+}
+
+/**
+ * @brief 计时：只跑指定算法，重复到总时长足够后取每采样平均
+ * @param ns_per_sample 输出主机纳秒/采样
+ * @param tsc_per_sample 输出主机周期计数/采样
+ */
+static void replay_bench(const replay_trace_t *trace, replay_bench_t which,
+                         double *ns_per_sample, double *tsc_per_sample)
+{
+    uint64_t ns = 0, tsc = 0, samples = 0;
+    uint32_t i;
+
+    if (trace->count == 0) {
+        *ns_per_sample = *tsc_per_sample = 0.0;
+        return;
+    }
+
+    host_mute_stdout(1);
+    while (ns < REPLAY_MIN_BENCH_NS) {
+        uint64_t t0, c0;
+
+        replay_init(trace->rate_hz);
+        t0 = host_now_ns();
+        c0 = cycle_counter_get64();
+
+        for (i = 0; i < trace->count; i++) {
+            const trace_sample_t *s = &trace->samples[i];
+
+            if (which == BENCH_ATTITUDE || which == BENCH_ALL) {
+                imu_attitude_update(s->ax, s->ay, s->az, s->gx, s->gy, s->gz, replay_dt(trace, i));
+            }
+            if (which == BENCH_SIMPLE || which == BENCH_ALL) {
+                simple_pedometer_update(s->ax, s->ay, s->az, s->timestamp_ms);
+            }
+            if (which == BENCH_STEP || which == BENCH_STEP_ACTIVITY || which == BENCH_ALL) {
+                step_detector_update(s->ax, s->ay, s->az, s->timestamp_ms);
+            }
+            if (which == BENCH_STEP_ACTIVITY || which == BENCH_ALL) {
+                activity_update(s->ax, s->ay, s->az, s->timestamp_ms);
+            }
+        }
+
+        tsc += cycle_counter_get64() - c0;
+        ns += host_now_ns() - t0;
+        samples += trace->count;
+    }
+    host_mute_stdout(0);
+
+    *ns_per_sample = (double)ns / (double)samples;
+    *tsc_per_sample = (double)tsc / (double)samples;
+}
+
+// ==================================
+// 标注
+// ==================================
+
+/**
+ * @brief 在标注文件中查找抓包的真值
+ * @return 0-找到，-1-没有
+ */
+static int replay_find_label(const char *labels_path, const char *trace_path,
+                             long *steps, long *tilts)
+{
+    const char *base = strrchr(trace_path, '/');
+    char line[256];
+    char name[128];
+    unsigned rate;
+    FILE *fp;
+
+    if (labels_path == NULL) {
+        return -1;
+    }
+    fp = fopen(labels_path, "r");
+    if (fp == NULL) {
+        return -1;
+    }
+
+    base = base ? base + 1 : trace_path;
+    while (fgets(line, sizeof(line), fp)) {
+        if (line[0] == '#') {
+            continue;
+        }
+        if (sscanf(line, "%127s %u %ld %ld", name, &rate, steps, tilts) == 4 &&
+            strcmp(name, base) == 0) {
+            fclose(fp);
+            return 0;
+        }
+    }
+
+    fclose(fp);
+    return -1;
+}
+
+static void replay_print_error(const char *what, unsigned long got, long truth)
+{
+    if (truth > 0) {
+        printf("  %-9s %6lu  truth %6ld  (%+.1f%%)\n", what, got, truth,
+               100.0 * ((double)got - (double)truth) / (double)truth);
+    } else {
+        printf("  %-9s %6lu  truth %6ld\n", what, got, truth);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *labels = NULL;
+    int argi = 1;
+    int ret = 0;
+
+    if (argc > 2 && strcmp(argv[1], "-l") == 0) {
+        labels = argv[2];
+        argi = 3;
+    }
+    if (argi >= argc) {
+        fprintf(stderr, "usage: %s [-l labels.txt] trace.bin ...\n", argv[0]);
+        return 2;
+    }
+
+    for (; argi < argc; argi++) {
+        replay_trace_t trace;
+        replay_result_t result;
+        long truth_steps, truth_tilts;
+        int b;
+
+        if (replay_load(argv[argi], &trace) != 0) {
+            fprintf(stderr, "%s: cannot read\n", argv[argi]);
+            ret = 1;
+            continue;
+        }
+
+        replay_run(&trace, &result);
+
+        printf("%s: %lu samples @%uHz, %lu gaps, %lu bad frames\n", argv[argi],
+               (unsigned long)trace.count, trace.rate_hz,
+               (unsigned long)trace.gaps, (unsigned long)trace.bad_frames);
+        if (replay_find_label(labels, argv[argi], &truth_steps, &truth_tilts) == 0) {
+            replay_print_error("simple", result.simple_steps, truth_steps);
+            replay_print_error("adaptive", result.steps, truth_steps);
+            replay_print_error("tilt", result.tilts, truth_tilts);
+        } else {
+            printf("  simple %lu  adaptive %lu  tilt %lu\n",
+                   result.simple_steps, result.steps, result.tilts);
+        }
+        printf("  peaks %lu  activity %s (%lu changes)  acc_used %.0f%%\n",
+               result.peaks, activity_state_name((activity_state_t)result.activity_state),
+               result.activity_changes,
+               trace.count ? 100.0 * result.acc_used / trace.count : 0.0);
+        printf("  pitch %.1f..%.1f  roll %.1f..%.1f deg\n",
+               result.pitch_min / 100.0, result.pitch_max / 100.0,
+               result.roll_min / 100.0, result.roll_max / 100.0);
+
+        printf("  host cost per sample:");
+        for (b = 0; b < BENCH_COUNT; b++) {
+            double ns, tsc;
+            replay_bench(&trace, (replay_bench_t)b, &ns, &tsc);
+            printf("  %s %.0fns/%.0ftsc", s_bench_name[b], ns, tsc);
+        }
+        printf("\n");
+
+        free(trace.samples);
+    }
+
+    return ret;
+}